@@ -11,6 +11,9 @@
 #include "NGSHelper.h"
 #include "BamWriter.h"
 #include <QHash>
+#include <map>
+#include <set>
+#include <limits>
 
 class ConcreteTool
 		: public ToolBase
@@ -20,6 +23,7 @@ class ConcreteTool
 public:
 	ConcreteTool(int& argc, char *argv[])
 		: ToolBase(argc, argv)
+		, out_(stderr)
 	{
 	}
 
@@ -30,7 +34,7 @@ public:
 													"There are several parameters available for handling of mismatches in overlapping reads. " \
 													"Within the overlap the higher base quality will be kept for each basepair."
 							   );
-		addInfile("in", "Input bam file. Needs to be sorted by name.", false);
+		addInfile("in", "Input bam file. Needs to be sorted by name (or by coordinate, see 'coord_sorted').", false);
 		addOutfile("out", "Output bam file.", false);
 		//optional
 		addFlag("overlap_mismatch_mapq", "Set mapping quality of pair to 0 if mismatch is found in overlapping reads.");
@@ -38,9 +42,11 @@ public:
 		addFlag("overlap_mismatch_baseq", "Reduce base quality if mismatch is found in overlapping reads.");
 		addFlag("overlap_mismatch_basen", "Set base to N if mismatch is found in overlapping reads.");
 		addFlag("ignore_indels","Turn off indel detection in overlap.");
+		addFlag("coord_sorted", "Input BAM is sorted by coordinate. Only reads waiting for their mate are kept in memory and the output is sorted by coordinate as well.");
 		addFlag("v", "Verbose mode.");
 
 		//changelog
+		changeLog(2026,10,18,"Added support for coordinate-sorted input (flag 'coord_sorted').");
 		changeLog(2018,01,11,"Updated base quality handling within overlap.");
 		changeLog(2017,01,16,"Added overlap mismatch filter.");
 	}
@@ -48,499 +54,654 @@ public:
 	virtual void main()
 	{
 		//step 1: init
-		int reads_count = 0;
-		int reads_saved = 0;
-		int reads_clipped = 0;
-		int reads_mismatch = 0;
-		quint64 bases_count = 0;
-		quint64 bases_clipped = 0;
-		QTextStream out(stderr);
-		bool verbose = getFlag("v");
-		bool ignore_indels = getFlag("ignore_indels");
+		verbose_ = getFlag("v");
+		ignore_indels_ = getFlag("ignore_indels");
 		BamReader reader(getInfile("in"));
 		BamWriter writer(getOutfile("out"));
 		writer.writeHeader(reader);
 
 		//step 2: get alignments and softclip if necessary
+		if (getFlag("coord_sorted"))
+		{
+			processCoordinateSorted(reader, writer);
+		}
+		else
+		{
+			processNameSorted(reader, writer);
+		}
+
+		//step 3: write out statistics
+		if(reads_saved_!=reads_count_)	THROW(ToolFailedException, "Lost Reads: "+QString::number(reads_count_-reads_saved_)+"/"+QString::number(reads_count_));
+		out_ << "Overlap mismatch filtering was used for " << QString::number(reads_mismatch_) << " of " << QString::number(reads_count_) << " reads (" << QString::number((double)reads_mismatch_/(double)reads_count_*100,'f',2) << " %)." << endl;
+		out_ << "Softclipped " << QString::number(reads_clipped_) << " of " << QString::number(reads_count_) << " reads (" << QString::number(((double)reads_clipped_/(double)reads_count_*100),'f',2) << " %)." << endl;
+		out_ << "Softclipped " << QString::number(bases_clipped_) << " of " << QString::number(bases_count_) << " basepairs (" << QString::number((double)bases_clipped_/(double)bases_count_*100,'f',2) << " %)." << endl;
+	}
+
+private:
+	QTextStream out_;
+	bool verbose_ = false;
+	bool ignore_indels_ = false;
+	int reads_count_ = 0;
+	int reads_saved_ = 0;
+	int reads_clipped_ = 0;
+	int reads_mismatch_ = 0;
+	quint64 bases_count_ = 0;
+	quint64 bases_clipped_ = 0;
+
+	//buffers for coordinate-sorted input
+	QHash<QByteArray, BamAlignment> pending_; //reads waiting for their mate
+	std::multimap<int, QByteArray> pending_mate_pos_; //expected mate position (1-based) > read name
+	std::multiset<int> pending_start_; //start positions of pending reads
+	std::multimap<int, BamAlignment> out_buffer_; //reorder window: clipping can move the start of alignments to the right
+
+	//Returns if the read can be clipped, i.e. it is a primary alignment of a pair with both reads mapped to the same chromosome.
+	static bool isClippingCandidate(const BamAlignment& al)
+	{
+		if(!al.isPaired() || al.isSecondaryAlignment()) return false;
+		if(al.isUnmapped() && al.isMateUnmapped()) return false; // only mapped reads
+		if(al.chromosomeID()!=al.mateChrosomeID()) return false; // different chromosomes
+		if(al.cigarData().isEmpty()) return false; // only with CIGAR data
+
+		return true;
+	}
+
+	//Name-sorted input: reads are kept in memory until their mate is found.
+	void processNameSorted(BamReader& reader, BamWriter& writer)
+	{
 		BamAlignment al;
 		QHash<QByteArray, BamAlignment> al_map;
 		while (reader.getNextAlignment(al))
 		{
-			++reads_count;
-			bases_count += al.length();
-			bool skip_al = false;
+			++reads_count_;
+			bases_count_ += al.length();
 
 			//check preconditions and if unmet save read to out and continue
-			if(!al.isPaired() || al.isSecondaryAlignment())
+			if(!isClippingCandidate(al))
 			{
 				writer.writeAlignment(al);
-				++reads_saved;
+				++reads_saved_;
 				continue;
 			}
-			if(al.isUnmapped() && al.isMateUnmapped())	// only mapped reads
+
+			QByteArray name = al.name();
+			if(al_map.contains(name))
 			{
-				writer.writeAlignment(al);
-				++reads_saved;
-				continue;
+				BamAlignment forward_read = al_map.take(name);
+				BamAlignment reverse_read = al;
+				bool skip_al = clipPair(forward_read, reverse_read, reader);
+
+				//save reads
+				reads_saved_+=2;
+				if(skip_al)	continue;
+				writer.writeAlignment(forward_read);
+				writer.writeAlignment(reverse_read);
 			}
-			if(al.chromosomeID()!=al.mateChrosomeID())	// different chromosomes
+			else    //keep in map
 			{
-				writer.writeAlignment(al);
-				++reads_saved;
-				continue;
+				al_map.insert(name, al);
 			}
-			if(al.cigarData().isEmpty())	// only with CIGAR data
+		}
+
+		//save all remaining reads
+		foreach(const BamAlignment& al, al_map)
+		{
+			writer.writeAlignment(al);
+			++reads_saved_;
+		}
+	}
+
+	//Coordinate-sorted input: only reads whose mate starts within the read are kept in memory until the mate is found, output is written in coordinate order.
+	void processCoordinateSorted(BamReader& reader, BamWriter& writer)
+	{
+		BamAlignment al;
+		int chr_id = std::numeric_limits<int>::min();
+		while (reader.getNextAlignment(al))
+		{
+			++reads_count_;
+			bases_count_ += al.length();
+
+			//chromosome changed > flush buffers
+			if (al.chromosomeID()!=chr_id)
+			{
+				flushAll(writer);
+				chr_id = al.chromosomeID();
+			}
+
+			//unplaced reads at the end of the file
+			if (chr_id<0)
 			{
 				writer.writeAlignment(al);
-				++reads_saved;
+				++reads_saved_;
 				continue;
 			}
 
-			if(al_map.contains(al.name()))
-			{
-				BamAlignment mate = al_map.take(al.name());
+			//reads whose mate was not found at the expected position are written unchanged
+			evictPending(al.start());
 
-				//check if reads are on different strands
-				BamAlignment forward_read = mate;
-				BamAlignment reverse_read = al;
-				bool both_strands = false;
-				if(forward_read.isReverseStrand()!=reverse_read.isReverseStrand())
+			if(!isClippingCandidate(al))
+			{
+				bufferOutput(al);
+				++reads_saved_;
+			}
+			else
+			{
+				QByteArray name = al.name();
+				if (pending_.contains(name))
 				{
-					both_strands = true;
-					if(!reverse_read.isReverseStrand())
+					BamAlignment forward_read = takePending(name);
+					BamAlignment reverse_read = al;
+					bool skip_al = clipPair(forward_read, reverse_read, reader);
+
+					//save reads
+					reads_saved_+=2;
+					if(!skip_al)
 					{
-						BamAlignment tmp_read = forward_read;
-						forward_read = reverse_read;
-						reverse_read = tmp_read;
+						bufferOutput(forward_read);
+						bufferOutput(reverse_read);
 					}
 				}
+				else if (al.mateStart()+1>=al.start() && al.mateStart()+1<=al.end())
+				{
+					addPending(name, al);
+				}
+				else //mate starts after the end of the read (or before the read and was already written) > reads cannot overlap
+				{
+					bufferOutput(al);
+					++reads_saved_;
+				}
+			}
+
+			flushOutput(writer, al.start());
+		}
+
+		flushAll(writer);
+	}
+
+	//Adds a read to the reads waiting for their mate.
+	void addPending(const QByteArray& name, const BamAlignment& al)
+	{
+		pending_.insert(name, al);
+		pending_mate_pos_.insert(std::make_pair(al.mateStart()+1, name));
+		pending_start_.insert(al.start());
+	}
+
+	//Removes a read from the reads waiting for their mate and returns it.
+	BamAlignment takePending(const QByteArray& name)
+	{
+		BamAlignment al = pending_.take(name);
+
+		auto range = pending_mate_pos_.equal_range(al.mateStart()+1);
+		for (auto it=range.first; it!=range.second; ++it)
+		{
+			if (it->second==name)
+			{
+				pending_mate_pos_.erase(it);
+				break;
+			}
+		}
+		pending_start_.erase(pending_start_.find(al.start()));
+
+		return al;
+	}
+
+	//Moves reads whose mate position is before the given position to the output buffer.
+	void evictPending(int pos)
+	{
+		while (!pending_mate_pos_.empty() && pending_mate_pos_.begin()->first<pos)
+		{
+			bufferOutput(takePending(pending_mate_pos_.begin()->second));
+			++reads_saved_;
+		}
+	}
+
+	//Adds an alignment to the output reorder window.
+	void bufferOutput(const BamAlignment& al)
+	{
+		out_buffer_.insert(std::make_pair(al.start(), al));
+	}
+
+	//Writes all buffered alignments that are before the given position and before all pending reads.
+	void flushOutput(BamWriter& writer, int pos)
+	{
+		if (!pending_start_.empty()) pos = std::min(pos, *pending_start_.begin());
+		while (!out_buffer_.empty() && out_buffer_.begin()->first<pos)
+		{
+			writer.writeAlignment(out_buffer_.begin()->second);
+			out_buffer_.erase(out_buffer_.begin());
+		}
+	}
+
+	//Writes all pending and buffered alignments.
+	void flushAll(BamWriter& writer)
+	{
+		evictPending(std::numeric_limits<int>::max());
+		flushOutput(writer, std::numeric_limits<int>::max());
+		while (!out_buffer_.empty())
+		{
+			writer.writeAlignment(out_buffer_.begin()->second);
+			out_buffer_.erase(out_buffer_.begin());
+		}
+	}
+
+	//Soft-clips the overlap of a read pair and handles mismatches in the overlap. Returns if the pair should be removed.
+	bool clipPair(BamAlignment& forward_read, BamAlignment& reverse_read, const BamReader& reader)
+	{
+		bool skip_al = false;
+
+		//check if reads are on different strands
+		bool both_strands = false;
+		if(forward_read.isReverseStrand()!=reverse_read.isReverseStrand())
+		{
+			both_strands = true;
+			if(!reverse_read.isReverseStrand())
+			{
+				BamAlignment tmp_read = forward_read;
+				forward_read = reverse_read;
+				reverse_read = tmp_read;
+			}
+		}
+
+		//check if reads overlap
+		int s1 = forward_read.start();
+		int e1 = forward_read.end();
+		int s2 = reverse_read.start();
+		int e2 = reverse_read.end();
+
+		//check if reads overlap
+		bool soft_clip = false;
+		if(forward_read.chromosomeID()==reverse_read.chromosomeID())	// same chromosome
+		{
+			if(s1>=s2 && s1<=e2)	soft_clip = true;	// start read1 within read2
+			else if(e1>=s2 && e1<=e2)	soft_clip = true;	// end read1 within read2
+			else if(s1<=s2 && e1>=e2)	soft_clip = true;	// start and end read1 outisde of read2
+		}
+
+		//soft-clip overlapping reads
+		if(soft_clip)
+		{
+			int clip_forward_read = 0;
+			int clip_reverse_read = 0;
+			int overlap = 0;
+			int overlap_start = 0;
+			int overlap_end = 0;
+
+			if(s1<=s2 && e1<=e2)	// forward read left of reverse read
+			{
+				overlap = forward_read.end()-reverse_read.start()+1;
+				overlap_start  = reverse_read.start()-1;
+				overlap_end = forward_read.end();
+				clip_forward_read = static_cast<int>(overlap/2);
+				clip_reverse_read = static_cast<int>(overlap/2);
+				if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
+				else	clip_reverse_read +=  overlap%2;
+			}
+			else if(s1>s2 && e1>e2)	// forward read right of reverse read
+			{
+				overlap = reverse_read.end()-forward_read.start()+1;
+				overlap_start  = forward_read.start()-1;
+				overlap_end = reverse_read.end();
+				clip_forward_read = static_cast<int>(overlap/2) + (forward_read.end()-reverse_read.end());
+				clip_reverse_read = static_cast<int>(overlap/2) + (forward_read.start()-reverse_read.start());
+				if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
+				else	clip_reverse_read +=  overlap%2;
+			}
+			else if(both_strands==true && s1>=s2 && e1<=e2)	// forward read within reverse read
+			{
+				overlap = forward_read.end()-forward_read.start()+1;
+				overlap_start  = forward_read.start()-1;
+				overlap_end = forward_read.end();
+				clip_forward_read = static_cast<int>(overlap/2);
+				clip_reverse_read = static_cast<int>(overlap/2) + (forward_read.start()-reverse_read.start());
+				if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
+				else	clip_reverse_read +=  overlap%2;
+			}
+			else if(both_strands==true && s1<=s2 && e1>=e2)	//reverse read within forward read
+			{
+				overlap = reverse_read.end()-reverse_read.start()+1;
+				overlap_start  = reverse_read.start()-1;
+				overlap_end = reverse_read.end();
+				clip_forward_read = static_cast<int>(overlap/2) + (forward_read.end()-reverse_read.end());
+				clip_reverse_read = static_cast<int>(overlap/2);
+				if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
+				else	clip_reverse_read +=  overlap%2;
+			}
+			else if(both_strands==false && s1>=s2 && e1<=e2)	//forward read lies completely within reverse read
+			{
+				overlap = forward_read.end()-forward_read.start()+1;
+				overlap_start  = forward_read.start()-1;
+				overlap_end = forward_read.end();
+				clip_forward_read = overlap;
+				clip_reverse_read = 0;
+			}
+			else if(both_strands==false && s1<=s2 && e1>=e2)	//reverse read lies completely within foward read
+			{
+				overlap = reverse_read.end()-reverse_read.start()+1;
+				overlap_start  = reverse_read.start()-1;
+				overlap_end = reverse_read.end() ;
+				clip_forward_read = 0;
+				clip_reverse_read = overlap;
+			}
+			else
+			{
+				if(both_strands)
+				{
+					THROW(Exception, "Read orientation of forward read " + forward_read.name() + " ("+reader.chromosome(forward_read.chromosomeID()).str()+":"+QString::number(forward_read.start())+"-"+QString::number(forward_read.end())+") and reverse read "+reverse_read.name()+" ("+reader.chromosome(reverse_read.chromosomeID()).str()+":"+QString::number(reverse_read.start())+"-"+QString::number(reverse_read.end())+") was not identified.");
+				}
+				else
+				{
+					THROW(Exception, "Read orientation of read1 " + forward_read.name() + " ("+reader.chromosome(forward_read.chromosomeID()).str()+":"+QString::number(forward_read.start())+"-"+QString::number(forward_read.end())+") and read2 "+reverse_read.name()+" ("+reader.chromosome(reverse_read.chromosomeID()).str()+":"+QString::number(reverse_read.start())+"-"+QString::number(reverse_read.end())+") was not identified.");
+				}
+			}
 
-				//check if reads overlap
-				int s1 = forward_read.start();
-				int e1 = forward_read.end();
-				int s2 = reverse_read.start();
-				int e2 = reverse_read.end();
+			//verbose mode
+			if(verbose_)	out_ << "forward read: name - " << forward_read.name() << ", region - " << reader.chromosome(forward_read.chromosomeID()).str() << ":" << (forward_read.start()-1) << "-" << forward_read.end() << ", insert size: "  << forward_read.insertSize() << " bp; mate: " << forward_read.mateStart() << ", CIGAR " << forward_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
+			if(verbose_)	out_ << "reverse read: name - " << reverse_read.name() << ", region - " << reader.chromosome(reverse_read.chromosomeID()).str() << ":" << (reverse_read.start()-1) << "-" << reverse_read.end() << ", insert size: "  << reverse_read.insertSize() << " bp; mate: " << reverse_read.mateStart() << ", CIGAR " << reverse_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
+			if(verbose_) out_ << "forward read bases " << forward_read.bases() << endl;
+			if(verbose_) out_ << "forward read qualities " << forward_read.qualities() << endl;
+			if(verbose_) out_ << "forward CIGAR " << forward_read.cigarDataAsString(true) << endl;
+			if(verbose_) out_ << "reverse read bases " << reverse_read.bases() << endl;
+			if(verbose_) out_ << "reverse read qualities " << reverse_read.qualities() << endl;
+			if(verbose_) out_ << "reverse CIGAR " << reverse_read.cigarDataAsString(true) << endl;
+			if(verbose_)	out_ << "  clip forward read from position " << (forward_read.end()-clip_forward_read+1) << " to " << forward_read.end() << endl;
+			if(verbose_)	out_ << "  clip reverse read from position " << reverse_read.start() << " to " << (reverse_read.start()-1+clip_reverse_read) << endl;
+
+			struct Overlap
+			{
+				QList<int> genome_pos;
+				QList<int> read_pos;
+				QList<char> base;
+				QList<char> quality;
+				QList<char> cigar;
 
-				//check if reads overlap
-				bool soft_clip = false;
-				if(forward_read.chromosomeID()==reverse_read.chromosomeID())	// same chromosome
+				void append(char base, char cigar, char quality, int genome_pos, int read_pos)
 				{
-					if(s1>=s2 && s1<=e2)	soft_clip = true;	// start read1 within read2
-					else if(e1>=s2 && e1<=e2)	soft_clip = true;	// end read1 within read2
-					else if(s1<=s2 && e1>=e2)	soft_clip = true;	// start and end read1 outisde of read2
+					this->base.append(base);
+					this->cigar.append(cigar);
+					this->quality.append(quality);
+					this->genome_pos.append(genome_pos);
+					this->read_pos.append(read_pos);
 				}
 
-				//soft-clip overlapping reads
-				if(soft_clip)
+				void insert(int at, char base, char cigar, char quality, int genome_pos, int read_pos)
 				{
-					int clip_forward_read = 0;
-					int clip_reverse_read = 0;
-					int overlap = 0;
-					int overlap_start = 0;
-					int overlap_end = 0;
+					this->base.insert(at, base);
+					this->cigar.insert(at, cigar);
+					this->quality.insert(at, quality);
+					this->genome_pos.insert(at, genome_pos);
+					this->read_pos.insert(at, read_pos);
+				}
 
-					if(s1<=s2 && e1<=e2)	// forward read left of reverse read
-					{
-						overlap = forward_read.end()-reverse_read.start()+1;
-						overlap_start  = reverse_read.start()-1;
-						overlap_end = forward_read.end();
-						clip_forward_read = static_cast<int>(overlap/2);
-						clip_reverse_read = static_cast<int>(overlap/2);
-						if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
-						else	clip_reverse_read +=  overlap%2;
-					}
-					else if(s1>s2 && e1>e2)	// forward read right of reverse read
-					{
-						overlap = reverse_read.end()-forward_read.start()+1;
-						overlap_start  = forward_read.start()-1;
-						overlap_end = reverse_read.end();
-						clip_forward_read = static_cast<int>(overlap/2) + (forward_read.end()-reverse_read.end());
-						clip_reverse_read = static_cast<int>(overlap/2) + (forward_read.start()-reverse_read.start());
-						if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
-						else	clip_reverse_read +=  overlap%2;
-					}
-					else if(both_strands==true && s1>=s2 && e1<=e2)	// forward read within reverse read
-					{
-						overlap = forward_read.end()-forward_read.start()+1;
-						overlap_start  = forward_read.start()-1;
-						overlap_end = forward_read.end();
-						clip_forward_read = static_cast<int>(overlap/2);
-						clip_reverse_read = static_cast<int>(overlap/2) + (forward_read.start()-reverse_read.start());
-						if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
-						else	clip_reverse_read +=  overlap%2;
-					}
-					else if(both_strands==true && s1<=s2 && e1>=e2)	//reverse read within forward read
-					{
-						overlap = reverse_read.end()-reverse_read.start()+1;
-						overlap_start  = reverse_read.start()-1;
-						overlap_end = reverse_read.end();
-						clip_forward_read = static_cast<int>(overlap/2) + (forward_read.end()-reverse_read.end());
-						clip_reverse_read = static_cast<int>(overlap/2);
-						if(forward_read.isRead1())	clip_forward_read +=  overlap%2;
-						else	clip_reverse_read +=  overlap%2;
-					}
-					else if(both_strands==false && s1>=s2 && e1<=e2)	//forward read lies completely within reverse read
-					{
-						overlap = forward_read.end()-forward_read.start()+1;
-						overlap_start  = forward_read.start()-1;
-						overlap_end = forward_read.end();
-						clip_forward_read = overlap;
-						clip_reverse_read = 0;
-					}
-					else if(both_strands==false && s1<=s2 && e1>=e2)	//reverse read lies completely within foward read
-					{
-						overlap = reverse_read.end()-reverse_read.start()+1;
-						overlap_start  = reverse_read.start()-1;
-						overlap_end = reverse_read.end() ;
-						clip_forward_read = 0;
-						clip_reverse_read = overlap;
-					}
-					else
+				QByteArray getBases() const
+				{
+					QByteArray output;
+					for(int i=0; i<base.length(); ++i)
 					{
-						if(both_strands)
-						{
-							THROW(Exception, "Read orientation of forward read " + forward_read.name() + " ("+reader.chromosome(forward_read.chromosomeID()).str()+":"+QString::number(forward_read.start())+"-"+QString::number(forward_read.end())+") and reverse read "+reverse_read.name()+" ("+reader.chromosome(reverse_read.chromosomeID()).str()+":"+QString::number(reverse_read.start())+"-"+QString::number(reverse_read.end())+") was not identified.");
-						}
-						else
-						{
-							THROW(Exception, "Read orientation of read1 " + forward_read.name() + " ("+reader.chromosome(forward_read.chromosomeID()).str()+":"+QString::number(forward_read.start())+"-"+QString::number(forward_read.end())+") and read2 "+reverse_read.name()+" ("+reader.chromosome(reverse_read.chromosomeID()).str()+":"+QString::number(reverse_read.start())+"-"+QString::number(reverse_read.end())+") was not identified.");
-						}
+						output.append(base[i]);
 					}
+					return output;
+				}
 
-					//verbose mode
-					if(verbose)	out << "forward read: name - " << forward_read.name() << ", region - " << reader.chromosome(forward_read.chromosomeID()).str() << ":" << (forward_read.start()-1) << "-" << forward_read.end() << ", insert size: "  << forward_read.insertSize() << " bp; mate: " << forward_read.mateStart() << ", CIGAR " << forward_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
-					if(verbose)	out << "reverse read: name - " << reverse_read.name() << ", region - " << reader.chromosome(reverse_read.chromosomeID()).str() << ":" << (reverse_read.start()-1) << "-" << reverse_read.end() << ", insert size: "  << reverse_read.insertSize() << " bp; mate: " << reverse_read.mateStart() << ", CIGAR " << reverse_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
-					if(verbose) out << "forward read bases " << forward_read.bases() << endl;
-					if(verbose) out << "forward read qualities " << forward_read.qualities() << endl;
-					if(verbose) out << "forward CIGAR " << forward_read.cigarDataAsString(true) << endl;
-					if(verbose) out << "reverse read bases " << reverse_read.bases() << endl;
-					if(verbose) out << "reverse read qualities " << reverse_read.qualities() << endl;
-					if(verbose) out << "reverse CIGAR " << reverse_read.cigarDataAsString(true) << endl;
-					if(verbose)	out << "  clip forward read from position " << (forward_read.end()-clip_forward_read+1) << " to " << forward_read.end() << endl;
-					if(verbose)	out << "  clip reverse read from position " << reverse_read.start() << " to " << (reverse_read.start()-1+clip_reverse_read) << endl;
-
-					struct Overlap
-					{
-						QList<int> genome_pos;
-						QList<int> read_pos;
-						QList<char> base;
-						QList<char> quality;
-						QList<char> cigar;
-
-						void append(char base, char cigar, char quality, int genome_pos, int read_pos)
-						{
-							this->base.append(base);
-							this->cigar.append(cigar);
-							this->quality.append(quality);
-							this->genome_pos.append(genome_pos);
-							this->read_pos.append(read_pos);
-						}
-
-						void insert(int at, char base, char cigar, char quality, int genome_pos, int read_pos)
-						{
-							this->base.insert(at, base);
-							this->cigar.insert(at, cigar);
-							this->quality.insert(at, quality);
-							this->genome_pos.insert(at, genome_pos);
-							this->read_pos.insert(at, read_pos);
-						}
-
-						QByteArray getBases() const
-						{
-							QByteArray output;
-							for(int i=0; i<base.length(); ++i)
-							{
-								output.append(base[i]);
-							}
-							return output;
-						}
-
-						QByteArray getCigar() const
-						{
-							QByteArray output;
-							for(int i=0; i<cigar.length(); ++i)
-							{
-								output.append(cigar[i]);
-							}
-							return output;
-						}
-
-						int length() const
-						{
-							if(read_pos.length()!=cigar.length()) THROW(Exception,"Lengths differ.");
-							return read_pos.length();
-						}
-					};
-
-					//check if bases in overlap match
-					if(verbose)	out << "  overlap found from " << QString::number(overlap_start) << " to " << QString::number(overlap_end) << endl;
-
-					//
-					bool has_indel = false; //INDEL ist around the clipping position
-					int surrounding_nuc = 5;
-
-
-					int genome_pos = forward_read.start()-1;
-					int read_pos = 0;
-					int clip_position = forward_read.end() - clip_forward_read;
-					Overlap forward_overlap;
-					QByteArray forward_bases = forward_read.bases();
-					QByteArray forward_qualities = forward_read.qualities();
-					QByteArray forward_cigar = forward_read.cigarDataAsString(true);
-					for(int i = 0;i<forward_cigar.length();++i)
-					{
-						if(genome_pos>=overlap_start && genome_pos<overlap_end && forward_cigar[i]!='H' && forward_cigar[i]!='S')
-						{
-							char current_base = forward_bases[read_pos];
-							char current_quality = forward_qualities[read_pos];
-							if(forward_cigar[i]=='D')	current_base = '-';
-							forward_overlap.append(current_base, forward_cigar[i], current_quality, genome_pos, read_pos);
-						}
-
-						if(!ignore_indels && genome_pos>(clip_position-surrounding_nuc) && genome_pos<(clip_position+surrounding_nuc))
-						{
-							if(forward_cigar[i]=='I' || forward_cigar[i]=='D')
-							{
-								has_indel = true;
-							}
-						}
-
-						if(forward_cigar[i]=='H')	continue;
-						else if(forward_cigar[i]=='S')	++read_pos;
-						else if(forward_cigar[i]=='M')
-						{
-							++genome_pos;
-							++read_pos;
-						}
-						else if(forward_cigar[i]=='D')
-						{
-							++genome_pos;
-						}
-						else if(forward_cigar[i]=='I')
-						{
-							++read_pos;
-						}
-						else
-						{
-							THROW(Exception, QByteArray("Unknown CIGAR character '") + forward_cigar[i] + "'")
-						}
-					}
-					if(verbose)	out << "  finished reading overlap forward bases " << forward_overlap.getBases() << endl;
-					if(verbose)	out << "  finished reading overlap forward cigar " << forward_overlap.getCigar() << endl;
-
-					genome_pos = reverse_read.start()-1;
-					read_pos = 0;
-					clip_position = reverse_read.start() -1 + clip_reverse_read;
-					Overlap reverse_overlap;
-					QByteArray reverse_bases = reverse_read.bases();
-					QByteArray reverse_qualities = reverse_read.qualities();
-					QByteArray reverse_cigar = reverse_read.cigarDataAsString(true);
-					for(int i=0; i<reverse_cigar.length();++i)
+				QByteArray getCigar() const
+				{
+					QByteArray output;
+					for(int i=0; i<cigar.length(); ++i)
 					{
-						if(genome_pos>=overlap_start && genome_pos<overlap_end && reverse_cigar[i]!='H' && reverse_cigar[i]!='S')
-						{
-							char current_base = reverse_bases[read_pos];
-							char current_quality = reverse_qualities[read_pos];
-							if(reverse_cigar[i]=='D')	current_base = '-';
-							reverse_overlap.append(current_base, reverse_cigar[i], current_quality, genome_pos, read_pos);
-						}
-
-						if(!ignore_indels && genome_pos>(clip_position-surrounding_nuc) && genome_pos<(clip_position+surrounding_nuc))
-						{
-							if(reverse_cigar[i]=='I' || reverse_cigar[i]=='D')
-							{
-								has_indel = true;
-							}
-						}
-
-						if(reverse_cigar[i]=='H')	continue;
-						else if(reverse_cigar[i]=='S')	++read_pos;
-						else if(reverse_cigar[i]=='M')
-						{
-							++genome_pos;
-							++read_pos;
-						}
-						else if(reverse_cigar[i]=='D')
-						{
-							++genome_pos;
-						}
-						else if(reverse_cigar[i]=='I')
-						{
-							++read_pos;
-						}
-						else
-						{
-							THROW(Exception, QByteArray("Unknown CIGAR character '") + reverse_cigar[i] + "'");
-						}
+						output.append(cigar[i]);
 					}
-					if(verbose)	out << "  finished reading overlap reverse bases " << reverse_overlap.getBases() << endl;
-					if(verbose)	out << "  finished reading overlap reverse cigar " << reverse_overlap.getCigar() << endl;
+					return output;
+				}
 
-					//correct for insertions
-					for(int i=0;i<forward_overlap.length();++i)
-					{
-						if(forward_overlap.cigar[i]!=reverse_overlap.cigar[i] && forward_overlap.cigar[i]=='I' && forward_overlap.base[i]!='+')
-						{
-							reverse_overlap.insert(i, '+', 'I', '0', reverse_overlap.genome_pos[i], reverse_overlap.read_pos[i]);
-						}
-						
-						if(forward_overlap.cigar[i]!=reverse_overlap.cigar[i] && reverse_overlap.cigar[i]=='I' && reverse_overlap.base[i]!='+')
-						{
-							forward_overlap.insert(i, '+', 'I', '0', forward_overlap.genome_pos[i], forward_overlap.read_pos[i]);
-						}
-					}
-					if(verbose)	out << "  finished indel correction forward bases " << forward_overlap.getBases() << endl;
-					if(verbose)	out << "  finished indel correction forward cigar " << forward_overlap.getCigar() << endl;
-					if(verbose)	out << "  finished indel correction reverse bases " << reverse_overlap.getBases() << endl;
-					if(verbose)	out << "  finished indel correction reverse cigar " << reverse_overlap.getCigar() << endl;
-					if(forward_overlap.length()!=reverse_overlap.length()) //both cigar and base string should now be equally long
-					{
-						THROW(Exception, "Length mismatch between forward/reverse overlap - forward:" + QByteArray::number(forward_overlap.length()) + " reverse:" + QByteArray::number(reverse_overlap.length()) );
-					}
+				int length() const
+				{
+					if(read_pos.length()!=cigar.length()) THROW(Exception,"Lengths differ.");
+					return read_pos.length();
+				}
+			};
 
-					//detect mismtaches(read pos for, read pos rev)
-					QList<QPair<int,int>> mm_pos;
-					for(int i=0;i<forward_overlap.length();++i)
-					{
-						if(forward_overlap.base[i]!=reverse_overlap.base[i])
-						{
-							int first = forward_overlap.read_pos[i];
-							int second = reverse_overlap.read_pos[i];
-							if(forward_overlap.base[i]=='-' || forward_overlap.base[i]=='+')	first = -1;
-							if(reverse_overlap.base[i]=='-' || reverse_overlap.base[i]=='+')	second = -1;
-							mm_pos.append(qMakePair(first,second));
-						}
-					}
+			//check if bases in overlap match
+			if(verbose_)	out_ << "  overlap found from " << QString::number(overlap_start) << " to " << QString::number(overlap_end) << endl;
+
+			//
+			bool has_indel = false; //INDEL ist around the clipping position
+			int surrounding_nuc = 5;
 
-					if(verbose && !mm_pos.isEmpty())
-					{
-						out << "  overlap mismatch for read pair " << forward_read.name() << " - " << forward_overlap.getBases() << " != " << reverse_overlap.getBases() << "!" << endl;
-					}
 
-					bool map = getFlag("overlap_mismatch_mapq");
-					bool rem = getFlag("overlap_mismatch_remove");
-					bool base = getFlag("overlap_mismatch_baseq");
-					bool basen = getFlag("overlap_mismatch_basen");
-					if(base || rem || map || basen)
+			int genome_pos = forward_read.start()-1;
+			int read_pos = 0;
+			int clip_position = forward_read.end() - clip_forward_read;
+			Overlap forward_overlap;
+			QByteArray forward_bases = forward_read.bases();
+			QByteArray forward_qualities = forward_read.qualities();
+			QByteArray forward_cigar = forward_read.cigarDataAsString(true);
+			for(int i = 0;i<forward_cigar.length();++i)
+			{
+				if(genome_pos>=overlap_start && genome_pos<overlap_end && forward_cigar[i]!='H' && forward_cigar[i]!='S')
+				{
+					char current_base = forward_bases[read_pos];
+					char current_quality = forward_qualities[read_pos];
+					if(forward_cigar[i]=='D')	current_base = '-';
+					forward_overlap.append(current_base, forward_cigar[i], current_quality, genome_pos, read_pos);
+				}
+
+				if(!ignore_indels_ && genome_pos>(clip_position-surrounding_nuc) && genome_pos<(clip_position+surrounding_nuc))
+				{
+					if(forward_cigar[i]=='I' || forward_cigar[i]=='D')
 					{
-						if(!mm_pos.isEmpty() && map)
-						{
-							forward_read.setMappingQuality(0);
-							reverse_read.setMappingQuality(0);
-							reads_mismatch += 2;
-							if(verbose) out << "  Set mapping quality to 0." << endl;
-						}
-						else if(!mm_pos.isEmpty() && rem)
-						{
-							reads_mismatch += 2;
-							skip_al = true;
-							if(verbose) out << "   Removed pair." << endl;
-						}
-						else if(!mm_pos.isEmpty() && base)
-						{
-							reads_mismatch += 2;
-							QByteArray orig_for = forward_read.qualities();
-							QByteArray orig_rev = reverse_read.qualities();
-							QByteArray new_for = orig_for;
-							QByteArray new_rev = orig_rev;
-
-							//set base quality for change qualities
-							for(int i=0;i<mm_pos.length();++i)
-							{
-								if(mm_pos[i].first>=0)	new_for[mm_pos[i].first] = '!';
-								if(mm_pos[i].second>=0)	new_rev[mm_pos[i].second] = '!';
-							}
-							forward_read.setQualities(new_for);
-							reverse_read.setQualities(new_rev);
-							if(verbose) out << "   changed forward base qualities from " << orig_for << " to " << forward_read.qualities() << endl;
-							if(verbose) out << "   changed reverse base qualities from " << orig_rev << " to " << reverse_read.qualities() << endl;
-						}
-						else if(!mm_pos.isEmpty() && basen)
-						{
-							reads_mismatch += 2;
-							QByteArray orig_for = forward_read.bases();
-							QByteArray orig_rev = reverse_read.bases();
-							QByteArray new_for = orig_for;
-							QByteArray new_rev = orig_rev;
-
-							//set Ns for mismatch bases
-							for(int i=0;i<mm_pos.length();++i)
-							{
-								if(mm_pos[i].first>=0)	new_for[mm_pos[i].first] = 'N';
-								if(mm_pos[i].second>=0)	new_rev[mm_pos[i].second] = 'N';
-							}
-							forward_read.setBases(new_for);
-							reverse_read.setBases(new_rev);
-							if(verbose) out << "   changed forward sequences from " << orig_for << " to " << forward_read.bases() << endl;
-							if(verbose) out << "   changed reverse sequences from " << orig_rev << " to " << reverse_read.bases() << endl;
-						}
-						else
-						{
-							if(verbose)	out << "  no overlap mismatch for read pair " << forward_read.name() << endl;
-						}
+						has_indel = true;
 					}
+				}
+
+				if(forward_cigar[i]=='H')	continue;
+				else if(forward_cigar[i]=='S')	++read_pos;
+				else if(forward_cigar[i]=='M')
+				{
+					++genome_pos;
+					++read_pos;
+				}
+				else if(forward_cigar[i]=='D')
+				{
+					++genome_pos;
+				}
+				else if(forward_cigar[i]=='I')
+				{
+					++read_pos;
+				}
+				else
+				{
+					THROW(Exception, QByteArray("Unknown CIGAR character '") + forward_cigar[i] + "'")
+				}
+			}
+			if(verbose_)	out_ << "  finished reading overlap forward bases " << forward_overlap.getBases() << endl;
+			if(verbose_)	out_ << "  finished reading overlap forward cigar " << forward_overlap.getCigar() << endl;
+
+			genome_pos = reverse_read.start()-1;
+			read_pos = 0;
+			clip_position = reverse_read.start() -1 + clip_reverse_read;
+			Overlap reverse_overlap;
+			QByteArray reverse_bases = reverse_read.bases();
+			QByteArray reverse_qualities = reverse_read.qualities();
+			QByteArray reverse_cigar = reverse_read.cigarDataAsString(true);
+			for(int i=0; i<reverse_cigar.length();++i)
+			{
+				if(genome_pos>=overlap_start && genome_pos<overlap_end && reverse_cigar[i]!='H' && reverse_cigar[i]!='S')
+				{
+					char current_base = reverse_bases[read_pos];
+					char current_quality = reverse_qualities[read_pos];
+					if(reverse_cigar[i]=='D')	current_base = '-';
+					reverse_overlap.append(current_base, reverse_cigar[i], current_quality, genome_pos, read_pos);
+				}
 
-					//try to avoid soft-clipping indels in overlap
-					if(has_indel)
+				if(!ignore_indels_ && genome_pos>(clip_position-surrounding_nuc) && genome_pos<(clip_position+surrounding_nuc))
+				{
+					if(reverse_cigar[i]=='I' || reverse_cigar[i]=='D')
 					{
-						if(reads_clipped%4==0)
-						{
-							clip_forward_read = 0;
-							clip_reverse_read = overlap;
-						}
-						else
-						{
-							clip_forward_read = overlap;
-							clip_reverse_read = 0;
-						}
+						has_indel = true;
 					}
+				}
 
-					//actual soft clipping
-					if(clip_forward_read>0)	NGSHelper::softClipAlignment(forward_read,(forward_read.end()-clip_forward_read+1),forward_read.end());
-					if(clip_reverse_read>0)	NGSHelper::softClipAlignment(reverse_read,reverse_read.start(),(reverse_read.start()-1+clip_reverse_read));
-
-					//set new insert size and mate position
-					forward_read.setInsertSize(reverse_read.end()-forward_read.start()+1);	//positive value
-					forward_read.setMateStart(reverse_read.start());
-					reverse_read.setInsertSize(forward_read.start()-reverse_read.end()-1);	//negative value
-					reverse_read.setMateStart(forward_read.start());
+				if(reverse_cigar[i]=='H')	continue;
+				else if(reverse_cigar[i]=='S')	++read_pos;
+				else if(reverse_cigar[i]=='M')
+				{
+					++genome_pos;
+					++read_pos;
+				}
+				else if(reverse_cigar[i]=='D')
+				{
+					++genome_pos;
+				}
+				else if(reverse_cigar[i]=='I')
+				{
+					++read_pos;
+				}
+				else
+				{
+					THROW(Exception, QByteArray("Unknown CIGAR character '") + reverse_cigar[i] + "'");
+				}
+			}
+			if(verbose_)	out_ << "  finished reading overlap reverse bases " << reverse_overlap.getBases() << endl;
+			if(verbose_)	out_ << "  finished reading overlap reverse cigar " << reverse_overlap.getCigar() << endl;
 
-					if(verbose)	out << "  clipped forward read: name - " << forward_read.name() << ", region - " << reader.chromosome(forward_read.chromosomeID()).str() << ":" << (forward_read.start()-1) << "-" << forward_read.end() << ", insert size: "  << forward_read.insertSize() << " bp; mate: " << forward_read.mateStart() << ", CIGAR " << forward_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
-					if(verbose)	out << "  clipped reverse read: name - " << reverse_read.name() << ", region - " << reader.chromosome(reverse_read.chromosomeID()).str()  << ":" << (reverse_read.start()-1) << "-" << reverse_read.end() << ", insert size: "  << reverse_read.insertSize() << " bp; mate: " << reverse_read.mateStart() << ", CIGAR " << reverse_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
-					if(verbose)	out << endl;
+			//correct for insertions
+			for(int i=0;i<forward_overlap.length();++i)
+			{
+				if(forward_overlap.cigar[i]!=reverse_overlap.cigar[i] && forward_overlap.cigar[i]=='I' && forward_overlap.base[i]!='+')
+				{
+					reverse_overlap.insert(i, '+', 'I', '0', reverse_overlap.genome_pos[i], reverse_overlap.read_pos[i]);
+				}
+				
+				if(forward_overlap.cigar[i]!=reverse_overlap.cigar[i] && reverse_overlap.cigar[i]=='I' && reverse_overlap.base[i]!='+')
+				{
+					forward_overlap.insert(i, '+', 'I', '0', forward_overlap.genome_pos[i], forward_overlap.read_pos[i]);
+				}
+			}
+			if(verbose_)	out_ << "  finished indel correction forward bases " << forward_overlap.getBases() << endl;
+			if(verbose_)	out_ << "  finished indel correction forward cigar " << forward_overlap.getCigar() << endl;
+			if(verbose_)	out_ << "  finished indel correction reverse bases " << reverse_overlap.getBases() << endl;
+			if(verbose_)	out_ << "  finished indel correction reverse cigar " << reverse_overlap.getCigar() << endl;
+			if(forward_overlap.length()!=reverse_overlap.length()) //both cigar and base string should now be equally long
+			{
+				THROW(Exception, "Length mismatch between forward/reverse overlap - forward:" + QByteArray::number(forward_overlap.length()) + " reverse:" + QByteArray::number(reverse_overlap.length()) );
+			}
 
-					//return reads
-					bases_clipped += overlap;
-					reads_clipped += 2;
+			//detect mismtaches(read pos for, read pos rev)
+			QList<QPair<int,int>> mm_pos;
+			for(int i=0;i<forward_overlap.length();++i)
+			{
+				if(forward_overlap.base[i]!=reverse_overlap.base[i])
+				{
+					int first = forward_overlap.read_pos[i];
+					int second = reverse_overlap.read_pos[i];
+					if(forward_overlap.base[i]=='-' || forward_overlap.base[i]=='+')	first = -1;
+					if(reverse_overlap.base[i]=='-' || reverse_overlap.base[i]=='+')	second = -1;
+					mm_pos.append(qMakePair(first,second));
 				}
+			}
 
+			if(verbose_ && !mm_pos.isEmpty())
+			{
+				out_ << "  overlap mismatch for read pair " << forward_read.name() << " - " << forward_overlap.getBases() << " != " << reverse_overlap.getBases() << "!" << endl;
+			}
 
-				//save reads
-				reads_saved+=2;
-				if(skip_al)	continue;
-				writer.writeAlignment(forward_read);
-				writer.writeAlignment(reverse_read);
+			bool map = getFlag("overlap_mismatch_mapq");
+			bool rem = getFlag("overlap_mismatch_remove");
+			bool base = getFlag("overlap_mismatch_baseq");
+			bool basen = getFlag("overlap_mismatch_basen");
+			if(base || rem || map || basen)
+			{
+				if(!mm_pos.isEmpty() && map)
+				{
+					forward_read.setMappingQuality(0);
+					reverse_read.setMappingQuality(0);
+					reads_mismatch_ += 2;
+					if(verbose_) out_ << "  Set mapping quality to 0." << endl;
+				}
+				else if(!mm_pos.isEmpty() && rem)
+				{
+					reads_mismatch_ += 2;
+					skip_al = true;
+					if(verbose_) out_ << "   Removed pair." << endl;
+				}
+				else if(!mm_pos.isEmpty() && base)
+				{
+					reads_mismatch_ += 2;
+					QByteArray orig_for = forward_read.qualities();
+					QByteArray orig_rev = reverse_read.qualities();
+					QByteArray new_for = orig_for;
+					QByteArray new_rev = orig_rev;
+
+					//set base quality for change qualities
+					for(int i=0;i<mm_pos.length();++i)
+					{
+						if(mm_pos[i].first>=0)	new_for[mm_pos[i].first] = '!';
+						if(mm_pos[i].second>=0)	new_rev[mm_pos[i].second] = '!';
+					}
+					forward_read.setQualities(new_for);
+					reverse_read.setQualities(new_rev);
+					if(verbose_) out_ << "   changed forward base qualities from " << orig_for << " to " << forward_read.qualities() << endl;
+					if(verbose_) out_ << "   changed reverse base qualities from " << orig_rev << " to " << reverse_read.qualities() << endl;
+				}
+				else if(!mm_pos.isEmpty() && basen)
+				{
+					reads_mismatch_ += 2;
+					QByteArray orig_for = forward_read.bases();
+					QByteArray orig_rev = reverse_read.bases();
+					QByteArray new_for = orig_for;
+					QByteArray new_rev = orig_rev;
+
+					//set Ns for mismatch bases
+					for(int i=0;i<mm_pos.length();++i)
+					{
+						if(mm_pos[i].first>=0)	new_for[mm_pos[i].first] = 'N';
+						if(mm_pos[i].second>=0)	new_rev[mm_pos[i].second] = 'N';
+					}
+					forward_read.setBases(new_for);
+					reverse_read.setBases(new_rev);
+					if(verbose_) out_ << "   changed forward sequences from " << orig_for << " to " << forward_read.bases() << endl;
+					if(verbose_) out_ << "   changed reverse sequences from " << orig_rev << " to " << reverse_read.bases() << endl;
+				}
+				else
+				{
+					if(verbose_)	out_ << "  no overlap mismatch for read pair " << forward_read.name() << endl;
+				}
 			}
-			else    //keep in map
+
+			//try to avoid soft-clipping indels in overlap
+			if(has_indel)
 			{
-				al_map.insert(al.name(), al);
+				if(reads_clipped_%4==0)
+				{
+					clip_forward_read = 0;
+					clip_reverse_read = overlap;
+				}
+				else
+				{
+					clip_forward_read = overlap;
+					clip_reverse_read = 0;
+				}
 			}
-		}
 
-		//step 3: save all remaining reads
-		foreach(const BamAlignment& al, al_map)
-		{
-			writer.writeAlignment(al);
-			++reads_saved;
+			//actual soft clipping
+			if(clip_forward_read>0)	NGSHelper::softClipAlignment(forward_read,(forward_read.end()-clip_forward_read+1),forward_read.end());
+			if(clip_reverse_read>0)	NGSHelper::softClipAlignment(reverse_read,reverse_read.start(),(reverse_read.start()-1+clip_reverse_read));
+
+			//set new insert size and mate position
+			forward_read.setInsertSize(reverse_read.end()-forward_read.start()+1);	//positive value
+			forward_read.setMateStart(reverse_read.start());
+			reverse_read.setInsertSize(forward_read.start()-reverse_read.end()-1);	//negative value
+			reverse_read.setMateStart(forward_read.start());
+
+			if(verbose_)	out_ << "  clipped forward read: name - " << forward_read.name() << ", region - " << reader.chromosome(forward_read.chromosomeID()).str() << ":" << (forward_read.start()-1) << "-" << forward_read.end() << ", insert size: "  << forward_read.insertSize() << " bp; mate: " << forward_read.mateStart() << ", CIGAR " << forward_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
+			if(verbose_)	out_ << "  clipped reverse read: name - " << reverse_read.name() << ", region - " << reader.chromosome(reverse_read.chromosomeID()).str()  << ":" << (reverse_read.start()-1) << "-" << reverse_read.end() << ", insert size: "  << reverse_read.insertSize() << " bp; mate: " << reverse_read.mateStart() << ", CIGAR " << reverse_read.cigarDataAsString() << ", overlap: " << overlap << " bp" << endl;
+			if(verbose_)	out_ << endl;
+
+			//return reads
+			bases_clipped_ += overlap;
+			reads_clipped_ += 2;
 		}
 
-		//step 4: write out statistics
-		if(reads_saved!=reads_count)	THROW(ToolFailedException, "Lost Reads: "+QString::number(reads_count-reads_saved)+"/"+QString::number(reads_count));
-		out << "Overlap mismatch filtering was used for " << QString::number(reads_mismatch) << " of " << QString::number(reads_count) << " reads (" << QString::number((double)reads_mismatch/(double)reads_count*100,'f',2) << " %)." << endl;
-		out << "Softclipped " << QString::number(reads_clipped) << " of " << QString::number(reads_count) << " reads (" << QString::number(((double)reads_clipped/(double)reads_count*100),'f',2) << " %)." << endl;
-		out << "Softclipped " << QString::number(bases_clipped) << " of " << QString::number(bases_count) << " basepairs (" << QString::number((double)bases_clipped/(double)bases_count*100,'f',2) << " %)." << endl;
+		return skip_al;
 	}
-
 };
 
 #include "main.moc"
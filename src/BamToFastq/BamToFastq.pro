@@ -15,6 +15,10 @@ CONFIG   -= app_bundle
 TEMPLATE = app
 
 
-SOURCES += main.cpp
+SOURCES += main.cpp \
+    OutputWorker.cpp
+
+HEADERS += \
+    OutputWorker.h
 
 include("../app_cli.pri")
@@ -0,0 +1,16 @@
+#include "OutputWorker.h"
+
+OutputWorker::OutputWorker(FastqOutfileStream& stream, QList<FastqEntry> entries)
+	: QRunnable()
+	, stream_(stream)
+	, entries_(entries)
+{
+}
+
+void OutputWorker::run()
+{
+	foreach(const FastqEntry& entry, entries_)
+	{
+		stream_.write(entry);
+	}
+}
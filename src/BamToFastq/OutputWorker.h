@@ -0,0 +1,21 @@
+#ifndef OUTPUTWORKER_H
+#define OUTPUTWORKER_H
+
+#include <QRunnable>
+#include "FastqFileStream.h"
+
+///Compresses and writes a batch of FASTQ entries to an output stream.
+///Only one worker per stream must run at a time, otherwise the order of entries is undefined.
+class OutputWorker
+	: public QRunnable
+{
+public:
+	OutputWorker(FastqOutfileStream& stream, QList<FastqEntry> entries);
+	void run();
+
+protected:
+	FastqOutfileStream& stream_;
+	QList<FastqEntry> entries_;
+};
+
+#endif // OUTPUTWORKER_H
@@ -1,6 +1,10 @@
 #include "ToolBase.h"
 #include "FastqFileStream.h"
 #include "NGSHelper.h"
+#include "Helper.h"
+#include "OutputWorker.h"
+#include <QThreadPool>
+#include <algorithm>
 
 class ConcreteTool
 		: public ToolBase
@@ -19,25 +23,228 @@ public:
 		addInfile("in", "Input BAM file.", false, true);
 		addOutfile("out1", "Read 1 output FASTQ.GZ file.", false);
 		addOutfile("out2", "Read 2 output FASTQ.GZ file.", false);
+		//optional
 		addFlag("remove_duplicates", "Does not export duplicate reads into the FASTQ file.");
+		addInt("max_cached", "Maximum number of reads cached while waiting for the mate. If exceeded, cached reads are written to temporary files, which are merged at the end.", true, 2000000);
+		addInt("batch_size", "Number of read pairs that are compressed in one batch by the writer threads.", true, 10000);
+
+		//changelog
+		changeLog(2026,10,18,"Added spilling of cached reads to temporary files (parameter 'max_cached') and compression in background threads.");
 	}
 
-	void write(FastqOutfileStream& out, const BamAlignment& al, bool rev_comp)
+	///Cached read that was written to a temporary file.
+	struct SpilledRead
+	{
+		QByteArray name;
+		bool read1;
+		FastqEntry entry;
+	};
+
+	///Removes the temporary files when the tool finishes - also if an exception is thrown.
+	struct SpillFileGuard
+	{
+		SpillFileGuard(QStringList& filenames)
+			: filenames_(filenames)
+		{
+		}
+		~SpillFileGuard()
+		{
+			foreach(const QString& filename, filenames_)
+			{
+				QFile::remove(filename);
+			}
+			filenames_.clear();
+		}
+
+		QStringList& filenames_;
+	};
+
+	///Sorted merge of temporary files by read name.
+	class SpillMerger
+	{
+	public:
+		SpillMerger(const QStringList& filenames)
+		{
+			foreach(const QString& filename, filenames)
+			{
+				QSharedPointer<QFile> file = Helper::openFileForReading(filename);
+				SpilledRead read;
+				if (!readSpilled(*file, read)) continue;
+				files_ << file;
+				heads_ << read;
+			}
+		}
+
+		//Returns the next read in name order, or false if all files are consumed.
+		bool next(SpilledRead& read)
+		{
+			if (files_.isEmpty()) return false;
+
+			//the number of files is small, so the minimum is determined by linear search
+			int min = 0;
+			for (int i=1; i<heads_.count(); ++i)
+			{
+				if (heads_[i].name<heads_[min].name) min = i;
+			}
+			read = heads_[min];
+			if (!readSpilled(*files_[min], heads_[min]))
+			{
+				files_.removeAt(min);
+				heads_.remove(min);
+			}
+
+			return true;
+		}
+
+	protected:
+		QList<QSharedPointer<QFile>> files_;
+		QVector<SpilledRead> heads_;
+	};
+
+	///Maximum number of temporary files that are merged (and thus open) at the same time.
+	static const int max_merge_files = 64;
+
+	static FastqEntry toFastq(const BamAlignment& al)
 	{
-		//create FASTQ entry
 		FastqEntry e;
 		e.header = "@" + al.name();
 		e.bases = al.bases();
 		e.header2 = "+";
 		e.qualities = al.qualities();
 
-		if (rev_comp)
+		if (al.isReverseStrand())
 		{
 			e.bases = NGSHelper::changeSeq(e.bases, true, true);
 			e.qualities = NGSHelper::changeSeq(e.qualities, true, false);
 		}
 
-		out.write(e);
+		return e;
+	}
+
+	void write(const FastqEntry& e1, const FastqEntry& e2)
+	{
+		batch1_ << e1;
+		batch2_ << e2;
+		if (batch1_.count()>=batch_size_) flushBatch();
+	}
+
+	//Hands the current batch over to the writer threads (one thread per output file).
+	void flushBatch()
+	{
+		//wait until the previous batch is written - the main thread prepares the next batch in the meantime
+		pool_.waitForDone();
+
+		pool_.start(new OutputWorker(*out1_, batch1_));
+		pool_.start(new OutputWorker(*out2_, batch2_));
+		batch1_.clear();
+		batch2_.clear();
+	}
+
+	//Writes the cached reads sorted by name to a temporary file and clears the cache.
+	void spill(QHash<QByteArray, BamAlignment>& al_cache)
+	{
+		QList<QByteArray> names = al_cache.keys();
+		std::sort(names.begin(), names.end());
+
+		QString filename = Helper::tempFileName(".tsv");
+		spill_files_ << filename;
+		QSharedPointer<QFile> file = Helper::openFileForWriting(filename);
+		foreach(const QByteArray& name, names)
+		{
+			const BamAlignment& al = al_cache[name];
+			writeSpilled(*file, SpilledRead{name, al.isRead1(), toFastq(al)});
+		}
+		file->close();
+
+		++c_spill_files_;
+		al_cache.clear();
+	}
+
+	static void writeSpilled(QFile& file, const SpilledRead& read)
+	{
+		file.write(read.name + "\t" + (read.read1 ? "1" : "2") + "\t" + read.entry.bases + "\t" + read.entry.qualities + "\n");
+	}
+
+	static bool readSpilled(QFile& file, SpilledRead& read)
+	{
+		if (file.atEnd()) return false;
+
+		QByteArrayList parts = file.readLine().trimmed().split('\t');
+		if (parts.count()!=4) THROW(FileParseException, "Invalid line in temporary file '" + file.fileName() + "'!");
+		read.name = parts[0];
+		read.read1 = parts[1]=="1";
+		read.entry.header = "@" + parts[0];
+		read.entry.bases = parts[2];
+		read.entry.header2 = "+";
+		read.entry.qualities = parts[3];
+
+		return true;
+	}
+
+	//Merges temporary files until at most 'max_merge_files' are left, so that the final merge does not open too many files at once.
+	void reduceSpilled()
+	{
+		while (spill_files_.count()>max_merge_files)
+		{
+			QStringList inputs = spill_files_.mid(0, max_merge_files);
+			QString filename = Helper::tempFileName(".tsv");
+			spill_files_ << filename;
+
+			{
+				QSharedPointer<QFile> file = Helper::openFileForWriting(filename);
+				SpillMerger merger(inputs);
+				SpilledRead read;
+				while (merger.next(read))
+				{
+					writeSpilled(*file, read);
+				}
+				file->close();
+			}
+
+			foreach(const QString& input, inputs)
+			{
+				QFile::remove(input);
+				spill_files_.removeOne(input);
+			}
+		}
+	}
+
+	//Merges the temporary files and writes the pairs found. Returns the number of unmatched reads.
+	long long mergeSpilled(long long& c_paired)
+	{
+		reduceSpilled();
+
+		long long c_unmatched = 0;
+		SpillMerger merger(spill_files_);
+		SpilledRead read;
+		SpilledRead last;
+		bool has_last = false;
+		while (merger.next(read))
+		{
+			//mates are adjacent in the merged order
+			if (has_last && last.name==read.name)
+			{
+				if (read.read1)
+				{
+					write(read.entry, last.entry);
+				}
+				else
+				{
+					write(last.entry, read.entry);
+				}
+				++c_paired;
+				has_last = false;
+			}
+			else
+			{
+				if (has_last) ++c_unmatched;
+				last = read;
+				has_last = true;
+			}
+		}
+		if (has_last) ++c_unmatched;
+
+		return c_unmatched;
 	}
 
 	virtual void main()
@@ -46,22 +253,25 @@ public:
 		QTextStream out(stdout);
 		BamReader reader(getInfile("in"));
 
-		FastqOutfileStream out1(getOutfile("out1"));
-		FastqOutfileStream out2(getOutfile("out2"));
+		out1_.reset(new FastqOutfileStream(getOutfile("out1")));
+		out2_.reset(new FastqOutfileStream(getOutfile("out2")));
 		bool remove_duplicates = getFlag("remove_duplicates");
+		int max_cached = getInt("max_cached");
+		if (max_cached<1) THROW(ArgumentException, "Parameter 'max_cached' has to be positive!");
+		batch_size_ = std::max(1, getInt("batch_size"));
+		pool_.setMaxThreadCount(2);
 
 		long long c_unpaired = 0;
 		long long c_paired = 0;
 		long long c_duplicates = 0;
-		int max_cached = 0;
+		int max_cached_used = 0;
+		SpillFileGuard spill_guard(spill_files_);
 
 		//iterate through reads
 		BamAlignment al;
 		QHash<QByteArray, BamAlignment> al_cache;
 		while (reader.getNextAlignment(al))
 		{
-			//out << al.name() << " PAIRED=" << al.isPaired() << " SEC=" << al.isSecondaryAlignment() << " PROP=" << al.isProperPair() << endl;
-			
 			//skip secondary alinments
 			if(al.isSecondaryAlignment()) continue;
 			if (remove_duplicates && al.isDuplicate())
@@ -69,7 +279,7 @@ public:
 				++c_duplicates;
 				continue;
 			}
-			
+
 			//skip unpaired
 			if(!al.isPaired())
 			{
@@ -82,17 +292,13 @@ public:
 			if (al_cache.contains(name))
 			{
 				BamAlignment mate = al_cache.take(name);
-				//out << name << " [AL] First: " << al.isRead1() << " Reverse: " << al.isReverseStrand() << " Seq: " << al.QueryBases.data() << endl;
-				//out << name << " [MA] First: " << mate.isRead1() << " Reverse: " << mate.isReverseStrand() << " Seq: " << mate.QueryBases.data() << endl;
 				if (al.isRead1())
 				{
-					write(out1, al, al.isReverseStrand());
-					write(out2, mate, mate.isReverseStrand());
+					write(toFastq(al), toFastq(mate));
 				}
 				else
 				{
-					write(out1, mate, mate.isReverseStrand());
-					write(out2, al, al.isReverseStrand());
+					write(toFastq(mate), toFastq(al));
 				}
 				++c_paired;
 			}
@@ -102,22 +308,50 @@ public:
 				al_cache.insert(name, al);
 			}
 
-			max_cached = std::max(max_cached, al_cache.size());
+			max_cached_used = std::max(max_cached_used, al_cache.size());
+
+			//cache is full => write to temporary file
+			if (al_cache.size()>=max_cached) spill(al_cache);
 		}
-		out1.close();
-		out2.close();
+
+		//match reads in temporary files
+		long long c_unmatched = al_cache.size();
+		if (c_spill_files_>0)
+		{
+			if (!al_cache.isEmpty()) spill(al_cache);
+			c_unmatched = mergeSpilled(c_paired);
+		}
+
+		flushBatch();
+		pool_.waitForDone();
+		out1_->close();
+		out2_->close();
 
 		//write debug output
 		out << "Pair reads (written)            : " << c_paired << endl;
 		out << "Unpaired reads (skipped)        : " << c_unpaired << endl;
-		out << "Unmatched paired reads (skipped): " << al_cache.size() << endl;
+		out << "Unmatched paired reads (skipped): " << c_unmatched << endl;
 		if (remove_duplicates)
 		{
 			out << "Duplicate reads (skipped)       : " << c_duplicates << endl;
 		}
 		out << endl;
-		out << "Maximum cached reads            : " << max_cached << endl;
+		out << "Maximum cached reads            : " << max_cached_used << endl;
+		if (c_spill_files_>0)
+		{
+			out << "Temporary files                 : " << c_spill_files_ << endl;
+		}
 	}
+
+private:
+	QSharedPointer<FastqOutfileStream> out1_;
+	QSharedPointer<FastqOutfileStream> out2_;
+	QThreadPool pool_;
+	int batch_size_;
+	QList<FastqEntry> batch1_;
+	QList<FastqEntry> batch2_;
+	QStringList spill_files_;
+	int c_spill_files_ = 0;
 };
 #include "main.moc"
 
@@ -3,6 +3,7 @@
 #include "NGSHelper.h"
 #include "Settings.h"
 #include "NGSD.h"
+#include "NGSDSnapshot.h"
 #include <QTextStream>
 
 class ConcreteTool
@@ -24,7 +25,9 @@ public:
 		addInt("extend", "The number of bases to extend the gene regions before annotation.", true, 0);
 		addFlag("test", "Uses the test database instead of on the production database.");
 		addFlag("clear", "Clear all annotations present in the input file.");
+		addInfile("snapshot", "NGSD snapshot file created with NGSDExportSnapshot. If set, the NGSD is not accessed.", true);
 
+		changeLog(2026, 10, 18, "Added 'snapshot' parameter for annotation without database connection.");
 		changeLog(2017, 11, 28, "Added 'clear' flag.");
 		changeLog(2017, 11, 03, "Now appends a column to the BED file instead of always writing it into the 4th column.");
 	}
@@ -33,7 +36,17 @@ public:
 	{
 		//init
 		int extend = getInt("extend");
-		NGSD db(getFlag("test"));
+		QString snapshot_file = getInfile("snapshot");
+		QSharedPointer<NGSD> db;
+		NGSDSnapshot snapshot;
+		if (snapshot_file.isEmpty())
+		{
+			db.reset(new NGSD(getFlag("test")));
+		}
+		else
+		{
+			snapshot.load(snapshot_file);
+		}
 
 		//process
 		BedFile file;
@@ -47,7 +60,7 @@ public:
 		{
 			BedLine& line = file[i];
 
-			GeneSet genes = db.genesOverlapping(line.chr(), line.start(), line.end(), extend);
+			GeneSet genes = db.isNull() ? snapshot.genesOverlapping(line.chr(), line.start(), line.end(), extend) : db->genesOverlapping(line.chr(), line.start(), line.end(), extend);
 			line.annotations() << genes.join(", ");
 		}
 
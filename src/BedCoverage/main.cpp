@@ -25,7 +25,9 @@ public:
 		addEnum("mode", "Mode to optimize run time. Use 'panel' mode if only a small part of the data in the BAM file is accessed, e.g. a sub-panel of an exome.", true, QStringList() << "default" << "panel", "default");
 		addInt("decimals", "Number of decimals used in output.", true, 2);
 		addOutfile("out", "Output BED file. If unset, writes to STDOUT.", true);
+		addInt("threads", "Number of threads used. The work is split by BAM file and chromosome.", true, 1);
 
+		changeLog(2026, 10, 18, "Added 'threads' parameter.");
 		changeLog(2017,  6,  2, "Added 'dup' parameter.");
 	}
 
@@ -39,9 +41,9 @@ public:
 		//get coverage info for bam files
 		QByteArray header = "#chr\tstart\tend";
 		QStringList bams = getInfileList("bam");
+		Statistics::avgCoverage(file, bams, getInt("min_mapq"), getFlag("dup"), getEnum("mode")=="panel", getInt("decimals"), getInt("threads"));
 		foreach(QString bam, bams)
 		{
-			Statistics::avgCoverage(file, bam, getInt("min_mapq"), getFlag("dup"), getEnum("mode")=="panel", getInt("decimals"));
 			header += "\t" + QFileInfo(bam).baseName();
 		}
 
@@ -1,4 +1,5 @@
 #include "BedFile.h"
+#include "BedFileStream.h"
 #include "ToolBase.h"
 
 class ConcreteTool
@@ -22,10 +23,32 @@ public:
 		//optional
 		addInfile("in", "Input BED file. If unset, reads from STDIN.", true);
 		addOutfile("out", "Output BED file. If unset, writes to STDOUT.", true);
+		addFlag("stream", "Streaming mode for large files: both input files have to be sorted and are not loaded into memory.");
+
+		changeLog(2026, 10, 18, "Added streaming mode for large files (parameter '-stream').");
 	}
 
 	virtual void main()
 	{
+		//streaming mode
+		QString mode = getEnum("mode");
+		if (getFlag("stream"))
+		{
+			if (mode=="intersect")
+			{
+				BedFileStream::intersect(getInfile("in"), getInfile("in2"), getOutfile("out"));
+			}
+			else if (mode=="in")
+			{
+				BedFileStream::overlapping(getInfile("in"), getInfile("in2"), getOutfile("out"));
+			}
+			else if (mode=="in2")
+			{
+				BedFileStream::overlapping(getInfile("in2"), getInfile("in"), getOutfile("out"));
+			}
+			return;
+		}
+
 		//input
 		BedFile in;
 		in.load(getInfile("in"));
@@ -33,7 +56,6 @@ public:
 		in2.load(getInfile("in2"));
 		
 		//calculate
-		QString mode = getEnum("mode");
 		if (mode=="intersect")
 		{
 			if (!in2.isMergedAndSorted()) in2.merge();
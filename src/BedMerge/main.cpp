@@ -1,4 +1,5 @@
 #include "BedFile.h"
+#include "BedFileStream.h"
 #include "ToolBase.h"
 
 class ConcreteTool
@@ -20,10 +21,19 @@ public:
 		addOutfile("out", "Output BED file. If unset, writes to STDOUT.", true);
 		addFlag("keep_b2b", "Do not merge non-overlapping but adjacent (back-to-back) regions.");
 		addFlag("merge_names", "Merge name columns instead of removing all annotations.");
+		addFlag("stream", "Streaming mode for large files: the input file has to be sorted and is not loaded into memory.");
+
+		changeLog(2026, 10, 18, "Added streaming mode for large files (parameter '-stream').");
 	}
 
 	virtual void main()
 	{
+		if (getFlag("stream"))
+		{
+			BedFileStream::merge(getInfile("in"), getOutfile("out"), !getFlag("keep_b2b"), getFlag("merge_names"));
+			return;
+		}
+
 		BedFile file;
 		file.load(getInfile("in"));
 		file.merge(!getFlag("keep_b2b"), getFlag("merge_names"));
@@ -1,4 +1,5 @@
 #include "BedFile.h"
+#include "BedFileStream.h"
 #include "ToolBase.h"
 
 class ConcreteTool
@@ -19,10 +20,20 @@ public:
 		//optional
 		addInfile("in", "Input BED file. If unset, reads from STDIN.", true);
 		addOutfile("out", "Output BED file. If unset, writes to STDOUT.", true);
+		addFlag("stream", "Streaming mode for large files: both input files have to be sorted and are not loaded into memory.");
+
+		changeLog(2026, 10, 18, "Added streaming mode for large files (parameter '-stream').");
 	}
 
 	virtual void main()
 	{
+		//streaming mode
+		if (getFlag("stream"))
+		{
+			BedFileStream::subtract(getInfile("in"), getInfile("in2"), getOutfile("out"));
+			return;
+		}
+
 		//input
 		BedFile file1;
 		file1.load(getInfile("in"));
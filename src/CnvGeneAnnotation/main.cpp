@@ -4,6 +4,7 @@
 #include "VariantList.h"
 #include "BedFile.h"
 #include "NGSD.h"
+#include "NGSDSnapshot.h"
 #include "TSVFileStream.h"
 #include <QFileInfo>
 
@@ -27,7 +28,9 @@ public:
 		//optional
 		addFlag("add_simple_gene_names", "Adds an additional column containing only the list of gene names.");
 		addFlag("test", "Uses the test database instead of on the production database.");
+		addInfile("snapshot", "NGSD snapshot file created with NGSDExportSnapshot. If set, the NGSD is not accessed.", true);
 
+		changeLog(2026, 10, 18, "Added 'snapshot' parameter for annotation without database connection.");
 		changeLog(2019, 11, 11, "Initial version of this tool.");
 
 
@@ -38,7 +41,15 @@ public:
 		//init
 		use_test_db_ = getFlag("test");
 		add_simple_gene_names_ = getFlag("add_simple_gene_names");
-		NGSD db(use_test_db_);
+		QString snapshot_file = getInfile("snapshot");
+		if (snapshot_file.isEmpty())
+		{
+			db_.reset(new NGSD(use_test_db_));
+		}
+		else
+		{
+			snapshot_.load(snapshot_file);
+		}
 		QTextStream out(stdout);
 
 		// start timer
@@ -50,7 +61,7 @@ public:
 		QHash<QByteArray, BedFile> exon_regions;
 
 		// get gene names:
-		GeneSet gene_names = db.approvedGeneNames();
+		GeneSet gene_names = db_.isNull() ? snapshot_.approvedGeneNames() : db_->approvedGeneNames();
 
 		out << "parsing " << gene_names.count() << " genes ..." << endl;
 		int parsed_genes = 0;
@@ -58,7 +69,7 @@ public:
 		foreach (QByteArray gene_name, gene_names)
 		{
 			// generate bed file for complete genes
-			gene_regions.add(getGeneRegion(gene_name, db, "gene"));
+			gene_regions.add(getGeneRegion(gene_name, "gene"));
 
 			// progress output
 			parsed_genes++;
@@ -115,7 +126,7 @@ public:
 			foreach (int index, matching_indices)
 			{
 				QByteArray gene_name = gene_regions[index].annotations()[0];
-				QByteArray gnomad_oe_lof = db.geneInfo(gene_name).oe_lof.toUtf8();
+				QByteArray gnomad_oe_lof = (db_.isNull() ? snapshot_.geneInfo(gene_name) : db_->geneInfo(gene_name)).oe_lof.toUtf8();
 				QByteArray covered_region;
 				if (start <= gene_regions[index].start() && end >= gene_regions[index].end())
 				{
@@ -127,7 +138,7 @@ public:
 					if (!exon_regions.contains(gene_name))
 					{
 						// get exon/splicing region from database
-						exon_regions[gene_name] = getGeneRegion(gene_name, db, "exon");
+						exon_regions[gene_name] = getGeneRegion(gene_name, "exon");
 					}
 					if (exon_regions[gene_name].overlapsWith(chr, start, end))
 					{
@@ -173,17 +184,27 @@ public:
 private:
 	bool use_test_db_;
 	bool add_simple_gene_names_;
+	QSharedPointer<NGSD> db_;
+	NGSDSnapshot snapshot_;
 
 	/*
 	 *	returns a BedLine containing the whole extended gene region for the given gene
 	 */
-	BedFile getGeneRegion(const QByteArray& gene_name, NGSD& db, const QByteArray& mode)
+	BedFile getGeneRegion(const QByteArray& gene_name, const QByteArray& mode)
 	{
 
-		// calculate region
-		GeneSet single_gene;
-		single_gene.insert(gene_name);
-		BedFile gene_regions = db.genesToRegions(single_gene, Transcript::ENSEMBL, mode, true, false);
+		// calculate region (from NGSD or snapshot)
+		BedFile gene_regions;
+		if (db_.isNull())
+		{
+			gene_regions = snapshot_.geneRegions(gene_name, mode);
+		}
+		else
+		{
+			GeneSet single_gene;
+			single_gene.insert(gene_name);
+			gene_regions = db_->genesToRegions(single_gene, Transcript::ENSEMBL, mode, true, false);
+		}
 
 		if (mode == "gene")
 		{
@@ -781,11 +781,11 @@ public:
 			anno_file.load(anno);
 			anno_file.sort();
 			ChromosomalIndex<BedFile> anno_index(anno_file);
+			ChromosomalIndex<BedFile>::Sweep anno_sweep(anno_index); //exons are sorted, see above
 			for (int i=0; i<exons.count(); ++i)
 			{
 				QSet<QByteArray> annos;
-				QVector<int> indices = anno_index.matchingIndices(exons[i]->chr, exons[i]->start, exons[i]->end);
-				foreach(int index, indices)
+				anno_sweep.forEachMatch(exons[i]->chr, exons[i]->start, exons[i]->end, [&](int index)
 				{
 					if (anno_file[index].annotations().isEmpty())
 					{
@@ -795,7 +795,8 @@ public:
 					{
 						annos.insert(anno_file[index].annotations()[0]);
 					}
-				}
+					return true;
+				});
 				exons[i]->annotations.append(annos);
 			}
 		}
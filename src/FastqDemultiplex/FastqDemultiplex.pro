@@ -0,0 +1,14 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2013-08-02T13:54:23
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+QT       -= gui
+CONFIG   += console
+CONFIG   -= app_bundle
+
+SOURCES += main.cpp
+
+include("../app_cli.pri")
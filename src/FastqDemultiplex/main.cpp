@@ -0,0 +1,328 @@
+#include "ToolBase.h"
+#include "FastqFileStream.h"
+#include "MidCheck.h"
+#include "Helper.h"
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QThread>
+#include <QDir>
+#include <QTextStream>
+
+//Output files of a sample (or undetermined reads).
+struct SampleOutput
+{
+	QString name;
+	QSharedPointer<FastqOutfileStream> out1;
+	QSharedPointer<FastqOutfileStream> out2;
+	QList<FastqEntry> batch1;
+	QList<FastqEntry> batch2;
+	QAtomicInt busy;
+	long long reads;
+};
+
+//Reads a batch of FASTQ entries from a stream.
+class ReadWorker
+	: public QRunnable
+{
+public:
+	ReadWorker(FastqFileStream& stream, QVector<FastqEntry>& entries, int& count, QString& error)
+		: QRunnable()
+		, stream_(stream)
+		, entries_(entries)
+		, count_(count)
+		, error_(error)
+	{
+	}
+
+	void run() override
+	{
+		try
+		{
+			count_ = 0;
+			while (count_<entries_.count() && !stream_.atEnd())
+			{
+				stream_.readEntry(entries_[count_]);
+				++count_;
+			}
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
+		}
+	}
+
+protected:
+	FastqFileStream& stream_;
+	QVector<FastqEntry>& entries_;
+	int& count_;
+	QString& error_;
+};
+
+//Compresses and writes a batch of reads of a sample. Only one worker per sample must run at a time, otherwise the order of reads is undefined.
+class WriteWorker
+	: public QRunnable
+{
+public:
+	WriteWorker(SampleOutput& output, QList<FastqEntry> batch1, QList<FastqEntry> batch2)
+		: QRunnable()
+		, output_(output)
+		, batch1_(batch1)
+		, batch2_(batch2)
+	{
+	}
+
+	void run() override
+	{
+		foreach(const FastqEntry& entry, batch1_)
+		{
+			output_.out1->write(entry);
+		}
+		foreach(const FastqEntry& entry, batch2_)
+		{
+			output_.out2->write(entry);
+		}
+		output_.busy.storeRelease(0);
+	}
+
+protected:
+	SampleOutput& output_;
+	QList<FastqEntry> batch1_;
+	QList<FastqEntry> batch2_;
+};
+
+class ConcreteTool
+		: public ToolBase
+{
+	Q_OBJECT
+
+public:
+	ConcreteTool(int& argc, char *argv[])
+		: ToolBase(argc, argv)
+	{
+	}
+
+	virtual void setup()
+	{
+		setDescription("Demultiplexes FASTQ files according to sample barcodes (MIDs).");
+		setExtendedDescription(QStringList() << "The sample sheet is a TSV file with the columns sample name, MID 1 and (optionally) MID 2."
+											 << "All index sequences within the allowed number of mismatches of a sample MID are assigned to the sample. Index sequences that match several samples are written to the undetermined output files."
+											 << "If no index FASTQ files are given, the index sequences are taken from the read header (Illumina format, e.g. '1:N:0:ACGTACGT+TTGATTGA')."
+											 << "For each sample, the output files '<sample>_R1_001.fastq.gz' and '<sample>_R2_001.fastq.gz' are written to the output folder. Reads that cannot be assigned are written to 'Undetermined_R1_001.fastq.gz' and 'Undetermined_R2_001.fastq.gz'.");
+		addInfile("in1", "Forward input gzipped FASTQ file.", false);
+		addInfile("sheet", "Sample sheet TSV file.", false);
+		addString("out", "Output folder.", false);
+		//optional
+		addInfile("in2", "Reverse input gzipped FASTQ file (for paired-end data).", true);
+		addInfile("index1", "Index 1 input gzipped FASTQ file.", true);
+		addInfile("index2", "Index 2 input gzipped FASTQ file.", true);
+		addInt("mismatches1", "Maximum number of mismatches in index 1.", true, 1);
+		addInt("mismatches2", "Maximum number of mismatches in index 2.", true, 1);
+		addInt("index1_length", "Number of index 1 bases used. If unset, the length of the shortest MID 1 in the sample sheet is used.", true, -1);
+		addInt("index2_length", "Number of index 2 bases used. If unset, the length of the shortest MID 2 in the sample sheet is used.", true, -1);
+		addOutfile("summary", "Output TSV file with the number of reads per sample. If unset, writes to STDOUT.", true);
+		addInt("threads", "Number of threads used for reading and compression.", true, 4);
+		addInt("batch_size", "Number of reads that are read and compressed in one batch.", true, 10000);
+		addInt("compression_level", "Output FASTQ compression level from 1 (fastest) to 9 (best compression).", true, Z_BEST_SPEED);
+
+		changeLog(2026, 10, 18, "Initial version.");
+	}
+
+	//Determines the index sequences of a read from the index reads or the read header.
+	static void indexSequences(const FastqEntry& read, const FastqEntry* index1, const FastqEntry* index2, int index1_length, int index2_length, QByteArray& seq1, QByteArray& seq2)
+	{
+		seq1.clear();
+		seq2.clear();
+		if (index1!=nullptr)
+		{
+			seq1 = index1->bases.left(index1_length);
+			if (index2!=nullptr) seq2 = index2->bases.left(index2_length);
+		}
+		else
+		{
+			QByteArray header = read.header;
+			int sep = header.lastIndexOf(':');
+			if (sep==-1) THROW(FileParseException, "Could not determine index sequence from FASTQ header '" + read.header + "'!");
+			QByteArrayList parts = header.mid(sep+1).trimmed().split('+');
+			seq1 = parts[0].left(index1_length);
+			if (parts.count()>1) seq2 = parts[1].left(index2_length);
+		}
+	}
+
+	//Loads the sample sheet.
+	static QList<SampleMids> loadSheet(QString filename)
+	{
+		QList<SampleMids> output;
+
+		QStringList lines = Helper::loadTextFile(filename, true, '#', true);
+		foreach(const QString& line, lines)
+		{
+			QStringList parts = line.split('\t');
+			if (parts.count()<2) THROW(FileParseException, "Invalid sample sheet line (at least two tab-separated columns expected): " + line);
+
+			SampleMids mids;
+			mids.name = parts[0].trimmed();
+			mids.lanes << 1;
+			mids.mid1_seq = parts[1].trimmed().toUpper();
+			mids.mid2_seq = parts.value(2).trimmed().toUpper();
+			if (mids.name=="Undetermined") THROW(FileParseException, "The sample name 'Undetermined' is reserved!");
+			output << mids;
+		}
+
+		return output;
+	}
+
+	//Hands the cached reads of a sample over to the writer threads (if no other batch of the sample is being written).
+	void flush(SampleOutput& output, bool force)
+	{
+		if (!output.busy.testAndSetAcquire(0, 1))
+		{
+			if (!force) return;
+			while (!output.busy.testAndSetAcquire(0, 1)) QThread::yieldCurrentThread();
+		}
+
+		pool_.start(new WriteWorker(output, output.batch1, output.batch2));
+		output.batch1.clear();
+		output.batch2.clear();
+	}
+
+	virtual void main()
+	{
+		//init
+		QString in2 = getInfile("in2");
+		QString index1 = getInfile("index1");
+		QString index2 = getInfile("index2");
+		if (index1.isEmpty() && !index2.isEmpty()) THROW(CommandLineParsingException, "Index 2 FASTQ file given without index 1 FASTQ file!");
+		int threads = std::max(1, getInt("threads"));
+		int batch_size = getInt("batch_size");
+		int compression_level = getInt("compression_level");
+		if (compression_level<1 || compression_level>9) THROW(CommandLineParsingException, "Invalid compression level " + QString::number(compression_level) +"!");
+
+		//load samples and check for MID clashes
+		QList<SampleMids> mids = loadSheet(getInfile("sheet"));
+		if (mids.isEmpty()) THROW(ArgumentException, "Sample sheet contains no samples!");
+		QPair<int, int> lengths = MidCheck::lengthFromSamples(mids);
+		int index1_length = getInt("index1_length");
+		if (index1_length==-1) index1_length = lengths.first;
+		int index2_length = getInt("index2_length");
+		if (index2_length==-1) index2_length = lengths.second;
+		QStringList messages;
+		if (!MidCheck::check(mids, index1_length, index2_length, messages).isEmpty())
+		{
+			THROW(ArgumentException, "MID clashes found:\n" + messages.join("\n"));
+		}
+		//create barcode table
+		BarcodeTable table = MidCheck::barcodeTable(mids, index1_length, index2_length, getInt("mismatches1"), getInt("mismatches2"));
+
+		//open input streams
+		QList<QSharedPointer<FastqFileStream>> streams;
+		streams << QSharedPointer<FastqFileStream>(new FastqFileStream(getInfile("in1"), false));
+		bool paired = !in2.isEmpty();
+		if (paired) streams << QSharedPointer<FastqFileStream>(new FastqFileStream(in2, false));
+		int index1_stream = -1;
+		if (!index1.isEmpty())
+		{
+			index1_stream = streams.count();
+			streams << QSharedPointer<FastqFileStream>(new FastqFileStream(index1, false));
+		}
+		int index2_stream = -1;
+		if (!index2.isEmpty())
+		{
+			index2_stream = streams.count();
+			streams << QSharedPointer<FastqFileStream>(new FastqFileStream(index2, false));
+		}
+
+		//open output streams (last output is undetermined)
+		QString out = getString("out");
+		QDir().mkpath(out);
+		QVector<SampleOutput> outputs(mids.count()+1);
+		for (int i=0; i<outputs.count(); ++i)
+		{
+			SampleOutput& output = outputs[i];
+			output.name = i<mids.count() ? mids[i].name : "Undetermined";
+			output.out1.reset(new FastqOutfileStream(out + "/" + output.name + "_R1_001.fastq.gz", compression_level));
+			if (paired) output.out2.reset(new FastqOutfileStream(out + "/" + output.name + "_R2_001.fastq.gz", compression_level));
+			output.busy.storeRelease(0);
+			output.reads = 0;
+		}
+
+		//process reads
+		pool_.setMaxThreadCount(threads);
+		QThreadPool read_pool;
+		read_pool.setMaxThreadCount(streams.count());
+		QVector<QVector<FastqEntry>> batches(streams.count(), QVector<FastqEntry>(batch_size));
+		QVector<int> counts(streams.count());
+		QVector<QString> errors(streams.count());
+		QByteArray seq1;
+		QByteArray seq2;
+		while (true)
+		{
+			//read next batch of all input files in parallel
+			for (int s=0; s<streams.count(); ++s)
+			{
+				read_pool.start(new ReadWorker(*streams[s], batches[s], counts[s], errors[s]));
+			}
+			read_pool.waitForDone();
+			for (int s=0; s<streams.count(); ++s)
+			{
+				if (!errors[s].isEmpty()) THROW(FileParseException, errors[s]);
+				if (counts[s]!=counts[0]) THROW(FileParseException, "Input FASTQ files have different number of reads!");
+			}
+			if (counts[0]==0) break;
+
+			//assign reads to samples
+			for (int i=0; i<counts[0]; ++i)
+			{
+				const FastqEntry* i1 = index1_stream==-1 ? nullptr : &(batches[index1_stream][i]);
+				const FastqEntry* i2 = index2_stream==-1 ? nullptr : &(batches[index2_stream][i]);
+				indexSequences(batches[0][i], i1, i2, index1_length, index2_length, seq1, seq2);
+				int sample = table.sample(seq1, seq2);
+				if (sample==-1) sample = mids.count();
+
+				SampleOutput& output = outputs[sample];
+				output.batch1 << batches[0][i];
+				if (paired) output.batch2 << batches[1][i];
+				++output.reads;
+				if (output.batch1.count()>=batch_size) flush(output, false);
+			}
+		}
+
+		//write remaining reads
+		for (int i=0; i<outputs.count(); ++i)
+		{
+			if (!outputs[i].batch1.isEmpty()) flush(outputs[i], true);
+		}
+		pool_.waitForDone();
+		for (int i=0; i<outputs.count(); ++i)
+		{
+			outputs[i].out1->close();
+			if (paired) outputs[i].out2->close();
+		}
+
+		//write summary
+		long long reads_total = 0;
+		foreach(const SampleOutput& output, outputs)
+		{
+			reads_total += output.reads;
+		}
+		QSharedPointer<QFile> summary_file = Helper::openFileForWriting(getOutfile("summary"), true);
+		QTextStream summary(summary_file.data());
+		summary << "#sample\tmid1\tmid2\treads\treads_percentage" << endl;
+		for (int i=0; i<outputs.count(); ++i)
+		{
+			const SampleOutput& output = outputs[i];
+			summary << output.name << "\t" << (i<mids.count() ? mids[i].mid1_seq : "") << "\t" << (i<mids.count() ? mids[i].mid2_seq : "") << "\t" << output.reads << "\t" << QString::number(reads_total==0 ? 0.0 : 100.0 * output.reads / reads_total, 'f', 2) << endl;
+		}
+	}
+
+protected:
+	QThreadPool pool_;
+};
+
+#include "main.moc"
+
+int main(int argc, char *argv[])
+{
+	ConcreteTool tool(argc, argv);
+	return tool.execute();
+}
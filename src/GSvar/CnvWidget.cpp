@@ -14,6 +14,7 @@
 #include "CnvSearchWidget.h"
 #include "LoginManager.h"
 #include "GeneInfoDBs.h"
+#include "ChromosomalIndex.h"
 #include <QMessageBox>
 #include <QFileInfo>
 #include <QBitArray>
@@ -328,10 +329,8 @@ void CnvWidget::applyFilters(bool debug_time)
 		//filter by report config
 		if (ui->filter_widget->reportConfigurationOnly())
 		{
-			for(int r=0; r<rows; ++r)
+			for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 			{
-				if (!filter_result.flags()[r]) continue;
-
 				if(!is_somatic_) filter_result.flags()[r] = report_config_->exists(VariantType::CNVS, r);
 				else filter_result.flags()[r] = somatic_report_config_->exists(VariantType::CNVS, r);
 			}
@@ -346,10 +345,8 @@ void CnvWidget::applyFilters(bool debug_time)
 			if (genes_joined.contains("*")) //with wildcards
 			{
 				QRegExp reg(genes_joined.replace("-", "\\-").replace("*", "[A-Z0-9-]*"));
-				for(int r=0; r<rows; ++r)
+				for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 				{
-					if (!filter_result.flags()[r]) continue;
-
 					bool match_found = false;
 					foreach(const QByteArray& cnv_gene, cnvs_[r].genes())
 					{
@@ -364,10 +361,8 @@ void CnvWidget::applyFilters(bool debug_time)
 			}
 			else //without wildcards
 			{
-				for(int r=0; r<rows; ++r)
+				for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 				{
-					if (!filter_result.flags()[r]) continue;
-
 					filter_result.flags()[r] = cnvs_[r].genes().intersectsWith(genes);
 				}
 			}
@@ -379,11 +374,11 @@ void CnvWidget::applyFilters(bool debug_time)
 		{
 			BedFile roi;
 			roi.load(roi_file);
-			for(int r=0; r<rows; ++r)
+			roi.sort();
+			ChromosomalIndex<BedFile> roi_idx(roi);
+			for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 			{
-				if (!filter_result.flags()[r]) continue;
-
-				filter_result.flags()[r] = roi.overlapsWith(cnvs_[r].chr(), cnvs_[r].start(), cnvs_[r].end());
+				filter_result.flags()[r] = roi_idx.matchingIndex(cnvs_[r].chr(), cnvs_[r].start(), cnvs_[r].end())!=-1;
 			}
 		}
 
@@ -402,10 +397,8 @@ void CnvWidget::applyFilters(bool debug_time)
 		}
 		if (region.isValid()) //valid region (chr,start, end or only chr)
 		{
-			for(int r=0; r<rows; ++r)
+			for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 			{
-				if (!filter_result.flags()[r]) continue;
-
 				filter_result.flags()[r] = region.overlapsWith(cnvs_[r].chr(), cnvs_[r].start(), cnvs_[r].end());
 			}
 		}
@@ -438,10 +431,8 @@ void CnvWidget::applyFilters(bool debug_time)
 			}
 			pheno_roi.merge();
 
-			for(int r=0; r<rows; ++r)
+			for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 			{
-				if (!filter_result.flags()[r]) continue;
-
 				filter_result.flags()[r] = pheno_roi.overlapsWith(cnvs_[r].chr(), cnvs_[r].start(), cnvs_[r].end());
 			}
 		}
@@ -450,10 +441,8 @@ void CnvWidget::applyFilters(bool debug_time)
 		QByteArray text = ui->filter_widget->text().trimmed().toLower();
 		if (text!="")
 		{
-			for(int r=0; r<rows; ++r)
+			for(int r=filter_result.nextPassing(0); r!=-1; r=filter_result.nextPassing(r+1))
 			{
-				if (!filter_result.flags()[r]) continue;
-
 				bool match = false;
 				foreach(const QByteArray& anno, cnvs_[r].annotations())
 				{
@@ -50,6 +50,8 @@ SOURCES += main.cpp\
     SequencingRunWidget.cpp \
     AnalysisStatusWidget.cpp \
     VariantTable.cpp \
+    VariantTableModel.cpp \
+    VariantLoadWorker.cpp \
     RtfDocument.cpp \
     SampleSearchWidget.cpp \
     SomaticReportHelper.cpp \
@@ -125,6 +127,8 @@ HEADERS  += MainWindow.h \
     SequencingRunWidget.h \
     AnalysisStatusWidget.h \
     VariantTable.h \
+    VariantTableModel.h \
+    VariantLoadWorker.h \
     RtfDocument.h \
     SampleSearchWidget.h \
     SomaticReportHelper.h \
@@ -142,6 +142,17 @@ QString GSvarHelper::applicationBaseName()
 }
 
 void GSvarHelper::colorGeneItem(QTableWidgetItem* item, const GeneSet& genes)
+{
+	QColor color;
+	QString tooltip;
+	if (geneHighlighting(genes, color, tooltip))
+	{
+		item->setBackgroundColor(color);
+		item->setToolTip(tooltip);
+	}
+}
+
+bool GSvarHelper::geneHighlighting(const GeneSet& genes, QColor& color, QString& tooltip)
 {
 	static const GeneSet& imprinting_genes = impritingGenes();
 	static const GeneSet& hi0_genes = hi0Genes();
@@ -150,17 +161,23 @@ void GSvarHelper::colorGeneItem(QTableWidgetItem* item, const GeneSet& genes)
 	bool hit_hi0 = hi0_genes.intersectsWith(genes);
 	if (hit_imprinting && hit_hi0)
 	{
-		item->setBackgroundColor(Qt::green);
-		item->setToolTip("Imprinting gene\nNo evidence for haploinsufficiency");
+		color = Qt::green;
+		tooltip = "Imprinting gene\nNo evidence for haploinsufficiency";
 	}
 	else if (hit_imprinting)
 	{
-		item->setBackgroundColor(Qt::yellow);
-		item->setToolTip("Imprinting gene");
+		color = Qt::yellow;
+		tooltip = "Imprinting gene";
 	}
 	else if (hit_hi0)
 	{
-		item->setBackgroundColor(Qt::cyan);
-		item->setToolTip("No evidence for haploinsufficiency");
+		color = Qt::cyan;
+		tooltip = "No evidence for haploinsufficiency";
+	}
+	else
+	{
+		return false;
 	}
+
+	return true;
 }
@@ -25,6 +25,8 @@ public:
 
 	//colors imprinting and non-haploinsufficiency genes.
 	static void colorGeneItem(QTableWidgetItem* item, const GeneSet& genes);
+	//determines background color and tooltip for imprinting and non-haploinsufficiency genes. Returns 'false' if the genes are not highlighted.
+	static bool geneHighlighting(const GeneSet& genes, QColor& color, QString& tooltip);
 
 protected:
 	GSvarHelper() = delete;
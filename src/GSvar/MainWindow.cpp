@@ -81,6 +81,7 @@ QT_CHARTS_USE_NAMESPACE
 #include "ProcessingSystemWidget.h"
 #include "ProjectWidget.h"
 #include "GSvarStoreWorker.h"
+#include "VariantLoadWorker.h"
 #include "DBEditor.h"
 #include "TsvTableWidget.h"
 #include "DBTableAdministration.h"
@@ -101,6 +102,7 @@ MainWindow::MainWindow(QWidget *parent)
 	, ui_()
 	, var_last_(-1)
 	, busy_dialog_(nullptr)
+	, load_worker_(nullptr)
 	, notification_label_(new QLabel())
 	, filename_()
 	, db_annos_updated_(NO)
@@ -246,10 +248,8 @@ void MainWindow::on_actionSV_triggered()
 			int res = QMessageBox::question(this, "Continue?", "There are " + QString::number(passing_vars) + " variants that pass the filters.\nGenerating the list of candidate genes for compound-heterozygous hits may take very long for this amount of variants.\nDo you want to continue?", QMessageBox::Yes, QMessageBox::No);
 			if(res==QMessageBox::No) return;
 		}
-		for (int i=0; i<variants_.count(); ++i)
+		for (int i=filter_result_.nextPassing(0); i!=-1; i=filter_result_.nextPassing(i+1))
 		{
-			if (!filter_result_.passing(i)) continue;
-
 			bool all_genos_het = true;
 			foreach(int i_genotype, i_genotypes)
 			{
@@ -294,6 +294,7 @@ void MainWindow::on_actionSV_triggered()
 void MainWindow::on_actionCNV_triggered()
 {
 	if (filename_=="") return;
+	if (loadingInProgress("Copy number variants")) return;
 
 	//create list of genes with heterozygous variant hits
 	GeneSet het_hit_genes;
@@ -310,10 +311,8 @@ void MainWindow::on_actionCNV_triggered()
 			int res = QMessageBox::question(this, "Continue?", "There are " + QString::number(passing_vars) + " variants that pass the filters.\nGenerating the list of candidate genes for compound-heterozygous hits may take very long for this amount of variants.\nPlease set a filter for the variant list, e.g. the recessive filter, and retry!\nDo you want to continue?", QMessageBox::Yes, QMessageBox::No);
 			if(res==QMessageBox::No) return;
 		}
-		for (int i=0; i<variants_.count(); ++i)
+		for (int i=filter_result_.nextPassing(0); i!=-1; i=filter_result_.nextPassing(i+1))
 		{
-			if (!filter_result_.passing(i)) continue;
-
 			bool all_genos_het = true;
 			foreach(int i_genotype, i_genotypes)
 			{
@@ -857,12 +856,12 @@ void MainWindow::showAfHistogram()
 	//create histogram
 	Histogram hist(0.0, 1.0, 0.05);
 	int col = ui_.vars->columnIndex("quality");
-	for (int row=0; row<=ui_.vars->rowCount(); ++row)
+	for (int row=0; row<ui_.vars->rowCount(); ++row)
 	{
-		QTableWidgetItem* item = ui_.vars->item(row, col);
-		if (item==nullptr) continue;
+		QString text = ui_.vars->text(row, col);
+		if (text.isEmpty()) continue;
 
-		QStringList parts = item->text().split(';');
+		QStringList parts = text.split(';');
 		foreach(const QString& part, parts)
 		{
 			if (part.startsWith("AF="))
@@ -1344,34 +1343,36 @@ void MainWindow::loadFile(QString filename)
 
 	Log::perf("Clearing variant table took ", timer);
 
+	//cancel loading of the previous file (the worker deletes itself when it is done)
+	if (load_worker_!=nullptr)
+	{
+		load_worker_->cancel();
+		disconnect(load_worker_, 0, this, 0);
+		disconnect(load_worker_, SIGNAL(progress(QString)), ui_.statusBar, SLOT(showMessage(QString)));
+		connect(load_worker_, SIGNAL(finished(bool)), load_worker_, SLOT(deleteLater()));
+		load_worker_ = nullptr;
+	}
+
 	if (filename=="") return;
 
-	//load data
+	//load data in background
+	load_worker_ = new VariantLoadWorker(filename, cnvFile(filename));
+	connect(load_worker_, SIGNAL(progress(QString)), ui_.statusBar, SLOT(showMessage(QString)));
+	connect(load_worker_, SIGNAL(variantsLoaded()), this, SLOT(variantsLoaded()));
+	connect(load_worker_, SIGNAL(finished(bool)), this, SLOT(loadingFinished(bool)));
+	load_worker_->start();
+}
+
+void MainWindow::variantsLoaded()
+{
+	VariantLoadWorker* worker = qobject_cast<VariantLoadWorker*>(sender());
+	if (worker==nullptr || worker!=load_worker_) return;
+	QString filename = worker->filename();
+
 	QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
 	try
 	{
-		//load variants
-		timer.restart();
-		variants_.load(filename);
-		Log::perf("Loading small variant list took ", timer);
-
-		//load CNVs
-		timer.restart();
-		QString cnv_file = cnvFile(filename);
-		if (cnv_file!="")
-		{
-			try
-			{
-				cnvs_.load(cnv_file);
-				if (cnvs_.count()>50000) THROW(ArgumentException, "CNV file contains too many CNVs - could not load it!")
-			}
-			catch(Exception& e)
-			{
-				QMessageBox::warning(this, "Error loading CNVs", e.message());
-				cnvs_.clear();
-			}
-		}
-		Log::perf("Loading CNV list took ", timer);
+		worker->takeVariants(variants_);
 
 		ui_.filters->setValidFilterEntries(variants_.filters().keys());
 
@@ -1424,8 +1425,33 @@ void MainWindow::loadFile(QString filename)
 	{
 		QMessageBox::warning(this, "Outdated GSvar file", "The GSvar file contains the following error:\n" + e.message() + "\n\nTo ensure that GSvar works as expected, re-run the analysis starting from annotation!");
 	}
+}
+
+void MainWindow::loadingFinished(bool success)
+{
+	VariantLoadWorker* worker = qobject_cast<VariantLoadWorker*>(sender());
+	if (worker==nullptr) return;
+	worker->deleteLater();
+	if (worker!=load_worker_) return;
+	load_worker_ = nullptr;
+
+	//loading of small variants failed
+	if (!success)
+	{
+		QMessageBox::warning(this, "Error", "Loading the file '" + worker->filename() + "' failed!\nError message:\n" + worker->errorMessage());
+		loadFile();
+		return;
+	}
+
+	//CNVs
+	worker->takeCnvs(cnvs_);
+	if (!worker->cnvErrorMessage().isEmpty())
+	{
+		QMessageBox::warning(this, "Error loading CNVs", worker->cnvErrorMessage());
+	}
+	ui_.statusBar->showMessage("Loaded variant list with " + QString::number(variants_.count()) + " variants and " + QString::number(cnvs_.count()) + " CNVs.");
 
-	//load report config
+	//load report config (needs CNVs)
 	if (LoginManager::active() && germlineReportSupported())
 	{
 		NGSD db;
@@ -1456,6 +1482,14 @@ void MainWindow::loadFile(QString filename)
 	checkPendingVariantValidations();
 }
 
+bool MainWindow::loadingInProgress(QString title)
+{
+	if (load_worker_==nullptr) return false;
+
+	QMessageBox::information(this, title, "The variant list is still being loaded.\nPlease try again when loading has finished!");
+	return true;
+}
+
 void MainWindow::on_actionAbout_triggered()
 {
 	QMessageBox::about(this, "About " + QCoreApplication::applicationName(), QCoreApplication::applicationName()+ " " + QCoreApplication::applicationVersion()+ "\n\nA free viewing and filtering tool for genomic variants.\n\nInstitute of Medical Genetics and Applied Genomics\nUniversity Hospital Tübingen\nGermany\n\nMore information at:\nhttps://github.com/imgag/ngs-bits");
@@ -1715,6 +1749,7 @@ void MainWindow::loadSomaticReportConfig()
 void MainWindow::storeSomaticReportConfig()
 {
 	if(filename_ == "") return;
+	if (loadingInProgress("Storing somatic report configuration")) return;
 	if(!LoginManager::active()) return;
 	if(variants_.type() != SOMATIC_PAIR) return;
 
@@ -1756,6 +1791,7 @@ void MainWindow::storeReportConfig()
 {
 	//check if applicable
 	if (filename_=="") return;
+	if (loadingInProgress("Storing report configuration")) return;
 	if (!LoginManager::active()) return;
 	if (!germlineReportSupported()) return;
 
@@ -2090,7 +2126,8 @@ void MainWindow::printVariantSheetRow(QTextStream& stream, const ReportVariantCo
 	QStringList hgvs_ps;
 	//for genes with preferred transcripts, determine if the variant is actually in the preferred transcript, or not.
 	QHash<QByteArray, bool> variant_in_pt;
-	foreach(const VariantTranscript& trans, v.transcriptAnnotations(i_co_sp))
+	QList<VariantTranscript> transcripts = variants_.transcriptAnnotations(conf.variant_index, i_co_sp);
+	foreach(const VariantTranscript& trans, transcripts)
 	{
 		if (preferred_transcripts.contains(trans.gene))
 		{
@@ -2104,7 +2141,7 @@ void MainWindow::printVariantSheetRow(QTextStream& stream, const ReportVariantCo
 			}
 		}
 	}
-	foreach(const VariantTranscript& trans, v.transcriptAnnotations(i_co_sp))
+	foreach(const VariantTranscript& trans, transcripts)
 	{
 		if (preferred_transcripts.contains(trans.gene) && variant_in_pt[trans.gene] && !preferred_transcripts[trans.gene].contains(trans.id))
 		{
@@ -2204,6 +2241,7 @@ QString MainWindow::exclusionCriteria(const ReportVariantConfiguration& conf)
 void MainWindow::generateReport()
 {
 	if (filename_=="") return;
+	if (loadingInProgress("Report")) return;
 
 	//check if this is a germline or somatic
 	if (somaticReportSupported())
@@ -3170,10 +3208,8 @@ void MainWindow::exportVCF()
 	//create new VCF
 	VariantList output;
 	output.copyMetaData(orig_vcf);
-	for(int i=0; i<variants_.count(); ++i)
+	for (int i=filter_result_.nextPassing(0); i!=-1; i=filter_result_.nextPassing(i+1))
 	{
-		if (!filter_result_.passing(i)) continue;
-
 		int hit_count = 0;
 		const Variant& v = variants_[i];
 		QVector<int> matches = orig_idx.matchingIndices(v.chr(), v.start()-10, v.end()+10);
@@ -3425,7 +3461,7 @@ void MainWindow::uploadtoLovd(int variant_index, int variant_index2)
 	int i_refseq = variants_.annotationIndexByName("coding_and_splicing_refseq", true, false);
 	if (i_refseq!=-1)
 	{
-		data.trans_data = variant.transcriptAnnotations(i_refseq);
+		data.trans_data = variants_.transcriptAnnotations(variant_index, i_refseq);
 	}
 
 	//data 2nd variant (comp-het)
@@ -3438,7 +3474,7 @@ void MainWindow::uploadtoLovd(int variant_index, int variant_index2)
 		data.classification2 = variant2.annotations()[classification_index];
 		if (i_refseq!=-1)
 		{
-			data.trans_data2 = variant2.transcriptAnnotations(i_refseq);
+			data.trans_data2 = variants_.transcriptAnnotations(variant_index2, i_refseq);
 		}
 	}
 
@@ -3602,7 +3638,7 @@ void MainWindow::contextMenuSingleVariant(QPoint pos, int index)
 	int i_gene = variants_.annotationIndexByName("gene", true, true);
 	GeneSet genes = GeneSet::createFromText(variant.annotations()[i_gene], ',');
 	int i_co_sp = variants_.annotationIndexByName("coding_and_splicing", true, true);
-	QList<VariantTranscript> transcripts = variant.transcriptAnnotations(i_co_sp);
+	QList<VariantTranscript> transcripts = variants_.transcriptAnnotations(index, i_co_sp);
 	int i_dbsnp = variants_.annotationIndexByName("dbSNP", true, true);
 	const QMap<QByteArray, QByteArrayList>& preferred_transcripts = GSvarHelper::preferredTranscripts();
 
@@ -4510,10 +4546,8 @@ void MainWindow::applyFilters(bool debug_time)
 		if (germlineReportSupported() && ui_.filters->reportConfigurationVariantsOnly())
 		{
 			QSet<int> report_variant_indices = report_settings_.report_config.variantIndices(VariantType::SNVS_INDELS, false).toSet();
-			for(int i=0; i<variants_.count(); ++i)
+			for(int i=filter_result_.nextPassing(0); i!=-1; i=filter_result_.nextPassing(i+1))
 			{
-				if (!filter_result_.flags()[i]) continue;
-
 				filter_result_.flags()[i] = report_variant_indices.contains(i);
 			}
 		}
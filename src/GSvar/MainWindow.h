@@ -12,6 +12,7 @@
 #include "ReportSettings.h"
 #include "DelayedInitializationTimer.h"
 #include "SomaticReportSettings.h"
+#include "VariantLoadWorker.h"
 struct IgvFile
 {
 	QString id; //sample identifier/name (for visualization)
@@ -82,6 +83,10 @@ public:
 public slots:
 	///Loads a variant list. Unloads the variant list if no file name is given
 	void loadFile(QString filename="");
+	///Small variants of the file have been loaded in the background
+	void variantsLoaded();
+	///Background loading of the file has finished
+	void loadingFinished(bool success);
 	///Open dialog
 	void on_actionOpen_triggered();
 	///Open dialog by name (using NGSD)
@@ -322,6 +327,8 @@ protected:
 	void closeEvent(QCloseEvent* event);
 	///Determines normal sample name from filename_, return "" otherwise (tumor-normal pairs)
 	QString normalSampleName();
+	///Shows a message and returns 'true' if the file is still being loaded in the background.
+	bool loadingInProgress(QString title);
 
 
 private:
@@ -329,6 +336,7 @@ private:
 	Ui::MainWindow ui_;
 	int var_last_;
 	BusyDialog* busy_dialog_;
+	VariantLoadWorker* load_worker_;
 	QList<QSharedPointer<QDialog>> modeless_dialogs_;
 	QLabel* notification_label_;
 
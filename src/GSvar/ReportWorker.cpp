@@ -628,7 +628,7 @@ void ReportWorker::writeHTML()
 			stream << sep << gene << inheritance << endl;
 		}
 		stream << "</td>" << endl;
-		stream << "<td>" << formatCodingSplicing(variant.transcriptAnnotations(i_co_sp)) << "</td>" << endl;
+		stream << "<td>" << formatCodingSplicing(variants_.transcriptAnnotations(var_conf.variant_index, i_co_sp)) << "</td>" << endl;
 		stream << "<td>" << variant.annotations().at(i_class) << "</td>" << endl;
 		stream << "<td>" << var_conf.inheritance << "</td>" << endl;
 		QByteArray freq = variant.annotations().at(i_kg).trimmed();
@@ -1096,7 +1096,7 @@ void ReportWorker::writeXML(QString outfile_name, QString report_document)
 		int i_co_sp = variants_.annotationIndexByName("coding_and_splicing", true, false);
 		if (i_co_sp!=-1)
 		{
-			foreach(const VariantTranscript& trans, variant.transcriptAnnotations(i_co_sp))
+			foreach(const VariantTranscript& trans, variants_.transcriptAnnotations(var_conf.variant_index, i_co_sp))
 			{
 				w.writeStartElement("TranscriptInformation");
 				w.writeAttribute("gene", trans.gene);
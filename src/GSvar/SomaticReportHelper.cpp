@@ -1849,7 +1849,7 @@ RtfTable SomaticReportHelper::pharamacogeneticsTable()
 				{
 					RtfTableRow row;
 
-					VariantTranscript trans = snv.transcriptAnnotations(i_co_sp)[0];
+					VariantTranscript trans = snv_germline_.transcriptAnnotations(i, i_co_sp)[0];
 
 					row.addCell(1200,snv.annotations().at(i_dbsnp),RtfParagraph().setFontSize(14));
 					row.addCell(800,trans.gene,RtfParagraph().setFontSize(14));
@@ -2045,7 +2045,7 @@ void SomaticReportHelper::writeRtf(const QByteArray& out_file)
 		target_bed.load(target_region_);
 		FilterResult filter_result(snv_variants_.count());
 		FilterRegions::apply(snv_variants_,target_bed,filter_result);
-		pass = filter_result.flags();
+		pass = filter_result.flags().toBitArray();
 	}
 
 	for(int i=0;i<pass.count();++i)
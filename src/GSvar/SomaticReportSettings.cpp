@@ -30,10 +30,8 @@ VariantList SomaticReportSettings::filterVariants(const VariantList &snvs, const
 
 	result.addAnnotation("alt_var_alteration","If an alternative text for protein change is specified in report config, this is stored here.", "");
 	result.addAnnotation("alt_var_description", "Alternate description text for variant alteration", "");
-	for(int i=0; i<snvs.count(); ++i)
+	for(int i=filter_res.nextPassing(0); i!=-1; i=filter_res.nextPassing(i+1))
 	{
-		if(!filter_res.flags()[i]) continue;
-
 		result.append(snvs[i]);
 
 		//add additional report config info into new empty annotation columns
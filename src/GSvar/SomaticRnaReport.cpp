@@ -9,7 +9,7 @@ SomaticRnaReport::SomaticRnaReport(const VariantList& snv_list, const FilterCasc
 	, dna_cnvs_(cnv_list)
 {
 	dna_snvs_.copyMetaData(snv_list);
-	QBitArray som_filters_pass = filters.apply(snv_list).flags();
+	BitSet som_filters_pass = filters.apply(snv_list).flags();
 	for(int i=0; i<snv_list.count(); ++i)
 	{
 		if(!som_filters_pass[i]) continue;
@@ -243,11 +243,10 @@ void SvWidget::applyFilters(bool debug_time)
 		}
 		if (roi!="") //perform actual filtering
 		{
-			for(int row=0; row<row_count; ++row)
+			ChromosomalIndex<BedFile> roi_idx(roi_);
+			for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 			{
-				if(!filter_result.flags()[row]) continue;
-
-				if (!sv_bedpe_file_[row].intersectsWith(roi_, true)) filter_result.flags()[row] = false;
+				if (!sv_bedpe_file_[row].intersectsWith(roi_idx, true)) filter_result.flags()[row] = false;
 			}
 		}
 
@@ -266,10 +265,8 @@ void SvWidget::applyFilters(bool debug_time)
 		}
 		if (region.isValid()) //valid region (chr,start, end or only chr)
 		{
-			for(int row=0; row<row_count; ++row)
+			for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 			{
-				if (!filter_result.flags()[row]) continue;
-
 				const BedpeLine& sv = sv_bedpe_file_[row];
 				filter_result.flags()[row] = sv.intersectsWith(BedFile(region.chr(), region.start(), region.end()), true);
 			}
@@ -304,10 +301,8 @@ void SvWidget::applyFilters(bool debug_time)
 			}
 			pheno_roi.merge();
 
-			for(int row=0; row<row_count; ++row)
+			for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 			{
-				if (!filter_result.flags()[row]) continue;
-
 				filter_result.flags()[row] = sv_bedpe_file_[row].intersectsWith(pheno_roi, true);
 			}
 		}
@@ -329,10 +324,8 @@ void SvWidget::applyFilters(bool debug_time)
 				if (genes_joined.contains("*")) //with wildcards
 				{
 					QRegExp reg(genes_joined.replace("-", "\\-").replace("*", "[A-Z0-9-]*"));
-					for(int row=0; row<row_count; ++row)
+					for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 					{
-						if (!filter_result.flags()[row]) continue;
-
 						// generate GeneSet from column text
 						GeneSet sv_genes = GeneSet::createFromText(sv_bedpe_file_[row].annotations()[i_genes], ',');
 
@@ -350,10 +343,8 @@ void SvWidget::applyFilters(bool debug_time)
 				}
 				else //without wildcards
 				{
-					for(int row=0; row<row_count; ++row)
+					for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 					{
-						if (!filter_result.flags()[row]) continue;
-
 						// generate GeneSet from column text
 						GeneSet sv_genes = GeneSet::createFromText(sv_bedpe_file_[row].annotations()[i_genes], ',');
 
@@ -367,10 +358,8 @@ void SvWidget::applyFilters(bool debug_time)
 		QByteArray text = ui->filter_widget->text().trimmed().toLower();
 		if (text!="")
 		{
-			for(int row=0; row<row_count; ++row)
+			for(int row=filter_result.nextPassing(0); row!=-1; row=filter_result.nextPassing(row+1))
 			{
-				if (!filter_result.flags()[row]) continue;
-
 				bool match = false;
 				foreach(const QByteArray& anno, sv_bedpe_file_[row].annotations())
 				{
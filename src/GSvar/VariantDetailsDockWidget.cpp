@@ -538,7 +538,7 @@ void VariantDetailsDockWidget::initTranscriptDetails(const VariantList& vl, int
     const QMap<QByteArray, QByteArrayList>& preferred_transcripts = GSvarHelper::preferredTranscripts();
 	try
 	{
-		trans_data = vl[index].transcriptAnnotations(a_index);
+		trans_data = vl.transcriptAnnotations(index, a_index);
 	}
 	catch(ProgrammingException)
 	{
@@ -0,0 +1,53 @@
+#include "VariantLoadWorker.h"
+#include "Exceptions.h"
+
+VariantLoadWorker::VariantLoadWorker(QString filename, QString cnv_file)
+	: WorkerBase("Loading variants")
+	, filename_(filename)
+	, cnv_file_(cnv_file)
+	, canceled_(0)
+{
+}
+
+VariantLoadWorker::~VariantLoadWorker()
+{
+}
+
+void VariantLoadWorker::process()
+{
+	//load small variants
+	emit progress("Loading small variants from '" + filename_ + "'...");
+	variants_.load(filename_);
+	if (canceled_.load()) return;
+	emit variantsLoaded();
+
+	//load CNVs (errors are reported, but do not abort loading)
+	if (canceled_.load() || cnv_file_.isEmpty()) return;
+	emit progress("Loading CNVs from '" + cnv_file_ + "'...");
+	try
+	{
+		cnvs_.load(cnv_file_);
+	}
+	catch(Exception& e)
+	{
+		cnv_error_ = e.message();
+		cnvs_.clear();
+	}
+}
+
+void VariantLoadWorker::cancel()
+{
+	canceled_.store(1);
+}
+
+void VariantLoadWorker::takeVariants(VariantList& variants)
+{
+	variants = variants_;
+	variants_.clear();
+}
+
+void VariantLoadWorker::takeCnvs(CnvList& cnvs)
+{
+	cnvs = cnvs_;
+	cnvs_.clear();
+}
@@ -0,0 +1,55 @@
+#ifndef VARIANTLOADWORKER_H
+#define VARIANTLOADWORKER_H
+
+#include "WorkerBase.h"
+#include "VariantList.h"
+#include "CnvList.h"
+#include <QAtomicInt>
+
+///Worker that loads the small variants and CNVs of a sample in the background.
+///The variants are provided as soon as they are parsed (signal variantsLoaded), i.e. before the CNVs are loaded.
+class VariantLoadWorker
+		: public WorkerBase
+{
+	Q_OBJECT
+
+public:
+	VariantLoadWorker(QString filename, QString cnv_file);
+	~VariantLoadWorker();
+
+	virtual void process();
+
+	///Cancels loading. No further files are parsed and no further signals except 'finished' are emitted.
+	void cancel();
+
+	///Returns the GSvar file name.
+	QString filename() const
+	{
+		return filename_;
+	}
+	///Moves the loaded variants to @p variants (only valid after variantsLoaded() was emitted).
+	void takeVariants(VariantList& variants);
+	///Moves the loaded CNVs to @p cnvs (only valid after finished() was emitted).
+	void takeCnvs(CnvList& cnvs);
+	///Returns the error message of CNV loading. CNV loading errors are not fatal, i.e. the worker finishes successfully.
+	QString cnvErrorMessage() const
+	{
+		return cnv_error_;
+	}
+
+signals:
+	///Progress message.
+	void progress(QString message);
+	///Emitted when the small variants are loaded.
+	void variantsLoaded();
+
+private:
+	QString filename_;
+	QString cnv_file_;
+	QAtomicInt canceled_;
+	VariantList variants_;
+	CnvList cnvs_;
+	QString cnv_error_;
+};
+
+#endif //VARIANTLOADWORKER_H
@@ -1,211 +1,25 @@
 #include "VariantTable.h"
 #include "GUIHelper.h"
 #include "Exceptions.h"
-#include "GSvarHelper.h"
 
-#include <QBitArray>
+#include <QSet>
 #include <QApplication>
 #include <QClipboard>
 #include <QMessageBox>
 #include <QHeaderView>
 
 VariantTable::VariantTable(QWidget* parent)
-	: QTableWidget(parent)
+	: QTableView(parent)
+	, model_(new VariantTableModel(this))
 {
+	setModel(model_);
+	connect(selectionModel(), SIGNAL(selectionChanged(QItemSelection,QItemSelection)), this, SIGNAL(itemSelectionChanged()));
+	connect(this, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(forwardDoubleClick(QModelIndex)));
 }
 
 void VariantTable::updateTable(const VariantList& variants, const FilterResult& filter_result, const QMap<int,bool>& index_show_report_icon, int max_variants)
 {
-	//set rows and cols
-	int row_count_new = std::min(filter_result.countPassing(), max_variants);
-	int col_count_new = 5 + variants.annotations().count();
-	if (rowCount()!=row_count_new || columnCount()!=col_count_new)
-	{
-		//completely clear items (is faster then resizing)
-		clearContents();
-		//set new size
-		setRowCount(row_count_new);
-		setColumnCount(col_count_new);
-	}
-
-	//header
-	setHorizontalHeaderItem(0, createTableItem("chr"));
-	horizontalHeaderItem(0)->setToolTip("Chromosome of variant");
-	setHorizontalHeaderItem(1, createTableItem("start"));
-	horizontalHeaderItem(1)->setToolTip("Genomic start position of variant");
-	setHorizontalHeaderItem(2, createTableItem("end"));
-	horizontalHeaderItem(2)->setToolTip("Genomic end position of variant");
-	setHorizontalHeaderItem(3, createTableItem("ref"));
-	horizontalHeaderItem(3)->setToolTip("Reference genome sequence");
-	setHorizontalHeaderItem(4, createTableItem("obs"));
-	horizontalHeaderItem(4)->setToolTip("Sequence observed in the sample");
-	for (int i=0; i<variants.annotations().count(); ++i)
-	{
-		QString anno = variants.annotations()[i].name();
-		QTableWidgetItem* header = new QTableWidgetItem(anno);
-
-		//additional descriptions for filter column
-		QString add_desc = "";
-		if (anno=="filter")
-		{
-			auto it = variants.filters().cbegin();
-			while (it!=variants.filters().cend())
-			{
-				add_desc += "\n - "+it.key() + ": " + it.value();
-				++it;
-			}
-		}
-
-		//additional descriptions and color for genotype columns
-		SampleHeaderInfo sample_data = variants.getSampleHeader(false);
-		foreach(const SampleInfo& info, sample_data)
-		{
-			if (info.column_name==anno)
-			{
-				auto it = info.properties.cbegin();
-				while(it != info.properties.cend())
-				{
-					add_desc += "\n - " + it.key() + ": " + it.value();
-
-					if (info.isAffected())
-					{
-						header->setForeground(QBrush(Qt::darkRed));
-					}
-
-					++it;
-				}
-			}
-		}
-
-		QString header_desc = variants.annotationDescriptionByName(anno, false, false).description();
-		header->setToolTip(header_desc + add_desc);
-		setHorizontalHeaderItem(i+5, header);
-	}
-
-	//content
-	int i_genes = variants.annotationIndexByName("gene", true, false);
-	int i_co_sp = variants.annotationIndexByName("coding_and_splicing", true, false);
-	int i_validation = variants.annotationIndexByName("validation", true, false);
-	int i_classification = variants.annotationIndexByName("classification", true, false);
-	int i_comment = variants.annotationIndexByName("comment", true, false);
-	int i_ihdb_hom = variants.annotationIndexByName("NGSD_hom", true, false);
-	int i_ihdb_het = variants.annotationIndexByName("NGSD_het", true, false);
-	int i_clinvar = variants.annotationIndexByName("ClinVar", true, false);
-	int i_hgmd = variants.annotationIndexByName("HGMD", true, false);
-	int r = -1;
-	for (int i=0; i<variants.count(); ++i)
-	{
-		if (!filter_result.passing(i)) continue;
-
-		++r;
-		if (r>=max_variants) break; //maximum number of variants reached > abort
-		const Variant& variant = variants[i];
-
-		setItem(r, 0, createTableItem(variant.chr().str()));
-		if (!variant.chr().isAutosome())
-		{
-			item(r,0)->setBackgroundColor(Qt::yellow);
-			item(r,0)->setToolTip("Not autosome");
-		}
-		setItem(r, 1, createTableItem(QByteArray::number(variant.start())));
-		setItem(r, 2, createTableItem(QByteArray::number(variant.end())));
-		setItem(r, 3, createTableItem(variant.ref()));
-		setItem(r, 4, createTableItem(variant.obs()));
-		bool is_warning_line = false;
-		bool is_notice_line = false;
-		bool is_ok_line = false;
-		for (int j=0; j<variant.annotations().count(); ++j)
-		{
-			const QByteArray& anno = variant.annotations().at(j);
-			QTableWidgetItem* item = createTableItem(anno);
-
-			//warning
-			if (j==i_co_sp && anno.contains(":HIGH:"))
-			{
-				item->setBackgroundColor(Qt::red);
-				is_warning_line = true;
-			}
-			else if (j==i_classification && (anno=="3" || anno=="M"))
-			{
-				item->setBackgroundColor(QColor(255, 135, 60)); //orange
-				is_notice_line = true;
-			}
-			else if (j==i_classification && (anno=="4" || anno=="5"))
-			{
-				item->setBackgroundColor(Qt::red);
-				is_warning_line = true;
-			}
-			else if (j==i_clinvar && anno.contains("pathogenic") && !anno.contains("conflicting interpretations of pathogenicity")) //matches "pathogenic" and "likely pathogenic"
-			{
-				item->setBackgroundColor(Qt::red);
-				is_warning_line = true;
-			}
-			else if (j==i_hgmd && anno.contains("CLASS=DM")) //matches both "DM" and "DM?"
-			{
-				item->setBackgroundColor(Qt::red);
-				is_warning_line = true;
-			}
-
-			//non-pathogenic
-			if (j==i_classification && (anno=="0" || anno=="1" || anno=="2"))
-			{
-				item->setBackgroundColor(Qt::green);
-				is_ok_line = true;
-			}
-
-			//highlighed
-			if (j==i_validation && anno.contains("TP"))
-			{
-				item->setBackgroundColor(Qt::yellow);
-			}
-			else if (j==i_comment && anno!="")
-			{
-				item->setBackgroundColor(Qt::yellow);
-			}
-			else if (j==i_ihdb_hom && anno=="0")
-			{
-				item->setBackgroundColor(Qt::yellow);
-			}
-			else if (j==i_ihdb_het && anno=="0")
-			{
-				item->setBackgroundColor(Qt::yellow);
-			}
-			else if (j==i_clinvar && anno.contains("(confirmed)"))
-			{
-				item->setBackgroundColor(Qt::yellow);
-			}
-			else if (j==i_genes)
-			{
-				GeneSet anno_genes = GeneSet::createFromText(anno, ',');
-				GSvarHelper::colorGeneItem(item, anno_genes);
-			}
-
-			setItem(r, 5+j, item);
-		}
-
-		//vertical headers - warning (red), notice (orange)
-		QTableWidgetItem* item = createTableItem(QByteArray::number(i+1));
-		item->setData(Qt::UserRole, i); //store variant index in user data (for selection methods)
-		if (is_notice_line && !is_ok_line)
-		{
-			item->setForeground(QBrush(QColor(255, 135, 60)));
-			QFont font;
-			font.setWeight(QFont::Bold);
-			item->setFont(font);
-		}
-		else if (is_warning_line && !is_ok_line)
-		{
-			item->setForeground(QBrush(Qt::red));
-			QFont font;
-			font.setWeight(QFont::Bold);
-			item->setFont(font);
-		}
-		if (index_show_report_icon.keys().contains(i))
-		{
-			item->setIcon(reportIcon(index_show_report_icon.value(i)));
-		}
-		setVerticalHeaderItem(r, item);
-	}
+	model_->setVariants(variants, filter_result, index_show_report_icon, max_variants);
 }
 
 void VariantTable::update(const VariantList& variants, const FilterResult& filter_result, const ReportSettings& report_settings, int max_variants)
@@ -234,32 +48,25 @@ void VariantTable::update(const VariantList& variants, const FilterResult& filte
 
 void VariantTable::updateVariantHeaderIcon(const ReportSettings& report_settings, int variant_index)
 {
-	int row = variantIndexToRow(variant_index);
+	variantIndexToRow(variant_index); //throws an exception if the variant is not shown
 
-	QIcon report_icon;
-	if (report_settings.report_config.exists(VariantType::SNVS_INDELS, variant_index))
-	{
-		report_icon = reportIcon(report_settings.report_config.get(VariantType::SNVS_INDELS, variant_index).showInReport());
-	}
-	verticalHeaderItem(row)->setIcon(report_icon);
+	bool has_config = report_settings.report_config.exists(VariantType::SNVS_INDELS, variant_index);
+	model_->updateReportIcon(variant_index, has_config, has_config && report_settings.report_config.get(VariantType::SNVS_INDELS, variant_index).showInReport());
 }
 
 void VariantTable::updateVariantHeaderIcon(const SomaticReportSettings &report_settings, int variant_index)
 {
-	int row = variantIndexToRow(variant_index);
-	QIcon report_icon;
-	if(report_settings.report_config.exists(VariantType::SNVS_INDELS, variant_index))
-	{
-		report_icon = reportIcon(report_settings.report_config.get(VariantType::SNVS_INDELS, variant_index).showInReport());
-	}
-	verticalHeaderItem(row)->setIcon(report_icon);
+	variantIndexToRow(variant_index); //throws an exception if the variant is not shown
+
+	bool has_config = report_settings.report_config.exists(VariantType::SNVS_INDELS, variant_index);
+	model_->updateReportIcon(variant_index, has_config, has_config && report_settings.report_config.get(VariantType::SNVS_INDELS, variant_index).showInReport());
 }
 
 int VariantTable::columnIndex(const QString& column_name) const
 {
 	for(int i=0; i<columnCount(); ++i)
 	{
-		if (horizontalHeaderItem(i)->text()==column_name)
+		if (model_->headerData(i, Qt::Horizontal).toString()==column_name)
 		{
 			return i;
 		}
@@ -281,10 +88,10 @@ QList<int> VariantTable::selectedVariantsIndices(bool gui_indices) const
 {
 	QList<int> output;
 
-	QList<QTableWidgetSelectionRange> ranges = selectedRanges();
-	foreach(const QTableWidgetSelectionRange& range, ranges)
+	QItemSelection ranges = selectionModel()->selection();
+	foreach(const QItemSelectionRange& range, ranges)
 	{
-		for(int row=range.topRow(); row<=range.bottomRow(); ++row)
+		for(int row=range.top(); row<=range.bottom(); ++row)
 		{
 			if (gui_indices)
 			{
@@ -304,36 +111,15 @@ QList<int> VariantTable::selectedVariantsIndices(bool gui_indices) const
 
 int VariantTable::rowToVariantIndex(int row) const
 {
-	//get header (variant index is stored in user data)
-	QTableWidgetItem* header = verticalHeaderItem(row);
-	if (header==nullptr) THROW(ProgrammingException, "Variant table row header not set!");
-
-	//convert header text to integer
-	bool ok;
-	int variant_index = header->data(Qt::UserRole).toInt(&ok);
-	if (!ok) THROW(ProgrammingException, "Variant table row header user data '" + header->data(Qt::UserRole).toString() + "' is not an integer!");
-
-	return variant_index;
+	return model_->rowToVariantIndex(row);
 }
 
 int VariantTable::variantIndexToRow(int index) const
 {
-	for (int row=0; row<verticalHeader()->count(); ++row)
-	{
-		QTableWidgetItem* item = verticalHeaderItem(row);
-		if (item==nullptr) THROW(ProgrammingException, "Variant table row header not set for row '" + QString::number(row) + "'!");
-
-		bool ok;
-		int index_header = item->data(Qt::UserRole).toInt(&ok);
-		if (!ok) THROW(ProgrammingException, "Variant table row header user data '" + item->data(Qt::UserRole).toString() + "' is not an integer!");
-
-		if(index_header==index)
-		{
-			return row;
-		}
-	}
+	int row = model_->variantIndexToRow(index);
+	if (row==-1) THROW(ProgrammingException, "Variant table row header not found for variant with index '" + QString::number(index) + "'!");
 
-	THROW(ProgrammingException, "Variant table row header not found for variant with index '" + QString::number(index) + "'!");
+	return row;
 }
 
 QList<int> VariantTable::columnWidths() const
@@ -361,19 +147,14 @@ void VariantTable::adaptRowHeights()
 {
 	if (rowCount()<1) return;
 
+	//rows are not resized individually - that would be slow for large tables
 	resizeRowToContents(0);
-	int height = rowHeight(0);
-
-	for (int i=0; i<rowCount(); ++i)
-	{
-		setRowHeight(i, height);
-	}
+	verticalHeader()->setDefaultSectionSize(rowHeight(0));
 }
 
 void VariantTable::clearContents()
 {
-	setRowCount(0);
-	setColumnCount(0);
+	model_->clear();
 }
 
 void VariantTable::adaptColumnWidths()
@@ -481,68 +262,35 @@ void VariantTable::adaptColumnWidthsCustom()
 
 void VariantTable::copyToClipboard(bool split_quality)
 {
+	QItemSelection selection = selectionModel()->selection();
+	if (selection.isEmpty()) return;
+
 	// Data to be copied is not selected en bloc
-	if (selectedRanges().count()!=1 && !split_quality)
+	if (selection.count()!=1 && !split_quality)
 	{
-		//Create 2d list with empty QStrings (size equal to QTable in Main Window)
-		QList< QList<QString> > data;
-		for(int r=0;r<rowCount();++r)
-		{
-			QList<QString> line;
-			for(int c=0;c<columnCount();++c)
-			{
-				line.append("");
-			}
-			data.append(line);
-		}
-
-		//Fill data with non-empty entries from QTable in Main Window
-		QBitArray empty_columns;
-		empty_columns.fill(true,columnCount());
-		QList<QTableWidgetItem*> all_items = selectedItems();
-		foreach(QTableWidgetItem* item,all_items)
-		{
-			if(!item->text().isEmpty())
-			{
-				data[item->row()][item->column()] = item->text();
-				empty_columns[item->column()] = false;
-			}
-		}
-
-		//Remove empty columns
-		for(int c=columnCount()-1;c>=0;--c)
+		//collect non-empty selected cells (row > column > text)
+		QMap<int, QMap<int, QString>> data;
+		QSet<int> non_empty_columns;
+		foreach(const QModelIndex& index, selectionModel()->selectedIndexes())
 		{
-			if(empty_columns[c])
+			QString text = index.data().toString();
+			if(!text.isEmpty())
 			{
-				for(int r=0;r<rowCount();++r)
-				{
-					data[r].removeAt(c);
-				}
+				data[index.row()][index.column()] = text;
+				non_empty_columns << index.column();
 			}
 		}
+		QList<int> columns = non_empty_columns.toList();
+		std::sort(columns.begin(), columns.end());
 
-		//Remove empty rows
-		for(int r=rowCount()-1;r>=0;--r)
-		{
-			bool row_is_empty = true;
-			for(int c=0;c<data[r].count();++c)
-			{
-				if(!data[r][c].isEmpty())
-				{
-					row_is_empty = false;
-					break;
-				}
-			}
-			if(row_is_empty) data.removeAt(r);
-		}
-
+		//empty rows and columns are skipped
 		QString text = "";
-		for(int r=0;r<data.count();++r)
+		foreach(const QMap<int, QString>& row_data, data)
 		{
-			for(int c=0;c<data[r].count();++c)
+			for(int c=0;c<columns.count();++c)
 			{
-				text.append(data[r][c]);
-				if(c<data[r].count()-1) text.append("\t");
+				text.append(row_data.value(columns[c]));
+				if(c<columns.count()-1) text.append("\t");
 			}
 			text.append("\n");
 		}
@@ -551,7 +299,7 @@ void VariantTable::copyToClipboard(bool split_quality)
 		return;
 	}
 
-	QTableWidgetSelectionRange range = selectedRanges()[0];
+	QItemSelectionRange range = selection[0];
 
 	//check quality column is present
 	QStringList quality_keys;
@@ -570,39 +318,39 @@ void VariantTable::copyToClipboard(bool split_quality)
 
 	//copy header
 	QString selected_text = "";
-	if (range.rowCount()!=1)
+	if (range.height()!=1)
 	{
 		selected_text += "#";
-		for (int col=range.leftColumn(); col<=range.rightColumn(); ++col)
+		for (int col=range.left(); col<=range.right(); ++col)
 		{
-			if (col!=range.leftColumn()) selected_text.append("\t");
+			if (col!=range.left()) selected_text.append("\t");
 			if (split_quality && col==qual_index)
 			{
 				selected_text.append(quality_keys.join('\t'));
 			}
 			else
 			{
-				selected_text.append(horizontalHeaderItem(col)->text());
+				selected_text.append(model_->headerData(col, Qt::Horizontal).toString());
 			}
 		}
 	}
 
 	//copy rows
-	for (int row=range.topRow(); row<=range.bottomRow(); ++row)
+	for (int row=range.top(); row<=range.bottom(); ++row)
 	{
 		if (selected_text!="") selected_text.append("\n");
-		for (int col=range.leftColumn(); col<=range.rightColumn(); ++col)
+		for (int col=range.left(); col<=range.right(); ++col)
 		{
-			if (col!=range.leftColumn()) selected_text.append("\t");
+			if (col!=range.left()) selected_text.append("\t");
 
-			QTableWidgetItem* current_item = item(row, col);
-			if (current_item==nullptr) continue;
+			QString current_text = text(row, col);
+			if (current_text.isEmpty()) continue;
 
 			if (split_quality && col==qual_index)
 			{
 				QStringList quality_values;
 				for(int i=0; i<quality_keys.count(); ++i) quality_values.append("");
-				QStringList entries = current_item->text().split(';');
+				QStringList entries = current_text.split(';');
 				foreach(const QString& entry, entries)
 				{
 					QStringList key_value = entry.split('=');
@@ -624,7 +372,7 @@ void VariantTable::copyToClipboard(bool split_quality)
 			}
 			else
 			{
-				selected_text.append(current_item->text().replace('\n',' ').replace('\r', ""));
+				selected_text.append(current_text.replace('\n',' ').replace('\r', ""));
 			}
 		}
 	}
@@ -649,6 +397,11 @@ void VariantTable::keyPressEvent(QKeyEvent* event)
 	}
 	else //default key-press event
 	{
-		QTableWidget::keyPressEvent(event);
+		QTableView::keyPressEvent(event);
 	}
 }
+
+void VariantTable::forwardDoubleClick(const QModelIndex& index)
+{
+	emit cellDoubleClicked(index.row(), index.column());
+}
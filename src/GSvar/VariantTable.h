@@ -1,15 +1,16 @@
 #ifndef VARIANTTABLE_H
 #define VARIANTTABLE_H
 
-#include <QTableWidget>
+#include <QTableView>
 #include "GeneSet.h"
 #include "FilterCascade.h"
 #include "ReportSettings.h"
 #include "SomaticReportSettings.h"
+#include "VariantTableModel.h"
 
-//GUI representation of (filtered) variant table
+//GUI representation of (filtered) variant table. The data is provided by a model, i.e. table cells are formatted only when they are displayed.
 class VariantTable
-	: public QTableWidget
+	: public QTableView
 {
 	Q_OBJECT
 
@@ -40,16 +41,23 @@ public:
 
 	///Convert table row to variant index.
 	int rowToVariantIndex(int row) const;
-	///Convert variant index to table row (attention this can be slow because it is done by linear search).
+	///Convert variant index to table row (binary search). Throws a ProgrammingException if the variant is not shown.
 	int variantIndexToRow(int index) const;
 
-	///Creates table widget items, or nullptr if the text is empty.
-	QTableWidgetItem* createTableItem(const QString& text) const
+	///Returns the number of rows.
+	int rowCount() const
 	{
-		//no text > no item (optimization for WGS - empty items are big and take a lot of RAM)
-		if (text.isEmpty()) return nullptr;
-
-		return new QTableWidgetItem(text);
+		return model_->rowCount();
+	}
+	///Returns the number of columns.
+	int columnCount() const
+	{
+		return model_->columnCount();
+	}
+	///Returns the text of a table cell.
+	QString text(int row, int column) const
+	{
+		return model_->index(row, column).data().toString();
 	}
 
 	///Returns the current column widths.
@@ -61,6 +69,12 @@ public:
 	///Returns report config icon
 	static QIcon reportIcon(bool show_in_report);
 
+signals:
+	///Emitted when the selection changed.
+	void itemSelectionChanged();
+	///Emitted when a cell is double-clicked.
+	void cellDoubleClicked(int row, int column);
+
 public slots:
 
 	///Clear contents
@@ -78,7 +92,12 @@ public slots:
 	///Copy table to clipboard
 	void copyToClipboard(bool split_quality=false);
 
+protected slots:
+	///Forwards double-clicks on cells.
+	void forwardDoubleClick(const QModelIndex& index);
+
 protected:
+	VariantTableModel* model_;
 
 	///Override copy command
 	void keyPressEvent(QKeyEvent* event) override;
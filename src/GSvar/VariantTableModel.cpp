@@ -0,0 +1,344 @@
+#include "VariantTableModel.h"
+#include "GSvarHelper.h"
+#include "Exceptions.h"
+#include "VariantTable.h"
+#include <QBrush>
+#include <QFont>
+#include <algorithm>
+
+VariantTableModel::VariantTableModel(QObject* parent)
+	: QAbstractTableModel(parent)
+	, variants_(nullptr)
+	, rows_()
+	, report_icons_()
+	, header_names_()
+	, header_tooltips_()
+	, header_affected_()
+	, i_genes_(-1)
+	, i_co_sp_(-1)
+	, i_validation_(-1)
+	, i_classification_(-1)
+	, i_comment_(-1)
+	, i_ihdb_hom_(-1)
+	, i_ihdb_het_(-1)
+	, i_clinvar_(-1)
+	, i_hgmd_(-1)
+{
+}
+
+void VariantTableModel::setVariants(const VariantList& variants, const FilterResult& filter_result, const QMap<int, bool>& index_show_report_icon, int max_variants)
+{
+	beginResetModel();
+
+	variants_ = &variants;
+	report_icons_ = index_show_report_icon;
+
+	//rows (only the index vector is updated when the filters change)
+	rows_.clear();
+	rows_.reserve(std::min(filter_result.countPassing(), max_variants));
+	for (int i=filter_result.nextPassing(0); i!=-1 && rows_.count()<max_variants; i=filter_result.nextPassing(i+1))
+	{
+		rows_.append(i);
+	}
+
+	//header
+	header_names_ = QStringList() << "chr" << "start" << "end" << "ref" << "obs";
+	header_tooltips_ = QStringList() << "Chromosome of variant" << "Genomic start position of variant" << "Genomic end position of variant" << "Reference genome sequence" << "Sequence observed in the sample";
+	header_affected_.fill(false, 5 + variants.annotations().count());
+	SampleHeaderInfo sample_data = variants.getSampleHeader(false);
+	for (int i=0; i<variants.annotations().count(); ++i)
+	{
+		QString anno = variants.annotations()[i].name();
+
+		//additional descriptions for filter column
+		QString add_desc = "";
+		if (anno=="filter")
+		{
+			auto it = variants.filters().cbegin();
+			while (it!=variants.filters().cend())
+			{
+				add_desc += "\n - "+it.key() + ": " + it.value();
+				++it;
+			}
+		}
+
+		//additional descriptions and color for genotype columns
+		foreach(const SampleInfo& info, sample_data)
+		{
+			if (info.column_name==anno)
+			{
+				auto it = info.properties.cbegin();
+				while(it != info.properties.cend())
+				{
+					add_desc += "\n - " + it.key() + ": " + it.value();
+
+					if (info.isAffected())
+					{
+						header_affected_[i+5] = true;
+					}
+
+					++it;
+				}
+			}
+		}
+
+		header_names_ << anno;
+		header_tooltips_ << variants.annotationDescriptionByName(anno, false, false).description() + add_desc;
+	}
+
+	//highlighted columns
+	i_genes_ = variants.annotationIndexByName("gene", true, false);
+	i_co_sp_ = variants.annotationIndexByName("coding_and_splicing", true, false);
+	i_validation_ = variants.annotationIndexByName("validation", true, false);
+	i_classification_ = variants.annotationIndexByName("classification", true, false);
+	i_comment_ = variants.annotationIndexByName("comment", true, false);
+	i_ihdb_hom_ = variants.annotationIndexByName("NGSD_hom", true, false);
+	i_ihdb_het_ = variants.annotationIndexByName("NGSD_het", true, false);
+	i_clinvar_ = variants.annotationIndexByName("ClinVar", true, false);
+	i_hgmd_ = variants.annotationIndexByName("HGMD", true, false);
+
+	endResetModel();
+}
+
+void VariantTableModel::clear()
+{
+	beginResetModel();
+
+	variants_ = nullptr;
+	rows_.clear();
+	report_icons_.clear();
+	header_names_.clear();
+	header_tooltips_.clear();
+	header_affected_.clear();
+
+	endResetModel();
+}
+
+void VariantTableModel::updateReportIcon(int variant_index, bool has_config, bool show_in_report)
+{
+	if (has_config)
+	{
+		report_icons_[variant_index] = show_in_report;
+	}
+	else
+	{
+		report_icons_.remove(variant_index);
+	}
+
+	int row = variantIndexToRow(variant_index);
+	if (row!=-1) emit headerDataChanged(Qt::Vertical, row, row);
+}
+
+int VariantTableModel::rowToVariantIndex(int row) const
+{
+	if (row<0 || row>=rows_.count()) THROW(ProgrammingException, "Variant table row '" + QString::number(row) + "' out of range!");
+
+	return rows_[row];
+}
+
+int VariantTableModel::variantIndexToRow(int index) const
+{
+	//rows are sorted by variant index => binary search
+	auto it = std::lower_bound(rows_.cbegin(), rows_.cend(), index);
+	if (it==rows_.cend() || *it!=index) return -1;
+
+	return it - rows_.cbegin();
+}
+
+int VariantTableModel::rowCount(const QModelIndex& parent) const
+{
+	if (parent.isValid()) return 0;
+
+	return rows_.count();
+}
+
+int VariantTableModel::columnCount(const QModelIndex& parent) const
+{
+	if (parent.isValid()) return 0;
+
+	return header_names_.count();
+}
+
+const Variant* VariantTableModel::variant(int row) const
+{
+	if (variants_==nullptr || row<0 || row>=rows_.count()) return nullptr;
+
+	//the variant list can be modified before the table is updated
+	int index = rows_[row];
+	if (index>=variants_->count()) return nullptr;
+
+	return &((*variants_)[index]);
+}
+
+QVariant VariantTableModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid()) return QVariant();
+
+	const Variant* v = variant(index.row());
+	if (v==nullptr) return QVariant();
+
+	int col = index.column();
+	if (role==Qt::DisplayRole)
+	{
+		switch(col)
+		{
+			case 0: return QString(v->chr().str());
+			case 1: return QString::number(v->start());
+			case 2: return QString::number(v->end());
+			case 3: return QString(v->ref());
+			case 4: return QString(v->obs());
+		}
+		if (col-5<v->annotations().count()) return QString(v->annotations()[col-5]);
+	}
+	else if (role==Qt::BackgroundRole)
+	{
+		if (col==0)
+		{
+			if (!v->chr().isAutosome()) return QBrush(Qt::yellow);
+		}
+		else if (col>=5 && col-5<v->annotations().count())
+		{
+			int flags = NONE;
+			QColor color = annotationColor(col-5, v->annotations()[col-5], flags);
+			if (color.isValid()) return QBrush(color);
+		}
+	}
+	else if (role==Qt::ToolTipRole)
+	{
+		if (col==0)
+		{
+			if (!v->chr().isAutosome()) return "Not autosome";
+		}
+		else if (col-5==i_genes_ && col-5<v->annotations().count())
+		{
+			QColor color;
+			QString tooltip;
+			if (GSvarHelper::geneHighlighting(GeneSet::createFromText(v->annotations()[col-5], ','), color, tooltip)) return tooltip;
+		}
+	}
+
+	return QVariant();
+}
+
+QVariant VariantTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation==Qt::Horizontal)
+	{
+		if (section<0 || section>=header_names_.count()) return QVariant();
+
+		if (role==Qt::DisplayRole) return header_names_[section];
+		if (role==Qt::ToolTipRole) return header_tooltips_[section];
+		if (role==Qt::ForegroundRole && header_affected_[section]) return QBrush(Qt::darkRed);
+	}
+	else
+	{
+		const Variant* v = variant(section);
+		if (v==nullptr) return QVariant();
+		int index = rows_[section];
+
+		if (role==Qt::DisplayRole) return QString::number(index+1);
+		if (role==Qt::UserRole) return index;
+		if (role==Qt::DecorationRole && report_icons_.contains(index)) return VariantTable::reportIcon(report_icons_[index]);
+
+		//warning (red), notice (orange)
+		if (role==Qt::ForegroundRole || role==Qt::FontRole)
+		{
+			int flags = lineFlags(*v);
+			if ((flags&OK) || !(flags&(NOTICE|WARNING))) return QVariant();
+
+			if (role==Qt::FontRole)
+			{
+				QFont font;
+				font.setWeight(QFont::Bold);
+				return font;
+			}
+			return QBrush((flags&NOTICE) ? QColor(255, 135, 60) : QColor(Qt::red));
+		}
+	}
+
+	return QVariant();
+}
+
+QColor VariantTableModel::annotationColor(int column, const QByteArray& anno, int& flags) const
+{
+	if (anno.isEmpty()) return QColor();
+
+	QColor color;
+
+	//warning
+	if (column==i_co_sp_ && anno.contains(":HIGH:"))
+	{
+		color = Qt::red;
+		flags |= WARNING;
+	}
+	else if (column==i_classification_ && (anno=="3" || anno=="M"))
+	{
+		color = QColor(255, 135, 60); //orange
+		flags |= NOTICE;
+	}
+	else if (column==i_classification_ && (anno=="4" || anno=="5"))
+	{
+		color = Qt::red;
+		flags |= WARNING;
+	}
+	else if (column==i_clinvar_ && anno.contains("pathogenic") && !anno.contains("conflicting interpretations of pathogenicity")) //matches "pathogenic" and "likely pathogenic"
+	{
+		color = Qt::red;
+		flags |= WARNING;
+	}
+	else if (column==i_hgmd_ && anno.contains("CLASS=DM")) //matches both "DM" and "DM?"
+	{
+		color = Qt::red;
+		flags |= WARNING;
+	}
+
+	//non-pathogenic
+	if (column==i_classification_ && (anno=="0" || anno=="1" || anno=="2"))
+	{
+		color = Qt::green;
+		flags |= OK;
+	}
+
+	//highlighed
+	if (column==i_validation_ && anno.contains("TP"))
+	{
+		color = Qt::yellow;
+	}
+	else if (column==i_comment_)
+	{
+		color = Qt::yellow;
+	}
+	else if (column==i_ihdb_hom_ && anno=="0")
+	{
+		color = Qt::yellow;
+	}
+	else if (column==i_ihdb_het_ && anno=="0")
+	{
+		color = Qt::yellow;
+	}
+	else if (column==i_clinvar_ && anno.contains("(confirmed)"))
+	{
+		color = Qt::yellow;
+	}
+	else if (column==i_genes_)
+	{
+		QString tooltip;
+		GSvarHelper::geneHighlighting(GeneSet::createFromText(anno, ','), color, tooltip);
+	}
+
+	return color;
+}
+
+int VariantTableModel::lineFlags(const Variant& variant) const
+{
+	int flags = NONE;
+
+	//only these columns contribute to the line state
+	const QList<QByteArray>& annos = variant.annotations();
+	foreach(int column, QList<int>() << i_co_sp_ << i_classification_ << i_clinvar_ << i_hgmd_)
+	{
+		if (column>=0 && column<annos.count()) annotationColor(column, annos[column], flags);
+	}
+
+	return flags;
+}
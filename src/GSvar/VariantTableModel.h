@@ -0,0 +1,76 @@
+#ifndef VARIANTTABLEMODEL_H
+#define VARIANTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QMap>
+#include <QBitArray>
+#include "VariantList.h"
+#include "FilterCascade.h"
+
+//Table model that provides the (filtered) variants of a variant list to the variant table.
+//No data is copied - cells are formatted on demand when they are displayed.
+class VariantTableModel
+	: public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	VariantTableModel(QObject* parent = 0);
+
+	///Sets the variants to display. At most @p max_variants passing variants are shown. The variant list has to outlive the model (or until clear() is called).
+	void setVariants(const VariantList& variants, const FilterResult& filter_result, const QMap<int, bool>& index_show_report_icon, int max_variants);
+	///Removes all rows and columns.
+	void clear();
+	///Updates the report config icon of a variant. If @p has_config is false, the icon is removed.
+	void updateReportIcon(int variant_index, bool has_config, bool show_in_report);
+
+	///Convert table row to variant index.
+	int rowToVariantIndex(int row) const;
+	///Convert variant index to table row, or -1 if the variant is not shown.
+	int variantIndexToRow(int index) const;
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+protected:
+	const VariantList* variants_;
+	QVector<int> rows_; //variant index of each table row (sorted ascending)
+	QMap<int, bool> report_icons_;
+
+	//header data (only a few columns, so it is cached)
+	QStringList header_names_;
+	QStringList header_tooltips_;
+	QBitArray header_affected_;
+
+	//indices of annotation columns that are highlighted
+	int i_genes_;
+	int i_co_sp_;
+	int i_validation_;
+	int i_classification_;
+	int i_comment_;
+	int i_ihdb_hom_;
+	int i_ihdb_het_;
+	int i_clinvar_;
+	int i_hgmd_;
+
+	///Line state flags derived from the annotations.
+	enum LineFlags
+	{
+		NONE = 0,
+		WARNING = 1,
+		NOTICE = 2,
+		OK = 4
+	};
+
+	///Returns the variant of a row, or nullptr if the row is invalid.
+	const Variant* variant(int row) const;
+	///Determines the background color of an annotation cell. Returns an invalid color if the cell is not highlighted. Line state flags are added to @p flags.
+	QColor annotationColor(int column, const QByteArray& anno, int& flags) const;
+	///Returns the line state flags of a variant.
+	int lineFlags(const Variant& variant) const;
+};
+
+#endif // VARIANTTABLEMODEL_H
@@ -34,6 +34,9 @@ public:
 		addFlag("test", "Uses the test database instead of on the production database.");
 		addFlag("debug", "Enable verbose debug output.");
 		addFlag("no_time", "Disable timing output.");
+
+		//changelog
+		changeLog(2026,10,18,"Small variants are imported using batched lookups and multi-row inserts.");
 	}
 
 	///split key-value pair based on separator
@@ -127,27 +130,42 @@ public:
 		out << "Imported variants (added:" << c_add << " updated:" << c_update << ")\n";
 		sub_times << ("adding variants took: " + Helper::elapsedTime(sub_timer));
 
-		//add detected variants
+		//add detected variants (multi-row inserts, one transaction per chunk)
 		sub_timer.start();
 		int i_geno = variants.getSampleHeader().infoByID(ps_name).column_index;
-		SqlQuery q_insert = db.getQuery();
-		q_insert.prepare("INSERT INTO detected_variant (processed_sample_id, variant_id, genotype) VALUES (" + ps_id + ", :0, :1)");
-		db.transaction();
+		const int chunk_size = 5000;
+		QStringList placeholders;
+		QVariantList values;
 		for (int i=0; i<variants.count(); ++i)
 		{
 			//skip high-AF variants
 			int variant_id = variant_ids[i];
-			if (variant_id==-1) continue;
+			if (variant_id!=-1)
+			{
+				//remove class 4/5 variant from list (see check below)
+				var_ids_class_4_or_5.remove(variant_id);
+
+				placeholders << "(" + ps_id + ", ?, ?)";
+				values << variant_id << variants[i].annotations()[i_geno];
+			}
 
-			//remove class 4/5 variant from list (see check below)
-			var_ids_class_4_or_5.remove(variant_id);
+			//insert chunk
+			if (placeholders.count()==chunk_size || (i==variants.count()-1 && !placeholders.isEmpty()))
+			{
+				db.transaction();
+				SqlQuery q_insert = db.getQuery();
+				q_insert.prepare("INSERT INTO detected_variant (processed_sample_id, variant_id, genotype) VALUES " + placeholders.join(","));
+				foreach(const QVariant& value, values)
+				{
+					q_insert.addBindValue(value);
+				}
+				q_insert.exec();
+				db.commit();
 
-			//bind
-			q_insert.bindValue(0, variant_id);
-			q_insert.bindValue(1, variants[i].annotations()[i_geno]);
-			q_insert.exec();
+				placeholders.clear();
+				values.clear();
+			}
 		}
-		db.commit();
 		sub_times << ("adding detected variants took: " + Helper::elapsedTime(sub_timer));
 
 		//check that all important variant are still there (we unset all re-imported variants above)
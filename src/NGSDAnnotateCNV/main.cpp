@@ -1,5 +1,6 @@
 #include "ToolBase.h"
 #include "NGSD.h"
+#include "NGSDSnapshot.h"
 #include "Exceptions.h"
 #include "Helper.h"
 #include "BedpeFile.h"
@@ -30,23 +31,34 @@ public:
 
 		//optional
 		addFlag("test", "Uses the test database instead of on the production database.");
+		addInfile("snapshot", "NGSD snapshot file created with NGSDExportSnapshot. If set, the NGSD is not accessed.", true);
 
+		changeLog(2026, 10, 18, "Added 'snapshot' parameter for annotation without database connection.");
 		changeLog(2020, 2, 21, "Initial version.");
 	}
 
 	virtual void main()
 	{
 		//init
-		NGSD db(getFlag("test"));
 		QTextStream out(stdout);
 		QTime timer;
 		timer.start();
 
-		// prepare SQL query
-		SqlQuery sql_query = db.getQuery();
-		sql_query.prepare("SELECT rcc.class, cnv.start, cnv.end FROM cnv INNER JOIN report_configuration_cnv rcc ON cnv.id = rcc.cnv_id WHERE rcc.class IN ('4', '5') AND cnv.chr = :0 AND cnv.start <= :1 AND :2 <= cnv.end ");
-
-
+		// use snapshot or prepare SQL query
+		QString snapshot_file = getInfile("snapshot");
+		NGSDSnapshot snapshot;
+		QSharedPointer<NGSD> db;
+		QSharedPointer<SqlQuery> sql_query;
+		if (snapshot_file.isEmpty())
+		{
+			db.reset(new NGSD(getFlag("test")));
+			sql_query.reset(new SqlQuery(db->getQuery()));
+			sql_query->prepare("SELECT rcc.class, cnv.start, cnv.end FROM cnv INNER JOIN report_configuration_cnv rcc ON cnv.id = rcc.cnv_id WHERE rcc.class IN ('4', '5') AND cnv.chr = :0 AND cnv.start <= :1 AND :2 <= cnv.end ");
+		}
+		else
+		{
+			snapshot.load(snapshot_file);
+		}
 
 		out << "annotate TSV file..." << endl;
 
@@ -78,25 +90,30 @@ public:
 			int end = Helper::toInt(tsv_line[i_end], "end");
 
 			// get all overlaping CNVs
-			sql_query.bindValue(0, chr.strNormalized(true));
-			sql_query.bindValue(1, end);
-			sql_query.bindValue(2, start);
-			sql_query.exec();
-
-			while(sql_query.next())
+			if (db.isNull())
 			{
-				int p_class = sql_query.value(0).toInt();
-				int p_start = sql_query.value(1).toInt();
-				int p_end = sql_query.value(2).toInt();
-
-				// compute overlap
-				int p_cnv_length = p_end - p_start;
-				int intersection = std::min(p_end, end) - std::max(p_start, start);
-				double overlap = (double) intersection / p_cnv_length;
-
-				// store tuple
-				pathogenic_cnvs.append(QPair<int, double>(p_class, overlap));
-
+				BedFile matches = snapshot.pathogenicCnvs(chr, start, end);
+				for (int i=0; i<matches.count(); ++i)
+				{
+					pathogenic_cnvs.append(QPair<int, double>(matches[i].annotations()[0].toInt(), overlap(matches[i].start(), matches[i].end(), start, end)));
+				}
+			}
+			else
+			{
+				sql_query->bindValue(0, chr.strNormalized(true));
+				sql_query->bindValue(1, end);
+				sql_query->bindValue(2, start);
+				sql_query->exec();
+
+				while(sql_query->next())
+				{
+					int p_class = sql_query->value(0).toInt();
+					int p_start = sql_query->value(1).toInt();
+					int p_end = sql_query->value(2).toInt();
+
+					// store tuple
+					pathogenic_cnvs.append(QPair<int, double>(p_class, overlap(p_start, p_end, start, end)));
+				}
 			}
 
 			// sort found cnvs desc
@@ -134,7 +151,15 @@ public:
 
 		out << "annotation complete (runtime: " << Helper::elapsedTime(timer) << ")." << endl;
 
-	}	
+	}
+
+	// returns the fraction of the pathogenic CNV covered by the CNV
+	static double overlap(int p_start, int p_end, int start, int end)
+	{
+		int p_cnv_length = p_end - p_start;
+		int intersection = std::min(p_end, end) - std::max(p_start, start);
+		return (double) intersection / p_cnv_length;
+	}
 };
 
 #include "main.moc"
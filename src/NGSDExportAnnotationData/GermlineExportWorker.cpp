@@ -0,0 +1,248 @@
+#include "GermlineExportWorker.h"
+#include "NGSD.h"
+#include "VcfFile.h"
+#include "Helper.h"
+#include "FastaFileIndex.h"
+#include <QElapsedTimer>
+#include <QTextStream>
+
+GermlineExportWorker::GermlineExportWorker(QString chr, QString tmp_file, const GermlineExportParameters& params)
+	: QRunnable()
+	, chr(chr)
+	, tmp_file(tmp_file)
+	, error()
+	, variant_count(0)
+	, ref_lookup_sum(0)
+	, db_query_sum(0)
+	, vcf_file_writing_sum(0)
+	, count_computation_sum(0)
+	, params_(params)
+{
+	setAutoDelete(false);
+}
+
+void GermlineExportWorker::run()
+{
+	try
+	{
+		exportVariants();
+	}
+	catch(Exception& e)
+	{
+		error = e.message();
+	}
+}
+
+void GermlineExportWorker::exportVariants()
+{
+	QElapsedTimer ref_lookup;
+	QElapsedTimer count_computation;
+	QElapsedTimer db_queries;
+	QElapsedTimer vcf_file_writing;
+
+	//database connections cannot be shared between threads
+	NGSD db(params_.use_test_db);
+	FastaFileIndex reference_file(params_.reference_file);
+
+	QSharedPointer<QFile> vcf_file = Helper::openFileForWriting(tmp_file);
+	QTextStream vcf_stream(vcf_file.data());
+
+	//prepare queries (one query per window)
+	db_queries.start();
+	SqlQuery variant_query = db.getQuery();
+	variant_query.prepare("SELECT id, start, end, ref, obs, 1000g, gnomad, comment FROM variant WHERE chr=:0 AND start>=:1 AND start<:2 ORDER BY start ASC, end ASC");
+	SqlQuery count_query = db.getQuery();
+	count_query.prepare(QString() + "SELECT dv.variant_id, s.id, s.disease_status, s.disease_group, dv.genotype "
+						+ "FROM variant v, detected_variant dv, processed_sample ps, sample s "
+						+ "WHERE v.chr=:0 AND v.start>=:1 AND v.start<:2 AND (v.1000g IS NULL OR v.1000g<=:3) AND (v.gnomad IS NULL OR v.gnomad<=:4) "
+						+ "AND dv.variant_id=v.id AND dv.processed_sample_id=ps.id AND ps.sample_id=s.id "
+						+ "GROUP BY dv.variant_id, s.id, dv.genotype ORDER BY dv.variant_id, s.id");
+	SqlQuery class_query = db.getQuery();
+	class_query.prepare("SELECT vc.variant_id, vc.class, vc.comment FROM variant_classification vc, variant v WHERE vc.variant_id=v.id AND v.chr=:0 AND v.start>=:1 AND v.start<:2");
+
+	//determine last position
+	int max_start = db.getValue("SELECT MAX(start) FROM variant WHERE chr=:0", true, chr).toInt();
+	db_query_sum += db_queries.elapsed();
+
+	for (int window_start=1; window_start<=max_start; window_start+=params_.window_size)
+	{
+		int window_end = window_start + params_.window_size;
+
+		//NGSD counts of all variants in the window (same-sample relations are resolved in memory)
+		struct Counts
+		{
+			int het = 0;
+			int hom = 0;
+			QHash<QString, int> het_per_group;
+			QHash<QString, int> hom_per_group;
+			QSet<int> samples_done_het;
+			QSet<int> samples_done_hom;
+		};
+		QHash<int, Counts> counts;
+		db_queries.restart();
+		count_query.bindValue(0, chr);
+		count_query.bindValue(1, window_start);
+		count_query.bindValue(2, window_end);
+		count_query.bindValue(3, params_.max_allele_frequency);
+		count_query.bindValue(4, params_.max_allele_frequency);
+		count_query.exec();
+		db_query_sum += db_queries.elapsed();
+		count_computation.restart();
+		while(count_query.next())
+		{
+			Counts& c = counts[count_query.value(0).toInt()];
+
+			//use sample ID to prevent counting variants several times if a sample was sequenced more than once.
+			int sample_id = count_query.value(1).toInt();
+			QByteArray genotype = count_query.value(4).toByteArray();
+			bool affected = count_query.value(2).toByteArray()=="Affected";
+
+			// count heterozygous variants
+			if (genotype=="het" && !c.samples_done_het.contains(sample_id))
+			{
+				++c.het;
+				c.samples_done_het << sample_id;
+				foreach(int same_sample_id, params_.same_samples.value(sample_id))
+				{
+					c.samples_done_het << same_sample_id;
+				}
+				if (affected) c.het_per_group[count_query.value(3).toString()] += 1;
+			}
+
+			// count homozygous variants
+			if (genotype=="hom" && !c.samples_done_hom.contains(sample_id))
+			{
+				++c.hom;
+				c.samples_done_hom << sample_id;
+				foreach(int same_sample_id, params_.same_samples.value(sample_id))
+				{
+					c.samples_done_hom << same_sample_id;
+				}
+				if (affected) c.hom_per_group[count_query.value(3).toString()] += 1;
+			}
+		}
+		count_computation_sum += count_computation.elapsed();
+
+		//classifications of all variants in the window
+		QHash<int, QPair<QByteArray, QByteArray>> classifications;
+		db_queries.restart();
+		class_query.bindValue(0, chr);
+		class_query.bindValue(1, window_start);
+		class_query.bindValue(2, window_end);
+		class_query.exec();
+		while(class_query.next())
+		{
+			classifications.insert(class_query.value(0).toInt(), qMakePair(class_query.value(1).toByteArray(), class_query.value(2).toByteArray()));
+		}
+
+		//variants
+		variant_query.bindValue(0, chr);
+		variant_query.bindValue(1, window_start);
+		variant_query.bindValue(2, window_end);
+		variant_query.exec();
+		db_query_sum += db_queries.elapsed();
+		while(variant_query.next())
+		{
+			int variant_id = variant_query.value(0).toInt();
+			Variant variant(chr, variant_query.value(1).toInt(), variant_query.value(2).toInt(), variant_query.value(3).toByteArray(), variant_query.value(4).toByteArray());
+			QByteArray one_thousand_g = variant_query.value(5).toByteArray();
+			QByteArray gnomad = variant_query.value(6).toByteArray();
+			QByteArray comment = variant_query.value(7).toByteArray();
+
+			// modify sequence if deletion or insertion occurs (to fit VCF specification)
+			if ((variant.ref() == "-") || (variant.obs() == "-"))
+			{
+				ref_lookup.restart();
+
+				//include base before (after) to the variant
+				QByteArray new_ref_seq, new_obs_seq;
+				if (variant.start() != 1)
+				{
+					// update position for deletion
+					if (variant.obs() == "-")
+					{
+						variant.setStart(variant.start() - 1);
+					}
+
+					// add base before ref and alt sequence
+					Sequence previous_base = reference_file.seq(variant.chr(), variant.start(), 1);
+					new_ref_seq = previous_base + variant.ref();
+					new_obs_seq = previous_base + variant.obs();
+				}
+				else
+				{
+					// add base after ref and alt sequence
+					Sequence next_base = reference_file.seq(variant.chr(), variant.start() + 1, 1);
+					new_ref_seq = variant.ref() + next_base;
+					new_obs_seq = variant.obs() + next_base;
+				}
+				new_ref_seq.replace("-", "");
+				new_obs_seq.replace("-", "");
+				variant.setRef(new_ref_seq);
+				variant.setObs(new_obs_seq);
+
+				ref_lookup_sum += ref_lookup.elapsed();
+			}
+
+			QByteArrayList info_column;
+			if((one_thousand_g.toDouble() <= params_.max_allele_frequency) && (gnomad.toDouble() <= params_.max_allele_frequency))
+			{
+				// store counts in vcf
+				const Counts c = counts.value(variant_id);
+				info_column.append("COUNTS=" + QByteArray::number(c.hom) + "," + QByteArray::number(c.het));
+
+				for(int i = 0; i < params_.disease_groups.size(); i++)
+				{
+					const QString& group = params_.disease_groups[i];
+					if ((c.het_per_group.value(group, 0) > 0) || (c.hom_per_group.value(group, 0) > 0))
+					{
+						info_column.append("GSC" + QByteArray::number(i + 1).rightJustified(2, '0') + "=" + QByteArray::number(c.hom_per_group.value(group, 0)) + "," + QByteArray::number(c.het_per_group.value(group, 0)));
+					}
+				}
+			}
+			else
+			{
+				// mark variants with high allele frequeny
+				info_column.append("HAF");
+			}
+
+			// add classification
+			if (classifications.contains(variant_id))
+			{
+				QByteArray classification = classifications[variant_id].first.trimmed().replace("n/a", "");
+				QByteArray clas_comment = VcfFile::encodeInfoValue(classifications[variant_id].second).toUtf8();
+				if (classification != "") info_column.append("CLAS=" + classification);
+				if (clas_comment != "") info_column.append("CLAS_COM=\"" + clas_comment + "\"");
+			}
+
+			// add comment
+			if(comment != "")
+			{
+				info_column.append("COM=\"" + VcfFile::encodeInfoValue(comment).toUtf8() + "\"");
+			}
+
+			vcf_file_writing.restart();
+			vcf_stream << variant.chr().strNormalized(true) << "\t";
+			vcf_stream << variant.start() << "\t";
+			vcf_stream << variant_id << "\t";
+			vcf_stream << variant.ref() << "\t";
+			vcf_stream << variant.obs() << "\t";
+			vcf_stream << "." << "\t"; //quality
+			vcf_stream << "." << "\t"; //filter
+			if (info_column.size() > 0)
+			{
+				vcf_stream << info_column.join(";") << "\n";
+			}
+			else
+			{
+				vcf_stream << ".\n";
+			}
+			vcf_file_writing_sum += vcf_file_writing.elapsed();
+
+			++variant_count;
+		}
+	}
+
+	vcf_stream.flush();
+	vcf_file->close();
+}
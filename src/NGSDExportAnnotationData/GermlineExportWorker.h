@@ -0,0 +1,45 @@
+#ifndef GERMLINEEXPORTWORKER_H
+#define GERMLINEEXPORTWORKER_H
+
+#include <QRunnable>
+#include <QHash>
+#include <QStringList>
+
+///Parameters shared by all germline export workers.
+struct GermlineExportParameters
+{
+	bool use_test_db;
+	QString reference_file;
+	double max_allele_frequency;
+	QStringList disease_groups;
+	QHash<int, QList<int>> same_samples;
+	int window_size;
+};
+
+///Exports the germline variants of one chromosome into a temporary VCF body file.
+///The variants are processed in windows of 'window_size' bases with one query for variants, counts and classifications per window.
+///Each worker uses its own database connection, so several chromosomes can be exported in parallel.
+class GermlineExportWorker
+	: public QRunnable
+{
+public:
+	GermlineExportWorker(QString chr, QString tmp_file, const GermlineExportParameters& params);
+	void run();
+
+	//results (valid after 'run' has finished)
+	QString chr;
+	QString tmp_file;
+	QString error;
+	int variant_count;
+	qint64 ref_lookup_sum;
+	qint64 db_query_sum;
+	qint64 vcf_file_writing_sum;
+	qint64 count_computation_sum;
+
+protected:
+	const GermlineExportParameters& params_;
+
+	void exportVariants();
+};
+
+#endif // GERMLINEEXPORTWORKER_H
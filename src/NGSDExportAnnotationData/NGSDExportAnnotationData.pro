@@ -11,7 +11,11 @@ QT       += sql
 CONFIG   += console
 CONFIG   -= app_bundle
 
-SOURCES += main.cpp
+SOURCES += main.cpp \
+    GermlineExportWorker.cpp
+
+HEADERS += \
+    GermlineExportWorker.h
 
 include("../app_cli.pri")
 
@@ -7,7 +7,9 @@
 #include "Log.h"
 #include "Settings.h"
 #include "VcfFile.h"
+#include "GermlineExportWorker.h"
 #include <QElapsedTimer>
+#include <QThreadPool>
 
 class ConcreteTool
 		: public ToolBase
@@ -37,7 +39,10 @@ public:
 		addString("chr", "Limit export to the given chromosome.", true, "");
 		addEnum("mode", "Determines the database which is exported.", true,
 				QStringList() << "germline" << "somatic", "germline");
+		addInt("threads", "Number of chromosomes that are exported in parallel (germline only). Each thread uses its own database connection.", true, 1);
+		addInt("window", "Size of the chromosomal windows for which variants and counts are queried at once (germline only).", true, 1000000);
 
+		changeLog(2026, 10, 18, "Germline counts are now queried per chromosomal window and chromosomes can be exported in parallel (parameters 'threads' and 'window').");
 		changeLog(2019, 12, 6, "Comments are now URL encoded.");
 		changeLog(2019, 9, 25, "Added somatic mode.");
 		changeLog(2019, 7, 29, "Added BED file for genes.");
@@ -54,6 +59,10 @@ public:
 		QTextStream out(stdout);
 		max_allel_frequency_ = getFloat("maxAF");
 		gene_offset_ = getInt("gene_offset");
+		threads_ = getInt("threads");
+		if (threads_<1) THROW(CommandLineParsingException, "Number of threads has to be positive!");
+		window_size_ = getInt("window");
+		if (window_size_<1) THROW(CommandLineParsingException, "Window size has to be positive!");
 		QString ref_file = getInfile("reference");
 		if (ref_file=="") ref_file = Settings::string("reference_genome");
 		if (ref_file=="") THROW(CommandLineParsingException,
@@ -99,6 +108,8 @@ private:
 	bool use_test_db_;
 	float max_allel_frequency_;
 	int gene_offset_;
+	int threads_;
+	int window_size_;
 	Chromosome limited_chr_;
 
 	/*
@@ -445,9 +456,7 @@ private:
 		QElapsedTimer timer;
 		timer.start();
 
-		QElapsedTimer ref_lookup;
 		qint64 ref_lookup_sum = 0;
-		QElapsedTimer count_computation;
 		qint64 count_computation_sum = 0;
 		qint64 create_header = 0;
 		QElapsedTimer db_queries;
@@ -501,14 +510,19 @@ private:
 			vcf_file_writing_sum += vcf_file_writing.elapsed();
 		}
 
+		// parameters shared by the export workers
+		GermlineExportParameters params;
+		params.use_test_db = use_test_db_;
+		params.reference_file = reference_file_path;
+		params.max_allele_frequency = max_allel_frequency_;
+		params.window_size = window_size_;
+
 		// get disease groups
 		db_queries.restart();
-		QStringList disease_groups = db.getEnum("sample", "disease_group");
+		params.disease_groups = db.getEnum("sample", "disease_group");
 		db_query_sum += db_queries.elapsed();
-		//disease_groups.removeAll("n/a");
 
 		//get same sample information
-		QHash<int, QList<int>> same_samples;
 		db_queries.restart();
 		SqlQuery query = db.getQuery();
 		query.exec("SELECT sample1_id, sample2_id FROM sample_relations WHERE relation='same sample'");
@@ -517,38 +531,22 @@ private:
 		{
 			int sample1_id = query.value(0).toInt();
 			int sample2_id = query.value(1).toInt();
-			same_samples[sample1_id] << sample2_id;
-			same_samples[sample2_id] << sample1_id;
+			params.same_samples[sample1_id] << sample2_id;
+			params.same_samples[sample2_id] << sample1_id;
 		}
 
-		// define query to get the NGSD counts for each variant
-		db_queries.restart();
-		SqlQuery ngsd_count_query = db.getQuery();
-		ngsd_count_query.prepare(QString() + "SELECT s.id, s.disease_status, s.disease_group, dv.genotype "
-								 + "FROM detected_variant dv, processed_sample ps, sample s "
-								 + "WHERE dv.variant_id=:0 AND ps.sample_id=s.id "
-								 + "AND dv.processed_sample_id=ps.id");
-		db_query_sum += db_queries.elapsed();
-
-		// define query to get the variant information by id
-		db_queries.restart();
-		SqlQuery variant_query = db.getQuery();
-		variant_query.prepare(QString() + "SELECT chr, start, end, ref, obs, 1000g, gnomad, comment "
-							  + "FROM variant WHERE id=:0");
-		db_query_sum += db_queries.elapsed();
-
 		// write info column descriptions
 		vcf_file_writing.restart();
 		vcf_stream << "##INFO=<ID=COUNTS,Number=2,Type=Integer,"
 				   << "Description=\"Homozygous/Heterozygous variant counts in NGSD.\">\n";
 
 		// create info column entry for all disease groups
-		for(int i = 0; i < disease_groups.size(); i++)
+		for(int i = 0; i < params.disease_groups.size(); i++)
 		{
 			vcf_stream << "##INFO=<ID=GSC" << QByteArray::number(i + 1).rightJustified(2, '0')
 					   << ",Number=2,Type=Integer,Description=\""
 					   << "Homozygous/Heterozygous variant counts in NGSD for "
-					   << disease_groups[i].toLower() << ".\">\n";
+					   << params.disease_groups[i].toLower() << ".\">\n";
 		}
 		vcf_stream << "##INFO=<ID=HAF,Number=0,Type=Flag,Description=\"Indicates a allele "
 				   << "frequency above a threshold of " << max_allel_frequency_ << ".\">\n";
@@ -561,247 +559,50 @@ private:
 
 		// write header line
 		vcf_stream << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+		vcf_stream.flush();
 		vcf_file_writing_sum += vcf_file_writing.elapsed();
 
 		out << "done" << endl;
 		create_header = timer.elapsed();
 
-		int variant_count = 0;
-
-		// iterate over database chromosome-wise
+		// export chromosomes in parallel (each worker writes to a temporary file and uses its own database connection)
+		out << "\texporting variants of " << chromosome_names.count() << " chromosomes using " << threads_ << " threads... " << endl;
+		QList<QSharedPointer<GermlineExportWorker>> workers;
+		QThreadPool pool;
+		pool.setMaxThreadCount(threads_);
 		foreach (QString chr_name, chromosome_names)
 		{
-			out << "\texporting variants from " << chr_name << "... " << endl;
-
-			// get all ids of all varaints on this chromosome
-			QString id_query_string = "SELECT id FROM variant WHERE chr='" + chr_name
-					+ "' ORDER BY start ASC, end ASC;";
-			db_queries.restart();
-			QStringList variant_ids = db.getValues(id_query_string);
-			db_query_sum += db_queries.elapsed();
+			QSharedPointer<GermlineExportWorker> worker(new GermlineExportWorker(chr_name, Helper::tempFileName(".vcf"), params));
+			workers << worker;
+			pool.start(worker.data());
+		}
+		pool.waitForDone();
 
-			int variant_count_per_chr = 0;
+		// concatenate the chromosomes in the order of the header
+		int variant_count = 0;
+		foreach (QSharedPointer<GermlineExportWorker> worker, workers)
+		{
+			if (!worker->error.isEmpty()) THROW(DatabaseException, "Exporting variants of " + worker->chr + " failed: " + worker->error);
 
-			// iterate over all variants
-			foreach (QString variant_id, variant_ids)
+			vcf_file_writing.restart();
+			QSharedPointer<QFile> tmp_file = Helper::openFileForReading(worker->tmp_file);
+			while (!tmp_file->atEnd())
 			{
-				Variant variant;
-				db_queries.restart();
-				variant_query.bindValue(0, variant_id);
-				variant_query.exec();
-				db_query_sum += db_queries.elapsed();
-
-				// parse query
-				if (variant_query.size() == 1)
-				{
-					variant_query.first();
-					variant.setChr(Chromosome(variant_query.value(0).toByteArray()));
-					variant.setStart(variant_query.value(1).toInt());
-					variant.setEnd(variant_query.value(2).toInt());
-					variant.setRef(variant_query.value(3).toByteArray());
-					variant.setObs(variant_query.value(4).toByteArray());
-					QByteArray one_thousand_g = variant_query.value(5).toByteArray();
-					QByteArray gnomad = variant_query.value(6).toByteArray();
-					QByteArray comment = variant_query.value(7).toByteArray();
-
-					// modify sequence if deletion or insertion occurs (to fit VCF specification)
-					if ((variant.ref() == "-") || (variant.obs() == "-"))
-					{
-						// benchmark
-						ref_lookup.restart();
-
-						//include base before (after) to the variant
-						QByteArray new_ref_seq, new_obs_seq;
-						if (variant.start() != 1)
-						{
-
-							// update position for deletion
-							if (variant.obs() == "-")
-							{
-								variant.setStart(variant.start() - 1);
-							}
-
-
-							// add base before ref and alt sequence
-							Sequence previous_base = reference_file.seq(variant.chr(),
-																		variant.start(), 1);
-							new_ref_seq = previous_base + variant.ref();
-							new_obs_seq = previous_base + variant.obs();
-						}
-						else
-						{
-							// add base after ref and alt sequence
-							Sequence next_base = reference_file.seq(variant.chr(),
-																	variant.start() + 1, 1);
-							new_ref_seq = variant.ref() + next_base;
-							new_obs_seq = variant.obs() + next_base;
-						}
-						new_ref_seq.replace("-", "");
-						new_obs_seq.replace("-", "");
-						variant.setRef(new_ref_seq);
-						variant.setObs(new_obs_seq);
-
-						// benchmark
-						ref_lookup_sum += ref_lookup.elapsed();
-					}
-					vcf_file_writing.restart();
-					vcf_stream << variant.chr().strNormalized(true) << "\t";
-					vcf_stream << variant.start() << "\t";
-					vcf_stream << variant_id << "\t";
-					vcf_stream << variant.ref() << "\t";
-					vcf_stream << variant.obs() << "\t";
-					vcf_stream << "." << "\t"; //quality
-					vcf_stream << "." << "\t"; //filter
-					vcf_file_writing_sum += vcf_file_writing.elapsed();
-
-					QByteArrayList info_column;
-
-					if((one_thousand_g.toDouble() <= max_allel_frequency_)
-					   && (gnomad.toDouble() <= max_allel_frequency_))
-					{
-
-						// benchmark
-						count_computation.restart();
-
-						// calculate NGSD counts for each variant
-						int count_het = 0;
-						int count_hom = 0;
-						//counts per group/status
-						QHash<QString, int> hom_per_group, het_per_group;
-						QSet<int> samples_done_het, samples_done_hom;
-						db_queries.restart();
-						ngsd_count_query.bindValue(0, variant_id);
-						ngsd_count_query.exec();
-						db_query_sum += db_queries.elapsed();
-						while(ngsd_count_query.next())
-						{
-							//use sample ID to prevent counting variants several times if a
-							//sample was sequenced more than once.
-							int sample_id = ngsd_count_query.value(0).toInt();
-
-							// count heterozygous variants
-							if (ngsd_count_query.value(3) == "het"
-								&& !samples_done_het.contains(sample_id))
-							{
-								++count_het;
-								samples_done_het << sample_id;
-
-								QList<int> tmp = same_samples.value(sample_id, QList<int>());
-								foreach(int same_sample_id, tmp)
-								{
-									samples_done_het << same_sample_id;
-								}
-
-								if (ngsd_count_query.value(1) == "Affected")
-								{
-									het_per_group[ngsd_count_query.value(2).toString()] += 1;
-								}
-							}
-
-							// count homozygous variants
-							if (ngsd_count_query.value(3) == "hom"
-								&& !samples_done_hom.contains(sample_id))
-							{
-								++count_hom;
-								samples_done_hom << sample_id;
-
-								QList<int> tmp = same_samples.value(sample_id, QList<int>());
-								foreach(int same_sample_id, tmp)
-								{
-									samples_done_hom << same_sample_id;
-								}
-
-								if (ngsd_count_query.value(1) == "Affected")
-								{
-									hom_per_group[ngsd_count_query.value(2).toString()] += 1;
-								}
-							}
-						}
-
-						// store counts in vcf
-						info_column.append("COUNTS=" + QByteArray::number(count_hom) + ","
-										   + QByteArray::number(count_het));
-
-
-						for(int i = 0; i < disease_groups.size(); i++)
-						{
-							if ((het_per_group.value(disease_groups[i], 0) > 0)
-								|| (hom_per_group.value(disease_groups[i], 0) > 0))
-							{
-								info_column.append("GSC"
-												   + QByteArray::number(i + 1).rightJustified(2, '0')
-												   + "="
-												   + QByteArray::number(hom_per_group
-																		.value(disease_groups[i], 0))
-												   + ","
-												   + QByteArray::number(het_per_group
-																		.value(disease_groups[i], 0)));
-							}
-						}
-
-						// benchmark
-						count_computation_sum += count_computation.elapsed();
-					}
-					else
-					{
-						// mark variants with high allele frequeny
-						info_column.append("HAF");
-					}
-
-					// get classification
-					db_queries.restart();
-					QString classification_query_string = QString() + "SELECT class, comment FROM "
-							+ "variant_classification WHERE variant_id='" + variant_id + "'";
-					query.exec(classification_query_string);
-					db_query_sum += db_queries.elapsed();
-					if (query.size() > 0)
-					{
-						query.first();
-						QByteArray classification = query.value(0).toByteArray().trimmed().replace("n/a", "");
-						QByteArray clas_comment = VcfFile::encodeInfoValue(query.value(1).toByteArray()).toUtf8();
-						if (classification != "") info_column.append("CLAS=" + classification);
-						if (clas_comment != "") info_column.append("CLAS_COM=\"" + clas_comment + "\"");
-					}
-
-					// get comment
-					if(comment != "")
-					{
-						info_column.append("COM=\"" + VcfFile::encodeInfoValue(comment).toUtf8() + "\"");
-					}
-
-					// concat all info entries
-					vcf_file_writing.restart();
-					if (info_column.size() > 0)
-					{
-						vcf_stream << info_column.join(";") << "\n";
-					}
-					else
-					{
-						vcf_stream << ".\n";
-					}
-					vcf_file_writing_sum += vcf_file_writing.elapsed();
-
-				}
-				else
-				{
-					THROW(DatabaseException, "Invalid number of database results found!")
-				}
-
-				variant_count_per_chr++;
-				if(variant_count_per_chr % 10000 == 0)
-				{
-					out << "\t\t\t" << variant_count_per_chr << " variants of " << chr_name
-						<< " exported. " << endl;
-				}
+				vcf_file->write(tmp_file->read(1048576));
 			}
+			tmp_file->close();
+			QFile::remove(worker->tmp_file);
+			vcf_file_writing_sum += vcf_file_writing.elapsed() + worker->vcf_file_writing_sum;
 
-			out << "\t...done\n\t\t" << variant_ids.size() << " variants exported.\n"
-				<< "\t\t(runtime: " << getTimeString(timer.elapsed()) << ")" << endl;
-			variant_count += variant_ids.size();
+			ref_lookup_sum += worker->ref_lookup_sum;
+			db_query_sum += worker->db_query_sum;
+			count_computation_sum += worker->count_computation_sum;
+
+			out << "\t\t" << worker->chr << ": " << worker->variant_count << " variants exported." << endl;
+			variant_count += worker->variant_count;
 		}
 
 		// close vcf file
-		vcf_stream.flush();
 		vcf_file->close();
 
 		out << " ...finished, " << variant_count << " variants exported.\n"
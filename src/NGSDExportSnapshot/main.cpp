@@ -0,0 +1,50 @@
+#include "ToolBase.h"
+#include "NGSD.h"
+#include "NGSDSnapshot.h"
+#include "Helper.h"
+
+class ConcreteTool
+		: public ToolBase
+{
+	Q_OBJECT
+
+public:
+	ConcreteTool(int& argc, char *argv[])
+		: ToolBase(argc, argv)
+	{
+	}
+
+	virtual void setup()
+	{
+		setDescription("Exports the NGSD data needed by gene/CNV annotation tools to a snapshot file, which can be used without database connection.");
+		setExtendedDescription(QStringList() << "The snapshot can be used with the 'snapshot' parameter of BedAnnotateGenes, CnvGeneAnnotation, BedpeGeneAnnotation and NGSDAnnotateCNV.");
+		addOutfile("out", "Output snapshot file.", false);
+
+		//optional
+		addFlag("test", "Uses the test database instead of on the production database.");
+
+		changeLog(2026, 10, 18, "Initial version.");
+	}
+
+	virtual void main()
+	{
+		//init
+		NGSD db(getFlag("test"));
+		QTextStream out(stdout);
+		QTime timer;
+		timer.start();
+
+		//export
+		NGSDSnapshot::create(db, getOutfile("out"));
+
+		out << "Snapshot (version " << NGSDSnapshot::VERSION << ") created (runtime: " << Helper::elapsedTime(timer) << ")" << endl;
+	}
+};
+
+#include "main.moc"
+
+int main(int argc, char *argv[])
+{
+	ConcreteTool tool(argc, argv);
+	return tool.execute();
+}
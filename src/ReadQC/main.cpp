@@ -1,6 +1,44 @@
 #include "ToolBase.h"
 #include "StatisticsReads.h"
 #include "Helper.h"
+#include <QThreadPool>
+#include <QRunnable>
+
+//Updates the statistics of one thread with a batch of reads.
+class UpdateWorker
+	: public QRunnable
+{
+public:
+	UpdateWorker(StatisticsReads& stats, QList<FastqEntry> entries, StatisticsReads::ReadDirection direction, QString& error)
+		: QRunnable()
+		, stats_(stats)
+		, entries_(entries)
+		, direction_(direction)
+		, error_(error)
+	{
+	}
+
+	void run() override
+	{
+		try
+		{
+			foreach(const FastqEntry& entry, entries_)
+			{
+				stats_.update(entry, direction_);
+			}
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
+		}
+	}
+
+protected:
+	StatisticsReads& stats_;
+	QList<FastqEntry> entries_;
+	StatisticsReads::ReadDirection direction_;
+	QString& error_;
+};
 
 class ConcreteTool
 		: public ToolBase
@@ -21,15 +59,63 @@ public:
 		//optional
 		addOutfile("out", "Output qcML file. If unset, writes to STDOUT.", true);
 		addFlag("txt", "Writes TXT format instead of qcML.");
+		addInt("threads", "Number of threads used to calculate the statistics.", true, 1);
 
+		changeLog(2026, 10, 18, "Added 'threads' parameter.");
 		changeLog(2016,  8, 19, "Added support for multiple input files.");
 	}
 
+	//Processes a FASTQ file. The reads are processed in batches by the threads (one statistics instance per thread), while the next batches are read. Returns the number of reads.
+	static long long process(QString filename, StatisticsReads::ReadDirection direction, QVector<StatisticsReads>& stats)
+	{
+		const int threads = stats.count();
+		const int batch_size = 10000;
+
+		QThreadPool pool;
+		pool.setMaxThreadCount(threads);
+		QVector<QString> errors(threads);
+		FastqEntry entry;
+		FastqFileStream stream(filename);
+		while(!stream.atEnd())
+		{
+			//read next batches (one per thread)
+			QVector<QList<FastqEntry>> batches(threads);
+			for (int t=0; t<threads && !stream.atEnd(); ++t)
+			{
+				while(batches[t].count()<batch_size && !stream.atEnd())
+				{
+					stream.readEntry(entry);
+					batches[t] << entry;
+				}
+			}
+
+			//wait until the previous batches are processed
+			pool.waitForDone();
+			foreach(const QString& error, errors)
+			{
+				if (!error.isEmpty()) THROW(Exception, error);
+			}
+
+			//process batches
+			for (int t=0; t<threads; ++t)
+			{
+				if (batches[t].isEmpty()) continue;
+				pool.start(new UpdateWorker(stats[t], batches[t], direction, errors[t]));
+			}
+		}
+		pool.waitForDone();
+		foreach(const QString& error, errors)
+		{
+			if (!error.isEmpty()) THROW(Exception, error);
+		}
+
+		return stream.index();
+	}
+
 	virtual void main()
 	{
 		//init
-		StatisticsReads stats;
-		FastqEntry entry;
+		QVector<StatisticsReads> stats(std::max(1, getInt("threads")));
 		QStringList infiles;
 		QStringList in1 = getInfileList("in1");
 		QStringList in2 = getInfileList("in2");
@@ -42,26 +128,16 @@ public:
 		for (int i=0; i<in1.count(); ++i)
 		{
 			//forward
-			FastqFileStream stream(in1[i]);
-			while(!stream.atEnd())
-			{
-				stream.readEntry(entry);
-				stats.update(entry, StatisticsReads::FORWARD);
-			}
+			long long reads1 = process(in1[i], StatisticsReads::FORWARD, stats);
 			infiles << in1[i];
 
 			//reverse (optional)
 			if (i<in2.count())
 			{
-				FastqFileStream stream2(in2[i]);
-				while(!stream2.atEnd())
-				{
-					 stream2.readEntry(entry);
-					 stats.update(entry, StatisticsReads::REVERSE);
-				}
+				long long reads2 = process(in2[i], StatisticsReads::REVERSE, stats);
 
 				//check read counts matches
-				if (stream.index()!=stream2.index())
+				if (reads1!=reads2)
 				{
 					THROW(ArgumentException, "Differing number of reads in file '" + in1[i] + "' and '" + in2[i] + "'!");
 				}
@@ -70,8 +146,14 @@ public:
 			}
 		}
 
+		//merge statistics of threads
+		for (int t=1; t<stats.count(); ++t)
+		{
+			stats[0].merge(stats[t]);
+		}
+
 		//store output
-		QCCollection metrics = stats.getResult();
+		QCCollection metrics = stats[0].getResult();
 		if (getFlag("txt"))
 		{
 			QStringList output;
@@ -274,9 +274,11 @@ public:
 				af = std::max(af, af_new);
 			}
 
+			VariantAnnotationIndex csq;
+			if (i_csq!=-1) csq = v.annotationIndex(i_csq, '|', false);
 			foreach(int index, csq_af_indices)
 			{
-				QByteArrayList annos = v.vepAnnotations(i_csq, index);
+				QByteArrayList annos = csq.fields(index);
 				foreach(const QByteArray& anno, annos)
 				{
 					float af_new = anno.toFloat();
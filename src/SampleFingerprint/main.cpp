@@ -0,0 +1,71 @@
+#include "SampleFingerprint.h"
+#include "ToolBase.h"
+#include "Helper.h"
+#include <QFileInfo>
+
+class ConcreteTool
+		: public ToolBase
+{
+	Q_OBJECT
+
+public:
+	ConcreteTool(int& argc, char *argv[])
+		: ToolBase(argc, argv)
+	{
+	}
+
+	virtual void setup()
+	{
+		setDescription("Creates genotype fingerprints of samples for fast sample identity checks.");
+		setExtendedDescription(QStringList() << "The fingerprint contains the genotypes of a fixed panel of common autosomal SNPs. The fingerprint file of a single sample can be stored next to the sample. Several fingerprints can be collected in one file that serves as fingerprint database (see 'append')."
+											 << "Fingerprints are compared with SampleFingerprintCompare.");
+		addInfileList("in", "Input BAM or variant list files (VCF/GSvar). If only one TXT file is given, each line in this file is interpreted as an input file path.", false, true);
+		addOutfile("out", "Output fingerprint file.", false);
+		//optional
+		addEnum("mode", "Mode (input format).", true, QStringList() << "bam" << "vcf", "bam");
+		addEnum("build", "Genome build used to generate the input.", true, QStringList() << "hg19" << "hg38", "hg19");
+		addInt("min_cov", "Minimum coverage to determine the genotype of a SNP (BAM mode).", true, 20);
+		addFlag("append", "Appends the fingerprints to the output file if it exists, e.g. to add them to a fingerprint database.");
+
+		changeLog(2026, 10, 18, "Initial version.");
+	}
+
+	virtual void main()
+	{
+		//init
+		QStringList in = getInfileList("in");
+		if (in.count()==1 && in[0].endsWith(".txt", Qt::CaseInsensitive))
+		{
+			in = Helper::loadTextFile(in[0], true, '#', true);
+		}
+		QString mode = getEnum("mode");
+		QString build = getEnum("build");
+		int min_cov = getInt("min_cov");
+
+		//create fingerprints
+		QList<SampleFingerprint> fingerprints;
+		foreach(QString filename, in)
+		{
+			QString name = QFileInfo(filename).baseName();
+			if (mode=="bam")
+			{
+				fingerprints << SampleFingerprint::fromBam(build, filename, min_cov, name);
+			}
+			else
+			{
+				fingerprints << SampleFingerprint::fromVcf(build, filename, name);
+			}
+		}
+
+		//store
+		SampleFingerprint::store(fingerprints, getOutfile("out"), getFlag("append"));
+	}
+};
+
+#include "main.moc"
+
+int main(int argc, char *argv[])
+{
+	ConcreteTool tool(argc, argv);
+	return tool.execute();
+}
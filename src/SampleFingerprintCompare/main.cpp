@@ -0,0 +1,98 @@
+#include "SampleFingerprint.h"
+#include "ToolBase.h"
+#include "Helper.h"
+#include <QTextStream>
+
+class ConcreteTool
+		: public ToolBase
+{
+	Q_OBJECT
+
+public:
+	ConcreteTool(int& argc, char *argv[])
+		: ToolBase(argc, argv)
+	{
+	}
+
+	virtual void setup()
+	{
+		setDescription("Compares genotype fingerprints of samples with a fingerprint database.");
+		setExtendedDescription(QStringList() << "Fingerprints are created with SampleFingerprint."
+											 << "The database is processed in blocks, so databases with many thousand samples can be scanned with little memory.");
+		addInfile("in", "Input fingerprint file with one or several samples.", false);
+		addInfileList("db", "Fingerprint database file(s).", false);
+		//optional
+		addOutfile("out", "Output TSV file. If unset, writes to STDOUT.", true);
+		addInt("min_overlap", "Minimum number of SNPs with known genotype in both samples. Sample pairs with less overlap are not reported.", true, 100);
+		addFloat("min_correlation", "Minimum genotype correlation of reported sample pairs.", true, -1.0);
+		addInt("threads", "Number of threads used for the comparison.", true, 1);
+
+		changeLog(2026, 10, 18, "Initial version.");
+	}
+
+	virtual void main()
+	{
+		//init
+		QList<SampleFingerprint> queries = SampleFingerprint::load(getInfile("in"));
+		if (queries.isEmpty()) THROW(ArgumentException, "Input fingerprint file contains no samples!");
+		QString build = queries[0].build();
+		int min_overlap = getInt("min_overlap");
+		double min_correlation = getFloat("min_correlation");
+		int threads = getInt("threads");
+		QSharedPointer<QFile> outfile = Helper::openFileForWriting(getOutfile("out"), true);
+		QTextStream out(outfile.data());
+		out << "#sample1\tsample2\toverlap\tcorrelation\tibs0_percent\tibs2_percent\tcomments" << endl;
+
+		//compare with database (in blocks)
+		const int block_size = 10000;
+		foreach(QString db_file, getInfileList("db"))
+		{
+			SampleFingerprintReader reader(db_file);
+			if (reader.build()!=build) THROW(ArgumentException, "Fingerprint database '" + db_file + "' has genome build " + reader.build() + ", but the input has genome build " + build + "!");
+
+			bool at_end = false;
+			while (!at_end)
+			{
+				//load block
+				QList<SampleFingerprint> block;
+				SampleFingerprint fp;
+				while (block.count()<block_size && !at_end)
+				{
+					at_end = !reader.read(fp);
+					if (!at_end) block << fp;
+				}
+				if (block.isEmpty()) break;
+
+				//compare (the queries are appended to the block)
+				SampleSimilarity::GenotypeMatrix matrix = SampleFingerprint::genotypeMatrix(block + queries);
+				for (int q=0; q<queries.count(); ++q)
+				{
+					QList<SampleSimilarity> results = SampleSimilarity::calculateSimilarity(matrix, block.count() + q, 0, block.count(), threads);
+					for (int i=0; i<block.count(); ++i)
+					{
+						SampleSimilarity& sc = results[i];
+						if (sc.olCount()<min_overlap || !(sc.sampleCorrelation()>=min_correlation)) continue;
+
+						QStringList cols;
+						cols << queries[q].name();
+						cols << block[i].name();
+						cols << QString::number(sc.olCount());
+						cols << QString::number(sc.sampleCorrelation(), 'f', 4);
+						cols << QString::number(sc.ibs0Perc(), 'f', 2);
+						cols << QString::number(sc.ibs2Perc(), 'f', 2);
+						cols << sc.messages().join(", ");
+						out << cols.join("\t") << endl;
+					}
+				}
+			}
+		}
+	}
+};
+
+#include "main.moc"
+
+int main(int argc, char *argv[])
+{
+	ConcreteTool tool(argc, argv);
+	return tool.execute();
+}
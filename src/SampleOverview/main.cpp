@@ -15,11 +15,14 @@ public:
 	virtual void setup()
 	{
 		setDescription("Creates a variant overview table from several samples.");
-		addInfileList("in", "Input variant lists in GSvar format.", false);
+		addInfileList("in", "Input variant lists in GSvar format. The variants of each chromosome have to be consecutive and sorted by start position.", false);
 		addOutfile("out", "Output variant list file in GSvar format.", false);
 		//optional
 		addInt("window", "Window to consider around indel positions to compensate for differing alignments.", true, 100);
 		addString("add_cols", "Comma-separated list of input columns that shall be added to the output. By default, all columns that are present in all input files.", true, "[auto]");
+
+		//changelog
+		changeLog(2026,10,18,"Input files are streamed instead of loaded into memory. Duplicate variants are annotated using the first input file that contains them.");
 	}
 
 	virtual void main()
@@ -33,8 +33,10 @@ public:
 		addInt("min_cov",  "Minimum coverage to consider a SNP for the analysis (BAM mode).",  true,  30);
 		addInt("max_snps",  "The maximum number of high-coverage SNPs to extract from BAM. 0 means unlimited (BAM mode).",  true, 2000);
 		addEnum("build", "Genome build used to generate the input (BAM mode).", true, QStringList() << "hg19" << "hg38", "hg19");
+		addInt("threads", "Number of threads used for the pairwise comparison (VCF mode).", true, 1);
 
 		//changelog
+		changeLog(2026, 10, 18, "VCF mode: all-vs-all comparison based on a compact genotype matrix, which can be processed with several threads (parameter 'threads').");
 		changeLog(2019,  2,  8, "Massive speed-up by caching of variants/genotypes instead of loading them again for each comparison.");
 		changeLog(2018, 11, 26, "Add flag 'skip_multi' to ignore multi-allelic sites.");
 		changeLog(2018,  7, 11, "Added build switch for hg38 support.");
@@ -60,6 +62,7 @@ public:
 		bool include_gonosomes = getFlag("include_gonosomes");
 		QString build = getEnum("build");
 		bool skip_multi = getFlag("skip_multi");
+		int threads = getInt("threads");
 
 		//write header
 		if (mode=="vcf")
@@ -93,35 +96,51 @@ public:
 		}
 
 		//process
-		for (int i=0; i<in.count(); ++i)
+		if (mode=="vcf")
 		{
-			for (int j=i+1; j<in.count(); ++j)
+			//compare all pairs based on the genotype matrix of the cohort
+			SampleSimilarity::GenotypeMatrix matrix = SampleSimilarity::genotypeMatrix(genotype_data);
+			genotype_data.clear();
+			QList<SampleSimilarity> results = SampleSimilarity::calculateSimilarityAll(matrix, threads);
+
+			int r = 0;
+			for (int i=0; i<in.count(); ++i)
 			{
-				SampleSimilarity sc;
-				QStringList cols;
-				cols << QFileInfo(in[i]).fileName();
-				cols << QFileInfo(in[j]).fileName();
-				if (mode=="vcf")
+				for (int j=i+1; j<in.count(); ++j)
 				{
-					sc.calculateSimilarity(genotype_data[i], genotype_data[j]);
-
+					SampleSimilarity& sc = results[r++];
+					QStringList cols;
+					cols << QFileInfo(in[i]).fileName();
+					cols << QFileInfo(in[j]).fileName();
 					cols << QString::number(sc.olPerc(), 'f', 2);
 					cols << QString::number(sc.sampleCorrelation(), 'f', 4);
 					cols << QString::number(sc.ibs2Perc(), 'f', 2);
 					cols << QString::number(sc.noVariants1());
 					cols << QString::number(sc.noVariants2());
+					cols << sc.messages().join(", ");
+					out << cols.join("\t") << endl;
 				}
-				else
+			}
+		}
+		else
+		{
+			for (int i=0; i<in.count(); ++i)
+			{
+				for (int j=i+1; j<in.count(); ++j)
 				{
+					SampleSimilarity sc;
 					sc.calculateSimilarity(genotype_data[i], genotype_data[j]);
 
+					QStringList cols;
+					cols << QFileInfo(in[i]).fileName();
+					cols << QFileInfo(in[j]).fileName();
 					cols << QString::number(sc.olCount());
 					cols << QString::number(sc.sampleCorrelation(), 'f', 4);
 					cols << QString::number(sc.ibs0Perc(), 'f', 2);
 					cols << QString::number(sc.ibs2Perc(), 'f', 2);
+					cols << sc.messages().join(", ");
+					out << cols.join("\t") << endl;
 				}
-				cols << sc.messages().join(", ");
-				out << cols.join("\t") << endl;
 			}
 		}
 	}
@@ -120,10 +120,8 @@ void AnalysisWorker::run()
 	//update raw data statistics (before trimming)
 	if (!params_.qc.isEmpty())
 	{
-		stats_.qc_mutex.lock();
-		stats_.qc.update(job_.e1, StatisticsReads::FORWARD);
-		stats_.qc.update(job_.e2, StatisticsReads::REVERSE);
-		stats_.qc_mutex.unlock();
+		job_.qc.update(job_.e1, StatisticsReads::FORWARD);
+		job_.qc.update(job_.e2, StatisticsReads::REVERSE);
 	}
 
 	//step 1: trim by insert match
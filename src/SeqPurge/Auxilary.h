@@ -33,6 +33,7 @@ struct AnalysisJob
 	int reads_trimmed_adapter = 0;
 	int reads_trimmed_q = 0;
 	int reads_trimmed_n = 0;
+	StatisticsReads qc; //read QC of all reads analyzed in this job slot (not cleared, merged at the end)
 
 	void clear()
 	{
@@ -103,7 +104,6 @@ struct TrimmingStatistics
 	double reads_removed;
 	double bases_perc_trim_sum;
 	StatisticsReads qc;
-	QMutex qc_mutex;
 
 	void writeStatistics(QTextStream& out, const TrimmingParameters& params_)
 	{
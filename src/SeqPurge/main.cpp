@@ -208,6 +208,10 @@ public:
 		//write qc output file
 		if (!params_.qc.isEmpty())
 		{
+			foreach(const AnalysisJob& job, job_pool)
+			{
+				stats_.qc.merge(job.qc);
+			}
 			stats_.qc.getResult().storeToQCML(getOutfile("qc"), QStringList() << in1_files << in2_files, "");
 		}
 
@@ -79,8 +79,10 @@ public:
 		addFlag("skip_plots", "Skip plots (intended to increase speed of automated tests).");
 		setExtendedDescription(QStringList() << "SomaticQC integrates the output of the other QC tools and adds several metrics specific for tumor-normal pairs." << "All tools produce qcML, a generic XML format for QC of -omics experiments, which we adapted for NGS.");
 		addEnum("build", "Genome build used to generate the input.", true, QStringList() << "hg19" << "hg38", "hg19");
+		addInt("threads", "Number of threads used to determine the tumor/normal allele frequencies of somatic variants.", true, 1);
 
 		//changelog
+		changeLog(2026, 10, 18, "Tumor/normal allele frequencies are determined in one sweep through the BAM files per chromosome. Added 'threads' parameter.");
 		changeLog(2018,  7, 11, "Added build switch for hg38 support.");
 		changeLog(2017,  7, 28, "Added somatic allele frequency histogram and tumor estimate.");
 		changeLog(2017,  1, 16, "Increased speed for mutation profile, removed genome build switch.");
@@ -104,6 +106,7 @@ public:
 		QStringList links = getInfileList("links");
 		bool skip_plots = getFlag("skip_plots");
 		QString build = getEnum("build");
+		int threads = getInt("threads");
 
 		// metadata
 		QList<QList<QString>> metadata;
@@ -137,7 +140,7 @@ public:
 		}
 
 		QCCollection metrics;
-		metrics = Statistics::somatic(build, tumor_bam, normal_bam, somatic_vcf, ref, target_bed_file, skip_plots);
+		metrics = Statistics::somatic(build, tumor_bam, normal_bam, somatic_vcf, ref, target_bed_file, skip_plots, threads);
 		QCValue tmb = Statistics::mutationBurden(somatic_vcf, target_exons, target_bed, tsg_bed, blacklist);
 		metrics.insert(tmb);
 
@@ -20,6 +20,10 @@ public:
 		//optional
 		addFlag("qual", "Also sort according to variant quality. Ignored if 'fai' file is given.");
 		addInfile("fai", "FAI file defining different chromosome order.", true, true);
+		addInt("external", "If set, sorts the input on disk in runs of the given number of variants (for files that do not fit into memory). Variant lines are written unchanged in this mode. Not supported for gzipped input.", true, 0);
+		addInt("threads", "Number of threads used for sorting runs (only used with 'external').", true, 1);
+
+		changeLog(2026, 10, 18, "Added 'external' and 'threads' parameters for sorting large files on disk.");
 	}
 
 	virtual void main()
@@ -27,8 +31,16 @@ public:
 		//init
 		QString fai = getInfile("fai");
 		bool qual = getFlag("qual");
+		int external = getInt("external");
+
+		//sort on disk
+		if (external>0)
+		{
+			VariantList::sortFile(getInfile("in"), getOutfile("out"), external, qual && fai=="", fai, getInt("threads"));
+			return;
+		}
 
-		//sort
+		//sort in memory
 		VariantList vl;
 		vl.load(getInfile("in"));
 		if (fai=="")
@@ -8,6 +8,9 @@
 #include <QFile>
 #include <QTextStream>
 #include <QList>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 class ConcreteTool
 		: public ToolBase
@@ -26,56 +29,137 @@ public:
 		//optional
 		addInfile("in", "Input VCF file. If unset, reads from STDIN.", true, true);
 		addOutfile("out", "Output VCF list. If unset, writes to STDOUT.", true, true);
-		addInt("n", "Number of variants to cache for sorting.", true, 10000);
+		addInt("n", "Number of variants to cache for sorting. The cache grows automatically if the input is less sorted than expected.", true, 10000);
 
+		changeLog(2026, 10, 18, "Faster reorder buffer. The cache size grows automatically if variants are far apart from their sorted position.");
 		changeLog(2019,  1,  8, "Added REF, ALT and INFO fields to sorting for a defined output order.");
 		changeLog(2016,  6, 27, "Initial implementation.");
 	}
 
-	//Datastructure for VCF lines
-	struct VcfCoords
+	//Buffered VCF line. The sort key fields are stored as offsets into the line to avoid copies.
+	struct VcfLine
 	{
+		QByteArray line;
 		int pos;
-		QByteArray ref;
-		QByteArray alt;
-		QByteArray info;
+		int ref_start;
+		int ref_len;
+		int alt_start;
+		int alt_len;
+		int info_start;
+		int info_len;
+		quint64 index; //input line index, used to keep the input order of identical keys
+	};
+
+	//Compares two sub-strings of lines (same order as for QByteArray).
+	static int compare(const VcfLine& a, int a_start, int a_len, const VcfLine& b, int b_start, int b_len)
+	{
+		int result = memcmp(a.line.constData() + a_start, b.line.constData() + b_start, std::min(a_len, b_len));
+		if (result!=0) return result;
+		return a_len - b_len;
+	}
 
-		bool operator<(const VcfCoords& rhs) const
+	//Returns if line a has to be written after line b (position first, REF/ALT/INFO strings only on ties).
+	static bool greater(const VcfLine& a, const VcfLine& b)
+	{
+		if (a.pos!=b.pos) return a.pos>b.pos;
+		int result = compare(a, a.ref_start, a.ref_len, b, b.ref_start, b.ref_len);
+		if (result!=0) return result>0;
+		result = compare(a, a.alt_start, a.alt_len, b, b.alt_start, b.alt_len);
+		if (result!=0) return result>0;
+		result = compare(a, a.info_start, a.info_len, b, b.info_start, b.info_len);
+		if (result!=0) return result>0;
+		return a.index>b.index;
+	}
+
+	//Reorder buffer: a binary min-heap of indices into a pool of line slots. Slots of written lines are re-used.
+	class ReorderBuffer
+	{
+	public:
+		int count() const
 		{
-			if (pos<rhs.pos) return true;
-			if (pos>rhs.pos) return false;
-			if (ref<rhs.ref) return true;
-			if (ref>rhs.ref) return false;
-			if (alt<rhs.alt) return true;
-			if (alt>rhs.alt) return false;
-			return info<rhs.info;
+			return heap_.size();
 		}
-	};
 
-	//Write all lines and clear datastructure.
-	static void flush(QMap<VcfCoords, QByteArray>& lines, QSharedPointer<QFile>& out_p)
-	{
-		auto it = lines.begin();
-		while (it!=lines.end())
+		//Returns a free slot for the next line.
+		VcfLine& nextSlot()
+		{
+			if (slot_==-1)
+			{
+				if (free_.empty())
+				{
+					slot_ = pool_.size();
+					pool_.push_back(VcfLine());
+				}
+				else
+				{
+					slot_ = free_.back();
+					free_.pop_back();
+				}
+			}
+			return pool_[slot_];
+		}
+
+		//Adds the line stored in the slot returned by nextSlot().
+		void push()
 		{
-			out_p->write(it.value());
-			++it;
+			heap_.push_back(slot_);
+			slot_ = -1;
+			std::push_heap(heap_.begin(), heap_.end(), SlotGreater{pool_});
 		}
 
-		lines.clear();
-	}
+		//Returns the first line.
+		const VcfLine& top() const
+		{
+			return pool_[heap_.front()];
+		}
+
+		//Removes the first line.
+		void pop()
+		{
+			std::pop_heap(heap_.begin(), heap_.end(), SlotGreater{pool_});
+			free_.push_back(heap_.back());
+			heap_.pop_back();
+		}
+
+		//Writes all lines.
+		void flush(QSharedPointer<QFile>& out_p)
+		{
+			while (!heap_.empty())
+			{
+				out_p->write(top().line);
+				pop();
+			}
+		}
+
+	protected:
+		std::vector<VcfLine> pool_;
+		std::vector<int> free_;
+		std::vector<int> heap_;
+		int slot_ = -1;
+
+		//Heap comparator for slot indices.
+		struct SlotGreater
+		{
+			const std::vector<VcfLine>& pool;
+
+			bool operator()(int a, int b) const
+			{
+				return greater(pool[a], pool[b]);
+			}
+		};
+	};
 
 	virtual void main()
 	{
-		QTextStream todo(stdout);
-
 		//init
-		QMap<VcfCoords, QByteArray> lines;
+		ReorderBuffer lines;
 		int n = getInt("n");
+		if (n<1) THROW(ArgumentException, "Parameter 'n' must be at least 1!");
 
 		QByteArray last_chr;
 		int last_pos_written = -1;
 		QSet<QByteArray> chr_done;
+		quint64 index = 0;
 
 		//open input/output streams
 		QString in = getInfile("in");
@@ -89,7 +173,9 @@ public:
 
 		while(!in_p->atEnd())
 		{
-			QByteArray line = in_p->readLine();
+			VcfLine& entry = lines.nextSlot();
+			QByteArray& line = entry.line;
+			line = in_p->readLine();
 			if (!line.endsWith('\n')) line += '\n';
 
 			//skip empty lines
@@ -102,20 +188,33 @@ public:
 				continue;
 			}
 
-			QByteArrayList parts = line.split('\t');
-			if (parts.count()<VcfFile::MIN_COLS)
+			//determine column offsets (CHROM, POS, ID, REF, ALT, QUAL, FILTER, INFO)
+			int starts[VcfFile::MIN_COLS];
+			int ends[VcfFile::MIN_COLS];
+			int cols = 0;
+			int col_start = 0;
+			while (cols<VcfFile::MIN_COLS)
+			{
+				int tab = line.indexOf('\t', col_start);
+				starts[cols] = col_start;
+				ends[cols] = tab==-1 ? line.size() : tab;
+				++cols;
+				if (tab==-1) break;
+				col_start = tab + 1;
+			}
+			if (cols<VcfFile::MIN_COLS)
 			{
 				THROW(FileParseException, "VCF line with less than 8 fields found: '" + line.trimmed() + "'");
 			}
 
-			QByteArray chr = parts[0];
-			int pos = Helper::toInt(parts[1], "chromosomal position");
+			QByteArray chr = line.left(ends[0]);
+			int pos = Helper::toInt(line.mid(starts[1], ends[1]-starts[1]), "chromosomal position");
 
 			//handle new chromosome
 			if (chr!=last_chr)
 			{
-				//flush lines
-				flush(lines, out_p);
+				//flush lines (the current line is not in the buffer yet)
+				lines.flush(out_p);
 
 				//reset pos
 				last_pos_written = -1;
@@ -139,21 +238,34 @@ public:
 				THROW(FileParseException, "Variants in input could not be sorted with given 'n' parameter! Positions " + QString::number(pos) + " and " + QString::number(last_pos_written) + " are too far apart on chromosome '" + chr + "'!");
 			}
 
+			//grow window if the line barely made it, i.e. it is placed before all buffered lines of a full buffer
+			if (lines.count()>=n && pos<lines.top().pos)
+			{
+				n *= 2;
+			}
+
 			//insert line
-			lines.insertMulti(VcfCoords{pos, parts[3], parts[4], parts[7]}, line);
+			entry.pos = pos;
+			entry.ref_start = starts[3];
+			entry.ref_len = ends[3] - starts[3];
+			entry.alt_start = starts[4];
+			entry.alt_len = ends[4] - starts[4];
+			entry.info_start = starts[7];
+			entry.info_len = ends[7] - starts[7];
+			entry.index = index++;
+			lines.push();
 
 			//write overflow lines
 			if (lines.count()>n)
 			{
-				auto it = lines.begin();
-				out_p->write(it.value());
-				last_pos_written = it.key().pos;
-				lines.erase(it);
+				out_p->write(lines.top().line);
+				last_pos_written = lines.top().pos;
+				lines.pop();
 			}
 		}
 
 		//flush lines
-		flush(lines, out_p);
+		lines.flush(out_p);
     }
 };
 
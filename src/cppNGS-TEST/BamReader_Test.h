@@ -238,6 +238,26 @@ private slots:
 		I_EQUAL(countSequencesContaining(pileup.indels(), '-'), 14);
 	}
 
+	void BamReader_getPileups()
+	{
+		BamReader reader(TESTDATA("data_in/panel.bam"));
+
+		//positions are not sorted
+		QVector<Pileup> pileups = reader.getPileups("chr1", QVector<int>() << 12062205 << 12062181 << 12062180 << 12062205);
+		I_EQUAL(pileups.count(), 4);
+		I_EQUAL(pileups[0].depth(false), 117);
+		F_EQUAL2(pileups[0].frequency('A', 'G'), 0.4102, 0.001);
+		I_EQUAL(pileups[1].depth(false), 167);
+		F_EQUAL2(pileups[1].frequency('A', 'G'), 0.0, 0.001);
+		I_EQUAL(pileups[2].depth(false), 167);
+		IS_TRUE(!BasicStatistics::isValidFloat(pileups[2].frequency('A', 'T')));
+		I_EQUAL(pileups[3].depth(false), 117);
+
+		//no positions
+		pileups = reader.getPileups("chr1", QVector<int>());
+		I_EQUAL(pileups.count(), 0);
+	}
+
 	//special test with RNA because it contains the CIGAR operations S and N
 	void BamReader_getPileup_RNA()
 	{
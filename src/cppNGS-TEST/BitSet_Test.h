@@ -0,0 +1,106 @@
+#include "TestFramework.h"
+#include "BitSet.h"
+
+TEST_CLASS(BitSet_Test)
+{
+Q_OBJECT
+private slots:
+
+	void count()
+	{
+		BitSet bits;
+		I_EQUAL(bits.count(), 0);
+		I_EQUAL(bits.count(true), 0);
+
+		bits = BitSet(130, true);
+		I_EQUAL(bits.count(), 130);
+		I_EQUAL(bits.count(true), 130);
+		I_EQUAL(bits.count(false), 0);
+
+		bits[0] = false;
+		bits[64] = false;
+		bits.clearBit(129);
+		I_EQUAL(bits.count(true), 127);
+		I_EQUAL(bits.count(false), 3);
+		IS_FALSE(bits[64]);
+		IS_TRUE(bits[65]);
+
+		bits.fill(false);
+		I_EQUAL(bits.count(true), 0);
+	}
+
+	void nextSetBit()
+	{
+		BitSet bits(200);
+		I_EQUAL(bits.nextSetBit(0), -1);
+
+		bits.setBit(3);
+		bits.setBit(63);
+		bits.setBit(64);
+		bits.setBit(199);
+		I_EQUAL(bits.nextSetBit(0), 3);
+		I_EQUAL(bits.nextSetBit(3), 3);
+		I_EQUAL(bits.nextSetBit(4), 63);
+		I_EQUAL(bits.nextSetBit(64), 64);
+		I_EQUAL(bits.nextSetBit(65), 199);
+		I_EQUAL(bits.nextSetBit(200), -1);
+
+		QList<int> indices;
+		for (int i=bits.nextSetBit(0); i!=-1; i=bits.nextSetBit(i+1))
+		{
+			indices << i;
+		}
+		I_EQUAL(indices.count(), 4);
+		I_EQUAL(indices[3], 199);
+	}
+
+	void bulk_operations()
+	{
+		BitSet a(70);
+		a.setBit(1);
+		a.setBit(2);
+		a.setBit(69);
+		BitSet b(70);
+		b.setBit(2);
+		b.setBit(3);
+
+		BitSet c = a;
+		c &= b;
+		I_EQUAL(c.count(true), 1);
+		IS_TRUE(c[2]);
+
+		c = a;
+		c |= b;
+		I_EQUAL(c.count(true), 4);
+		IS_TRUE(c[3]);
+		IS_TRUE(c[69]);
+
+		c = a;
+		c.andNot(b);
+		I_EQUAL(c.count(true), 2);
+		IS_TRUE(c[1]);
+		IS_FALSE(c[2]);
+
+		c = ~a;
+		I_EQUAL(c.count(true), 67);
+		IS_FALSE(c[69]);
+		IS_TRUE(c[68]);
+		IS_TRUE(c==~~c);
+
+		IS_THROWN(ArgumentException, c &= BitSet(71));
+	}
+
+	void toBitArray()
+	{
+		BitSet bits(100);
+		bits.setBit(7);
+		bits.setBit(99);
+
+		QBitArray array = bits.toBitArray();
+		I_EQUAL(array.count(), 100);
+		I_EQUAL(array.count(true), 2);
+		IS_TRUE(array[99]);
+
+		IS_TRUE(BitSet::fromBitArray(array)==bits);
+	}
+};
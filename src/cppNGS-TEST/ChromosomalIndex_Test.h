@@ -2,6 +2,7 @@
 #include "ChromosomalIndex.h"
 #include "BedFile.h"
 #include "VariantList.h"
+#include "CnvList.h"
 #include "Log.h"
 
 TEST_CLASS(ChromosomalIndex_Test)
@@ -203,4 +204,151 @@ private slots:
 		index = var_index.matchingIndex("chr2", 500, 505);
 		I_EQUAL(index, -1);
 	}
+
+	void matchingIndices_longElements()
+	{
+		//a single very long element must not degrade the query to a linear scan nor hide short elements
+		BedFile bed_file;
+		bed_file.append(BedLine("chr1", 1, 10000000));
+		for (int p=1; p<=10000; ++p)
+		{
+			bed_file.append(BedLine("chr1", p*100, p*100 + 9));
+		}
+		bed_file.append(BedLine("chr1", 5000000, 5000000));
+		bed_file.append(BedLine("chr2", 1, 100));
+		bed_file.sort();
+		ChromosomalIndex<BedFile> bed_index(bed_file);
+
+		//only the long element
+		QVector<int> elements = bed_index.matchingIndices("chr1", 150, 160);
+		I_EQUAL(elements.count(), 1);
+		I_EQUAL(elements[0], 0);
+
+		//long element and one short element
+		elements = bed_index.matchingIndices("chr1", 505, 505);
+		I_EQUAL(elements.count(), 2);
+		I_EQUAL(bed_file[elements[0]].end(), 10000000);
+		I_EQUAL(bed_file[elements[1]].start(), 500);
+
+		//long element and single-base element after all short elements
+		elements = bed_index.matchingIndices("chr1", 4999999, 5000001);
+		I_EQUAL(elements.count(), 2);
+		I_EQUAL(bed_file[elements[1]].start(), 5000000);
+
+		//after long element
+		elements = bed_index.matchingIndices("chr1", 10000001, 20000000);
+		I_EQUAL(elements.count(), 0);
+
+		//first match is the long element
+		I_EQUAL(bed_index.matchingIndex("chr1", 999000, 999000), 0);
+
+		//other chromosome
+		elements = bed_index.matchingIndices("chr2", 50, 5000000);
+		I_EQUAL(elements.count(), 1);
+		X_EQUAL(bed_file[elements[0]].chr(), Chromosome("chr2"));
+	}
+
+	void matchingIndices_CnvList()
+	{
+		CnvList cnvs;
+		cnvs.append(CopyNumberVariant("chr1", 1000, 2000));
+		cnvs.append(CopyNumberVariant("chr1", 1500, 900000));
+		cnvs.append(CopyNumberVariant("chr1", 3000, 4000));
+		cnvs.append(CopyNumberVariant("chr3", 100, 200));
+		ChromosomalIndex<CnvList> cnv_index(cnvs);
+
+		QVector<int> elements = cnv_index.matchingIndices("chr1", 3500, 3500);
+		I_EQUAL(elements.count(), 2);
+		I_EQUAL(elements[0], 1);
+		I_EQUAL(elements[1], 2);
+
+		elements = cnv_index.matchingIndices("chr1", 1, 999);
+		I_EQUAL(elements.count(), 0);
+
+		elements = cnv_index.matchingIndices("chr2", 1, 999);
+		I_EQUAL(elements.count(), 0);
+
+		I_EQUAL(cnv_index.matchingIndex("chr3", 1, 100), 3);
+	}
+
+	void sweep_BedFile()
+	{
+		BedFile bed_file;
+		bed_file.append(BedLine("chr1", 1, 1000));
+		bed_file.append(BedLine("chr1", 10, 20));
+		bed_file.append(BedLine("chr1", 30, 40));
+		bed_file.append(BedLine("chr1", 35, 36));
+		bed_file.append(BedLine("chr2", 5, 10));
+		ChromosomalIndex<BedFile> bed_index(bed_file);
+		ChromosomalIndex<BedFile>::Sweep sweep(bed_index);
+
+		QVector<int> matches;
+		auto collect = [&matches](int index)
+		{
+			matches.append(index);
+			return true;
+		};
+
+		sweep.forEachMatch("chr1", 5, 35, collect);
+		I_EQUAL(matches.count(), 4);
+		I_EQUAL(matches[0], 0);
+		I_EQUAL(matches[3], 3);
+
+		//shorter query after longer query
+		matches.clear();
+		sweep.forEachMatch("chr1", 15, 15, collect);
+		I_EQUAL(matches.count(), 2);
+		I_EQUAL(matches[0], 0);
+		I_EQUAL(matches[1], 1);
+
+		matches.clear();
+		sweep.forEachMatch("chr1", 37, 100, collect);
+		I_EQUAL(matches.count(), 2);
+		I_EQUAL(matches[0], 0);
+		I_EQUAL(matches[1], 2);
+
+		IS_TRUE(sweep.hasMatch("chr1", 999, 2000));
+		IS_FALSE(sweep.hasMatch("chr1", 1001, 2000));
+		IS_FALSE(sweep.hasMatch("chrX", 1, 2000));
+		IS_TRUE(sweep.hasMatch("chr2", 1, 5));
+		IS_FALSE(sweep.hasMatch("chr2", 11, 20));
+
+		//unsorted query
+		IS_THROWN(ArgumentException, sweep.hasMatch("chr2", 1, 20));
+
+		//reset
+		sweep.reset();
+		IS_TRUE(sweep.hasMatch("chr2", 1, 20));
+	}
+
+	void forEachOverlap_VariantList()
+	{
+		BedFile bed_file;
+		bed_file.append(BedLine("chr1", 100, 200));
+		bed_file.append(BedLine("chr1", 150, 500));
+		bed_file.append(BedLine("chr2", 1, 10));
+		ChromosomalIndex<BedFile> bed_index(bed_file);
+
+		VariantList var_list;
+		var_list.append(Variant("chr1", 50, 50, "A", "G"));
+		var_list.append(Variant("chr1", 160, 160, "A", "G"));
+		var_list.append(Variant("chr1", 300, 300, "A", "G"));
+		var_list.append(Variant("chr2", 5, 5, "A", "G"));
+		var_list.append(Variant("chr3", 5, 5, "A", "G"));
+
+		QVector<QPair<int, int>> pairs;
+		bed_index.forEachOverlap(var_list, [&pairs](int q, int e)
+		{
+			pairs.append(QPair<int, int>(q, e));
+		});
+		I_EQUAL(pairs.count(), 4);
+		I_EQUAL(pairs[0].first, 1);
+		I_EQUAL(pairs[0].second, 0);
+		I_EQUAL(pairs[1].first, 1);
+		I_EQUAL(pairs[1].second, 1);
+		I_EQUAL(pairs[2].first, 2);
+		I_EQUAL(pairs[2].second, 1);
+		I_EQUAL(pairs[3].first, 3);
+		I_EQUAL(pairs[3].second, 2);
+	}
 };
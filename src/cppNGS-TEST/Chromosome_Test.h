@@ -1,5 +1,32 @@
 #include "TestFramework.h"
 #include "Chromosome.h"
+#include <QThreadPool>
+#include <QRunnable>
+#include <QVector>
+#include <QSet>
+
+//Creates non-standard chromosomes and stores their numeric representation.
+class ChromosomeNumWorker
+	: public QRunnable
+{
+public:
+	ChromosomeNumWorker(QVector<int>& nums)
+		: QRunnable()
+		, nums_(nums)
+	{
+	}
+
+	void run() override
+	{
+		for (int i=0; i<nums_.count(); ++i)
+		{
+			nums_[i] = Chromosome("chrThread_" + QByteArray::number(i)).num();
+		}
+	}
+
+protected:
+	QVector<int>& nums_;
+};
 
 TEST_CLASS(Chromosome_Test)
 {
@@ -58,6 +85,36 @@ private slots:
 		I_EQUAL(Chromosome("BLA2").num(),base+1);
 	}
 
+	void num_threads()
+	{
+		//the same chromosome has the same number in all threads
+		QList<QVector<int>> nums;
+		for (int t=0; t<4; ++t)
+		{
+			nums << QVector<int>(500, 0);
+		}
+		QThreadPool pool;
+		pool.setMaxThreadCount(4);
+		for (int t=0; t<nums.count(); ++t)
+		{
+			ChromosomeNumWorker* worker = new ChromosomeNumWorker(nums[t]);
+			pool.start(worker);
+		}
+		pool.waitForDone();
+
+		QSet<int> unique;
+		for (int i=0; i<nums[0].count(); ++i)
+		{
+			IS_TRUE(nums[0][i]>=1004);
+			for (int t=1; t<nums.count(); ++t)
+			{
+				I_EQUAL(nums[t][i], nums[0][i]);
+			}
+			unique << nums[0][i];
+		}
+		I_EQUAL(unique.count(), nums[0].count());
+	}
+
 	void isNonSpecial()
 	{
 		IS_TRUE(Chromosome("1").isNonSpecial());
@@ -30,6 +30,54 @@ private slots:
 		IS_TRUE(names.count()<count_all);
 	}
 
+	/********************************************* Filter result *********************************************/
+
+	void FilterResult_combine()
+	{
+		VariantList vl;
+		vl.load(TESTDATA("data_in/VariantFilter_in.GSvar"));
+
+		FilterResult result_af(vl.count());
+		FilterAlleleFrequency filter_af;
+		filter_af.setDouble("max_af", 1.0);
+		filter_af.apply(vl, result_af);
+		I_EQUAL(result_af.countPassing(), 22);
+
+		FilterResult result_snp(vl.count());
+		FilterVariantIsSNP filter_snp;
+		filter_snp.apply(vl, result_snp);
+
+		//intersection is the same as applying both filters
+		FilterResult result_both(vl.count());
+		filter_af.apply(vl, result_both);
+		filter_snp.apply(vl, result_both);
+		FilterResult result = result_af;
+		result.intersect(result_snp);
+		IS_TRUE(result.flags()==result_both.flags());
+
+		//union and difference
+		result = result_af;
+		result.unite(result_snp);
+		I_EQUAL(result.countPassing(), result_af.countPassing() + result_snp.countPassing() - result_both.countPassing());
+		result = result_af;
+		result.subtract(result_snp);
+		I_EQUAL(result.countPassing(), result_af.countPassing() - result_both.countPassing());
+
+		//iteration over passing variants
+		int count = 0;
+		for (int i=result_af.nextPassing(0); i!=-1; i=result_af.nextPassing(i+1))
+		{
+			IS_TRUE(result_af.passing(i));
+			++count;
+		}
+		I_EQUAL(count, 22);
+
+		//remove flagged
+		result_af.removeFlagged(vl);
+		I_EQUAL(vl.count(), 22);
+		I_EQUAL(result_af.countPassing(), 22);
+	}
+
 	/********************************************* Filters for small variants *********************************************/
 
 	void FilterAlleleFrequency_apply()
@@ -52,6 +52,44 @@ private slots:
 		S_EQUAL(set[2], "C");
 	}
 
+	void GeneSymbolTable_id()
+	{
+		int id = GeneSymbolTable::id("GENESET_TEST_GENE");
+		I_EQUAL(GeneSymbolTable::id("GENESET_TEST_GENE"), id);
+		I_EQUAL(GeneSymbolTable::find("GENESET_TEST_GENE"), id);
+		S_EQUAL(GeneSymbolTable::symbol(id), "GENESET_TEST_GENE");
+		IS_TRUE(GeneSymbolTable::count()>id);
+
+		I_EQUAL(GeneSymbolTable::find("GENESET_TEST_GENE_MISSING"), -1);
+	}
+
+	void GeneSymbolTable_intern()
+	{
+		int id = -1;
+		const QByteArray& symbol = GeneSymbolTable::intern("GENESET_TEST_GENE_INTERN", id);
+		S_EQUAL(symbol, "GENESET_TEST_GENE_INTERN");
+		I_EQUAL(GeneSymbolTable::find("GENESET_TEST_GENE_INTERN"), id);
+
+		int id2 = -1;
+		const QByteArray& symbol2 = GeneSymbolTable::intern("GENESET_TEST_GENE_INTERN", id2);
+		I_EQUAL(id2, id);
+		IS_TRUE(&symbol2==&symbol);
+	}
+
+	void operator_equal()
+	{
+		GeneSet set;
+		set << "B" << "A";
+		GeneSet set2;
+		set2 << "a" << "b";
+		IS_TRUE(set==set2);
+		IS_FALSE(set!=set2);
+
+		set2 << "C";
+		IS_FALSE(set==set2);
+		IS_TRUE(set!=set2);
+	}
+
 	void clear()
 	{
 		GeneSet set;
@@ -150,4 +150,13 @@ private slots:
 		S_EQUAL(NGSHelper::cytoBand("chrY", 34847524), "Yq12");
 		S_EQUAL(NGSHelper::cytoBand("chr1", 76992611), "1p31.1");
 	}
+
+	void createSampleOverview_unsorted()
+	{
+		//chromosome not consecutive
+		IS_THROWN(FileParseException, NGSHelper::createSampleOverview(QStringList() << TESTDATA("data_in/SampleOverview_unsorted1.tsv"), "out/SampleOverview_unsorted1.tsv", 100, true, QStringList()));
+
+		//positions not sorted
+		IS_THROWN(FileParseException, NGSHelper::createSampleOverview(QStringList() << TESTDATA("data_in/SampleOverview_unsorted2.tsv"), "out/SampleOverview_unsorted2.tsv", 100, true, QStringList()));
+	}
 };
@@ -0,0 +1,56 @@
+#include "TestFramework.h"
+#include "QCPlot.h"
+
+TEST_CLASS(QCPlot_Test)
+{
+Q_OBJECT
+private slots:
+
+	void color()
+	{
+		IS_TRUE(QCPlot::color("b")==QColor(Qt::blue));
+		IS_TRUE(QCPlot::color("k")==QColor(Qt::black));
+		IS_TRUE(QCPlot::color("#ff0000")==QColor(255, 0, 0));
+		IS_TRUE(QCPlot::color("invalid")==QColor(Qt::black));
+	}
+
+	void render()
+	{
+		QCPlot plot;
+		plot.setXLabel("depth");
+		plot.setYLabel("count");
+		plot.setXValues(QVector<double>() << 1 << 2 << 3);
+		plot.addLine(QVector<double>() << 5.0 << 7.0 << 6.0, "line");
+		plot.addVLine(2.0);
+
+		QImage image = plot.render(400, 300);
+		I_EQUAL(image.width(), 400);
+		I_EQUAL(image.height(), 300);
+
+		//white background and colored line pixels
+		IS_TRUE(image.pixel(0, 0)==qRgb(255, 255, 255));
+		int colored = 0;
+		for (int y=0; y<image.height(); ++y)
+		{
+			for (int x=0; x<image.width(); ++x)
+			{
+				QRgb pixel = image.pixel(x, y);
+				if (qRed(pixel)!=qGreen(pixel) || qGreen(pixel)!=qBlue(pixel)) ++colored;
+			}
+		}
+		IS_TRUE(colored>0);
+	}
+
+	void toPNG()
+	{
+		QCPlot plot;
+		plot.setBars(QList<double>() << 1.0 << 3.0, QStringList() << "A" << "B", QStringList() << "r" << "g");
+
+		QByteArray png = plot.toPNG();
+		IS_TRUE(png.startsWith("\x89PNG"));
+
+		QImage image = QImage::fromData(png, "PNG");
+		I_EQUAL(image.width(), 800);
+		I_EQUAL(image.height(), 600);
+	}
+};
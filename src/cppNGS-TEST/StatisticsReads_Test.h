@@ -51,4 +51,43 @@ private slots:
 			IS_TRUE(result[i].description()!="");
 		}
 	}
+
+	void merge()
+	{
+		//every second read is processed by a second instance
+		StatisticsReads stats;
+		StatisticsReads stats2;
+
+		FastqEntry e;
+		FastqFileStream stream(TESTDATA("data_in/example6.fastq.gz"), false);
+		while(!stream.atEnd())
+		{
+			stream.readEntry(e);
+			(stream.index()%2==0 ? stats : stats2).update(e, StatisticsReads::FORWARD);
+		}
+		FastqFileStream stream2(TESTDATA("data_in/example7.fastq.gz"), false);
+		while(!stream2.atEnd())
+		{
+			stream2.readEntry(e);
+			(stream2.index()%2==0 ? stats : stats2).update(e, StatisticsReads::REVERSE);
+		}
+		stats.merge(stats2);
+
+		QCCollection result = stats.getResult();
+		S_EQUAL(result[0].name(), QString("read count"));
+		S_EQUAL(result[0].toString(), QString("5000"));
+		S_EQUAL(result[1].name(), QString("read length"));
+		S_EQUAL(result[1].toString(), QString("151"));
+		S_EQUAL(result[2].name(), QString("bases sequenced (MB)"));
+		S_EQUAL(result[2].toString(), QString("0.76"));
+		S_EQUAL(result[3].name(), QString("Q20 read percentage"));
+		S_EQUAL(result[3].toString(), QString("99.40"));
+		S_EQUAL(result[4].name(), QString("Q30 base percentage"));
+		S_EQUAL(result[4].toString(), QString("96.30"));
+		S_EQUAL(result[5].name(), QString("no base call percentage"));
+		S_EQUAL(result[5].toString(), QString("0.00"));
+		S_EQUAL(result[6].name(), QString("gc content percentage"));
+		S_EQUAL(result[6].toString(), QString("46.26"));
+		I_EQUAL(result.count(), 9);
+	}
 };
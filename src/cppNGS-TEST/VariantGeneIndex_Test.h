@@ -0,0 +1,69 @@
+#include "TestFramework.h"
+#include "VariantGeneIndex.h"
+#include "VariantList.h"
+
+TEST_CLASS(VariantGeneIndex_Test)
+{
+Q_OBJECT
+private slots:
+
+	void index()
+	{
+		VariantList vl;
+		vl.annotations().append(VariantAnnotationHeader("gene"));
+		vl.append(Variant("chr1", 1000, 1000, "A", "C", QByteArrayList() << "BRCA1,brca2,BRCA1"));
+		vl.append(Variant("chr1", 2000, 2000, "A", "C", QByteArrayList() << ""));
+		vl.append(Variant("chr1", 3000, 3000, "A", "C", QByteArrayList() << "BRCA2, TP53"));
+
+		VariantGeneIndex index(vl, 0);
+		I_EQUAL(index.variantCount(), 3);
+		IS_TRUE(index.geneIdCount()>GeneSymbolTable::find("TP53"));
+
+		//variant => genes
+		I_EQUAL(index.genes(0).count(), 2);
+		I_EQUAL(index.genes(1).count(), 0);
+		I_EQUAL(index.genes(2).count(), 2);
+		QVector<int> ids = (GeneSet() << "BRCA2" << "TP53").ids(); //identifiers of GeneSymbolTable
+		I_EQUAL(index.genes(2).begin()[0], ids[0]);
+		I_EQUAL(index.genes(2).begin()[1], ids[1]);
+
+		//gene => variants
+		VariantGeneIndex::Range variants = index.variants(GeneSymbolTable::find("BRCA2"));
+		I_EQUAL(variants.count(), 2);
+		I_EQUAL(variants.begin()[0], 0);
+		I_EQUAL(variants.begin()[1], 2);
+		variants = index.variants(GeneSymbolTable::find("TP53"));
+		I_EQUAL(variants.count(), 1);
+		I_EQUAL(variants.begin()[0], 2);
+
+		//gene identifiers not contained in the index
+		I_EQUAL(index.variants(-1).count(), 0);
+		I_EQUAL(index.variants(index.geneIdCount()).count(), 0);
+	}
+
+	void VariantList_geneIndex()
+	{
+		VariantList vl;
+		vl.annotations().append(VariantAnnotationHeader("gene"));
+		vl.append(Variant("chr1", 1000, 1000, "A", "C", QByteArrayList() << "BRCA1"));
+		vl.append(Variant("chr1", 2000, 2000, "A", "C", QByteArrayList() << "BRCA2"));
+
+		//cached
+		QSharedPointer<const VariantGeneIndex> index = vl.geneIndex(0);
+		IS_TRUE(index->createdFrom(vl, 0));
+		IS_TRUE(vl.geneIndex(0)==index);
+
+		//re-created when genes change
+		vl[1].annotations()[0] = "TP53";
+		IS_FALSE(index->createdFrom(vl, 0));
+		index = vl.geneIndex(0);
+		I_EQUAL(index->variants(GeneSymbolTable::find("TP53")).count(), 1);
+		I_EQUAL(index->variants(GeneSymbolTable::find("BRCA2")).count(), 0);
+
+		//re-created when variants change
+		vl.append(Variant("chr1", 3000, 3000, "A", "C", QByteArrayList() << "BRCA2"));
+		index = vl.geneIndex(0);
+		I_EQUAL(index->variantCount(), 3);
+		I_EQUAL(index->variants(GeneSymbolTable::find("BRCA2")).count(), 1);
+	}
+};
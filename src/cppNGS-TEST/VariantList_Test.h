@@ -349,6 +349,21 @@ private slots:
 		I_EQUAL(vl.annotations().count(), 30);
 	}
 
+	void loadHeaderOnly()
+	{
+		VariantList vl;
+		vl.load(TESTDATA("data_in/panel_vep.GSvar"));
+		VariantList header;
+		header.loadHeaderOnly(TESTDATA("data_in/panel_vep.GSvar"));
+		I_EQUAL(header.count(), 0);
+		I_EQUAL(header.annotations().count(), vl.annotations().count());
+		S_EQUAL(header.annotations()[27].name(), QString("validation"));
+		I_EQUAL(header.annotationDescriptions().count(), vl.annotationDescriptions().count());
+		I_EQUAL(header.filters().count(), 2);
+		I_EQUAL(header.comments().count(), vl.comments().count());
+		S_EQUAL(header.getPipeline(), vl.getPipeline());
+	}
+
 	void test_backward_compatabilty_genotype_column()
 	{
 		//new format
@@ -847,4 +862,36 @@ private slots:
 		vl.load(TESTDATA("data_in/VariantFilter_in_multi.GSvar"));
 		S_EQUAL(vl.getPipeline(), "n/a");
 	}
+
+	void transcriptAnnotations()
+	{
+		VariantList vl;
+		vl.annotations().append(VariantAnnotationHeader("coding_and_splicing"));
+		vl.append(Variant("chr1", 120611964, 120611964, "G", "C", QList<QByteArray>() << "NOTCH2:ENST00000256646:missense_variant:MODERATE:exon1/34:c.57C>G:p.Cys19Trp:Pfam,NOTCH2:ENST00000369340:intron_variant:MODIFIER::c.5+1C>G::"));
+		vl.append(Variant("chr1", 120611965, 120611965, "G", "T", QList<QByteArray>() << ""));
+
+		QList<VariantTranscript> transcripts = vl.transcriptAnnotations(0, 0);
+		I_EQUAL(transcripts.count(), 2);
+		S_EQUAL(transcripts[0].impact, "MODERATE");
+		S_EQUAL(transcripts[1].id, "ENST00000369340");
+		I_EQUAL(vl.transcriptAnnotations(1, 0).count(), 0);
+
+		//cached annotation
+		transcripts = vl.transcriptAnnotations(0, 0);
+		I_EQUAL(transcripts.count(), 2);
+		S_EQUAL(transcripts[0].impact, "MODERATE");
+
+		//cache is updated when the annotation changes
+		vl[0].annotations()[0].replace("MODERATE", "HIGH");
+		transcripts = vl.transcriptAnnotations(0, 0);
+		I_EQUAL(transcripts.count(), 2);
+		S_EQUAL(transcripts[0].impact, "HIGH");
+
+		//cache is updated when the variants change
+		vl.clearVariants();
+		vl.append(Variant("chr1", 120611964, 120611964, "G", "C", QList<QByteArray>() << "NOTCH2:ENST00000256646:missense_variant:LOW:exon1/34:c.57C>G:p.Cys19Trp:Pfam"));
+		transcripts = vl.transcriptAnnotations(0, 0);
+		I_EQUAL(transcripts.count(), 1);
+		S_EQUAL(transcripts[0].impact, "LOW");
+	}
 };
@@ -374,6 +374,72 @@ private slots:
 		S_EQUAL(v.annotations()[0], "off-target;off-target2");
 	}
 
+	void transcriptAnnotations()
+	{
+		Variant v = Variant("chr1", 120611964, 120611964, "G", "C");
+		v.annotations().append("NOTCH2:ENST00000256646:missense_variant:MODERATE:exon1/34:c.57C>G:p.Cys19Trp:Pfam , NOTCH2:ENST00000369340:intron_variant:MODIFIER::c.5+1C>G::,");
+
+		QList<VariantTranscript> transcripts = v.transcriptAnnotations(0);
+		I_EQUAL(transcripts.count(), 2);
+		S_EQUAL(transcripts[0].gene, "NOTCH2");
+		S_EQUAL(transcripts[0].id, "ENST00000256646");
+		S_EQUAL(transcripts[0].type, "missense_variant");
+		S_EQUAL(transcripts[0].impact, "MODERATE");
+		S_EQUAL(transcripts[0].exon, "exon1/34");
+		S_EQUAL(transcripts[0].hgvs_c, "c.57C>G");
+		S_EQUAL(transcripts[0].hgvs_p, "p.Cys19Trp");
+		S_EQUAL(transcripts[0].domain, "Pfam");
+		S_EQUAL(transcripts[1].id, "ENST00000369340");
+		S_EQUAL(transcripts[1].exon, "");
+		S_EQUAL(transcripts[1].domain, "");
+
+		//changed annotation
+		v.annotations()[0].replace("MODERATE", "HIGH");
+		transcripts = v.transcriptAnnotations(0);
+		I_EQUAL(transcripts.count(), 2);
+		S_EQUAL(transcripts[0].impact, "HIGH");
+
+		v.setAnnotations(QByteArrayList() << "BRCA2:ENST00000380152:synonymous_variant:LOW:exon2/27:c.9C>T:p.=:");
+		transcripts = v.transcriptAnnotations(0);
+		I_EQUAL(transcripts.count(), 1);
+		S_EQUAL(transcripts[0].gene, "BRCA2");
+
+		//copies
+		Variant v2 = v;
+		v2.annotations()[0] = "";
+		I_EQUAL(v2.transcriptAnnotations(0).count(), 0);
+		I_EQUAL(v.transcriptAnnotations(0).count(), 1);
+
+		//invalid format
+		v.annotations()[0] = "BRCA2:ENST00000380152:synonymous_variant";
+		IS_THROWN(ProgrammingException, v.transcriptAnnotations(0));
+	}
+
+	void vepAnnotations()
+	{
+		Variant v = Variant("chr1", 120611964, 120611964, "G", "C");
+		v.annotations().append(" C|missense_variant|MODERATE|NOTCH2,C|intron_variant|MODIFIER|NOTCH2|ENST00000369340 ");
+
+		QByteArrayList values = v.vepAnnotations(0, 1);
+		I_EQUAL(values.count(), 2);
+		S_EQUAL(values[0], "missense_variant");
+		S_EQUAL(values[1], "intron_variant");
+
+		values = v.vepAnnotations(0, 4);
+		I_EQUAL(values.count(), 2);
+		S_EQUAL(values[0], "");
+		S_EQUAL(values[1], "ENST00000369340");
+
+		VariantAnnotationIndex csq = v.annotationIndex(0, '|', false);
+		I_EQUAL(csq.count(), 2);
+		I_EQUAL(csq.fieldCount(0), 4);
+		I_EQUAL(csq.fieldCount(1), 5);
+		S_EQUAL(csq.field(1, 2), "MODIFIER");
+		S_EQUAL(csq.entry(0), "C|missense_variant|MODERATE|NOTCH2");
+
+		v.annotations()[0] = "";
+		I_EQUAL(v.vepAnnotations(0, 1).count(), 0);
+	}
 
 	void fromString()
 	{
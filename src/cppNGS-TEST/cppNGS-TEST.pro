@@ -2,7 +2,7 @@
 CONFIG += c++11
 
 #base settings
-QT       -= gui
+QT       += gui
 CONFIG   += console
 CONFIG   -= app_bundle
 TEMPLATE = app
@@ -60,7 +60,10 @@ HEADERS += \
         BedpeLine_Test.h \
     CnvList_Test.h \
     StructuralVariantType_Test.h \
-    Transcript_Test.h
+    Transcript_Test.h \
+    BitSet_Test.h \
+    VariantGeneIndex_Test.h \
+    QCPlot_Test.h
 
 SOURCES += \
         main.cpp
@@ -4,6 +4,8 @@
 
 #include <QFile>
 #include <QFileInfo>
+#include <algorithm>
+#include <numeric>
 
 /*
 External documentation used for the implementation:
@@ -538,6 +540,78 @@ Pileup BamReader::getPileup(const Chromosome& chr, int pos, int indel_window, in
 	return output;
 }
 
+QVector<Pileup> BamReader::getPileups(const Chromosome& chr, const QVector<int>& positions, int min_mapq, bool anom, int min_baseq)
+{
+	//sort positions (the output is in the order of the input positions)
+	QVector<int> order(positions.count());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&positions](int a, int b){ return positions[a]<positions[b]; });
+	QVector<int> sorted(positions.count());
+	for (int i=0; i<order.count(); ++i)
+	{
+		sorted[i] = positions[order[i]];
+	}
+
+	//init
+	QVector<Pileup> pileups(sorted.count());
+	QVector<int> reads_mapped(sorted.count(), 0);
+	QVector<int> reads_mapq0(sorted.count(), 0);
+
+	//process clusters of positions (large gaps are skipped using the index)
+	const int max_gap = 1000000;
+	int cluster_start = 0;
+	while (cluster_start<sorted.count())
+	{
+		int cluster_end = cluster_start;
+		while (cluster_end+1<sorted.count() && sorted[cluster_end+1]-sorted[cluster_end]<=max_gap)
+		{
+			++cluster_end;
+		}
+
+		//iterate through all alignments of the cluster (sorted by start position)
+		setRegion(chr, sorted[cluster_start], sorted[cluster_end]);
+		int first = cluster_start; //first position not before the current alignment
+		BamAlignment al;
+		while (getNextAlignment(al))
+		{
+			if (!al.isProperPair() && anom==false) continue;
+			if (al.isSecondaryAlignment()) continue;
+			if (al.isDuplicate()) continue;
+			if (al.isUnmapped()) continue;
+
+			const int start = al.start();
+			const int end = al.end();
+			while (first<=cluster_end && sorted[first]<start) ++first;
+
+			bool mapq_ok = al.mappingQuality()>=min_mapq;
+			for (int i=first; i<=cluster_end && sorted[i]<=end; ++i)
+			{
+				reads_mapped[i] += 1;
+				if (al.mappingQuality()==0) reads_mapq0[i] += 1;
+
+				if (!mapq_ok) continue;
+
+				QPair<char, int> base = al.extractBaseByCIGAR(sorted[i]);
+				if (base.second>=min_baseq)
+				{
+					pileups[i].inc(base.first);
+				}
+			}
+		}
+
+		cluster_start = cluster_end + 1;
+	}
+
+	QVector<Pileup> output(positions.count());
+	for (int i=0; i<sorted.count(); ++i)
+	{
+		pileups[i].setMapq0Frac((double)reads_mapq0[i] / reads_mapped[i]);
+		output[order[i]] = pileups[i];
+	}
+
+	return output;
+}
+
 
 VariantDetails BamReader::getVariantDetails(const FastaFileIndex& reference, const Variant& variant)
 {
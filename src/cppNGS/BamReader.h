@@ -293,6 +293,8 @@ class CPPNGSSHARED_EXPORT BamReader
 		  @param indel_window The value controls how far up- and down-stream of the given postion, indels are considered to compensate for alignment differences. Indels are not reported when this parameter is set to -1.
 		*/
 		Pileup getPileup(const Chromosome& chr, int pos, int indel_window = -1, int min_mapq = 1, bool anom = false, int min_baseq = 13);
+		///Returns the pileups of several positions on one chromosome (same counts as getPileup without indels). The alignments are read in one sweep instead of one random access per position. The pileups are returned in the order of @p positions, which do not have to be sorted.
+		QVector<Pileup> getPileups(const Chromosome& chr, const QVector<int>& positions, int min_mapq = 1, bool anom = false, int min_baseq = 13);
 
 		//Returns the depth/frequency for a variant (start, ref, obs in TSV style). If the depth is 0, quiet_NaN is returned as frequency.
 		VariantDetails getVariantDetails(const FastaFileIndex& reference, const Variant& variant);
@@ -54,6 +54,36 @@ BedLine BedLine::fromString(QString str)
 	}
 }
 
+BedLine BedLine::fromBedLine(const QByteArray& line)
+{
+	//error when less than 3 fields
+	QByteArrayList fields = line.split('\t');
+	if (fields.count()<3)
+	{
+		THROW(FileParseException, "BED file line with less than three fields found: '" + line.trimmed() + "'");
+	}
+
+	//check that start/end is number
+	bool ok = true;
+	int start = fields[1].toInt(&ok) + 1;
+	if (!ok) THROW(FileParseException, "BED file line with invalid starts position found: '" + line.trimmed() + "'");
+	int end = fields[2].toInt(&ok);
+	if (!ok) THROW(FileParseException, "BED file line with invalid end position found: '" + line.trimmed() + "'");
+
+	return BedLine(fields[0], start, end, fields.mid(3));
+}
+
+QByteArray BedLine::toBedLine() const
+{
+	QByteArray output = chr_.str() + "\t" + QByteArray::number(start_-1) + "\t" + QByteArray::number(end_);
+	foreach(const QByteArray& anno, annotations_)
+	{
+		output += '\t';
+		output += anno;
+	}
+	return output;
+}
+
 BedFile::BedFile()
 {
 }
@@ -119,20 +149,7 @@ void BedFile::load(QString filename)
 			continue;
 		}
 
-		//error when less than 3 fields
-		QByteArrayList fields = line.split('\t');
-		if (fields.count()<3)
-		{
-			THROW(FileParseException, "BED file line with less than three fields found: '" + line.trimmed() + "'");
-		}
-
-		//check that start/end is number
-		bool ok = true;
-		int start = fields[1].toInt(&ok) + 1;
-		if (!ok) THROW(FileParseException, "BED file line with invalid starts position found: '" + line.trimmed() + "'");
-		int end = fields[2].toInt(&ok);
-		if (!ok) THROW(FileParseException, "BED file line with invalid end position found: '" + line.trimmed() + "'");
-		append(BedLine(fields[0], start, end, fields.mid(3)));
+		append(BedLine::fromBedLine(line));
 	}
 }
 
@@ -303,17 +320,44 @@ void BedFile::add(const BedFile& file2)
 
 void BedFile::subtract(const BedFile& file2)
 {
-	//check target region is merged/sorted and create index
+	//check target region is merged/sorted
 	if (!file2.isMergedAndSorted())
 	{
 		THROW(ArgumentException, "Merged and sorted BED file required for calculating the difference of BED files!");
 	}
-	ChromosomalIndex<BedFile> file2_idx(file2);
 
 	//remove annotations
 	clearAnnotations();
 
-	//subtract
+	//sorted input => linear sweep through both files
+	if (isSorted())
+	{
+		QVector<BedLine> output;
+		output.reserve(lines_.count());
+		int j = 0;
+		for (int i=0; i<lines_.count(); ++i)
+		{
+			const BedLine& line = lines_[i];
+			j = firstNotBefore(file2, j, line);
+
+			//add parts between overlapping regions of file2
+			int start = line.start();
+			for (int k=j; k<file2.count() && file2[k].chr()==line.chr() && file2[k].start()<=line.end(); ++k)
+			{
+				if (file2[k].start()>start) output.append(BedLine(line.chr(), start, file2[k].start()-1));
+				start = file2[k].end() + 1;
+			}
+			if (start<=line.end()) output.append(BedLine(line.chr(), start, line.end()));
+		}
+		lines_.swap(output);
+
+		//parts of nested lines can be out of order
+		if (!isSorted()) sort();
+		return;
+	}
+
+	//unsorted input
+	ChromosomalIndex<BedFile> file2_idx(file2);
 	int removed_lines = 0;
 	for (int i=0; i<lines_.count(); ++i)
 	{
@@ -359,17 +403,39 @@ void BedFile::subtract(const BedFile& file2)
 
 void BedFile::intersect(const BedFile& file2)
 {
-	//check target region is merged/sorted and create index
+	//check target region is merged/sorted
 	if (!file2.isMergedAndSorted())
 	{
 		THROW(ArgumentException, "Merged and sorted BED file required for for calculating the intersect of BED files!");
 	}
-	ChromosomalIndex<BedFile> file2_idx(file2);
 
 	//remove annotations and headers
 	clearAnnotations();
 
-	//intersect
+	//sorted input => linear sweep through both files
+	if (isSorted())
+	{
+		QVector<BedLine> output;
+		output.reserve(lines_.count());
+		int j = 0;
+		for (int i=0; i<lines_.count(); ++i)
+		{
+			const BedLine& line = lines_[i];
+			j = firstNotBefore(file2, j, line);
+			for (int k=j; k<file2.count() && file2[k].chr()==line.chr() && file2[k].start()<=line.end(); ++k)
+			{
+				output.append(BedLine(line.chr(), std::max(line.start(), file2[k].start()), std::min(line.end(), file2[k].end())));
+			}
+		}
+		lines_.swap(output);
+
+		//parts of nested lines can be out of order
+		if (!isSorted()) sort();
+		return;
+	}
+
+	//unsorted input
+	ChromosomalIndex<BedFile> file2_idx(file2);
 	int lines_original = lines_.count();
 	for (int i=0; i<lines_original; ++i)
 	{
@@ -402,14 +468,33 @@ void BedFile::intersect(const BedFile& file2)
 
 void BedFile::overlapping(const BedFile& file2)
 {
-	//check target region is merged/sorted and create index
+	//check target region is merged/sorted
 	if (!file2.isMergedAndSorted())
 	{
 		THROW(ArgumentException, "Merged and sorted BED file required for calculating the overlap of BED files!");
 	}
-	ChromosomalIndex<BedFile> file2_idx(file2);
 
-	//overlapping
+	//sorted input => linear sweep through both files
+	if (isSorted())
+	{
+		int o = 0;
+		int j = 0;
+		for (int i=0; i<lines_.count(); ++i)
+		{
+			const BedLine& line = lines_[i];
+			j = firstNotBefore(file2, j, line);
+			if (j<file2.count() && file2[j].chr()==line.chr() && file2[j].start()<=line.end())
+			{
+				if (i!=o) lines_[o] = line;
+				++o;
+			}
+		}
+		lines_.resize(o);
+		return;
+	}
+
+	//unsorted input
+	ChromosomalIndex<BedFile> file2_idx(file2);
 	for (int i=0; i<lines_.count(); ++i)
 	{
 		if (file2_idx.matchingIndex(lines_[i].chr(), lines_[i].start(), lines_[i].end())==-1)
@@ -472,6 +557,15 @@ void BedFile::chunk(int chunk_size)
 	lines_.swap(new_lines);
 }
 
+int BedFile::firstNotBefore(const BedFile& file2, int index, const BedLine& line)
+{
+	while (index<file2.count() && (file2[index].chr()<line.chr() || (file2[index].chr()==line.chr() && file2[index].end()<line.start())))
+	{
+		++index;
+	}
+	return index;
+}
+
 void BedFile::removeInvalidLines()
 {
 	//shift valid lines to the front
@@ -118,6 +118,10 @@ public:
 
 	///Parses a chromosomal region string and constructs a line from it. An invalid line is returned, if the string cannot be parsed.
 	static BedLine fromString(QString str);
+	///Parses a line of a 0-based BED file (without trailing newline) and converts it to a 1-based line. Throws FileParseException.
+	static BedLine fromBedLine(const QByteArray& line);
+	///Converts the line to a line of a 0-based BED file (without trailing newline).
+	QByteArray toBedLine() const;
 
 protected:
     Chromosome chr_;
@@ -196,11 +200,11 @@ public:
     void shrink(int n);
 	///Adds the regions from the given file.
 	void add(const BedFile& file2);
-    ///Subtracts the regions in the given file.
+    ///Subtracts the regions in the given file. If this file is sorted, a linear sweep is used and the output is sorted.
     void subtract(const BedFile& file2);
-    ///Removed all parts of regions that do not overlap with the given file.
+    ///Removed all parts of regions that do not overlap with the given file. If this file is sorted, a linear sweep is used and the output is sorted.
     void intersect(const BedFile& file2);
-    ///Removes all regions that do not overlap with the given file.
+    ///Removes all regions that do not overlap with the given file. If this file is sorted, a linear sweep is used.
     void overlapping(const BedFile& file2);
     ///Splits all regions to chunks of an approximate size.
     void chunk(int size);
@@ -217,6 +221,8 @@ public:
 protected:
     ///Removes empty lines.
     void removeInvalidLines();
+	///Returns the index of the first region in the merged/sorted @p file2 that does not end before @p line, starting the search at @p index (for sweeps through sorted files).
+	static int firstNotBefore(const BedFile& file2, int index, const BedLine& line);
 
 	QVector<QByteArray> headers_;
 	QVector<BedLine> lines_;
@@ -0,0 +1,230 @@
+#include "BedFileStream.h"
+#include "Exceptions.h"
+#include "Helper.h"
+#include <set>
+#include <algorithm>
+
+BedFileStream::BedFileStream(QString filename, bool merge)
+	: filename_(filename)
+	, file_(Helper::openFileForReading(filename, true))
+	, merge_(merge)
+	, headers_()
+	, next_()
+	, has_next_(false)
+{
+	//read headers and first region
+	has_next_ = readNext();
+}
+
+bool BedFileStream::readNext()
+{
+	while(!file_->atEnd())
+	{
+		QByteArray line = file_->readLine();
+		while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+
+		//skip empty lines
+		if(line.length()==0) continue;
+
+		//store headers (only before the first region)
+		if (line.startsWith("#") || line.startsWith("track ") || line.startsWith("browser "))
+		{
+			if (!has_next_) headers_.append(line);
+			continue;
+		}
+
+		BedLine region = BedLine::fromBedLine(line);
+		if (has_next_ && region<next_)
+		{
+			THROW(FileParseException, "BED file '" + filename_ + "' is not sorted: " + region.toString(true) + " after " + next_.toString(true) + "!");
+		}
+		next_ = region;
+		return true;
+	}
+
+	return false;
+}
+
+bool BedFileStream::readRawLine(BedLine& line)
+{
+	if (!has_next_) return false;
+
+	line = next_;
+	has_next_ = readNext();
+
+	return true;
+}
+
+bool BedFileStream::readLine(BedLine& line)
+{
+	if (!readRawLine(line)) return false;
+
+	if (merge_)
+	{
+		line.annotations().clear();
+		while (has_next_ && (line.overlapsWith(next_.chr(), next_.start(), next_.end()) || line.adjacentTo(next_.chr(), next_.start(), next_.end())))
+		{
+			line.setEnd(std::max(line.end(), next_.end()));
+			has_next_ = readNext();
+		}
+	}
+
+	return true;
+}
+
+void BedFileStream::writeHeaders(QFile& out) const
+{
+	foreach(const QByteArray& header, headers_)
+	{
+		out.write(header.trimmed() + "\n");
+	}
+}
+
+template <typename Handler>
+void BedFileStream::sweep(BedFileStream& stream, BedFileStream& stream2, Handler handler)
+{
+	QList<BedLine> window; //regions of file 2 that might overlap the current or following lines (sorted)
+	BedLine region;
+	bool has_region = stream2.readLine(region);
+
+	BedLine line;
+	while (stream.readLine(line))
+	{
+		//remove regions that end before the line
+		while (!window.isEmpty() && (window.first().chr()<line.chr() || (window.first().chr()==line.chr() && window.first().end()<line.start())))
+		{
+			window.removeFirst();
+		}
+
+		//add regions that start before the line end
+		while (has_region && (region.chr()<line.chr() || (region.chr()==line.chr() && region.start()<=line.end())))
+		{
+			if (region.chr()==line.chr() && region.end()>=line.start()) window.append(region);
+			has_region = stream2.readLine(region);
+		}
+
+		//determine overlapping regions (the window can contain regions after the line end)
+		int match_count = 0;
+		while (match_count<window.count() && window[match_count].start()<=line.end()) ++match_count;
+
+		handler(line, window, match_count);
+	}
+}
+
+void BedFileStream::merge(QString in, QString out, bool merge_back_to_back, bool merge_names)
+{
+	BedFileStream stream(in);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out, true);
+	stream.writeHeaders(*out_file);
+
+	BedLine next_output_line;
+	bool has_output_line = false;
+	BedLine line;
+	while (stream.readRawLine(line))
+	{
+		//remove annotations data
+		QByteArray name = (merge_names && line.annotations().count()) ? line.annotations()[0] : "";
+		line.annotations().clear();
+		if (merge_names) line.annotations().append(name);
+
+		//merge lines
+		if (has_output_line &&
+			(next_output_line.overlapsWith(line.chr(), line.start(), line.end())
+			 ||
+			 (merge_back_to_back && next_output_line.adjacentTo(line.chr(), line.start(), line.end())))
+			)
+		{
+			if (line.end()>next_output_line.end())
+			{
+				next_output_line.setEnd(line.end());
+				if (merge_names)
+				{
+					next_output_line.annotations()[0] += "," + line.annotations()[0];
+				}
+			}
+		}
+		else
+		{
+			if (has_output_line) out_file->write(next_output_line.toBedLine() + "\n");
+			next_output_line = line;
+			has_output_line = true;
+		}
+	}
+
+	//add last line
+	if (has_output_line) out_file->write(next_output_line.toBedLine() + "\n");
+}
+
+void BedFileStream::subtract(QString in, QString in2, QString out)
+{
+	BedFileStream stream(in);
+	BedFileStream stream2(in2, true);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out, true);
+	stream.writeHeaders(*out_file);
+
+	//parts of nested lines can be out of order => buffer output until no smaller parts can follow
+	std::multiset<BedLine> pending;
+	sweep(stream, stream2, [&](const BedLine& line, const QList<BedLine>& regions, int match_count)
+	{
+		while (!pending.empty() && (pending.begin()->chr()!=line.chr() || pending.begin()->start()<line.start()))
+		{
+			out_file->write(pending.begin()->toBedLine() + "\n");
+			pending.erase(pending.begin());
+		}
+
+		int start = line.start();
+		for (int i=0; i<match_count; ++i)
+		{
+			if (regions[i].start()>start) pending.insert(BedLine(line.chr(), start, regions[i].start()-1));
+			start = regions[i].end() + 1;
+		}
+		if (start<=line.end()) pending.insert(BedLine(line.chr(), start, line.end()));
+	});
+
+	for (const BedLine& line : pending)
+	{
+		out_file->write(line.toBedLine() + "\n");
+	}
+}
+
+void BedFileStream::intersect(QString in, QString in2, QString out)
+{
+	BedFileStream stream(in);
+	BedFileStream stream2(in2, true);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out, true);
+	stream.writeHeaders(*out_file);
+
+	//parts of nested lines can be out of order => buffer output until no smaller parts can follow
+	std::multiset<BedLine> pending;
+	sweep(stream, stream2, [&](const BedLine& line, const QList<BedLine>& regions, int match_count)
+	{
+		while (!pending.empty() && (pending.begin()->chr()!=line.chr() || pending.begin()->start()<line.start()))
+		{
+			out_file->write(pending.begin()->toBedLine() + "\n");
+			pending.erase(pending.begin());
+		}
+
+		for (int i=0; i<match_count; ++i)
+		{
+			pending.insert(BedLine(line.chr(), std::max(line.start(), regions[i].start()), std::min(line.end(), regions[i].end())));
+		}
+	});
+
+	for (const BedLine& line : pending)
+	{
+		out_file->write(line.toBedLine() + "\n");
+	}
+}
+
+void BedFileStream::overlapping(QString in, QString in2, QString out)
+{
+	BedFileStream stream(in);
+	BedFileStream stream2(in2, true);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out, true);
+	stream.writeHeaders(*out_file);
+
+	sweep(stream, stream2, [&](const BedLine& line, const QList<BedLine>& /*regions*/, int match_count)
+	{
+		if (match_count>0) out_file->write(line.toBedLine() + "\n");
+	});
+}
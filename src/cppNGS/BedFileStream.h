@@ -0,0 +1,58 @@
+#ifndef BEDFILESTREAM_H
+#define BEDFILESTREAM_H
+
+#include "cppNGS_global.h"
+#include "BedFile.h"
+#include <QFile>
+#include <QSharedPointer>
+
+///Sequential reader for sorted BED files that are too large to be loaded into memory (1-based).
+///The lines have to be sorted as by BedFile::sort(), otherwise a FileParseException is thrown.
+class CPPNGSSHARED_EXPORT BedFileStream
+{
+public:
+	///Constructor. If @p filename is empty, reads from STDIN. If @p merge is set, overlapping and back-to-back lines are merged on the fly and annotations are removed (see BedFile::merge).
+	BedFileStream(QString filename, bool merge = false);
+
+	///Returns the header lines (only those before the first region are returned).
+	const QVector<QByteArray>& headers() const
+	{
+		return headers_;
+	}
+
+	///Reads the next line. Returns @em false if the end of the file is reached.
+	bool readLine(BedLine& line);
+
+	///Merges overlapping regions (see BedFile::merge).
+	static void merge(QString in, QString out, bool merge_back_to_back = true, bool merge_names = false);
+	///Subtracts the regions of @p in2 from the regions of @p in (see BedFile::subtract). The output is sorted.
+	static void subtract(QString in, QString in2, QString out);
+	///Writes the parts of regions of @p in that overlap with @p in2 (see BedFile::intersect). The output is sorted.
+	static void intersect(QString in, QString in2, QString out);
+	///Writes the regions of @p in that overlap with @p in2 (see BedFile::overlapping).
+	static void overlapping(QString in, QString in2, QString out);
+
+protected:
+	QString filename_;
+	QSharedPointer<QFile> file_;
+	bool merge_;
+	QVector<QByteArray> headers_;
+	BedLine next_;
+	bool has_next_;
+
+	///Reads the next region from the file into 'next_'.
+	bool readNext();
+	///Returns the next unmerged line.
+	bool readRawLine(BedLine& line);
+	///Sweep through both files, calling @p handler with each line of @p in and the regions of @p in2 that overlap it.
+	template <typename Handler>
+	static void sweep(BedFileStream& stream, BedFileStream& stream2, Handler handler);
+	///Writes the headers of the stream to the output file.
+	void writeHeaders(QFile& out) const;
+
+	//declared away methods
+	BedFileStream(const BedFileStream&) = delete;
+	BedFileStream& operator=(const BedFileStream&) = delete;
+};
+
+#endif // BEDFILESTREAM_H
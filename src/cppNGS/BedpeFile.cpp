@@ -90,6 +90,22 @@ bool BedpeLine::intersectsWith(const BedFile& regions, bool imprecise_breakpoint
 	THROW(ProgrammingException, "Unhandled variant type (int): " + BedpeFile::typeToString(t));
 }
 
+bool BedpeLine::intersectsWith(const ChromosomalIndex<BedFile>& regions_idx, bool imprecise_breakpoints) const
+{
+	StructuralVariantType t = type();
+	if (t==StructuralVariantType::DEL || t==StructuralVariantType::DUP || t==StructuralVariantType::INV)
+	{
+		return regions_idx.matchingIndex(chr1(), start1(), end2())!=-1;
+	}
+	else if (t==StructuralVariantType::INS || t==StructuralVariantType::BND)
+	{
+		if (imprecise_breakpoints) return regions_idx.matchingIndex(chr1(), start1(), end1())!=-1 || regions_idx.matchingIndex(chr2(), start2(), end2())!=-1;
+		return regions_idx.matchingIndex(chr1(), start1(), start1())!=-1 || regions_idx.matchingIndex(chr2(), start2(), start2())!=-1;
+	}
+
+	THROW(ProgrammingException, "Unhandled variant type (int): " + BedpeFile::typeToString(t));
+}
+
 QString BedpeLine::position1() const
 {
 	return chr1().str() + ":" + QString::number(start1()) + "-" + QString::number(end1());
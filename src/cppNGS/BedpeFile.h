@@ -5,6 +5,7 @@
 #include "Chromosome.h"
 #include "Helper.h"
 #include "BedFile.h"
+#include "ChromosomalIndex.h"
 #include <QByteArrayList>
 #include <QMap>
 
@@ -131,6 +132,8 @@ public:
 	///Returns if a structural variant intersects with the given regions
 	///    (if imprecise_breakpoints == true also include confidence intervall for BND and INS into intersection)
 	bool intersectsWith(const BedFile& regions, bool imprecise_breakpoints = false) const;
+	///Returns if a structural variant intersects with the given indexed regions (see above). Use this overload when checking many variants against large region sets.
+	bool intersectsWith(const ChromosomalIndex<BedFile>& regions_idx, bool imprecise_breakpoints = false) const;
 
 	///Returns position 1 as string
 	QString position1() const;
@@ -0,0 +1,137 @@
+#include "BitSet.h"
+#include "Exceptions.h"
+
+BitSet::BitSet()
+	: size_(0)
+	, words_()
+{
+}
+
+BitSet::BitSet(int size, bool value)
+	: size_(size)
+	, words_((size+63)/64, value ? ~Q_UINT64_C(0) : Q_UINT64_C(0))
+{
+	clearUnusedBits();
+}
+
+int BitSet::count(bool value) const
+{
+	int count = 0;
+	foreach(quint64 word, words_)
+	{
+		count += qPopulationCount(word);
+	}
+
+	return value ? count : size_ - count;
+}
+
+void BitSet::fill(bool value)
+{
+	words_.fill(value ? ~Q_UINT64_C(0) : Q_UINT64_C(0));
+	clearUnusedBits();
+}
+
+int BitSet::nextSetBit(int index) const
+{
+	if (index>=size_) return -1;
+
+	int w = index>>6;
+	quint64 word = words_[w] & (~Q_UINT64_C(0) << (index & 63));
+	while (word==0)
+	{
+		++w;
+		if (w==words_.count()) return -1;
+		word = words_[w];
+	}
+
+	return (w<<6) + qCountTrailingZeroBits(word);
+}
+
+void BitSet::invert()
+{
+	for (int w=0; w<words_.count(); ++w)
+	{
+		words_[w] = ~words_[w];
+	}
+	clearUnusedBits();
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs)
+{
+	checkSize(rhs);
+
+	quint64* words = words_.data();
+	const quint64* rhs_words = rhs.words_.constData();
+	for (int w=0; w<words_.count(); ++w)
+	{
+		words[w] &= rhs_words[w];
+	}
+
+	return *this;
+}
+
+BitSet& BitSet::operator|=(const BitSet& rhs)
+{
+	checkSize(rhs);
+
+	quint64* words = words_.data();
+	const quint64* rhs_words = rhs.words_.constData();
+	for (int w=0; w<words_.count(); ++w)
+	{
+		words[w] |= rhs_words[w];
+	}
+
+	return *this;
+}
+
+BitSet& BitSet::andNot(const BitSet& rhs)
+{
+	checkSize(rhs);
+
+	quint64* words = words_.data();
+	const quint64* rhs_words = rhs.words_.constData();
+	for (int w=0; w<words_.count(); ++w)
+	{
+		words[w] &= ~rhs_words[w];
+	}
+
+	return *this;
+}
+
+QBitArray BitSet::toBitArray() const
+{
+	QBitArray output(size_, false);
+	for (int i=nextSetBit(0); i!=-1; i=nextSetBit(i+1))
+	{
+		output.setBit(i);
+	}
+
+	return output;
+}
+
+BitSet BitSet::fromBitArray(const QBitArray& bits)
+{
+	BitSet output(bits.count(), false);
+	for (int i=0; i<bits.count(); ++i)
+	{
+		if (bits.testBit(i)) output.setBit(i);
+	}
+
+	return output;
+}
+
+void BitSet::checkSize(const BitSet& rhs) const
+{
+	if (size_!=rhs.size_)
+	{
+		THROW(ArgumentException, "Cannot combine bit sets of different size: " + QString::number(size_) + " and " + QString::number(rhs.size_) + "!");
+	}
+}
+
+void BitSet::clearUnusedBits()
+{
+	if (size_ & 63)
+	{
+		words_.last() &= ~(~Q_UINT64_C(0) << (size_ & 63));
+	}
+}
@@ -0,0 +1,147 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include "cppNGS_global.h"
+#include <QVector>
+#include <QBitArray>
+#include <QtAlgorithms>
+
+///Fixed-size bit array stored in 64-bit words.
+///In addition to the single bit access of QBitArray, it supports bulk operations on whole words, fast counting and iteration over set bits.
+class CPPNGSSHARED_EXPORT BitSet
+{
+public:
+	///Reference to a single bit (returned by the non-const index operator).
+	class Reference
+	{
+	public:
+		Reference(quint64& word, quint64 mask)
+			: word_(word)
+			, mask_(mask)
+		{
+		}
+		operator bool() const
+		{
+			return (word_ & mask_)!=0;
+		}
+		bool operator!() const
+		{
+			return (word_ & mask_)==0;
+		}
+		Reference& operator=(bool value)
+		{
+			if (value) word_ |= mask_;
+			else word_ &= ~mask_;
+			return *this;
+		}
+		Reference& operator=(const Reference& rhs)
+		{
+			return operator=(bool(rhs));
+		}
+
+	protected:
+		quint64& word_;
+		quint64 mask_;
+	};
+
+	///Default constructor (empty).
+	BitSet();
+	///Constructor. All bits are set to @p value.
+	BitSet(int size, bool value=false);
+
+	///Returns the number of bits.
+	int size() const
+	{
+		return size_;
+	}
+	///Returns the number of bits.
+	int count() const
+	{
+		return size_;
+	}
+	///Returns the number of bits set to @p value.
+	int count(bool value) const;
+
+	///Returns the bit at @p index.
+	bool testBit(int index) const
+	{
+		return (words_[index>>6] & bitMask(index))!=0;
+	}
+	///Sets the bit at @p index.
+	void setBit(int index, bool value=true)
+	{
+		if (value) words_[index>>6] |= bitMask(index);
+		else words_[index>>6] &= ~bitMask(index);
+	}
+	///Clears the bit at @p index.
+	void clearBit(int index)
+	{
+		words_[index>>6] &= ~bitMask(index);
+	}
+	///Returns the bit at @p index.
+	bool operator[](int index) const
+	{
+		return testBit(index);
+	}
+	///Returns a reference to the bit at @p index.
+	Reference operator[](int index)
+	{
+		return Reference(words_[index>>6], bitMask(index));
+	}
+
+	///Sets all bits to @p value.
+	void fill(bool value);
+	///Returns the index of the first set bit at or after @p index, or -1 if there is none.
+	int nextSetBit(int index) const;
+
+	///Inverts all bits.
+	void invert();
+	///Bitwise AND. Both bit sets must have the same size.
+	BitSet& operator&=(const BitSet& rhs);
+	///Bitwise OR. Both bit sets must have the same size.
+	BitSet& operator|=(const BitSet& rhs);
+	///Bitwise AND with the inverse of @p rhs, i.e. clears all bits that are set in @p rhs. Both bit sets must have the same size.
+	BitSet& andNot(const BitSet& rhs);
+	///Returns the inverted bit set.
+	BitSet operator~() const
+	{
+		BitSet output = *this;
+		output.invert();
+		return output;
+	}
+
+	///Equality operator.
+	bool operator==(const BitSet& rhs) const
+	{
+		return size_==rhs.size_ && words_==rhs.words_;
+	}
+	///Inequality operator.
+	bool operator!=(const BitSet& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	///Read-only access to the words. Bits after the last bit of the last word are always unset.
+	const QVector<quint64>& words() const
+	{
+		return words_;
+	}
+
+	///Converts the bit set to a QBitArray.
+	QBitArray toBitArray() const;
+	///Creates a bit set from a QBitArray.
+	static BitSet fromBitArray(const QBitArray& bits);
+
+protected:
+	int size_;
+	QVector<quint64> words_;
+
+	static quint64 bitMask(int index)
+	{
+		return Q_UINT64_C(1) << (index & 63);
+	}
+	void checkSize(const BitSet& rhs) const;
+	void clearUnusedBits();
+};
+
+#endif // BITSET_H
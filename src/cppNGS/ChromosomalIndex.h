@@ -1,18 +1,20 @@
 #ifndef CHROMOSOMALINDEX_H
 #define CHROMOSOMALINDEX_H
 #include "cppNGS_global.h"
-#include "limits"
 #include "Chromosome.h"
+#include "Exceptions.h"
+#include <algorithm>
 #include <QHash>
 #include <QVector>
-#include <QPair>
 
-///Chromosomal index for fast access to @em sorted containers with chromosomal range elements like BedFile and VariantList.
+///Chromosomal index for fast access to @em sorted containers with chromosomal range elements like BedFile, VariantList and CnvList.
+///The elements of each chromosome are treated as an implicit, in-order binary tree over their container positions.
+///Each node is annotated with the maximum end position of its sub-tree (see Heng Li's cgranges), which makes queries O(log(n) + k) independent of the element length distribution.
 template <class T>
 class CPPNGSSHARED_EXPORT ChromosomalIndex
 {
 public:
-	///Constructor.
+	///Constructor. Sub-trees with at most @p bin_size elements are scanned linearly instead of being traversed.
 	ChromosomalIndex(const T& container, int bin_size = 30);
 
 	///Re-creates the index (only needed if the container content changed after calling the index constructor).
@@ -21,69 +23,187 @@ public:
 	///Returns the underlying container
 	const T& container() const { return container_; }
 
-	///Returns a vector of element indices overlapping the given chromosomal range.
+	///Returns a vector of element indices overlapping the given chromosomal range (sorted ascending).
 	QVector<int> matchingIndices(const Chromosome& chr, int start, int end) const;
 	///Returns the index of the first element in the container that overlaps the given chromosomal range, or -1 if no element overlaps.
 	int matchingIndex(const Chromosome& chr, int start, int end) const;
 
+	///Calls @p handler(query_index, element_index) for each overlap between the elements of @p queries and the indexed container.
+	///The queries have to be grouped by chromosome and sorted by start position - they are answered in a single pass through both containers.
+	template <class Q, typename Handler>
+	void forEachOverlap(const Q& queries, Handler handler) const;
+
+	///Cursor for overlap queries that are grouped by chromosome and sorted by start position, e.g. alignments of a sorted BAM file.
+	///In contrast to matchingIndices(), the cursor advances monotonically through the container and does not allocate memory per query.
+	class Sweep
+	{
+	public:
+		///Constructor.
+		Sweep(const ChromosomalIndex<T>& index);
+
+		///Calls @p handler with each overlapping element index in ascending order. Stops as soon as the handler returns @em false.
+		///Throws an ArgumentException if the start position is smaller than the start position of the previous query on the same chromosome.
+		template <typename Handler>
+		void forEachMatch(const Chromosome& chr, int start, int end, Handler handler);
+		///Returns if an element overlaps the given chromosomal range (same restrictions as forEachMatch).
+		bool hasMatch(const Chromosome& chr, int start, int end);
+
+		///Resets the cursor to the beginning of the container.
+		void reset();
+
+	protected:
+		const ChromosomalIndex<T>& index_;
+		int chr_; //numeric representation of the current chromosome
+		int next_; //index of the first element not yet added to 'active_'
+		int chr_end_; //index after the last element of the current chromosome
+		int last_start_; //start of the previous query
+		QVector<int> active_; //elements that start before the maximum query end and end after the last query start (sorted ascending)
+	};
+
 protected:
-	const T& container_;
-	QHash<int, QVector<QPair<int, int> > > index_;
-	int max_length_;
-	int bin_size_;
-	static bool firstOfPairComparator(const QPair<int, int>& a, const QPair<int, int>& b)
+	///Index data of a chromosome
+	struct ChrIndex
 	{
-		return	a.first < b.first;
-	}
+		int offset; //container index of the first element
+		int count; //element count
+		int root_level; //level of the root node in the implicit tree
+	};
+
+	const T& container_;
+	QHash<int, ChrIndex> index_;
+	QVector<int> max_end_;
+	int leaf_level_;
+
+	///Annotates the elements of one chromosome with the sub-tree maximum end position. Returns the level of the root node.
+	int indexChromosome(int offset, int count);
+	///Calls @p handler with each overlapping element index in ascending order. Stops as soon as the handler returns @em false.
+	template <typename Handler>
+	void forEachMatch(const Chromosome& chr, int start, int end, Handler handler) const;
 };
 
 template <class T>
 ChromosomalIndex<T>::ChromosomalIndex(const T& container, int bin_size)
 	: container_(container)
 	, index_()
-	, max_length_(-1)
-	, bin_size_(bin_size)
+	, max_end_()
+	, leaf_level_(0)
 {
+	//sub-trees of level k contain 2^(k+1)-1 elements
+	while ((2<<(leaf_level_+1))-1 <= bin_size) ++leaf_level_;
+
 	createIndex();
 }
 
 template <class T>
 void ChromosomalIndex<T>::createIndex()
 {
-	int min = std::numeric_limits<int>::min();
-	int max = std::numeric_limits<int>::max();
+	index_.clear();
+	max_end_.fill(0, container_.count());
+
+	int offset = 0;
+	while (offset<container_.count())
+	{
+		//determine chromosome range
+		const Chromosome& chr = container_[offset].chr();
+		int end = offset + 1;
+		while (end<container_.count() && container_[end].chr()==chr) ++end;
+
+		ChrIndex chr_index;
+		chr_index.offset = offset;
+		chr_index.count = end - offset;
+		chr_index.root_level = indexChromosome(offset, end - offset);
+		index_.insert(chr.num(), chr_index);
+
+		offset = end;
+	}
+}
+
+template <class T>
+int ChromosomalIndex<T>::indexChromosome(int offset, int count)
+{
+	int* max_end = max_end_.data() + offset;
 
-	int bin_count = 0;
-	Chromosome last_chr;
-	QVector< QPair<int, int> > chr_indices;
-	for (int i=0; i<container_.count(); ++i)
+	//leaves (level 0)
+	int last_i = 0;
+	int last = 0;
+	for (int i=0; i<count; i+=2)
 	{
-		if (container_[i].chr()!=last_chr)
+		last_i = i;
+		last = max_end[i] = container_[offset+i].end();
+	}
+
+	//inner nodes (bottom-up)
+	int k = 1;
+	for (; (1ll<<k)<=count; ++k)
+	{
+		int x = 1 << (k-1);
+		int i0 = (x << 1) - 1;
+		int step = x << 2;
+		for (int i=i0; i<count; i+=step)
 		{
-			if (last_chr.isValid())
+			int end_left = max_end[i-x];
+			int end_right = i+x<count ? max_end[i+x] : last;
+			max_end[i] = std::max(container_[offset+i].end(), std::max(end_left, end_right));
+		}
+
+		//'last' is the max end of the right-most node of the current level, which can be missing a parent node
+		last_i = ((last_i>>k)&1) ? last_i-x : last_i+x;
+		if (last_i<count && max_end[last_i]>last) last = max_end[last_i];
+	}
+
+	return k - 1;
+}
+
+template <class T>
+template <typename Handler>
+void ChromosomalIndex<T>::forEachMatch(const Chromosome& chr, int start, int end, Handler handler) const
+{
+	//chromosome not found
+	typename QHash<int, ChrIndex>::const_iterator it = index_.constFind(chr.num());
+	if (it==index_.constEnd()) return;
+
+	const int offset = it->offset;
+	const int count = it->count;
+	const int* max_end = max_end_.constData() + offset;
+
+	//iterative in-order traversal of the implicit tree
+	struct StackItem
+	{
+		int level;
+		int node;
+		bool left_done;
+	};
+	StackItem stack[64];
+	int t = 0;
+	stack[t++] = StackItem{it->root_level, (1<<it->root_level) - 1, false};
+	while (t>0)
+	{
+		StackItem z = stack[--t];
+		if (z.level<=leaf_level_) //small sub-tree => linear scan
+		{
+			int i0 = z.node >> z.level << z.level;
+			int i1 = std::min(i0 + (1<<(z.level+1)) - 1, count);
+			for (int i=i0; i<i1 && container_[offset+i].start()<=end; ++i)
 			{
-				chr_indices.append(QPair<int, int>(max,i-1));
-				index_.insert(last_chr.num(), chr_indices);
+				if (container_[offset+i].end()>=start && !handler(offset+i)) return;
 			}
-			chr_indices.clear();
-			chr_indices.append(QPair<int, int>(min,i));
-			last_chr = container_[i].chr();
-			bin_count = 0;
 		}
-		else if (bin_count==bin_size_)
+		else if (!z.left_done) //left child not processed yet
 		{
-			chr_indices.append(QPair<int, int>(container_[i].start(),i));
-			bin_count = 0;
+			int left = z.node - (1<<(z.level-1));
+			stack[t++] = StackItem{z.level, z.node, true};
+			//nodes outside the range are not annotated, but can have children inside the range
+			if (left>=count || max_end[left]>=start)
+			{
+				stack[t++] = StackItem{z.level-1, left, false};
+			}
+		}
+		else if (z.node<count && container_[offset+z.node].start()<=end) //node itself and right child
+		{
+			if (container_[offset+z.node].end()>=start && !handler(offset+z.node)) return;
+			stack[t++] = StackItem{z.level-1, z.node + (1<<(z.level-1)), false};
 		}
-
-		max_length_ = std::max(max_length_, container_[i].end() - container_[i].start() + 1);
-
-		++bin_count;
 	}
-
-	//add last chromosome index
-	chr_indices.append(QPair<int, int>(max,container_.count()-1));
-	index_.insert(last_chr.num(), chr_indices);
 }
 
 template <class T>
@@ -91,67 +211,125 @@ QVector<int> ChromosomalIndex<T>::matchingIndices(const Chromosome& chr, int sta
 {
 	QVector<int> matches;
 
-	//chromosome not found
-	if (!index_.contains(chr.num())) return matches;
+	forEachMatch(chr, start, end, [&matches](int index)
+	{
+		matches.append(index);
+		return true;
+	});
 
-	//find start iterator in index
-	const QVector<QPair<int,int> >& pos_array = index_[chr.num()];
-	QVector<QPair<int,int> >::const_iterator it = std::lower_bound(pos_array.begin(), pos_array.end(), QPair<int, int>(start, -1), firstOfPairComparator);
-	--it;
+	return matches;
+}
+
+template <class T>
+int ChromosomalIndex<T>::matchingIndex(const Chromosome& chr, int start, int end) const
+{
+	int match = -1;
 
-	//find start in container
-	int index = it->second;
-	while(index>0 && container_[index].start()>=start-max_length_ && container_[index].chr()==chr)
+	forEachMatch(chr, start, end, [&match](int index)
 	{
-		--index;
-	}
-	if (container_[index].chr()!=chr) ++index;
+		match = index;
+		return false;
+	});
+
+	return match;
+}
 
-	//find end in container
-	while(index<container_.count() && container_[index].start()<end+max_length_ && container_[index].chr()==chr)
+template <class T>
+template <class Q, typename Handler>
+void ChromosomalIndex<T>::forEachOverlap(const Q& queries, Handler handler) const
+{
+	Sweep sweep(*this);
+	for (int q=0; q<queries.count(); ++q)
 	{
-		if (container_[index].overlapsWith(start, end))
+		const auto& query = queries[q];
+		sweep.forEachMatch(query.chr(), query.start(), query.end(), [&handler, q](int index)
 		{
-			matches.append(index);
-		}
-		++index;
+			handler(q, index);
+			return true;
+		});
 	}
+}
 
-	return matches;
+template <class T>
+ChromosomalIndex<T>::Sweep::Sweep(const ChromosomalIndex<T>& index)
+	: index_(index)
+	, chr_(0)
+	, next_(0)
+	, chr_end_(0)
+	, last_start_(0)
+	, active_()
+{
 }
 
+template <class T>
+void ChromosomalIndex<T>::Sweep::reset()
+{
+	chr_ = 0;
+	next_ = 0;
+	chr_end_ = 0;
+	last_start_ = 0;
+	active_.clear();
+}
 
 template <class T>
-int ChromosomalIndex<T>::matchingIndex(const Chromosome& chr, int start, int end) const
+template <typename Handler>
+void ChromosomalIndex<T>::Sweep::forEachMatch(const Chromosome& chr, int start, int end, Handler handler)
 {
-	//chromosome not found
-	if (!index_.contains(chr.num())) return -1;
+	const T& container = index_.container_;
 
-	//find start iterator in index
-	const QVector<QPair<int,int> >& pos_array = index_[chr.num()];
-	QVector<QPair<int,int> >::const_iterator it = std::lower_bound(pos_array.begin(), pos_array.end(), QPair<int, int>(start, -1), firstOfPairComparator);
-	--it;
+	//chromosome changed => jump to chromosome range
+	if (chr.num()!=chr_)
+	{
+		reset();
+		chr_ = chr.num();
+		typename QHash<int, ChrIndex>::const_iterator it = index_.index_.constFind(chr_);
+		if (it!=index_.index_.constEnd())
+		{
+			next_ = it->offset;
+			chr_end_ = it->offset + it->count;
+		}
+	}
+	else if (start<last_start_)
+	{
+		THROW(ArgumentException, "Sweep queries are not sorted by position: " + chr.str() + ":" + QString::number(start) + " after " + chr.str() + ":" + QString::number(last_start_) + "!");
+	}
+	last_start_ = start;
 
-	//find start in container
-	int index = it->second;
-	while(index>0 && container_[index].start()>=start-max_length_ && container_[index].chr()==chr)
+	//remove elements that end before the query (they cannot overlap later queries either)
+	int kept = 0;
+	for (int i=0; i<active_.count(); ++i)
 	{
-		--index;
+		if (container[active_[i]].end()>=start) active_[kept++] = active_[i];
 	}
-	if (container_[index].chr()!=chr) ++index;
+	active_.resize(kept);
 
-	//find match
-	while(index<container_.count() && container_[index].start()<end+max_length_ && container_[index].chr()==chr)
+	//add elements that start before the query end
+	while (next_<chr_end_ && container[next_].start()<=end)
 	{
-		if (container_[index].overlapsWith(start, end))
-		{
-			return index;
-		}
-		++index;
+		if (container[next_].end()>=start) active_.append(next_);
+		++next_;
 	}
 
-	return -1;
+	//report matches (active elements can start after the query end, if a previous query ended later)
+	for (int i=0; i<active_.count(); ++i)
+	{
+		int index = active_[i];
+		if (container[index].start()<=end && !handler(index)) return;
+	}
 }
 
+template <class T>
+bool ChromosomalIndex<T>::Sweep::hasMatch(const Chromosome& chr, int start, int end)
+{
+	bool match = false;
+
+	forEachMatch(chr, start, end, [&match](int /*index*/)
+	{
+		match = true;
+		return false;
+	});
+
+	return match;
+}
 
 #endif // CHROMOSOMALINDEX_H
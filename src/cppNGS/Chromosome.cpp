@@ -1,6 +1,7 @@
 #include "Chromosome.h"
 #include "Exceptions.h"
 #include <QHash>
+#include <QReadWriteLock>
 
 Chromosome::Chromosome()
 	: str_("")
@@ -76,14 +77,19 @@ int Chromosome::numericRepresentation() const
 	{
 		return value;
 	}
-	//other non-numeric chromosome
+	//other non-numeric chromosome (chromosomes are created in worker threads as well, so the cache is locked)
 	static int next_num = 1004;
 	static QHash<QByteArray, int> cache;
-	if (!cache.contains(tmp))
+	static QReadWriteLock lock;
 	{
-		cache[tmp] = next_num;
-		++next_num;
+		QReadLocker locker(&lock);
+		auto it = cache.constFind(tmp);
+		if (it!=cache.constEnd()) return it.value();
 	}
 
-	return cache[tmp];
+	QWriteLocker locker(&lock);
+	auto it = cache.constFind(tmp);
+	if (it!=cache.constEnd()) return it.value();
+	cache.insert(tmp, next_num);
+	return next_num++;
 }
@@ -2,6 +2,7 @@
 #include "Exceptions.h"
 #include "GeneSet.h"
 #include "Helper.h"
+#include "VariantGeneIndex.h"
 #include "NGSHelper.h"
 #include "Log.h"
 #include "cmath"
@@ -54,7 +55,7 @@ FilterResult::FilterResult()
 
 FilterResult::FilterResult(int variant_count, bool value)
 {
-	pass = QBitArray(variant_count, value);
+	pass = BitSet(variant_count, value);
 }
 
 void FilterResult::removeFlagged(VariantList& variants)
@@ -62,25 +63,22 @@ void FilterResult::removeFlagged(VariantList& variants)
 	//skip if all variants pass
 	if (countPassing()==variants.count()) return;
 
-	//move passing variant to the front of the variant list
+	//move passing variant to the front of the variant list (only set bits are visited)
 	int to_index = 0;
-	for (int i=0; i<variants.count(); ++i)
+	for (int i=pass.nextSetBit(0); i!=-1; i=pass.nextSetBit(i+1))
 	{
-		if (pass[i])
+		if (to_index!=i)
 		{
-			if (to_index!=i)
-			{
-				variants[to_index] = variants[i];
-			}
-			++to_index;
+			variants[to_index] = variants[i];
 		}
+		++to_index;
 	}
 
 	//resize to new size
 	variants.resize(to_index);
 
 	//update flags
-	pass = QBitArray(variants.count(), true);
+	pass = BitSet(variants.count(), true);
 }
 
 void FilterResult::tagNonPassing(VariantList& variants, QByteArray tag, QByteArray description)
@@ -95,12 +93,10 @@ void FilterResult::tagNonPassing(VariantList& variants, QByteArray tag, QByteArr
 	}
 
 	//tag variants that did not pass
-	for (int i=0; i<variants.count(); ++i)
+	BitSet non_passing = ~pass;
+	for (int i=non_passing.nextSetBit(0); i!=-1; i=non_passing.nextSetBit(i+1))
 	{
-		if (!pass[i])
-		{
-			variants[i].addFilter(tag, index);
-		}
+		variants[i].addFilter(tag, index);
 	}
 }
 
@@ -813,39 +809,38 @@ void FilterGenes::apply(const VariantList& variants, FilterResult& result) const
 
 	GeneSet genes = GeneSet::createFromStringList(getStringList("genes"));
 
-	//get column indices
+	//get gene index
 	int i_gene = annotationColumn(variants, "gene");
+	QSharedPointer<const VariantGeneIndex> gene_index = variants.geneIndex(i_gene);
 
-	//filter (text-based)
-	if (!genes.join('|').contains("*"))
+	//determine matching genes
+	QVector<int> gene_ids;
+	if (!genes.join('|').contains("*")) //text-based
 	{
-		for(int i=0; i<variants.count(); ++i)
-		{
-			if (!result.flags()[i]) continue;
-
-			result.flags()[i] = genes.intersectsWith(GeneSet::createFromText(variants[i].annotations()[i_gene], ','));
-		}
+		gene_ids = genes.ids();
 	}
-	else //filter (regexp)
+	else //regexp (matched against each distinct gene once)
 	{
 		QRegExp reg(genes.join('|').replace("-", "\\-").replace("*", "[A-Z0-9-]*"));
-		for(int i=0; i<variants.count(); ++i)
+		for (int g=0; g<gene_index->geneIdCount(); ++g)
 		{
-			if (!result.flags()[i]) continue;
-
-			GeneSet var_genes = GeneSet::createFromText(variants[i].annotations()[i_gene], ',');
-			bool match_found = false;
-			foreach(const QByteArray& var_gene, var_genes)
+			if (gene_index->variants(g).count()>0 && reg.exactMatch(GeneSymbolTable::symbol(g)))
 			{
-				if (reg.exactMatch(var_gene))
-				{
-					match_found = true;
-					break;
-				}
+				gene_ids << g;
 			}
-			result.flags()[i] = match_found;
 		}
 	}
+
+	//filter
+	BitSet match(variants.count());
+	foreach(int gene_id, gene_ids)
+	{
+		for (int v : gene_index->variants(gene_id))
+		{
+			match.setBit(v);
+		}
+	}
+	result.flags() &= match;
 }
 
 
@@ -860,10 +855,8 @@ void FilterRegions::apply(const VariantList& variants, const BedFile& regions, F
 	//special case when only one region is contained
 	if (regions.count()==1)
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = variants[i].overlapsWith(regions[0]);
 		}
 		return;
@@ -871,10 +864,31 @@ void FilterRegions::apply(const VariantList& variants, const BedFile& regions, F
 
 	//general case with many regions
 	ChromosomalIndex<BedFile> regions_idx(regions);
-	for (int i=0; i<variants.count(); ++i)
+
+	//sorted variants (chromosomes grouped, positions ascending) => single sweep through both lists
+	bool sorted = true;
+	for (int i=1; i<variants.count(); ++i)
+	{
+		if (variants[i].chr()==variants[i-1].chr() && variants[i].start()<variants[i-1].start())
+		{
+			sorted = false;
+			break;
+		}
+	}
+	if (sorted)
 	{
-		if (!result.flags()[i]) continue;
+		ChromosomalIndex<BedFile>::Sweep regions_sweep(regions_idx);
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
+		{
+			const Variant& v = variants[i];
+			result.flags()[i] = regions_sweep.hasMatch(v.chr(), v.start(), v.end());
+		}
+		return;
+	}
 
+	//unsorted variants
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
+	{
 		const Variant& v = variants[i];
 		int index = regions_idx.matchingIndex(v.chr(), v.start(), v.end());
 		result.flags()[i] = (index!=-1);
@@ -899,10 +913,8 @@ void FilterFilterColumnEmpty::apply(const VariantList& variants, FilterResult& r
 {
 	if (!enabled_) return;
 
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		result.flags()[i] = variants[i].filters().isEmpty();
 	}
 }
@@ -924,10 +936,8 @@ void FilterVariantIsSNP::apply(const VariantList& variants, FilterResult& result
 {
 	if (!enabled_) return;
 
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		result.flags()[i] = variants[i].isSNV();
 	}
 }
@@ -957,10 +967,8 @@ void FilterSubpopulationAlleleFrequency::apply(const VariantList& variants, Filt
 
 	//filter
 	int i_gnomad = annotationColumn(variants, "gnomAD_sub");
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		QByteArrayList parts = variants[i].annotations()[i_gnomad].split(',');
 		foreach(const QByteArray& part, parts)
 		{
@@ -1001,10 +1009,8 @@ void FilterVariantImpact::apply(const VariantList& variants, FilterResult& resul
 	QByteArrayList impacts = getStringList("impact").join(":,:").prepend(":").append(":").toLatin1().split(',');
 
 	//filter
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		bool pass_impact = false;
 		foreach(const QByteArray& impact, impacts)
 		{
@@ -1046,10 +1052,8 @@ void FilterVariantCountNGSD::apply(const VariantList& variants, FilterResult& re
 
 	if (getBool("ignore_genotype"))
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = (variants[i].annotations()[i_ihdb_hom].toInt() + variants[i].annotations()[i_ihdb_het].toInt()) <= max_count;
 		}
 	}
@@ -1059,10 +1063,8 @@ void FilterVariantCountNGSD::apply(const VariantList& variants, FilterResult& re
 		QList<int> geno_indices = variants.getSampleHeader().sampleColumns(true);
 		if (geno_indices.isEmpty()) THROW(ArgumentException, "Cannot apply filter '" + name() + "' to variant list without affected samples!");
 
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			bool var_is_hom = false;
 			foreach(int index, geno_indices)
 			{
@@ -1114,19 +1116,15 @@ void FilterFilterColumn::apply(const VariantList& variants, FilterResult& result
 	QString action = getString("action");
 	if (action=="REMOVE")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = !match(variants[i]);
 		}
 	}
 	else if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = match(variants[i]);
 		}
 	}
@@ -1181,19 +1179,15 @@ void FilterClassificationNGSD::apply(const VariantList& variants, FilterResult&
 	QString action = getString("action");
 	if (action=="REMOVE")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = !match(variants[i]);
 		}
 	}
 	else if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = match(variants[i]);
 		}
 	}
@@ -1243,10 +1237,8 @@ void FilterGeneInheritance::apply(const VariantList& variants, FilterResult& res
 	QStringList modes_passing = getStringList("modes");
 
 	//filter
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: AL627309.1 (inh=n/a pLI=n/a), PRPF31 (inh=AD pLI=0.97), 34P13.14 (inh=n/a pLI=n/a)
 		QByteArrayList genes = variants[i].annotations()[i_geneinfo].split(',');
 		bool any_gene_passed = false;
@@ -1304,10 +1296,8 @@ void FilterGeneConstraint::apply(const VariantList& variants, FilterResult& resu
 	double max_oe_lof = getDouble("max_oe_lof");
 
 	//filter
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: AL627309.1 (inh=n/a pLI=n/a), PRPF31 (inh=AD pLI=0.97), 34P13.14 (inh=n/a pLI=n/a oe_lof=)
 		QByteArrayList genes = variants[i].annotations()[i_geneinfo].split(',');
 		bool any_gene_passed = false;
@@ -1374,10 +1364,8 @@ void FilterGenotypeControl::apply(const VariantList& variants, FilterResult& res
 	if (geno_indices.isEmpty()) THROW(ArgumentException, "Cannot apply filter '" + name() + "' to variant list without control samples!");
 
 	//filter
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (same_genotype)
 		{
 			QByteArray geno_all = checkSameGenotype(geno_indices, variants[i]);
@@ -1445,10 +1433,8 @@ void FilterGenotypeAffected::apply(const VariantList& variants, FilterResult& re
 	//filter
 	if (!genotypes.contains("comp-het"))
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QByteArray geno_all = checkSameGenotype(geno_indices, variants[i]);
 			if (geno_all.isEmpty() || !genotypes.contains(geno_all))
 			{
@@ -1459,38 +1445,29 @@ void FilterGenotypeAffected::apply(const VariantList& variants, FilterResult& re
 	else
 	{
 		int i_gene = annotationColumn(variants, "gene");
+		QSharedPointer<const VariantGeneIndex> gene_index = variants.geneIndex(i_gene);
 
 		//(1) filter for all genotypes but comp-het
 		//(2) count heterozygous passing variants per gene
-		QHash<QByteArray, int> gene_to_het;
-		FilterResult result_other(variants.count());
-		for(int i=0; i<variants.count(); ++i)
+		QVector<int> gene_to_het(gene_index->geneIdCount(), 0);
+		FilterResult result_other(variants.count(), false);
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i])
-			{
-				result_other.flags()[i] = false;
-				continue;
-			}
-
 			QByteArray geno_all = checkSameGenotype(geno_indices, variants[i]);
 			result_other.flags()[i] = !geno_all.isEmpty() && genotypes.contains(geno_all);
 
 			if (geno_all=="het")
 			{
-				QList<QByteArray> genes = variants[i].annotations()[i_gene].toUpper().split(',');
-				foreach(const QByteArray& gene, genes)
+				for (int gene_id : gene_index->genes(i))
 				{
-					gene_to_het[gene.trimmed()] += 1;
+					++gene_to_het[gene_id];
 				}
-
 			}
 		}
 
 		//apply combined results from above
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			//other filter pass => pass
 			if (result_other.flags()[i]) continue;
 
@@ -1499,10 +1476,9 @@ void FilterGenotypeAffected::apply(const VariantList& variants, FilterResult& re
 			QByteArray geno_all = checkSameGenotype(geno_indices, variants[i]);
 			if (geno_all=="het")
 			{
-				QList<QByteArray> genes = variants[i].annotations()[i_gene].toUpper().split(',');
-				foreach(const QByteArray& gene, genes)
+				for (int gene_id : gene_index->genes(i))
 				{
-					if (gene_to_het[gene.trimmed()]>=2)
+					if (gene_to_het[gene_id]>=2)
 					{
 						pass = true;
 						break;
@@ -1558,19 +1534,15 @@ void FilterColumnMatchRegexp::apply(const VariantList& variants, FilterResult& r
 	QString action = getString("action");
 	if (action=="REMOVE")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = !match(variants[i]);
 		}
 	}
 	else if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = match(variants[i]);
 		}
 	}
@@ -1623,10 +1595,8 @@ void FilterAnnotationPathogenic::apply(const VariantList& variants, FilterResult
 
 	if (getString("action")=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = annotatedPathogenic(variants[i]);
 		}
 
@@ -1709,10 +1679,8 @@ void FilterPredictionPathogenic::apply(const VariantList& variants, FilterResult
 
 	if (getString("action")=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = predictedPathogenic(variants[i]);
 		}
 	}
@@ -1798,19 +1766,15 @@ void FilterAnnotationText::apply(const VariantList& variants, FilterResult& resu
 	QString action = getString("action");
 	if (action=="REMOVE")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = !match(variants[i]);
 		}
 	}
 	else if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			result.flags()[i] = match(variants[i]);
 		}
 	}
@@ -1892,10 +1856,8 @@ void FilterVariantType::apply(const VariantList& variants, FilterResult& result)
 
 	int index = annotationColumn(variants, "coding_and_splicing");
 
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		bool match_found = false;
 		foreach(const QByteArray& type, types)
 		{
@@ -1938,9 +1900,8 @@ void FilterVariantQC::apply(const VariantList& variants, FilterResult& result) c
 	int depth = getInt("depth");
 	int mapq = getInt("mapq");
 
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
 		QByteArrayList parts = variants[i].annotations()[index].split(';');
 		foreach(const QByteArray& part, parts)
 		{
@@ -2039,16 +2000,15 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 
 	//pre-calculate genes with heterozygous variants
 	QSet<QString> types = getStringList("types").toSet();
-	GeneSet genes_comphet;
+	QSharedPointer<const VariantGeneIndex> gene_index = variants.geneIndex(i_gene);
+	BitSet genes_comphet(gene_index->geneIdCount());
 	if (types.contains("comp-het"))
 	{
-		GeneSet het_father;
-		GeneSet het_mother;
+		BitSet het_father(gene_index->geneIdCount());
+		BitSet het_mother(gene_index->geneIdCount());
 
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			const Variant& v = variants[i];
 			bool diplod_chromosome = v.chr().isAutosome() || (v.chr().isX() && gender_child=="female") || (v.chr().isX() && par_region.overlapsWith(v.chr(), v.start(), v.end()));
 			if (diplod_chromosome)
@@ -2058,15 +2018,22 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 
 				if (geno_c=="het" && geno_f=="het" && geno_m=="wt")
 				{
-					het_mother << GeneSet::createFromText(v.annotations()[i_gene], ',');
+					for (int gene_id : gene_index->genes(i))
+					{
+						het_mother.setBit(gene_id);
+					}
 				}
 				if (geno_c=="het" && geno_f=="wt" && geno_m=="het")
 				{
-					het_father << GeneSet::createFromText(v.annotations()[i_gene], ',');
+					for (int gene_id : gene_index->genes(i))
+					{
+						het_father.setBit(gene_id);
+					}
 				}
 			}
 		}
-		genes_comphet = het_mother.intersect(het_father);
+		genes_comphet = het_mother;
+		genes_comphet &= het_father;
 	}
 
 	//load imprinting gene list
@@ -2085,10 +2052,8 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 	}
 
 	//apply
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		const Variant& v = variants[i];
 
 		//get genotypes
@@ -2148,9 +2113,13 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 					||
 					(geno_c=="het" && geno_f=="wt" && geno_m=="het"))
 				{
-					if (genes_comphet.intersectsWith(GeneSet::createFromText(v.annotations()[i_gene], ',')))
+					for (int gene_id : gene_index->genes(i))
 					{
-						match = true;
+						if (genes_comphet[gene_id])
+						{
+							match = true;
+							break;
+						}
 					}
 				}
 			}
@@ -2166,9 +2135,9 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 		{
 			if (geno_c=="het" && geno_f=="het" && geno_m=="wt")
 			{
-				GeneSet genes = GeneSet::createFromText(v.annotations()[i_gene], ',');
-				foreach(const QByteArray& gene, genes)
+				for (int gene_id : gene_index->genes(i))
 				{
+					const QByteArray& gene = GeneSymbolTable::symbol(gene_id);
 					if (imprinting.contains(gene) && (imprinting[gene]=="paternal" || imprinting[gene]=="both"))
 					{
 						match = true;
@@ -2177,9 +2146,9 @@ void FilterTrio::apply(const VariantList& variants, FilterResult& result) const
 			}
 			if (geno_c=="het" && geno_f=="wt" && geno_m=="het")
 			{
-				GeneSet genes = GeneSet::createFromText(v.annotations()[i_gene], ',');
-				foreach(const QByteArray& gene, genes)
+				for (int gene_id : gene_index->genes(i))
 				{
+					const QByteArray& gene = GeneSymbolTable::symbol(gene_id);
 					if (imprinting.contains(gene) && (imprinting[gene]=="maternal" || imprinting[gene]=="both"))
 					{
 						match = true;
@@ -2247,10 +2216,8 @@ void FilterOMIM::apply(const VariantList& variants, FilterResult& result) const
 	QString action = getString("action");
 	if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (variants[i].annotations()[index].trimmed().isEmpty())
 			{
 				result.flags()[i] = false;
@@ -2259,10 +2226,8 @@ void FilterOMIM::apply(const VariantList& variants, FilterResult& result) const
 	}
 	else //REMOVE
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (!variants[i].annotations()[index].trimmed().isEmpty())
 			{
 				result.flags()[i] = false;
@@ -2292,10 +2257,8 @@ void FilterConservedness::apply(const VariantList& variants, FilterResult& resul
 	int i_phylop = annotationColumn(variants, "phyloP");
 	double min_score = getDouble("min_score");
 
-	for(int i=0; i<variants.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		bool ok;
 		double value = variants[i].annotations()[i_phylop].toDouble(&ok);
 		if (!ok || value<min_score)
@@ -2329,10 +2292,8 @@ void FilterRegulatory::apply(const VariantList& variants, FilterResult& result)
 	QString action = getString("action");
 	if (action=="FILTER")
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (variants[i].annotations()[index].trimmed().isEmpty())
 			{
 				result.flags()[i] = false;
@@ -2341,10 +2302,8 @@ void FilterRegulatory::apply(const VariantList& variants, FilterResult& result)
 	}
 	else //REMOVE
 	{
-		for(int i=0; i<variants.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (!variants[i].annotations()[index].trimmed().isEmpty())
 			{
 				result.flags()[i] = false;
@@ -2376,10 +2335,8 @@ void FilterCnvSize::apply(const CnvList& cnvs, FilterResult& result) const
 	if (!enabled_) return;
 
 	double min_size_bases = getDouble("size") * 1000.0;
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (cnvs[i].size() < min_size_bases)
 		{
 			result.flags()[i] = false;
@@ -2408,10 +2365,8 @@ void FilterCnvRegions::apply(const CnvList& cnvs, FilterResult& result) const
 	if (!enabled_) return;
 
 	int min_regions = getInt("regions");
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (cnvs[i].regions()==0) continue; //multi-sample CNV lists sometimes don't contain region counts (e.g. for ClinCNV)
 
 		if (cnvs[i].regions() < min_regions)
@@ -2448,10 +2403,8 @@ void FilterCnvCopyNumber::apply(const CnvList& cnvs, FilterResult& result) const
 	if (cnvs.type()==CnvListType::CNVHUNTER_GERMLINE_SINGLE || cnvs.type()==CnvListType::CNVHUNTER_GERMLINE_SINGLE)
 	{
 		int i_cns = cnvs.annotationIndexByName("region_copy_numbers", true);
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QByteArrayList cns = cnvs[i].annotations()[i_cns].split(',');
 
 			bool hit = false;
@@ -2469,10 +2422,8 @@ void FilterCnvCopyNumber::apply(const CnvList& cnvs, FilterResult& result) const
 	else
 	{
 		int i_cn = cnvs.annotationIndexByName("CN_change", true);
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			const QByteArray& cn = cnvs[i].annotations()[i_cn];
 
 			if (!((!cn_exp_4plus && cn==cn_exp) || (cn_exp_4plus && cn.toInt()>=4)))
@@ -2509,10 +2460,8 @@ void FilterCnvAlleleFrequency::apply(const CnvList& cnvs, FilterResult& result)
 	if (cnvs.type()==CnvListType::CNVHUNTER_GERMLINE_SINGLE || cnvs.type()==CnvListType::CNVHUNTER_GERMLINE_MULTI)
 	{
 		int i_afs = cnvs.annotationIndexByName("region_cnv_af", true);
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QByteArrayList afs = cnvs[i].annotations()[i_afs].split(',');
 
 			bool hit = false;
@@ -2530,10 +2479,8 @@ void FilterCnvAlleleFrequency::apply(const CnvList& cnvs, FilterResult& result)
 	else
 	{
 		int i_af = cnvs.annotationIndexByName("potential_AF", true);
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			const QByteArray& af = cnvs[i].annotations()[i_af];
 
 			if (af.toDouble()>max_af)
@@ -2569,10 +2516,8 @@ void FilterCnvZscore::apply(const CnvList& cnvs, FilterResult& result) const
 
 	double min_z = getDouble("min_z");
 	int i_zs = cnvs.annotationIndexByName("region_zscores", true);
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		QByteArrayList zs = cnvs[i].annotations()[i_zs].split(',');
 
 		bool hit = false;
@@ -2615,10 +2560,8 @@ void FilterCnvLoglikelihood::apply(const CnvList& cnvs, FilterResult& result) co
 	int i_ll = cnvs.annotationIndexByName("loglikelihood", true);
 	if (cnvs.type()==CnvListType::CLINCNV_GERMLINE_SINGLE || cnvs.type()==CnvListType::CLINCNV_TUMOR_NORMAL_PAIR)
 	{
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (scale_by_regions)
 			{
 				double number_of_regions = cnvs[i].regions();
@@ -2641,10 +2584,8 @@ void FilterCnvLoglikelihood::apply(const CnvList& cnvs, FilterResult& result) co
 	else if (cnvs.type()==CnvListType::CLINCNV_GERMLINE_MULTI)
 	{
 		if (scale_by_regions) THROW(ArgumentException, "log-likelihood scaling cannot be applied to multi-sample/trio CNVs!");
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QByteArrayList lls = cnvs[i].annotations()[i_ll].split(',');
 			foreach(const QByteArray& ll, lls)
 			{
@@ -2688,10 +2629,8 @@ void FilterCnvQvalue::apply(const CnvList& cnvs, FilterResult& result) const
 
 	if (cnvs.type()==CnvListType::CLINCNV_GERMLINE_SINGLE)
 	{
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			if (cnvs[i].annotations()[i_q].toDouble()>max_q)
 			{
 				result.flags()[i] = false;
@@ -2700,10 +2639,8 @@ void FilterCnvQvalue::apply(const CnvList& cnvs, FilterResult& result) const
 	}
 	else if (cnvs.type()==CnvListType::CLINCNV_GERMLINE_MULTI)
 	{
-		for(int i=0; i<cnvs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QByteArrayList qs = cnvs[i].annotations()[i_q].split(',');
 			foreach(const QByteArray& q, qs)
 			{
@@ -2746,27 +2683,26 @@ void FilterCnvCompHet::apply(const CnvList& cnvs, FilterResult& result) const
 	if (mode=="n/a") return;
 
 	//count hits per gene for CNVs
-	QMap<QByteArray, int> gene_count;
-	for(int i=0; i<cnvs.count(); ++i)
+	VariantGeneIndex gene_index(cnvs);
+	QVector<int> gene_count(gene_index.geneIdCount(), 0);
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
-		foreach(const QByteArray& gene, cnvs[i].genes())
+		for (int gene_id : gene_index.genes(i))
 		{
-			gene_count[gene] += 1;
+			++gene_count[gene_id];
 		}
 	}
 
-	GeneSet comphet_hit;
+	BitSet comphet_hit(gene_index.geneIdCount());
 
 	//two CNV hits
 	if (mode=="CNV-CNV")
 	{
-		for(auto it=gene_count.cbegin(); it!=gene_count.cend(); ++it)
+		for (int g=0; g<gene_index.geneIdCount(); ++g)
 		{
-			if (it.value()>1)
+			if (gene_count[g]>1)
 			{
-				comphet_hit.insert(it.key());
+				comphet_hit.setBit(g);
 			}
 		}
 	}
@@ -2774,30 +2710,28 @@ void FilterCnvCompHet::apply(const CnvList& cnvs, FilterResult& result) const
 	//one CNV and one SNV/INDEL hit
 	else if (mode=="CNV-SNV/INDEL")
 	{
-		GeneSet single_hit_cnv;
-		for(auto it=gene_count.cbegin(); it!=gene_count.cend(); ++it)
+		foreach(int g, het_hit_genes_.ids())
 		{
-			if (it.value()==1)
+			if (g<gene_index.geneIdCount() && gene_count[g]==1)
 			{
-				single_hit_cnv.insert(it.key());
+				comphet_hit.setBit(g);
 			}
 		}
+	}
 
-		foreach(const QByteArray& gene, single_hit_cnv)
+	//flag passing CNVs
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
+	{
+		bool match = false;
+		for (int gene_id : gene_index.genes(i))
 		{
-			if (het_hit_genes_.contains(gene))
+			if (comphet_hit[gene_id])
 			{
-				comphet_hit.insert(gene);
+				match = true;
+				break;
 			}
 		}
-	}
-
-	//flag passing CNVs
-	for(int i=0; i<cnvs.count(); ++i)
-	{
-		if (!result.flags()[i]) continue;
-
-		result.flags()[i] = cnvs[i].genes().intersectsWith(comphet_hit);
+		result.flags()[i] = match;
 	}
 }
 
@@ -2821,10 +2755,8 @@ void FilterCnvOMIM::apply(const CnvList& cnvs, FilterResult& result) const
 
 	int index = cnvs.annotationIndexByName("omim", true);
 
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (cnvs[i].annotations()[index].trimmed().isEmpty())
 		{
 			result.flags()[i] = false;
@@ -2857,10 +2789,8 @@ void FilterCnvCnpOverlap::apply(const CnvList& cnvs, FilterResult& result) const
 	int index = cnvs.annotationIndexByName(getString("column").toUtf8(), true);
 	double max_ol = getDouble("max_ol");
 
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (cnvs[i].annotations()[index].left(5).toDouble()>max_ol)
 		{
 			result.flags()[i] = false;
@@ -2895,10 +2825,8 @@ void FilterCnvGeneConstraint::apply(const CnvList& cnvs, FilterResult& result) c
 	double max_oe_lof = getDouble("max_oe_lof");
 
 	//filter
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: 34P13.14 (region=complete oe_lof=), ...
 		QByteArrayList gene_entries= cnvs[i].annotations()[i_geneinfo].split(',');
 		bool any_gene_passed = false;
@@ -2950,10 +2878,8 @@ void FilterCnvGeneOverlap::apply(const CnvList& cnvs, FilterResult& result) cons
 	QByteArrayList selected = selectedOptions();
 
 	//filter
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: 34P13.14 (region=complete oe_lof=), ...
 		QByteArrayList gene_entries = cnvs[i].annotations()[i_geneinfo].split(',');
 		bool any_gene_passed = false;
@@ -3006,10 +2932,8 @@ void FilterCnvPathogenicCnvOverlap::apply(const CnvList& cnvs, FilterResult& res
 
 	int index = cnvs.annotationIndexByName("ngsd_pathogenic_cnvs", true);
 
-	for(int i=0; i<cnvs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (cnvs[i].annotations()[index].trimmed().isEmpty())
 		{
 			result.flags()[i] = false;
@@ -3045,10 +2969,8 @@ void FilterSvType::apply(const BedpeFile& svs, FilterResult& result) const
 	QStringList sv_types = getStringList("Structural variant type");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		result.flags()[i] = sv_types.contains(StructuralVariantTypeToString(svs[i].type()));
 	}
 }
@@ -3077,9 +2999,8 @@ void FilterSvRemoveChromosomeType::apply(const BedpeFile& svs, FilterResult& res
 
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
 		if (remove_special_chr)
 		{
 			// only pass if both positions are located on standard chromosomes
@@ -3126,10 +3047,8 @@ void FilterSvGenotype::apply(const BedpeFile& svs, FilterResult& result) const
 	int format_col_index = svs.annotationIndexByName("FORMAT");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get genotype
 
 		// get format keys and values
@@ -3180,10 +3099,8 @@ void FilterSvQuality::apply(const BedpeFile& svs, FilterResult& result) const
 	int quality_col_index = svs.annotationIndexByName("QUAL");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		result.flags()[i] = Helper::toDouble(svs[i].annotations()[quality_col_index]) >= min_quality;
 	}
 }
@@ -3218,10 +3135,8 @@ void FilterSvFilterColumn::apply(const BedpeFile& svs, FilterResult& result) con
 
 	if (action=="REMOVE")
 	{
-		for(int i=0; i<svs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QSet<QString> sv_entries = QString(svs[i].annotations()[filter_col_index]).split(';').toSet();
 			// check if intersection of both list == 0 -> remove entry otherwise
 			result.flags()[i] = (sv_entries.intersect(filter_entries).size() == 0);
@@ -3229,10 +3144,8 @@ void FilterSvFilterColumn::apply(const BedpeFile& svs, FilterResult& result) con
 	}
 	else if (action=="FILTER")
 	{
-		for(int i=0; i<svs.count(); ++i)
+		for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 		{
-			if (!result.flags()[i]) continue;
-
 			QSet<QString> sv_entries = QString(svs[i].annotations()[filter_col_index]).split(';').toSet();
 			// iterate over list of required entries
 			foreach (QString filter_entry, filter_entries)
@@ -3303,10 +3216,8 @@ void FilterSvPairedReadAF::apply(const BedpeFile& svs, FilterResult& result) con
 	int format_col_index = svs.annotationIndexByName("FORMAT");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get format keys and values
 		QByteArrayList format_keys = svs[i].annotations()[format_col_index].split(':');
 		QByteArrayList format_values = svs[i].annotations()[format_col_index + 1].split(':');
@@ -3362,10 +3273,8 @@ void FilterSvSplitReadAF::apply(const BedpeFile& svs, FilterResult& result) cons
 	int format_col_index = svs.annotationIndexByName("FORMAT");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get format keys and values
 		QByteArrayList format_keys = svs[i].annotations()[format_col_index].split(':');
 		QByteArrayList format_values = svs[i].annotations()[format_col_index + 1].split(':');
@@ -3427,10 +3336,8 @@ void FilterSvPeReadDepth::apply(const BedpeFile& svs, FilterResult& result) cons
 	int format_col_index = svs.annotationIndexByName("FORMAT");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get format keys and values
 		QByteArrayList format_keys = svs[i].annotations()[format_col_index].split(':');
 		QByteArrayList format_values = svs[i].annotations()[format_col_index + 1].split(':');
@@ -3482,10 +3389,8 @@ void FilterSvSomaticscore::apply(const BedpeFile& svs, FilterResult& result) con
 	if (i_somaticscore == -1) THROW(FileParseException, "No SOMATICSCORE column found in BEDPE file!");
 
 	// iterate over all SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get somaticscore
 		double somaticscore = Helper::toInt(svs[i].annotations()[i_somaticscore], "Somaticscore", QString::number(i));
 		// compare AF with filter
@@ -3527,10 +3432,8 @@ void FilterSvGeneConstraint::apply(const BedpeFile& svs, FilterResult& result) c
 	double max_oe_lof = getDouble("max_oe_lof");
 
 	//filter
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: 34P13.14 (region=complete oe_lof=), ...
 		QByteArrayList gene_entries= svs[i].annotations()[i_gene_info].split(',');
 		bool any_gene_passed = false;
@@ -3591,10 +3494,8 @@ void FilterSvGeneOverlap::apply(const BedpeFile& svs, FilterResult& result) cons
 	QByteArrayList selected = selectedOptions();
 
 	//filter
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		//parse gene_info entry - example: 34P13.14 (region=complete oe_lof=), ...
 		QByteArrayList gene_entries = svs[i].annotations()[i_gene_info].split(',');
 		bool any_gene_passed = false;
@@ -3661,10 +3562,8 @@ void FilterSvSize::apply(const BedpeFile& svs, FilterResult& result) const
 	int min_size = getInt("min_size", false);
 	int max_size = getInt("max_size", false);
 
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		// get SV length
 		int sv_length = svs.estimatedSvSize(i);
 		if (sv_length < min_size) result.flags()[i] = false;
@@ -3692,10 +3591,8 @@ void FilterSvOMIM::apply(const BedpeFile& svs, FilterResult& result) const
 
 	int index = svs.annotationIndexByName("OMIM", true);
 
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		if (svs[i].annotations()[index].trimmed().isEmpty())
 		{
 			result.flags()[i] = false;
@@ -3731,10 +3628,8 @@ void FilterSvCompHet::apply(const BedpeFile& svs, FilterResult& result) const
 
 	//count hits per gene for SVs
 	QMap<QByteArray, int> gene_count;
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		GeneSet genes;
 		genes << svs[i].annotations()[i_genes].split(';');
 
@@ -3780,10 +3675,8 @@ void FilterSvCompHet::apply(const BedpeFile& svs, FilterResult& result) const
 	}
 
 	//flag passing SVs
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		GeneSet genes;
 		genes << svs[i].annotations()[i_genes].split(';');
 		result.flags()[i] = genes.intersectsWith(comphet_hit);
@@ -3825,10 +3718,8 @@ void FilterSvCountNGSD::apply(const BedpeFile& svs, FilterResult& result) const
 		ngsd_col_index = svs.annotationIndexByName("NGSD_COUNT");
 	}
 
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		int ngsd_count;
 
 		if (overlap_match)
@@ -3872,10 +3763,8 @@ void FilterSvAfNGSD::apply(const BedpeFile& svs, FilterResult& result) const
 
 	int ngsd_col_index = svs.annotationIndexByName("NGSD_COUNT");
 
-	for(int i=0; i<svs.count(); ++i)
+	for(int i=result.nextPassing(0); i!=-1; i=result.nextPassing(i+1))
 	{
-		if (!result.flags()[i]) continue;
-
 		result.flags()[i] = Helper::toDouble(svs[i].annotations()[ngsd_col_index].split('(')[1].split(')')[0], "NGSD count column", QString::number(i)) <= max_af;
 	}
 
@@ -6,13 +6,13 @@
 #include "GeneSet.h"
 #include "VariantType.h"
 #include "BedpeFile.h"
+#include "BitSet.h"
 
 #include <QVariant>
 #include <QString>
 #include <QList>
 #include <QSharedPointer>
 #include <QMap>
-#include <QBitArray>
 #include <QRegularExpression>
 
 //Parameter type
@@ -53,7 +53,13 @@ class CPPNGSSHARED_EXPORT FilterResult
 		///Returns if the variant at @p index passed the filter.
 		bool passing(int index) const
 		{
-			return pass[index];
+			return pass.testBit(index);
+		}
+
+		///Returns the index of the next passing variant at or after @p index, or -1 if there is none.
+		int nextPassing(int index) const
+		{
+			return pass.nextSetBit(index);
 		}
 
 		///Returns the number of passing variants.
@@ -65,7 +71,7 @@ class CPPNGSSHARED_EXPORT FilterResult
 		///Inverts the flags.
 		void invert()
 		{
-			pass = ~pass;
+			pass.invert();
 		}
 
 		///Resets the flags to all passing.
@@ -74,14 +80,32 @@ class CPPNGSSHARED_EXPORT FilterResult
 			pass.fill(value);
 		}
 
+		///Keeps only variants that pass both filter results.
+		void intersect(const FilterResult& rhs)
+		{
+			pass &= rhs.pass;
+		}
+
+		///Keeps variants that pass at least one of the filter results.
+		void unite(const FilterResult& rhs)
+		{
+			pass |= rhs.pass;
+		}
+
+		///Removes variants that pass the other filter result.
+		void subtract(const FilterResult& rhs)
+		{
+			pass.andNot(rhs.pass);
+		}
+
 		///Read-write access to flags array.
-		QBitArray& flags()
+		BitSet& flags()
 		{
 			return pass;
 		}
 
 		///Read-only access to flags array.
-		const QBitArray& flags() const
+		const BitSet& flags() const
 		{
 			return pass;
 		}
@@ -93,7 +117,7 @@ class CPPNGSSHARED_EXPORT FilterResult
 		void tagNonPassing(VariantList& variants, QByteArray tag, QByteArray description);
 
 	private:
-		QBitArray pass;
+		BitSet pass;
 };
 
 //Base class for all filters
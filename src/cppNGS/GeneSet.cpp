@@ -1,46 +1,147 @@
 #include "GeneSet.h"
 #include "Helper.h"
+#include <QHash>
+#include <QReadWriteLock>
+#include <deque>
+#include <iterator>
+
+//Data of the gene symbol table (a deque is used because references to its elements stay valid when elements are appended)
+struct GeneSymbolTableData
+{
+	QReadWriteLock lock;
+	QHash<QByteArray, int> ids;
+	std::deque<QByteArray> symbols;
+};
+
+static GeneSymbolTableData& geneSymbolTableData()
+{
+	static GeneSymbolTableData data;
+	return data;
+}
+
+int GeneSymbolTable::id(const QByteArray& gene)
+{
+	int id;
+	intern(gene, id);
+	return id;
+}
+
+const QByteArray& GeneSymbolTable::intern(const QByteArray& gene, int& id)
+{
+	GeneSymbolTableData& data = geneSymbolTableData();
+
+	//fast path: already contained
+	{
+		QReadLocker locker(&data.lock);
+		auto it = data.ids.constFind(gene);
+		if (it!=data.ids.cend())
+		{
+			id = it.value();
+			return data.symbols[id];
+		}
+	}
+
+	//add (if not added by another thread in the meantime)
+	QWriteLocker locker(&data.lock);
+	auto it = data.ids.constFind(gene);
+	if (it!=data.ids.cend())
+	{
+		id = it.value();
+		return data.symbols[id];
+	}
+
+	id = static_cast<int>(data.symbols.size());
+	data.symbols.push_back(gene);
+	data.ids.insert(gene, id);
+
+	return data.symbols.back();
+}
+
+int GeneSymbolTable::find(const QByteArray& gene)
+{
+	GeneSymbolTableData& data = geneSymbolTableData();
+
+	QReadLocker locker(&data.lock);
+	return data.ids.value(gene, -1);
+}
+
+const QByteArray& GeneSymbolTable::symbol(int id)
+{
+	GeneSymbolTableData& data = geneSymbolTableData();
+
+	QReadLocker locker(&data.lock);
+	return data.symbols[id];
+}
+
+int GeneSymbolTable::count()
+{
+	GeneSymbolTableData& data = geneSymbolTableData();
+
+	QReadLocker locker(&data.lock);
+	return static_cast<int>(data.symbols.size());
+}
 
 GeneSet::GeneSet()
 	: QList<QByteArray>()
+	, ids_()
 {
 }
 
 void GeneSet::insert(const QByteArray& gene)
 {
 	QByteArray tmp = gene.trimmed().toUpper();
-	if (tmp.isEmpty() || set_.contains(tmp)) return;
+	if (tmp.isEmpty()) return;
 
-	auto it = std::lower_bound(begin(), end(), tmp);
-	QList<QByteArray>::insert(it, tmp);
+	int id;
+	const QByteArray& symbol = GeneSymbolTable::intern(tmp, id);
+	auto id_it = std::lower_bound(ids_.begin(), ids_.end(), id);
+	if (id_it!=ids_.end() && *id_it==id) return;
+	ids_.insert(id_it, id);
 
-	set_.insert(tmp);
+	auto it = std::lower_bound(begin(), end(), symbol);
+	QList<QByteArray>::insert(it, symbol);
 }
 
-bool GeneSet::containsAll(const GeneSet& genes) const
+void GeneSet::insert(const GeneSet& genes)
 {
-	foreach(const QByteArray& gene, genes)
+	if (genes.isEmpty()) return;
+	if (isEmpty())
 	{
-		if (!contains(gene)) return false;
+		*this = genes;
+		return;
 	}
 
-	return true;
+	//merge identifiers
+	QVector<int> ids;
+	ids.reserve(ids_.count() + genes.ids_.count());
+	std::set_union(ids_.cbegin(), ids_.cend(), genes.ids_.cbegin(), genes.ids_.cend(), std::back_inserter(ids));
+	if (ids.count()==ids_.count()) return;
+	ids_ = ids;
+
+	updateGenes();
 }
 
 GeneSet GeneSet::intersect(const GeneSet& genes) const
 {
 	GeneSet output;
 
-	QSet<QByteArray> tmp = set_;
-	tmp.intersect(genes.set_);
-	foreach(const QByteArray& gene, tmp)
-	{
-		output.insert(gene);
-	}
+	std::set_intersection(ids_.cbegin(), ids_.cend(), genes.ids_.cbegin(), genes.ids_.cend(), std::back_inserter(output.ids_));
+	output.updateGenes();
 
 	return output;
 }
 
+void GeneSet::updateGenes()
+{
+	QList<QByteArray>::clear();
+	reserve(ids_.count());
+	foreach(int id, ids_)
+	{
+		append(GeneSymbolTable::symbol(id));
+	}
+	std::sort(begin(), end());
+}
+
 void GeneSet::store(QString filename) const
 {
 	auto handle = Helper::openFileForWriting(filename);
@@ -4,10 +4,30 @@
 #include "cppNGS_global.h"
 #include <QList>
 #include <QSet>
+#include <QVector>
 #include <QByteArray>
 #include <QDataStream>
+#include <algorithm>
+
+// Global table of interned gene names. Each gene name is assigned a unique integer identifier. The table is thread-safe.
+// Entries are never removed, i.e. the table grows with each distinct gene name for the lifetime of the process.
+class CPPNGSSHARED_EXPORT GeneSymbolTable
+{
+	public:
+		///Returns the identifier of a gene name. If the name is not contained, it is added.
+		static int id(const QByteArray& gene);
+		///Returns the interned gene name and its identifier. If the name is not contained, it is added. The reference stays valid.
+		static const QByteArray& intern(const QByteArray& gene, int& id);
+		///Returns the identifier of a gene name, or -1 if it is not contained.
+		static int find(const QByteArray& gene);
+		///Returns the gene name of an identifier. The reference stays valid.
+		static const QByteArray& symbol(int id);
+		///Returns the number of gene names.
+		static int count();
+};
 
 // A set of gene names (sorted, upper-case and without duplicates)
+// The names are interned (see GeneSymbolTable), so set operations work on sorted integer identifiers.
 class CPPNGSSHARED_EXPORT GeneSet
 	: protected QList<QByteArray>
 {
@@ -29,13 +49,7 @@ class CPPNGSSHARED_EXPORT GeneSet
 		void insert(const QByteArray& gene);
 
 		///Inserts a gene set
-		void insert(const GeneSet& genes)
-		{
-			foreach(const QByteArray& gene, genes)
-			{
-				insert(gene);
-			}
-		}
+		void insert(const GeneSet& genes);
 
 		///Inserts a gene list
 		void insert(const QByteArrayList& genes)
@@ -71,38 +85,49 @@ class CPPNGSSHARED_EXPORT GeneSet
 		void clear()
 		{
 			QList<QByteArray>::clear();
-			set_.clear();
+			ids_.clear();
 		}
 
 		///Equality check
 		bool operator==(const GeneSet& rhs)
 		{
-			return QList<QByteArray>::operator ==(rhs);
+			return ids_==rhs.ids_;
 		}
 
 		///Inequality check
 		bool operator!=(const GeneSet& rhs)
 		{
-			return QList<QByteArray>::operator!=(rhs);
+			return ids_!=rhs.ids_;
 		}
 
 		///Checks if the gene is contained
 		bool contains(const QByteArray& gene) const
 		{
-			QByteArray tmp = gene.trimmed().toUpper();
-			return set_.contains(tmp);
+			int id = GeneSymbolTable::find(gene.trimmed().toUpper());
+			return id!=-1 && std::binary_search(ids_.cbegin(), ids_.cend(), id);
 		}
 		///Checks if the gene is contained
-		bool containsAll(const GeneSet& genes) const;
+		bool containsAll(const GeneSet& genes) const
+		{
+			return std::includes(ids_.cbegin(), ids_.cend(), genes.ids_.cbegin(), genes.ids_.cend());
+		}
+		///Returns the sorted identifiers of the genes (see GeneSymbolTable)
+		const QVector<int>& ids() const
+		{
+			return ids_;
+		}
 		///Returns the intersection of two gene sets
 		GeneSet intersect(const GeneSet& genes) const;
 		///Checks if any gene is contained
 		bool intersectsWith(const GeneSet& genes) const
 		{
-			//NOTE: can be replaced when we no longer use Qt 5.5: return set_.intersects(genes.set_);
-			for (auto it = genes.cbegin(); it != genes.cend(); ++it)
+			auto it = ids_.cbegin();
+			auto it2 = genes.ids_.cbegin();
+			while (it!=ids_.cend() && it2!=genes.ids_.cend())
 			{
-				if (contains(*it)) return true;
+				if (*it<*it2) ++it;
+				else if (*it2<*it) ++it2;
+				else return true;
 			}
 
 			return false;
@@ -120,13 +145,16 @@ class CPPNGSSHARED_EXPORT GeneSet
 		///Converts the datastructure to a string list
 		QStringList toStringList() const;
 		///Converts the datastructure to a set
-		const QSet<QByteArray>& toSet() const
+		QSet<QByteArray> toSet() const
 		{
-			return set_;
+			return QSet<QByteArray>::fromList(*this);
 		}
 
 	protected:
-		QSet<QByteArray> set_;
+		QVector<int> ids_; //sorted identifiers of the genes (see GeneSymbolTable)
+
+		///Creates the sorted gene list from the identifiers
+		void updateGenes();
 };
 
 #endif // GENESET_H
@@ -95,6 +95,113 @@ QList<MidClash> MidCheck::check(QList<SampleMids> mids, int index1_length, int i
 	return output;
 }
 
+BarcodeTable MidCheck::barcodeTable(QList<SampleMids> mids, int index1_length, int index2_length, int mismatches1, int mismatches2)
+{
+	BarcodeTable output;
+
+	for(int i=0; i<mids.count(); ++i)
+	{
+		//trim MIDs to usable length
+		QByteArray mid1 = mids[i].mid1_seq.left(index1_length).toLatin1().toUpper();
+		QByteArray mid2 = mids[i].mid2_seq.left(index2_length).toLatin1().toUpper();
+		if (mid1.isEmpty()) THROW(ArgumentException, "MID 1 of sample " + mids[i].name + " is empty!");
+
+		//add all sequences within the allowed distance (samples are processed in order, so the sample lists are sorted)
+		foreach(const QByteArray& seq, hammingNeighbors(mid1, mismatches1))
+		{
+			output.index1_[seq] << i;
+		}
+		if (!mid2.isEmpty())
+		{
+			foreach(const QByteArray& seq, hammingNeighbors(mid2, mismatches2))
+			{
+				output.index2_[seq] << i;
+			}
+		}
+		output.dual_ << !mid2.isEmpty();
+	}
+
+	return output;
+}
+
+int BarcodeTable::sample(const QByteArray& seq1, const QByteArray& seq2) const
+{
+	auto it1 = index1_.find(seq1);
+	if (it1==index1_.end()) return -1;
+	const QList<int>& samples1 = it1.value();
+
+	//samples with dual index: intersection of the samples matching index 1 and index 2
+	int match = -1;
+	int match_count = 0;
+	if (!seq2.isEmpty())
+	{
+		auto it2 = index2_.find(seq2);
+		if (it2!=index2_.end())
+		{
+			const QList<int>& samples2 = it2.value();
+			int i1 = 0;
+			int i2 = 0;
+			while (i1<samples1.count() && i2<samples2.count())
+			{
+				if (samples1[i1]<samples2[i2]) ++i1;
+				else if (samples2[i2]<samples1[i1]) ++i2;
+				else
+				{
+					match = samples1[i1];
+					++match_count;
+					++i1;
+					++i2;
+				}
+			}
+		}
+		if (match_count==1) return match;
+	}
+
+	//samples with single index
+	match = -1;
+	match_count = 0;
+	foreach(int sample, samples1)
+	{
+		if (dual_[sample]) continue;
+		match = sample;
+		++match_count;
+	}
+
+	return match_count==1 ? match : -1;
+}
+
+QList<QByteArray> MidCheck::hammingNeighbors(const QByteArray& seq, int mismatches)
+{
+	QList<QByteArray> output;
+	output << seq;
+
+	//add sequences with one more mismatch in each round (mismatches are only placed after the position of the previous mismatch to avoid duplicates)
+	QList<QPair<QByteArray, int>> last;
+	last << qMakePair(seq, 0);
+	for (int m=0; m<mismatches; ++m)
+	{
+		QList<QPair<QByteArray, int>> current;
+		for (int i=0; i<last.count(); ++i)
+		{
+			for (int pos=last[i].second; pos<seq.length(); ++pos)
+			{
+				foreach(char base, QByteArray("ACGTN"))
+				{
+					if (base==seq[pos]) continue;
+
+					QByteArray tmp = last[i].first;
+					tmp[pos] = base;
+					current << qMakePair(tmp, pos+1);
+					output << tmp;
+				}
+			}
+		}
+		last = current;
+	}
+
+	return output;
+}
+
 QString SampleMids::lanesAsString() const
 {
 	QStringList output;
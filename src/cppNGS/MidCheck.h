@@ -7,6 +7,7 @@
 #include <QString>
 #include <QList>
 #include <QSet>
+#include <QHash>
 
 //Datastructure for sample MIDs
 struct CPPNGSSHARED_EXPORT SampleMids
@@ -30,6 +31,21 @@ struct CPPNGSSHARED_EXPORT MidClash
 	int s2_index;
 };
 
+//Lookup table for demultiplexing (see MidCheck::barcodeTable)
+class CPPNGSSHARED_EXPORT BarcodeTable
+{
+public:
+	//Returns the index of the sample that matches the index sequences, or -1 if no sample or several samples match. @p seq2 is empty for reads without index 2. Samples with single index are used if no sample with dual index matches.
+	int sample(const QByteArray& seq1, const QByteArray& seq2) const;
+
+protected:
+	QHash<QByteArray, QList<int>> index1_; //index 1 sequence > matching samples (sorted)
+	QHash<QByteArray, QList<int>> index2_; //index 2 sequence > matching samples with dual index (sorted)
+	QList<bool> dual_; //sample has dual index
+
+	friend class MidCheck;
+};
+
 //MID clash check
 class CPPNGSSHARED_EXPORT MidCheck
 {
@@ -37,8 +53,12 @@ public:
 	static QPair<int, int> lengthFromRecipe(QString recipe);
 	static QPair<int, int> lengthFromSamples(const QList<SampleMids>& mids);
 	static QList<MidClash> check(QList<SampleMids> mids, int index1_length, int index2_length, QStringList& messages);
+	//Returns a lookup table for demultiplexing: all index 1 and index 2 sequences within the given number of mismatches of a sample MID are mapped to the sample. Index 1 and index 2 are stored separately, i.e. the table size is linear in the number of neighbor sequences.
+	static BarcodeTable barcodeTable(QList<SampleMids> mids, int index1_length, int index2_length, int mismatches1, int mismatches2);
 
 protected:
+	//Returns all sequences (alphabet ACGTN) within the given Hamming distance of a sequence.
+	static QList<QByteArray> hammingNeighbors(const QByteArray& seq, int mismatches);
 	MidCheck() = delete;
 };
 
@@ -9,8 +9,11 @@
 #include <QTextStream>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QThreadPool>
+#include <QRunnable>
 #include <cmath>
 #include <vector>
+#include <algorithm>
 
 VariantList NGSHelper::getKnownVariants(QString build, bool only_snvs, double min_af, double max_af, const BedFile* roi)
 {
@@ -36,10 +39,8 @@ VariantList NGSHelper::getKnownVariants(QString build, bool only_snvs, double mi
 	if (min_set || max_set)
 	{
 		int i_af = output.annotationIndexByName("AF");
-		for (int i=0; i<output.count(); ++i)
+		for (int i=filter_result.nextPassing(0); i!=-1; i=filter_result.nextPassing(i+1))
 		{
-			if (!filter_result.passing(i)) continue;
-
 			double af = output[i].annotations()[i_af].toDouble();
 			filter_result.flags()[i] = (!min_set || af>min_af) && (!max_set || af<max_af);
 		}
@@ -58,72 +59,311 @@ VariantList NGSHelper::getKnownVariants(QString build, bool only_snvs, double mi
 	return output;
 }
 
+///Input file of NGSHelper::createSampleOverview. The file is streamed chromosome by chromosome, using an index of the chromosome start positions in the file.
+///The first call of run() parses the header and creates the index. Later calls read the next chunk of variants of the current chromosome.
+class SampleOverviewInput
+	: public QRunnable
+{
+public:
+	SampleOverviewInput(QString filename, int chunk_size)
+		: QRunnable()
+		, filename_(filename)
+		, file_(Helper::openFileForReading(filename))
+		, chunk_size_(chunk_size)
+		, indexed_(false)
+		, error_()
+		, header_()
+		, chr_starts_()
+		, chrs_()
+		, chr_pos_()
+		, anno_indices_()
+		, geno_index_(-1)
+		, chr_()
+		, chr_done_(true)
+		, queue_()
+		, window_()
+	{
+		setAutoDelete(false);
+	}
+
+	void run() override
+	{
+		try
+		{
+			if (!indexed_)
+			{
+				createIndex();
+				indexed_ = true;
+			}
+			else
+			{
+				readChunk();
+			}
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
+		}
+	}
+
+	///Throws the exception that occured in run() - if any.
+	void checkError() const
+	{
+		if (!error_.isEmpty()) THROW(FileParseException, error_);
+	}
+
+	///Starts streaming the variants of a chromosome.
+	void startChromosome(const Chromosome& chr)
+	{
+		chr_ = chr;
+		queue_.clear();
+		window_.clear();
+		chr_done_ = !chr_pos_.contains(chr.num());
+		if (!chr_done_) file_->seek(chr_pos_[chr.num()]);
+	}
+
+	///Returns if there are unread variants of the current chromosome.
+	bool canRead() const
+	{
+		return !chr_done_;
+	}
+
+	///Reads up to 'chunk_size' variants of the current chromosome into the queue.
+	void readChunk()
+	{
+		int c_read = 0;
+		while (c_read<chunk_size_ && !file_->atEnd())
+		{
+			QByteArray line = file_->readLine();
+			while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+			if (line.isEmpty()) continue;
+
+			QList<QByteArray> fields = line.split('\t');
+			if (fields.count()!=5+header_.annotations().count())
+			{
+				THROW(FileParseException, "Variant TSV file '" + filename_ + "' contains line with wrong number of fields: '" + line + "'");
+			}
+			Chromosome chr(fields[0]);
+			if (chr!=chr_)
+			{
+				chr_done_ = true;
+				return;
+			}
+
+			//keep output columns only - the genotype/AF column is appended last
+			QList<QByteArray> annos;
+			annos.reserve(anno_indices_.count() + 1);
+			foreach(int index, anno_indices_)
+			{
+				annos << fields[5+index];
+			}
+			annos << fields[5+geno_index_];
+
+			queue_.append(Variant(chr, atoi(fields[1]), atoi(fields[2]), fields[3], fields[4], annos));
+			++c_read;
+		}
+		if (file_->atEnd()) chr_done_ = true;
+	}
+
+	QString filename_;
+	QSharedPointer<QFile> file_;
+	int chunk_size_;
+	bool indexed_;
+	QString error_;
+
+	VariantList header_; //header only, no variants
+	QList<QPair<QByteArray, qint64>> chr_starts_; //name and file position of the first variant of each chromosome (in file order)
+	QList<Chromosome> chrs_; //chromosomes in file order
+	QHash<int, qint64> chr_pos_; //file position of the first variant of each chromosome
+	QVector<int> anno_indices_; //indices of output columns
+	int geno_index_; //index of genotype/AF column
+
+	Chromosome chr_;
+	bool chr_done_;
+	QList<Variant> queue_; //variants that were read, but not merged yet
+	QList<Variant> window_; //merged variants that can still overlap with following variants
+
+protected:
+	///Creates the chromosome index from the chromosome start positions determined by run().
+	///Has to be called from the main thread for all inputs in the same order, so that non-standard chromosomes are numbered in a deterministic order. Throws an exception if the file is not sorted.
+	void createChromosomeIndex()
+	{
+		typedef QPair<QByteArray, qint64> ChrStart;
+		foreach(const ChrStart& chr_start, chr_starts_)
+		{
+			Chromosome chr(chr_start.first);
+			if (chr_pos_.contains(chr.num()))
+			{
+				THROW(FileParseException, "Variant TSV file '" + filename_ + "' is not sorted: variants of chromosome " + chr.str() + " are not consecutive!");
+			}
+			chrs_ << chr;
+			chr_pos_[chr.num()] = chr_start.second;
+		}
+	}
+
+protected:
+	///Parses the header (see VariantList::loadHeaderOnly) and determines the start positions of the chromosomes. Throws an exception if the file is not sorted.
+	///Chromosome objects are not created here: the numbers of non-standard chromosomes would depend on the order in which the worker threads run.
+	void createIndex()
+	{
+		header_.loadHeaderOnly(filename_);
+
+		QByteArray last_chr;
+		QSet<QByteArray> chrs_done;
+		int last_start = -1;
+		while(!file_->atEnd())
+		{
+			qint64 pos = file_->pos();
+			QByteArray line = file_->readLine();
+			while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+			if (line.isEmpty() || line.startsWith("#")) continue;
+
+			//variant line (only chromosome and start are parsed)
+			int tab1 = line.indexOf('\t');
+			int tab2 = tab1==-1 ? -1 : line.indexOf('\t', tab1+1);
+			if (tab2==-1)
+			{
+				THROW(FileParseException, "Variant TSV file line with less than five fields found: '" + line + "'");
+			}
+			QByteArray chr = line.left(tab1).trimmed();
+			int start = atoi(line.mid(tab1+1, tab2-tab1-1));
+			if (chr!=last_chr)
+			{
+				if (chrs_done.contains(chr))
+				{
+					THROW(FileParseException, "Variant TSV file '" + filename_ + "' is not sorted: variants of chromosome " + chr + " are not consecutive!");
+				}
+				chrs_done << chr;
+				chr_starts_ << qMakePair(chr, pos);
+				last_chr = chr;
+			}
+			else if (start<last_start)
+			{
+				THROW(FileParseException, "Variant TSV file '" + filename_ + "' is not sorted: " + chr + ":" + QString::number(start) + " after " + chr + ":" + QString::number(last_start) + "!");
+			}
+			last_start = start;
+		}
+	}
+};
+
+///Reads the next chunk of all inputs with less than @p min_queued queued variants (in parallel).
+static void fillSampleOverviewInputs(QList<QSharedPointer<SampleOverviewInput>>& inputs, QThreadPool& pool, int min_queued)
+{
+	foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
+	{
+		if (input->canRead() && input->queue_.count()<min_queued) pool.start(input.data());
+	}
+	pool.waitForDone();
+
+	foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
+	{
+		input->checkError();
+	}
+}
+
+///Returns the sample column entry of variant @p v, based on the variants of one input (in file order) that might overlap it.
+static QByteArray sampleOverviewEntry(const Variant& v, const QList<const Variant*>& candidates, int indel_window)
+{
+	if (v.isSNV()) //SNP
+	{
+		QByteArray entry = "no";
+		foreach(const Variant* v2, candidates)
+		{
+			if (v2->start()<=v.end() && v2->end()>=v.start() && v2->ref()==v.ref() && v2->obs()==v.obs())
+			{
+				entry = "yes (" + v2->annotations().last() + ")";
+			}
+		}
+		return entry;
+	}
+
+	//indel
+	QList<const Variant*> matches;
+	foreach(const Variant* v2, candidates)
+	{
+		if (v2->start()<=v.end()+indel_window && v2->end()>=v.start()-indel_window) matches << v2;
+	}
+
+	//exact match (start, obs, ref)
+	foreach(const Variant* v2, matches)
+	{
+		if (v2->start()==v.start() && v2->ref()==v.ref() && v2->obs()==v.obs()) return "yes (" + v2->annotations().last() + ")";
+	}
+
+	//same indel nearby (ref, obs)
+	foreach(const Variant* v2, matches)
+	{
+		if (v2->ref()==v.ref() && v2->obs()==v.obs()) return "near (" + v2->annotations().last() + ")";
+	}
+
+	//different indel nearby
+	foreach(const Variant* v2, matches)
+	{
+		if (!v2->isSNV()) return "different (" + v2->annotations().last() + ")";
+	}
+
+	return "no";
+}
+
 void NGSHelper::createSampleOverview(QStringList in, QString out, int indel_window, bool cols_auto, QStringList cols)
 {
+	//parse headers and index input files (in parallel)
+	const int chunk_size = 10000;
+	QThreadPool pool;
+	QList<QSharedPointer<SampleOverviewInput>> inputs;
+	foreach(QString filename, in)
+	{
+		inputs << QSharedPointer<SampleOverviewInput>(new SampleOverviewInput(filename, chunk_size));
+		pool.start(inputs.last().data());
+	}
+	pool.waitForDone();
+	foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
+	{
+		input->checkError();
+		input->createChromosomeIndex();
+	}
+
 	//determine columns contained in all samples from file headers (keep order)
 	if (cols_auto)
 	{
-		bool init = true;
-		foreach(QString filename, in)
+		for (int i=0; i<inputs.count(); ++i)
 		{
-			auto file = Helper::openFileForReading(filename, false);
-			while (!file->atEnd())
+			QSet<QString> names;
+			foreach(const VariantAnnotationHeader& header, inputs[i]->header_.annotations())
 			{
-				QString line = file->readLine();
-				if (!line.startsWith('#')) break;
-				if (line.startsWith("#chr"))
-				{
-					if (init)
-					{
-						QStringList parts = line.trimmed().split('\t');
-						foreach(QString part, parts)
-						{
-							//skip base columns
-							if (part=="#chr" || part=="start" || part=="end" || part=="ref" || part=="obs") continue;
+				QString name = header.name();
+				names << name;
+				if (i>0) continue;
 
-							//skip sample-specific germline columns
-							if (part=="genotype" || part=="quality") continue;
+				//skip sample-specific germline columns
+				if (name=="genotype" || name=="quality") continue;
 
-							//skip sample-specific somatic columns
-							if (part=="tumor_af" || part=="tumor_dp" || part=="normal_af" || part=="normal_dp")	continue;
+				//skip sample-specific somatic columns
+				if (name=="tumor_af" || name=="tumor_dp" || name=="normal_af" || name=="normal_dp")	continue;
 
-							cols.append(part);
-						}
-						init = false;
-					}
-					else
-					{
-						QSet<QString> parts = line.trimmed().split('\t').toSet();
-						for (int i=cols.count()-1; i>=0; --i)
-						{
-							if (!parts.contains(cols[i]))
-							{
-								cols.removeAt(i);
-							}
-						}
-					}
-				}
+				cols.append(name);
+			}
+
+			for (int c=cols.count()-1; c>=0; --c)
+			{
+				if (!names.contains(cols[c])) cols.removeAt(c);
 			}
-			file->close();
 		}
 	}
 
-	//load variant lists
-	QVector<VariantList> vls;
-	QVector<QVector<int> > vls_anno_indices;
+	//determine column indices
 	QList <VariantAnnotationDescription> vls_anno_descriptions;
-	foreach(QString filename, in)
+	for (int i=0; i<inputs.count(); ++i)
 	{
-		VariantList vl;
-		vl.load(filename, TSV);
+		SampleOverviewInput& input = *(inputs[i]);
+		const VariantList& vl = input.header_;
 
 		//check the all required fields are present in the input file
-		QVector<int> anno_indices;
 		foreach(QString col, cols)
 		{
 			if (col=="genotype") continue;
 			int index = vl.annotationIndexByName(col, true, true);
-			anno_indices.append(index);
+			input.anno_indices_.append(index);
 
 			foreach(VariantAnnotationDescription vad, vl.annotationDescriptions())
 			{
@@ -140,16 +380,36 @@ void NGSHelper::createSampleOverview(QStringList in, QString out, int indel_wind
 			}
 		}
 
-		vls_anno_indices.append(anno_indices);
-		vls.append(vl);
+		//get genotype/AF index
+		AnalysisType type = vl.type();
+		if (type==SOMATIC_SINGLESAMPLE || type==SOMATIC_PAIR)
+		{
+			input.geno_index_ = vl.annotationIndexByName("tumor_af", true, true);
+		}
+		else if (type==GERMLINE_SINGLESAMPLE || type==GERMLINE_TRIO || type==GERMLINE_MULTISAMPLE)
+		{
+			QList<int> affected_cols = vl.getSampleHeader().sampleColumns(true);
+			if (affected_cols.count()==1)
+			{
+				input.geno_index_ = affected_cols[0];
+			}
+			else
+			{
+				THROW(ToolFailedException, "No/several affected in sample header of input file '" + in[i] + "'.");
+			}
+		}
+		else
+		{
+			THROW(ToolFailedException, "Unsupported analysis type in input file '" + in[i] + "'.");
+		}
 	}
 
-	//set up combined variant list (annotation and filter descriptions)
+	//set up combined variant list header (annotation and filter descriptions)
 	VariantList vl_merged;
-	foreach(const VariantList& vl, vls)
+	foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 	{
-		auto it = vl.filters().begin();
-		while(it!=vl.filters().end())
+		auto it = input->header_.filters().cbegin();
+		while(it!=input->header_.filters().cend())
 		{
 			if (!vl_merged.filters().contains(it.key()))
 			{
@@ -158,132 +418,125 @@ void NGSHelper::createSampleOverview(QStringList in, QString out, int indel_wind
 			++it;
 		}
 	}
-	foreach(int index, vls_anno_indices[0])
+	foreach(int index, inputs[0]->anno_indices_)
 	{
-		vl_merged.annotations().append(vls[0].annotations()[index]);
+		vl_merged.annotations().append(inputs[0]->header_.annotations()[index]);
 	}
 	foreach(VariantAnnotationDescription vad, vls_anno_descriptions)
 	{
 		vl_merged.annotationDescriptions().append(vad);
 	}
+	foreach(QString filename, in)
+	{
+		vl_merged.annotationDescriptions().append(VariantAnnotationDescription(QFileInfo(filename).baseName(), ""));
+		vl_merged.annotations().append(VariantAnnotationHeader(QFileInfo(filename).baseName()));
+	}
+
+	//store header - variants are appended below
+	vl_merged.store(out, TSV);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out, false, true);
+	QTextStream stream(out_file.data());
 
-	//merge variants
-	vl_merged.reserve(2 * vls[0].count());
-	for (int i=0; i<vls.count(); ++i)
+	//merge variants chromosome by chromosome (k-way merge of the inputs)
+	QMap<int, Chromosome> chrs;
+	foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 	{
-		for(int j=0; j<vls[i].count(); ++j)
+		foreach(const Chromosome& chr, input->chrs_)
 		{
-			Variant v = vls[i][j];
-			QList<QByteArray> annos = v.annotations();
-			v.annotations().clear();
-			foreach(int index, vls_anno_indices[i])
-			{
-				v.annotations().append(annos[index]);
-			}
-			vl_merged.append(v);
+			chrs[chr.num()] = chr;
 		}
 	}
-
-	//remove duplicates from variant list
-    vl_merged.removeDuplicates(false);
-
-	//append sample columns
-	for (int i=0; i<vls.count(); ++i)
+	foreach(const Chromosome& chr, chrs)
 	{
-		//get genotype/AF index
-		int geno_index = -1;
-		AnalysisType type = vls[i].type();
-		if (type==SOMATIC_SINGLESAMPLE || type==SOMATIC_PAIR)
+		foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 		{
-			geno_index = vls[i].annotationIndexByName("tumor_af", true, true);
+			input->startChromosome(chr);
 		}
-		else if (type==GERMLINE_SINGLESAMPLE || type==GERMLINE_TRIO || type==GERMLINE_MULTISAMPLE)
+
+		while (true)
 		{
-			QList<int> affected_cols = vls[i].getSampleHeader().sampleColumns(true);
-			if (affected_cols.count()==1)
+			fillSampleOverviewInputs(inputs, pool, chunk_size/2);
+
+			//determine next start position
+			int start = -1;
+			foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 			{
-				geno_index = affected_cols[0];
+				if (!input->queue_.isEmpty() && (start==-1 || input->queue_.first().start()<start)) start = input->queue_.first().start();
 			}
-			else
+			if (start==-1) break;
+
+			//collect variants with that start position
+			QList<Variant> group;
+			foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 			{
-				THROW(ToolFailedException, "No/several affected in sample header of input file '" + in[i] + "'.");
-			}
-		}
-		else
-		{
-			THROW(ToolFailedException, "Unsupported analysis type in input file '" + in[i] + "'.");
-		}
+				while (true)
+				{
+					if (input->queue_.isEmpty() && input->canRead()) input->readChunk();
+					if (input->queue_.isEmpty() || input->queue_.first().start()!=start) break;
 
-		//add column header
-		vl_merged.annotationDescriptions().append(VariantAnnotationDescription(QFileInfo(in[i]).baseName(), ""));
-		vl_merged.annotations().append(VariantAnnotationHeader(QFileInfo(in[i]).baseName()));
+					Variant v = input->queue_.takeFirst();
+					input->window_.append(v);
+					v.annotations().removeLast();
+					group.append(v);
+				}
+			}
 
-		//create index over variant list to speed up the search
-		const VariantList& vl = vls[i];
-		ChromosomalIndex<VariantList> cidx(vl);
+			//sort by end, ref and obs and remove duplicates (annotations of the first input containing the variant are used)
+			std::stable_sort(group.begin(), group.end(), [](const Variant& a, const Variant& b)
+			{
+				if (a.end()!=b.end()) return a.end()<b.end();
+				if (a.ref()!=b.ref()) return a.ref()<b.ref();
+				return a.obs()<b.obs();
+			});
+			for (int i=group.count()-1; i>0; --i)
+			{
+				if (group[i].end()==group[i-1].end() && group[i].ref()==group[i-1].ref() && group[i].obs()==group[i-1].obs()) group.removeAt(i);
+			}
 
-		//add sample-specific columns
-		for (int j=0; j<vl_merged.count(); ++j)
-		{
-			Variant& v = vl_merged[j];
-			QByteArray entry = "no";
-			if (v.isSNV()) //SNP
+			//make sure all variants that might overlap with the group are queued
+			int max_end = start;
+			foreach(const Variant& v, group)
 			{
-				QVector<int> matches = cidx.matchingIndices(v.chr(), v.start(), v.end());
-				for (int k=0; k<matches.count(); ++k)
-				{
-					int match = matches[k];
-					if (match!=-1 && vl[match].ref()==v.ref() && vl[match].obs()==v.obs())
-					{
-						entry = "yes (" + vl[match].annotations()[geno_index] + ")";
-					}
-				}
+				max_end = std::max(max_end, v.end() + indel_window);
 			}
-			else //indel
+			foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 			{
-				QVector<int> matches = cidx.matchingIndices(v.chr(), v.start()-indel_window, v.end()+indel_window);
-				if (matches.count()>0)
+				while (input->canRead() && (input->queue_.isEmpty() || input->queue_.last().start()<=max_end)) input->readChunk();
+			}
+
+			//append sample-specific columns and write variants
+			foreach(Variant v, group)
+			{
+				foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
 				{
-					//exact match (start, obs, ref)
-					bool done = false;
-					for (int k=0; k<matches.count(); ++k)
+					QList<const Variant*> candidates;
+					for (int k=0; k<input->window_.count(); ++k)
 					{
-						const Variant& v2 = vl[matches[k]];
-						if (!done && v2.start()==v.start() && v2.ref()==v.ref() && v2.obs()==v.obs())
-						{
-							entry = "yes (" + v2.annotations()[geno_index] + ")";
-							done = true;
-						}
+						candidates << &(input->window_.at(k));
 					}
-
-					//same indel nearby (ref, obs)
-					for (int k=0; k<matches.count(); ++k)
+					for (int k=0; k<input->queue_.count() && input->queue_.at(k).start()<=v.end()+indel_window; ++k)
 					{
-						const Variant& v2 = vl[matches[k]];
-						if (!done && v2.ref()==v.ref() && v2.obs()==v.obs())
-						{
-							entry = "near (" + v2.annotations()[geno_index] + ")";
-							done = true;
-						}
+						candidates << &(input->queue_.at(k));
 					}
 
-					//different indel nearby
-					for (int k=0; k<matches.count(); ++k)
-					{
-						const Variant& v2 = vl[matches[k]];
-						if (!done && !v2.isSNV())
-						{
-							entry = "different (" + v2.annotations()[geno_index] + ")";
-							done = true;
-						}
-					}
+					v.annotations().append(sampleOverviewEntry(v, candidates, indel_window));
+				}
+
+				stream << v.chr().str() << "\t" << v.start() << "\t" << v.end() << "\t" << v.ref() << "\t" << v.obs();
+				foreach(QByteArray entry, v.annotations())
+				{
+					stream << "\t" << entry.replace("\n", " ").replace("\t", " ");
 				}
+				stream << "\n";
+			}
+
+			//remove variants that cannot overlap with following variants
+			foreach(const QSharedPointer<SampleOverviewInput>& input, inputs)
+			{
+				while (!input->window_.isEmpty() && input->window_.first().end()<start-indel_window) input->window_.removeFirst();
 			}
-			v.annotations().append(entry);
 		}
 	}
-
-	vl_merged.store(out, TSV);
 }
 
 QByteArray NGSHelper::expandAminoAcidAbbreviation(QChar amino_acid_change_in)
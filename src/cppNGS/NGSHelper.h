@@ -20,7 +20,7 @@ public:
 	///Soft-clip alignment from the beginning or end (positions are 1-based)
 	static void softClipAlignment(BamAlignment& al, int start_ref_pos, int end_ref_pos);
 
-	///Create sample overview file
+	///Create sample overview file. The input files are streamed, so the variants of each chromosome have to be consecutive and sorted by start position.
 	static void createSampleOverview(QStringList in, QString out, int indel_window=100, bool cols_auto=true, QStringList cols = QStringList());
 
 	///Expands a Amino acid notation with 1 letter to 3 letters
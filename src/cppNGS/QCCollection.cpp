@@ -70,6 +70,17 @@ QCValue QCValue::Image(const QString& name, const QString& filename, const QStri
 	return value;
 }
 
+QCValue QCValue::ImageFromData(const QString& name, const QByteArray& png, const QString& description, const QString& accession)
+{
+	QCValue value;
+	value.name_ = name;
+	value.value_ = png.toBase64();
+	value.description_ = description;
+	value.accession_ = accession;
+
+	return value;
+}
+
 const QString& QCValue::name() const
 {
 	return name_;
@@ -23,6 +23,8 @@ public:
 
 	///Base64-encoded PNG image creation function.
 	static QCValue Image(const QString& name, const QString& filename, const QString& description="", const QString& accession="NONE");
+	///Base64-encoded PNG image creation function (from PNG data in memory).
+	static QCValue ImageFromData(const QString& name, const QByteArray& png, const QString& description="", const QString& accession="NONE");
 
 	///Returns the name.
 	const QString& name() const;
@@ -0,0 +1,542 @@
+#include "QCPlot.h"
+#include "Exceptions.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QBuffer>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+//Returns the strokes of a character of the built-in stroke font.
+//Glyphs are defined on a 4x6 grid (x from left to right, y from the cap height to the baseline). Polylines are separated by ';', points by ' '.
+//Lower-case letters are drawn as small capitals. Characters without glyph are drawn as space.
+static const char* glyph(QChar c)
+{
+	switch(c.toUpper().toLatin1())
+	{
+		case 'A': return "0,6 0,2 2,0 4,2 4,6;0,3 4,3";
+		case 'B': return "0,6 0,0 3,0 4,1 4,2 3,3 0,3;3,3 4,4 4,5 3,6 0,6";
+		case 'C': return "4,1 3,0 1,0 0,1 0,5 1,6 3,6 4,5";
+		case 'D': return "0,0 0,6 3,6 4,5 4,1 3,0 0,0";
+		case 'E': return "4,0 0,0 0,6 4,6;0,3 3,3";
+		case 'F': return "4,0 0,0 0,6;0,3 3,3";
+		case 'G': return "4,1 3,0 1,0 0,1 0,5 1,6 3,6 4,5 4,3 2,3";
+		case 'H': return "0,0 0,6;4,0 4,6;0,3 4,3";
+		case 'I': return "1,0 3,0;2,0 2,6;1,6 3,6";
+		case 'J': return "4,0 4,5 3,6 1,6 0,5";
+		case 'K': return "0,0 0,6;4,0 0,4;1,3 4,6";
+		case 'L': return "0,0 0,6 4,6";
+		case 'M': return "0,6 0,0 2,3 4,0 4,6";
+		case 'N': return "0,6 0,0 4,6 4,0";
+		case 'O': return "1,0 3,0 4,1 4,5 3,6 1,6 0,5 0,1 1,0";
+		case 'P': return "0,6 0,0 3,0 4,1 4,2 3,3 0,3";
+		case 'Q': return "1,0 3,0 4,1 4,5 3,6 1,6 0,5 0,1 1,0;2,4 4,6";
+		case 'R': return "0,6 0,0 3,0 4,1 4,2 3,3 0,3;2,3 4,6";
+		case 'S': return "4,1 3,0 1,0 0,1 0,2 1,3 3,3 4,4 4,5 3,6 1,6 0,5";
+		case 'T': return "0,0 4,0;2,0 2,6";
+		case 'U': return "0,0 0,5 1,6 3,6 4,5 4,0";
+		case 'V': return "0,0 2,6 4,0";
+		case 'W': return "0,0 1,6 2,3 3,6 4,0";
+		case 'X': return "0,0 4,6;4,0 0,6";
+		case 'Y': return "0,0 2,3 4,0;2,3 2,6";
+		case 'Z': return "0,0 4,0 0,6 4,6";
+		case '0': return "1,0 3,0 4,1 4,5 3,6 1,6 0,5 0,1 1,0;0,5 4,1";
+		case '1': return "1,1 2,0 2,6;1,6 3,6";
+		case '2': return "0,1 1,0 3,0 4,1 4,2 0,6 4,6";
+		case '3': return "0,1 1,0 3,0 4,1 4,2 3,3 4,4 4,5 3,6 1,6 0,5;1,3 3,3";
+		case '4': return "3,6 3,0 0,4 4,4";
+		case '5': return "4,0 0,0 0,3 3,3 4,4 4,5 3,6 0,6";
+		case '6': return "3,0 1,0 0,1 0,5 1,6 3,6 4,5 4,4 3,3 0,3";
+		case '7': return "0,0 4,0 1,6";
+		case '8': return "1,0 3,0 4,1 4,2 3,3 1,3 0,2 0,1 1,0;1,3 0,4 0,5 1,6 3,6 4,5 4,4 3,3";
+		case '9': return "4,3 1,3 0,2 0,1 1,0 3,0 4,1 4,5 3,6 1,6";
+		case '.': return "2,5.5 2,6";
+		case ',': return "2,5 1,7";
+		case ':': return "2,1 2,2;2,4 2,5";
+		case '-': return "1,3 3,3";
+		case '+': return "0,3 4,3;2,1 2,5";
+		case '=': return "0,2 4,2;0,4 4,4";
+		case '_': return "0,6 4,6";
+		case '/': return "0,6 4,0";
+		case '<': return "4,1 0,3 4,5";
+		case '>': return "0,1 4,3 0,5";
+		case '(': return "3,0 1,2 1,4 3,6";
+		case ')': return "1,0 3,2 3,4 1,6";
+		case '[': return "3,0 1,0 1,6 3,6";
+		case ']': return "1,0 3,0 3,6 1,6";
+		case '%': return "0,6 4,0;0,0 1,0 1,1 0,1 0,0;3,5 4,5 4,6 3,6 3,5";
+		case '?': return "0,1 1,0 3,0 4,1 4,2 2,3 2,4;2,5.5 2,6";
+		case '\'': return "2,0 2,2";
+		default: return "";
+	}
+}
+
+//Returns the width of a text drawn with the stroke font with the given cap height.
+static double textWidth(const QString& text, double size)
+{
+	if (text.isEmpty()) return 0.0;
+
+	return (6.0 * text.count() - 2.0) * size / 6.0;
+}
+
+//Draws a text with the stroke font with the given cap height. The anchor is on the baseline at the left (-1), center (0) or right (1) end of the text.
+static void drawText(QPainter& painter, double x, double y, const QString& text, double size, int align)
+{
+	double unit = size / 6.0;
+	x -= (align + 1) * textWidth(text, size) / 2.0;
+
+	QPainterPath path;
+	foreach(QChar c, text)
+	{
+		double scale = c.isLower() ? 0.75 : 1.0;
+		foreach(const QByteArray& stroke, QByteArray(glyph(c)).split(';'))
+		{
+			QList<QByteArray> points = stroke.split(' ');
+			for (int i=0; i<points.count(); ++i)
+			{
+				QList<QByteArray> coords = points[i].split(',');
+				if (coords.count()!=2) continue;
+
+				QPointF point(x + coords[0].toDouble() * unit * scale, y - (6.0 - coords[1].toDouble()) * unit * scale);
+				if (i==0) path.moveTo(point);
+				else path.lineTo(point);
+			}
+		}
+		x += 6.0 * unit;
+	}
+
+	painter.save();
+	painter.setBrush(Qt::NoBrush);
+	painter.setPen(QPen(Qt::black, std::max(1.0, size / 9.0), Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+	painter.drawPath(path);
+	painter.restore();
+}
+
+//Returns tick positions with a step of 1, 2 or 5 times a power of ten (about 5 to 10 ticks).
+static QVector<double> linearTicks(double min, double max)
+{
+	QVector<double> output;
+
+	double range = max - min;
+	if (!(range>0) || !std::isfinite(range)) return output;
+
+	double step = std::pow(10.0, std::floor(std::log10(range / 5.0)));
+	if (range/step>25) step *= 5;
+	else if (range/step>10) step *= 2;
+
+	long long first = (long long)std::ceil(min / step - 1e-9);
+	long long last = (long long)std::floor(max / step + 1e-9);
+	for (long long i=first; i<=last; ++i)
+	{
+		output << i * step;
+	}
+
+	return output;
+}
+
+//Returns the label of a tick. Ticks of logarithmic axes are given as exponent.
+static QString tickLabel(double tick, bool log_scale)
+{
+	if (log_scale) tick = std::pow(10.0, tick);
+	if (std::abs(tick)<1e-12) tick = 0.0;
+
+	return QString::number(tick, 'g', 6);
+}
+
+//Returns the color of the n-th line.
+static QColor lineColor(int n)
+{
+	static const QList<QColor> colors = QList<QColor>() << QColor(31, 119, 180) << QColor(255, 127, 14) << QColor(44, 160, 44) << QColor(214, 39, 40) << QColor(148, 103, 189) << QColor(140, 86, 75) << QColor(227, 119, 194) << QColor(127, 127, 127);
+
+	return colors[n % colors.count()];
+}
+
+QCPlot::QCPlot()
+	: xlabel_()
+	, ylabel_()
+	, xrange_set_(false)
+	, xmin_(0.0)
+	, xmax_(0.0)
+	, yrange_set_(false)
+	, ymin_(0.0)
+	, ymax_(0.0)
+	, ylog_(false)
+	, xticks_(true)
+	, xvalues_()
+	, lines_()
+	, bar_values_()
+	, bar_labels_()
+	, bar_colors_()
+	, points_()
+	, point_colors_()
+	, vlines_()
+	, color_legend_()
+{
+}
+
+void QCPlot::addLine(const QVector<double>& values, QString label)
+{
+	lines_ << Line{values, label};
+}
+
+void QCPlot::setBars(const QList<double>& values, const QStringList& labels, const QStringList& colors)
+{
+	bar_values_ = values;
+	bar_labels_ = labels;
+	bar_colors_ = colors;
+}
+
+void QCPlot::setPoints(const QList<QPair<double, double>>& points, const QStringList& colors)
+{
+	points_ = points;
+	point_colors_ = colors;
+}
+
+void QCPlot::addVLine(double x)
+{
+	vlines_ << x;
+}
+
+void QCPlot::addColorLegend(QString color, QString label)
+{
+	color_legend_ << qMakePair(color, label);
+}
+
+QColor QCPlot::color(QString code)
+{
+	if (code=="b") return QColor(0, 0, 255);
+	if (code=="g") return QColor(0, 128, 0);
+	if (code=="r") return QColor(255, 0, 0);
+	if (code=="c") return QColor(0, 191, 191);
+	if (code=="m") return QColor(191, 0, 191);
+	if (code=="y") return QColor(191, 191, 0);
+	if (code=="k") return QColor(0, 0, 0);
+	if (code=="w") return QColor(255, 255, 255);
+
+	QColor output(code);
+	return output.isValid() ? output : QColor(0, 0, 0);
+}
+
+double QCPlot::axisY(double y) const
+{
+	if (!std::isfinite(y)) return std::numeric_limits<double>::quiet_NaN();
+
+	if (ylog_)
+	{
+		return y>0 ? std::log10(y) : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	return y;
+}
+
+void QCPlot::dataRange(double& xmin, double& xmax, double& ymin, double& ymax) const
+{
+	//x-axis
+	if (xrange_set_)
+	{
+		xmin = xmin_;
+		xmax = xmax_;
+	}
+	else
+	{
+		xmin = std::numeric_limits<double>::max();
+		xmax = std::numeric_limits<double>::lowest();
+		foreach(const Line& line, lines_)
+		{
+			for (int i=0; i<line.values.count(); ++i)
+			{
+				xmin = std::min(xmin, lineX(i));
+				xmax = std::max(xmax, lineX(i));
+			}
+		}
+		if (!bar_values_.isEmpty())
+		{
+			xmin = std::min(xmin, -1.0);
+			xmax = std::max(xmax, (double)bar_values_.count());
+		}
+		if (!points_.isEmpty())
+		{
+			typedef QPair<double, double> Point;
+			foreach(const Point& point, points_)
+			{
+				if (!std::isfinite(point.first)) continue;
+				xmin = std::min(xmin, point.first);
+				xmax = std::max(xmax, point.first);
+			}
+			double padding = xmin<xmax ? 0.05 * (xmax - xmin) : 0.0;
+			xmin -= padding;
+			xmax += padding;
+		}
+		foreach(double x, vlines_)
+		{
+			xmin = std::min(xmin, x);
+			xmax = std::max(xmax, x);
+		}
+		if (xmin>xmax)
+		{
+			xmin = 0.0;
+			xmax = 1.0;
+		}
+	}
+	if (xmin==xmax)
+	{
+		xmin -= 1.0;
+		xmax += 1.0;
+	}
+
+	//y-axis (in axis coordinates)
+	ymin = axisY(ymin_);
+	ymax = axisY(ymax_);
+	if (!yrange_set_ || !std::isfinite(ymin) || !std::isfinite(ymax))
+	{
+		ymin = std::numeric_limits<double>::max();
+		ymax = std::numeric_limits<double>::lowest();
+		auto update = [&](double value)
+		{
+			double y = axisY(value);
+			if (!std::isfinite(y)) return;
+			ymin = std::min(ymin, y);
+			ymax = std::max(ymax, y);
+		};
+		foreach(const Line& line, lines_)
+		{
+			foreach(double value, line.values)
+			{
+				update(value);
+			}
+		}
+		foreach(double value, bar_values_)
+		{
+			update(value);
+		}
+		if (!bar_values_.isEmpty() && !ylog_) update(0.0);
+		typedef QPair<double, double> Point;
+		foreach(const Point& point, points_)
+		{
+			update(point.second);
+		}
+		if (ymin>ymax)
+		{
+			ymin = 0.0;
+			ymax = 1.0;
+		}
+		double padding = 0.05 * (ymax - ymin);
+		ymin -= padding;
+		ymax += padding;
+	}
+	if (ymin==ymax)
+	{
+		ymin -= 1.0;
+		ymax += 1.0;
+	}
+}
+
+QImage QCPlot::render(int width, int height) const
+{
+	const double tick_size = 11.0; //cap height of tick labels
+	const double label_size = 13.0; //cap height of axis labels
+
+	double xmin, xmax, ymin, ymax;
+	dataRange(xmin, xmax, ymin, ymax);
+
+	//ticks (logarithmic axes have ticks at powers of ten if the range spans at least one)
+	QVector<double> xticks;
+	if (xticks_ && bar_values_.isEmpty()) xticks = linearTicks(xmin, xmax);
+	QVector<double> yticks;
+	if (ylog_)
+	{
+		for (double e=std::ceil(ymin); e<=std::floor(ymax); e+=1.0)
+		{
+			yticks << e;
+		}
+	}
+	if (yticks.count()<2) yticks = linearTicks(ymin, ymax);
+	double ytick_width = 0.0;
+	foreach(double tick, yticks)
+	{
+		ytick_width = std::max(ytick_width, textWidth(tickLabel(tick, ylog_), tick_size));
+	}
+	double bar_label_width = 0.0;
+	foreach(const QString& label, bar_labels_)
+	{
+		bar_label_width = std::max(bar_label_width, textWidth(label, tick_size));
+	}
+
+	//layout
+	double left = 15.0 + label_size + 15.0 + ytick_width + 10.0;
+	double bottom = 10.0 + std::max(tick_size, bar_label_width) + 15.0 + label_size + 15.0;
+	QRectF area(left, 15.0, width - left - 25.0, height - 15.0 - bottom);
+	auto px = [&](double x)
+	{
+		return area.left() + (x - xmin) / (xmax - xmin) * area.width();
+	};
+	auto py = [&](double y)
+	{
+		return area.bottom() - (y - ymin) / (ymax - ymin) * area.height();
+	};
+
+	QImage image(width, height, QImage::Format_ARGB32);
+	image.fill(Qt::white);
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+
+	//data (clipped to the plot area)
+	painter.save();
+	painter.setClipRect(area);
+
+	painter.setPen(QPen(QColor(128, 128, 128), 1.0, Qt::DashLine));
+	foreach(double x, vlines_)
+	{
+		painter.drawLine(QPointF(px(x), area.top()), QPointF(px(x), area.bottom()));
+	}
+
+	double bar_base = ylog_ ? ymin : std::max(ymin, std::min(ymax, 0.0));
+	for (int i=0; i<bar_values_.count(); ++i)
+	{
+		double y = axisY(bar_values_[i]);
+		if (!std::isfinite(y)) continue;
+		QRectF bar(QPointF(px(i - 0.4), py(y)), QPointF(px(i + 0.4), py(bar_base)));
+		painter.fillRect(bar.normalized(), color(i<bar_colors_.count() ? bar_colors_[i] : "b"));
+	}
+
+	painter.setBrush(Qt::NoBrush);
+	for (int l=0; l<lines_.count(); ++l)
+	{
+		QPainterPath path;
+		bool open = false;
+		const QVector<double>& values = lines_[l].values;
+		for (int i=0; i<values.count(); ++i)
+		{
+			double x = lineX(i);
+			double y = axisY(values[i]);
+			if (!std::isfinite(x) || !std::isfinite(y))
+			{
+				open = false;
+				continue;
+			}
+
+			QPointF point(px(x), py(y));
+			if (open) path.lineTo(point);
+			else path.moveTo(point);
+			open = true;
+		}
+		painter.setPen(QPen(lineColor(l), 1.5));
+		painter.drawPath(path);
+	}
+
+	painter.setPen(Qt::NoPen);
+	for (int i=0; i<points_.count(); ++i)
+	{
+		double x = points_[i].first;
+		double y = axisY(points_[i].second);
+		if (!std::isfinite(x) || !std::isfinite(y)) continue;
+		painter.setBrush(color(i<point_colors_.count() ? point_colors_[i] : "b"));
+		painter.drawEllipse(QPointF(px(x), py(y)), 2.5, 2.5);
+	}
+
+	painter.restore();
+
+	//axes
+	painter.setPen(QPen(Qt::black, 1.0));
+	painter.setBrush(Qt::NoBrush);
+	painter.drawRect(area);
+	foreach(double tick, xticks)
+	{
+		double x = px(tick);
+		painter.drawLine(QPointF(x, area.bottom()), QPointF(x, area.bottom() + 5.0));
+		drawText(painter, x, area.bottom() + 10.0 + tick_size, tickLabel(tick, false), tick_size, 0);
+	}
+	foreach(double tick, yticks)
+	{
+		double y = py(tick);
+		painter.drawLine(QPointF(area.left() - 5.0, y), QPointF(area.left(), y));
+		drawText(painter, area.left() - 10.0, y + tick_size / 2.0, tickLabel(tick, ylog_), tick_size, 1);
+	}
+	for (int i=0; i<bar_labels_.count(); ++i)
+	{
+		if (i<xmin || i>xmax) continue;
+
+		//vertical text that ends below the bar
+		painter.save();
+		painter.translate(px(i), area.bottom() + 8.0);
+		painter.rotate(-90);
+		drawText(painter, 0.0, tick_size / 2.0, bar_labels_[i], tick_size, 1);
+		painter.restore();
+	}
+	drawText(painter, area.center().x(), height - 15.0, xlabel_, label_size, 0);
+	painter.save();
+	painter.translate(15.0 + label_size, area.center().y());
+	painter.rotate(-90);
+	drawText(painter, 0.0, 0.0, ylabel_, label_size, 0);
+	painter.restore();
+
+	//legend (lines with label and color legend)
+	struct LegendEntry
+	{
+		QColor color;
+		QString label;
+		bool is_line;
+	};
+	QList<LegendEntry> legend;
+	for (int l=0; l<lines_.count(); ++l)
+	{
+		if (!lines_[l].label.isEmpty()) legend << LegendEntry{lineColor(l), lines_[l].label, true};
+	}
+	typedef QPair<QString, QString> ColorLabel;
+	foreach(const ColorLabel& entry, color_legend_)
+	{
+		legend << LegendEntry{color(entry.first), entry.second, false};
+	}
+	if (!legend.isEmpty())
+	{
+		double text_width = 0.0;
+		foreach(const LegendEntry& entry, legend)
+		{
+			text_width = std::max(text_width, textWidth(entry.label, tick_size));
+		}
+		double row_height = tick_size + 8.0;
+		QRectF box(area.right() - 10.0 - text_width - 42.0, area.top() + 10.0, text_width + 42.0, legend.count() * row_height + 8.0);
+		painter.setPen(QPen(QColor(128, 128, 128), 1.0));
+		painter.setBrush(Qt::white);
+		painter.drawRect(box);
+		for (int i=0; i<legend.count(); ++i)
+		{
+			double y = box.top() + 4.0 + (i + 0.5) * row_height;
+			if (legend[i].is_line)
+			{
+				painter.setPen(QPen(legend[i].color, 2.0));
+				painter.drawLine(QPointF(box.left() + 8.0, y), QPointF(box.left() + 28.0, y));
+			}
+			else
+			{
+				painter.fillRect(QRectF(box.left() + 13.0, y - 5.0, 10.0, 10.0), legend[i].color);
+			}
+			drawText(painter, box.left() + 34.0, y + tick_size / 2.0, legend[i].label, tick_size, -1);
+		}
+	}
+
+	painter.end();
+
+	return image;
+}
+
+QByteArray QCPlot::toPNG() const
+{
+	QByteArray output;
+	QBuffer buffer(&output);
+	buffer.open(QIODevice::WriteOnly);
+	if (!render().save(&buffer, "PNG"))
+	{
+		THROW(Exception, "Could not encode QC plot as PNG image!");
+	}
+
+	return output;
+}
+
+void QCPlot::store(QString filename) const
+{
+	if (!render().save(filename, "PNG"))
+	{
+		THROW(FileAccessException, "Could not store QC plot to PNG file '" + filename + "'!");
+	}
+}
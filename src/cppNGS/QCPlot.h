@@ -0,0 +1,121 @@
+#ifndef QCPLOT_H
+#define QCPLOT_H
+
+#include "cppNGS_global.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QPair>
+#include <QColor>
+#include <QImage>
+
+///QC plot (lines, bars and/or points) that is rendered in-process into a PNG image with QPainter.
+///Unlike LinePlot/BarPlot/ScatterPlot, no plot script is written and no external process is started.
+///Text is drawn with a built-in stroke font, i.e. no fonts and no QGuiApplication are needed. Plots can thus be rendered in command-line tools and in worker threads.
+class CPPNGSSHARED_EXPORT QCPlot
+{
+public:
+	///Default constructor.
+	QCPlot();
+
+	///Sets the x-axis label.
+	void setXLabel(QString label)
+	{
+		xlabel_ = label;
+	}
+	///Sets the y-axis label.
+	void setYLabel(QString label)
+	{
+		ylabel_ = label;
+	}
+	///Sets the x-axis range. If not set, the range is determined from the data.
+	void setXRange(double min, double max)
+	{
+		xmin_ = min;
+		xmax_ = max;
+		xrange_set_ = true;
+	}
+	///Sets the y-axis range. If not set, the range is determined from the data.
+	void setYRange(double min, double max)
+	{
+		ymin_ = min;
+		ymax_ = max;
+		yrange_set_ = true;
+	}
+	///Enables a logarithmic y-axis (base 10). Values smaller than or equal to zero are not shown.
+	void setYLogScale(bool log_scale)
+	{
+		ylog_ = log_scale;
+	}
+	///Hides the ticks of the x-axis.
+	void noXTicks()
+	{
+		xticks_ = false;
+	}
+
+	///Sets the x values of the lines.
+	void setXValues(const QVector<double>& values)
+	{
+		xvalues_ = values;
+	}
+	///Adds a line with one y value per x value (see setXValues). Non-finite values interrupt the line. Lines with label are shown in the legend.
+	void addLine(const QVector<double>& values, QString label = "");
+	///Sets bars at the x positions 0, 1, 2, ... with labels (shown below the x-axis) and colors (see color()).
+	void setBars(const QList<double>& values, const QStringList& labels, const QStringList& colors);
+	///Sets points with one color per point (see color()). If no colors are given, all points are blue.
+	void setPoints(const QList<QPair<double, double>>& points, const QStringList& colors = QStringList());
+	///Adds a vertical line, e.g. a chromosome border.
+	void addVLine(double x);
+	///Adds a color to the legend.
+	void addColorLegend(QString color, QString label);
+
+	///Renders the plot.
+	QImage render(int width = 800, int height = 600) const;
+	///Renders the plot and returns the PNG data.
+	QByteArray toPNG() const;
+	///Renders the plot and stores it as PNG file.
+	void store(QString filename) const;
+
+	///Returns the color of a color code. The single-letter codes of LinePlot/BarPlot/ScatterPlot ('b', 'g', 'r', 'c', 'm', 'y', 'k', 'w') and color names/hex codes are supported. Invalid codes are black.
+	static QColor color(QString code);
+
+protected:
+	struct Line
+	{
+		QVector<double> values;
+		QString label;
+	};
+
+	QString xlabel_;
+	QString ylabel_;
+	bool xrange_set_;
+	double xmin_;
+	double xmax_;
+	bool yrange_set_;
+	double ymin_;
+	double ymax_;
+	bool ylog_;
+	bool xticks_;
+	QVector<double> xvalues_;
+	QList<Line> lines_;
+	QList<double> bar_values_;
+	QStringList bar_labels_;
+	QStringList bar_colors_;
+	QList<QPair<double, double>> points_;
+	QStringList point_colors_;
+	QList<double> vlines_;
+	QList<QPair<QString, QString>> color_legend_; //color code and label
+
+	///Returns the x value of the i-th value of a line.
+	double lineX(int i) const
+	{
+		return i<xvalues_.count() ? xvalues_[i] : i;
+	}
+	///Determines the data range of the x-axis and the y-axis (y in axis coordinates, i.e. log10 for logarithmic axes).
+	void dataRange(double& xmin, double& xmax, double& ymin, double& ymax) const;
+	///Converts a y value to axis coordinates. Returns NaN if the value cannot be shown.
+	double axisY(double y) const;
+};
+
+#endif // QCPLOT_H
@@ -0,0 +1,69 @@
+#include "QCPlotRenderer.h"
+#include "Exceptions.h"
+#include <QRunnable>
+
+//Renders one plot.
+class QCPlotWorker
+	: public QRunnable
+{
+public:
+	QCPlotWorker(QSharedPointer<QCPlotRenderer::Job> job)
+		: QRunnable()
+		, job_(job)
+	{
+	}
+
+	void run() override
+	{
+		try
+		{
+			job_->png = job_->plot.toPNG();
+		}
+		catch(Exception& e)
+		{
+			job_->error = e.message();
+		}
+	}
+
+protected:
+	QSharedPointer<QCPlotRenderer::Job> job_;
+};
+
+QCPlotRenderer::QCPlotRenderer(QCCollection& output)
+	: output_(output)
+	, pool_()
+	, jobs_()
+{
+	//one worker thread: plots are rendered in-process, so they are cheap compared to the statistics
+	pool_.setMaxThreadCount(1);
+}
+
+QCPlotRenderer::~QCPlotRenderer()
+{
+	pool_.waitForDone();
+}
+
+void QCPlotRenderer::add(const QCPlot& plot, QString name, QString description, QString accession)
+{
+	QSharedPointer<Job> job(new Job{plot, name, description, accession, QByteArray(), QString()});
+	jobs_ << job;
+	output_.insert(QCValue::ImageFromData(name, QByteArray(), description, accession));
+
+	pool_.start(new QCPlotWorker(job));
+}
+
+void QCPlotRenderer::finish()
+{
+	pool_.waitForDone();
+
+	foreach(const QSharedPointer<Job>& job, jobs_)
+	{
+		if (!job->error.isEmpty()) THROW(Exception, "Could not render QC plot '" + job->name + "': " + job->error);
+	}
+
+	foreach(const QSharedPointer<Job>& job, jobs_)
+	{
+		output_.insert(QCValue::ImageFromData(job->name, job->png, job->description, job->accession));
+	}
+	jobs_.clear();
+}
@@ -0,0 +1,47 @@
+#ifndef QCPLOTRENDERER_H
+#define QCPLOTRENDERER_H
+
+#include "cppNGS_global.h"
+#include "QCCollection.h"
+#include "QCPlot.h"
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QList>
+
+///Renders QC plots on a worker thread while the statistics are calculated and adds the images to a QC collection.
+///Rendering of a plot starts when it is added. To keep the order of the QC values, an empty image is inserted immediately and replaced in finish().
+class CPPNGSSHARED_EXPORT QCPlotRenderer
+{
+public:
+	///Constructor.
+	QCPlotRenderer(QCCollection& output);
+	///Destructor. Waits for pending plots.
+	~QCPlotRenderer();
+
+	///Adds a plot. The plot is copied, i.e. it can be changed or destroyed afterwards.
+	void add(const QCPlot& plot, QString name, QString description, QString accession);
+	///Waits until all plots are rendered and replaces the empty images in the QC collection.
+	void finish();
+
+	///Job data (public for the worker).
+	struct Job
+	{
+		QCPlot plot;
+		QString name;
+		QString description;
+		QString accession;
+		QByteArray png;
+		QString error;
+	};
+
+protected:
+	QCCollection& output_;
+	QThreadPool pool_;
+	QList<QSharedPointer<Job>> jobs_;
+
+	//declared away methods
+	QCPlotRenderer(const QCPlotRenderer&) = delete;
+	QCPlotRenderer& operator=(const QCPlotRenderer&) = delete;
+};
+
+#endif // QCPLOTRENDERER_H
@@ -0,0 +1,271 @@
+#include "SampleFingerprint.h"
+#include "Exceptions.h"
+#include "Helper.h"
+#include "NGSHelper.h"
+#include "BamReader.h"
+#include "BasicStatistics.h"
+#include "FilterCascade.h"
+#include <QTextStream>
+#include <QMutex>
+#include <QMutexLocker>
+
+SampleFingerprint::SampleFingerprint()
+	: name_()
+	, build_()
+	, genotypes_()
+{
+}
+
+SampleFingerprint::SampleFingerprint(QString name, QString build, QByteArray genotypes)
+	: name_(name)
+	, build_(build)
+	, genotypes_(genotypes)
+{
+	if (genotypes_.count()!=panel(build_).count())
+	{
+		THROW(ArgumentException, "Fingerprint of sample '" + name + "' contains " + QString::number(genotypes_.count()) + " genotypes, but the " + build + " panel contains " + QString::number(panel(build_).count()) + " SNPs!");
+	}
+}
+
+int SampleFingerprint::count() const
+{
+	return genotypes_.count() - genotypes_.count('.');
+}
+
+const VariantList& SampleFingerprint::panel(QString build)
+{
+	static QMutex mutex;
+	static QMap<QString, VariantList> panels;
+
+	QMutexLocker locker(&mutex);
+	if (!panels.contains(build))
+	{
+		VariantList snps = NGSHelper::getKnownVariants(build, true, 0.2, 0.8);
+
+		//keep only autosomes
+		FilterResult filter_result(snps.count());
+		for (int i=0; i<snps.count(); ++i)
+		{
+			filter_result.flags()[i] = snps[i].chr().isAutosome();
+		}
+		filter_result.removeFlagged(snps);
+
+		panels[build] = snps;
+	}
+
+	return panels[build];
+}
+
+SampleFingerprint SampleFingerprint::fromBam(QString build, QString filename, int min_cov, QString name)
+{
+	const VariantList& snps = panel(build);
+	QByteArray genotypes(snps.count(), '.');
+
+	//the panel is sorted, so the SNPs of each chromosome are consecutive - the BAM is read in one sweep per chromosome
+	BamReader reader(filename);
+	int chr_start = 0;
+	while (chr_start<snps.count())
+	{
+		const Chromosome& chr = snps[chr_start].chr();
+		QVector<int> positions;
+		int chr_end = chr_start;
+		while (chr_end<snps.count() && snps[chr_end].chr()==chr)
+		{
+			positions << snps[chr_end].start();
+			++chr_end;
+		}
+
+		QVector<Pileup> pileups = reader.getPileups(chr, positions);
+		for(int i=chr_start; i<chr_end; ++i)
+		{
+			const Pileup& pileup = pileups[i-chr_start];
+			if (pileup.depth(false)<min_cov) continue;
+
+			double frequency = pileup.frequency(snps[i].ref()[0], snps[i].obs()[0]);
+			if (!BasicStatistics::isValidFloat(frequency)) continue;
+
+			genotypes[i] = genotype(frequency);
+		}
+
+		chr_start = chr_end;
+	}
+
+	return SampleFingerprint(name, build, genotypes);
+}
+
+SampleFingerprint SampleFingerprint::fromVcf(QString build, QString filename, QString name)
+{
+	const VariantList& snps = panel(build);
+	QHash<QString, int> snp_index;
+	snp_index.reserve(snps.count());
+	for(int i=0; i<snps.count(); ++i)
+	{
+		snp_index[snps[i].toString()] = i;
+	}
+
+	QByteArray genotypes(snps.count(), '.');
+	SampleSimilarity::VariantGenotypes variants = SampleSimilarity::genotypesFromVcf(filename, false, true);
+	for (auto it=variants.cbegin(); it!=variants.cend(); ++it)
+	{
+		int index = snp_index.value(QString(it.key()), -1);
+		if (index==-1) continue;
+
+		genotypes[index] = genotype(it.value());
+	}
+
+	return SampleFingerprint(name, build, genotypes);
+}
+
+QList<SampleFingerprint> SampleFingerprint::load(QString filename)
+{
+	SampleFingerprintReader reader(filename);
+
+	QList<SampleFingerprint> output;
+	SampleFingerprint fp;
+	while(reader.read(fp))
+	{
+		output << fp;
+	}
+
+	return output;
+}
+
+void SampleFingerprint::store(const QList<SampleFingerprint>& fingerprints, QString filename, bool append)
+{
+	if (fingerprints.isEmpty()) THROW(ArgumentException, "Cannot store empty fingerprint list to '" + filename + "'!");
+
+	//check genome build
+	QString build = fingerprints[0].build();
+	foreach(const SampleFingerprint& fp, fingerprints)
+	{
+		if (fp.build()!=build) THROW(ArgumentException, "Fingerprints with different genome builds cannot be stored in one file!");
+	}
+	append = append && QFile::exists(filename);
+	if (append)
+	{
+		QString file_build = SampleFingerprintReader(filename).build();
+		if (file_build!=build) THROW(ArgumentException, "Cannot append " + build + " fingerprints to " + file_build + " fingerprint file '" + filename + "'!");
+	}
+
+	//store
+	QSharedPointer<QFile> file = Helper::openFileForWriting(filename, false, append);
+	QTextStream stream(file.data());
+	if (!append)
+	{
+		stream << "##fingerprint=" << VERSION << "\n";
+		stream << "##build=" << build << "\n";
+		stream << "##panel=" << panel(build).count() << "\n";
+		stream << "#sample\tgenotypes\n";
+	}
+	foreach(const SampleFingerprint& fp, fingerprints)
+	{
+		stream << fp.name() << "\t" << fp.genotypes() << "\n";
+	}
+}
+
+SampleSimilarity::GenotypeMatrix SampleFingerprint::genotypeMatrix(const QList<SampleFingerprint>& fingerprints)
+{
+	SampleSimilarity::GenotypeMatrix output;
+	if (fingerprints.isEmpty()) return output;
+
+	QString build = fingerprints[0].build();
+	output.samples = fingerprints.count();
+	output.variants = panel(build).count();
+	output.words = (output.variants+63)/64;
+	output.bits.fill(0, 3 * output.samples * output.words);
+	for (int s=0; s<fingerprints.count(); ++s)
+	{
+		const SampleFingerprint& fp = fingerprints[s];
+		if (fp.build()!=build) THROW(ArgumentException, "Fingerprint of sample '" + fp.name() + "' has genome build " + fp.build() + ", but " + build + " was expected!");
+
+		const QByteArray& genotypes = fp.genotypes();
+		quint64* bits = output.bits.data() + 3 * s * output.words;
+		for (int i=0; i<genotypes.count(); ++i)
+		{
+			char geno = genotypes[i];
+			if (geno=='.') continue;
+
+			quint64 bit = Q_UINT64_C(1) << (i%64);
+			quint64* words = bits + 3 * (i/64);
+			words[0] |= bit;
+			if (geno=='1')
+			{
+				words[1] |= bit;
+			}
+			else if (geno=='2')
+			{
+				words[2] |= bit;
+			}
+			else if (geno!='0')
+			{
+				THROW(ArgumentException, "Fingerprint of sample '" + fp.name() + "' contains invalid genotype '" + QString(geno) + "'!");
+			}
+		}
+	}
+
+	return output;
+}
+
+char SampleFingerprint::genotype(double frequency)
+{
+	if (frequency<0.1) return '0';
+	if (frequency>0.9) return '2';
+	return '1';
+}
+
+SampleFingerprintReader::SampleFingerprintReader(QString filename)
+	: filename_(filename)
+	, file_(Helper::openFileForReading(filename))
+	, build_()
+{
+	//parse header
+	while(!file_->atEnd())
+	{
+		QByteArray line = file_->readLine().trimmed();
+		if (line.startsWith("##fingerprint="))
+		{
+			int version = line.mid(14).toInt();
+			if (version!=SampleFingerprint::VERSION) THROW(FileParseException, "Fingerprint file '" + filename + "' has version " + QString::number(version) + ", but version " + QString::number(SampleFingerprint::VERSION) + " is required!");
+		}
+		else if (line.startsWith("##build="))
+		{
+			build_ = line.mid(8);
+		}
+		else if (line.startsWith("##panel="))
+		{
+			if (build_.isEmpty()) THROW(FileParseException, "Fingerprint file '" + filename + "' contains no genome build before the panel header!");
+			int snps = line.mid(8).toInt();
+			int panel_snps = SampleFingerprint::panel(build_).count();
+			if (snps!=panel_snps) THROW(FileParseException, "Fingerprint file '" + filename + "' was created with a panel of " + QString::number(snps) + " SNPs, but the current " + build_ + " panel contains " + QString::number(panel_snps) + " SNPs!");
+		}
+		else if (line.startsWith("#sample"))
+		{
+			if (build_.isEmpty()) THROW(FileParseException, "Fingerprint file '" + filename + "' contains no genome build header!");
+			return;
+		}
+		else
+		{
+			THROW(FileParseException, "Invalid header line in fingerprint file '" + filename + "': " + line);
+		}
+	}
+
+	THROW(FileParseException, "Fingerprint file '" + filename + "' contains no header line!");
+}
+
+bool SampleFingerprintReader::read(SampleFingerprint& fingerprint)
+{
+	while(!file_->atEnd())
+	{
+		QByteArray line = file_->readLine();
+		while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+		if (line.isEmpty()) continue;
+
+		QList<QByteArray> parts = line.split('\t');
+		if (parts.count()!=2) THROW(FileParseException, "Invalid line in fingerprint file '" + filename_ + "': " + line.left(100));
+
+		fingerprint = SampleFingerprint(parts[0], build_, parts[1]);
+		return true;
+	}
+
+	return false;
+}
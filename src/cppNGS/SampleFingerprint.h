@@ -0,0 +1,97 @@
+#ifndef SAMPLEFINGERPRINT_H
+#define SAMPLEFINGERPRINT_H
+
+#include "cppNGS_global.h"
+#include "SampleSimilarity.h"
+#include "VariantList.h"
+#include <QFile>
+#include <QSharedPointer>
+
+///Genotype fingerprint of a sample, i.e. the genotypes of a fixed panel of common autosomal SNPs (see NGSHelper::getKnownVariants).
+///Fingerprints are stored in TSV files, which can contain one sample or a whole fingerprint database:
+///  ##fingerprint=<format version>
+///  ##build=<genome build>
+///  ##panel=<number of panel SNPs>
+///  #sample	genotypes
+///  <sample name>	<one character per panel SNP: '0' (wildtype), '1' (het), '2' (hom) or '.' (unknown)>
+class CPPNGSSHARED_EXPORT SampleFingerprint
+{
+public:
+	///Default constructor.
+	SampleFingerprint();
+	///Constructor.
+	SampleFingerprint(QString name, QString build, QByteArray genotypes);
+
+	///Returns the sample name.
+	const QString& name() const
+	{
+		return name_;
+	}
+	///Returns the genome build.
+	const QString& build() const
+	{
+		return build_;
+	}
+	///Returns the genotypes (one character per panel SNP).
+	const QByteArray& genotypes() const
+	{
+		return genotypes_;
+	}
+	///Returns the number of panel SNPs with known genotype.
+	int count() const;
+
+	///Returns the SNP panel of a genome build.
+	static const VariantList& panel(QString build);
+
+	///Creates a fingerprint from a BAM file. Panel SNPs with less than @p min_cov reads are unknown.
+	static SampleFingerprint fromBam(QString build, QString filename, int min_cov, QString name);
+	///Creates a fingerprint from a VCF/GSvar file. Panel SNPs not contained in the variant list are unknown.
+	static SampleFingerprint fromVcf(QString build, QString filename, QString name);
+
+	///Loads fingerprints from a file.
+	static QList<SampleFingerprint> load(QString filename);
+	///Stores fingerprints to a file. If @p append is set and the file exists, the fingerprints are appended (the genome build has to match).
+	static void store(const QList<SampleFingerprint>& fingerprints, QString filename, bool append = false);
+
+	///Creates the genotype matrix of fingerprints (see SampleSimilarity). All fingerprints have to be of the same genome build.
+	static SampleSimilarity::GenotypeMatrix genotypeMatrix(const QList<SampleFingerprint>& fingerprints);
+
+	///File format version.
+	static const int VERSION = 1;
+
+protected:
+	QString name_;
+	QString build_;
+	QByteArray genotypes_;
+
+	///Returns the genotype character for an allele frequency.
+	static char genotype(double frequency);
+};
+
+///Sequential reader for fingerprint files, e.g. for fingerprint databases that are too large to be loaded into memory at once.
+class CPPNGSSHARED_EXPORT SampleFingerprintReader
+{
+public:
+	///Constructor. Parses the header of the file.
+	SampleFingerprintReader(QString filename);
+
+	///Returns the genome build of the fingerprints.
+	const QString& build() const
+	{
+		return build_;
+	}
+
+	///Reads the next fingerprint. Returns @em false if the end of the file is reached.
+	bool read(SampleFingerprint& fingerprint);
+
+protected:
+	QString filename_;
+	QSharedPointer<QFile> file_;
+	QString build_;
+
+	//declared away methods
+	SampleFingerprintReader(const SampleFingerprintReader&) = delete;
+	SampleFingerprintReader& operator=(const SampleFingerprintReader&) = delete;
+};
+
+#endif // SAMPLEFINGERPRINT_H
@@ -3,6 +3,90 @@
 #include "Statistics.h"
 #include "BasicStatistics.h"
 #include "NGSHelper.h"
+#include <QThreadPool>
+#include <QRunnable>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+
+//Returns the index of the sample pair i<j in row-major order.
+static inline int pairIndex(int samples, int i, int j)
+{
+	return i*samples - i*(i+1)/2 + (j-i-1);
+}
+
+//Calculates the genotype counts of all sample pairs of a tile of the genotype matrix.
+//The bitmaps are processed in chunks of words, so that the data of the tile samples stays in the CPU cache.
+class SampleSimilarityWorker
+	: public QRunnable
+{
+public:
+	SampleSimilarityWorker(const SampleSimilarity::GenotypeMatrix& matrix, int start1, int end1, int start2, int end2, SampleSimilarity::PairCounts* counts)
+		: QRunnable()
+		, matrix_(matrix)
+		, start1_(start1)
+		, end1_(end1)
+		, start2_(start2)
+		, end2_(end2)
+		, counts_(counts)
+	{
+	}
+
+	void run() override
+	{
+		const int chunk_words = 256;
+		for (int word_start=0; word_start<matrix_.words; word_start+=chunk_words)
+		{
+			int word_end = std::min(word_start+chunk_words, matrix_.words);
+			for (int i=start1_; i<end1_; ++i)
+			{
+				for (int j=std::max(i+1, start2_); j<end2_; ++j)
+				{
+					SampleSimilarity::countPair(matrix_, i, j, word_start, word_end, counts_[pairIndex(matrix_.samples, i, j)]);
+				}
+			}
+		}
+	}
+
+protected:
+	const SampleSimilarity::GenotypeMatrix& matrix_;
+	int start1_;
+	int end1_;
+	int start2_;
+	int end2_;
+	SampleSimilarity::PairCounts* counts_;
+};
+
+//Calculates the genotype counts of one sample and a block of other samples of the genotype matrix.
+class SampleSimilarityRowWorker
+	: public QRunnable
+{
+public:
+	SampleSimilarityRowWorker(const SampleSimilarity::GenotypeMatrix& matrix, int sample, int start, int end, SampleSimilarity::PairCounts* counts)
+		: QRunnable()
+		, matrix_(matrix)
+		, sample_(sample)
+		, start_(start)
+		, end_(end)
+		, counts_(counts)
+	{
+	}
+
+	void run() override
+	{
+		for (int i=start_; i<end_; ++i)
+		{
+			SampleSimilarity::countPair(matrix_, sample_, i, 0, matrix_.words, counts_[i-start_]);
+		}
+	}
+
+protected:
+	const SampleSimilarity::GenotypeMatrix& matrix_;
+	int sample_;
+	int start_;
+	int end_;
+	SampleSimilarity::PairCounts* counts_;
+};
 
 SampleSimilarity::VariantGenotypes SampleSimilarity::genotypesFromVcf(QString filename, bool include_gonosomes, bool skip_multi, const BedFile* roi)
 {
@@ -132,6 +216,216 @@ void SampleSimilarity::calculateSimilarity(const VariantGenotypes& in1, const Va
 	}
 }
 
+SampleSimilarity::GenotypeMatrix SampleSimilarity::genotypeMatrix(const QList<VariantGenotypes>& samples)
+{
+	//create sorted variant dictionary (the keys are unique string pointers, see strToPointer)
+	QSet<const QChar*> keys;
+	foreach(const VariantGenotypes& sample, samples)
+	{
+		for (auto it=sample.cbegin(); it!=sample.cend(); ++it)
+		{
+			keys << it.key();
+		}
+	}
+	QVector<const QChar*> dict;
+	dict.reserve(keys.count());
+	foreach(const QChar* key, keys)
+	{
+		dict << key;
+	}
+	keys.clear();
+	std::sort(dict.begin(), dict.end());
+
+	//encode genotypes
+	GenotypeMatrix output;
+	output.samples = samples.count();
+	output.variants = dict.count();
+	output.words = (dict.count()+63)/64;
+	output.bits.fill(0, 3 * output.samples * output.words);
+	for (int s=0; s<samples.count(); ++s)
+	{
+		const VariantGenotypes& sample = samples[s];
+		for (auto it=sample.cbegin(); it!=sample.cend(); ++it)
+		{
+			int index = std::lower_bound(dict.cbegin(), dict.cend(), it.key()) - dict.cbegin();
+			quint64 bit = Q_UINT64_C(1) << (index%64);
+			quint64* words = output.bits.data() + 3 * (s*output.words + index/64);
+
+			words[0] |= bit;
+			double geno = it.value();
+			if (geno==0.5)
+			{
+				words[1] |= bit;
+			}
+			else if (geno==1.0)
+			{
+				words[2] |= bit;
+			}
+			else if (geno!=0.0)
+			{
+				THROW(ArgumentException, "Genotype matrix supports only discrete genotypes, but found '" + QString::number(geno) + "'!");
+			}
+		}
+	}
+
+	return output;
+}
+
+void SampleSimilarity::calculateSimilarity(const GenotypeMatrix& matrix, int sample1, int sample2)
+{
+	PairCounts counts;
+	countPair(matrix, sample1, sample2, 0, matrix.words, counts);
+	setMetrics(counts, variantCount(matrix, sample1), variantCount(matrix, sample2));
+}
+
+QList<SampleSimilarity> SampleSimilarity::calculateSimilarityAll(const GenotypeMatrix& matrix, int threads)
+{
+	//count genotypes of all pairs (one job per tile of sample pairs)
+	const int block_size = 32;
+	int samples = matrix.samples;
+	QVector<PairCounts> counts(samples*(samples-1)/2);
+	QThreadPool pool;
+	pool.setMaxThreadCount(std::max(1, threads));
+	for (int start1=0; start1<samples; start1+=block_size)
+	{
+		for (int start2=start1; start2<samples; start2+=block_size)
+		{
+			pool.start(new SampleSimilarityWorker(matrix, start1, std::min(start1+block_size, samples), start2, std::min(start2+block_size, samples), counts.data()));
+		}
+	}
+	pool.waitForDone();
+
+	//calculate metrics
+	QVector<int> variant_counts;
+	for (int i=0; i<samples; ++i)
+	{
+		variant_counts << variantCount(matrix, i);
+	}
+	QList<SampleSimilarity> output;
+	for (int i=0; i<samples; ++i)
+	{
+		for (int j=i+1; j<samples; ++j)
+		{
+			SampleSimilarity sc;
+			sc.setMetrics(counts[pairIndex(samples, i, j)], variant_counts[i], variant_counts[j]);
+			output << sc;
+		}
+	}
+
+	return output;
+}
+
+QList<SampleSimilarity> SampleSimilarity::calculateSimilarity(const GenotypeMatrix& matrix, int sample, int start, int end, int threads)
+{
+	//count genotypes (one job per block of samples)
+	const int block_size = 256;
+	QVector<PairCounts> counts(end-start);
+	QThreadPool pool;
+	pool.setMaxThreadCount(std::max(1, threads));
+	for (int block_start=start; block_start<end; block_start+=block_size)
+	{
+		pool.start(new SampleSimilarityRowWorker(matrix, sample, block_start, std::min(block_start+block_size, end), counts.data() + (block_start-start)));
+	}
+	pool.waitForDone();
+
+	//calculate metrics
+	int variant_count = variantCount(matrix, sample);
+	QList<SampleSimilarity> output;
+	for (int i=start; i<end; ++i)
+	{
+		SampleSimilarity sc;
+		sc.setMetrics(counts[i-start], variant_count, variantCount(matrix, i));
+		output << sc;
+	}
+
+	return output;
+}
+
+void SampleSimilarity::setMetrics(const PairCounts& counts, int no_variants1, int no_variants2)
+{
+	clear();
+
+	//abort if no overlap
+	if (counts.overlap==0)
+	{
+		messages_.append("Zero overlap between variant lists!");
+		return;
+	}
+
+	no_variants1_ = no_variants1;
+	no_variants2_ = no_variants2;
+	int min_count = std::min(no_variants1_, no_variants2_);
+	ol_perc_ = 100.0 * counts.overlap / min_count;
+	ol_count_ = counts.overlap;
+	ibs2_perc_ = 100.0 * (counts.hom_hom + counts.wt_wt) / min_count;
+	ibs0_perc_ = 100.0 * counts.ibs0 / min_count;
+
+	//correlation of genotypes (0, 1 and 2 instead of 0.0, 0.5 and 1.0 - the correlation does not depend on the scale)
+	double n = counts.overlap;
+	double sum1 = counts.het1 + 2.0 * counts.hom1;
+	double sum2 = counts.het2 + 2.0 * counts.hom2;
+	double sum_sq1 = counts.het1 + 4.0 * counts.hom1;
+	double sum_sq2 = counts.het2 + 4.0 * counts.hom2;
+	double sum_prod = counts.het_het + 2.0 * (counts.het_hom + counts.hom_het) + 4.0 * counts.hom_hom;
+	double var1 = n * sum_sq1 - sum1 * sum1;
+	double var2 = n * sum_sq2 - sum2 * sum2;
+	if (var1>0.0 && var2>0.0)
+	{
+		sample_correlation_ = (n * sum_prod - sum1 * sum2) / std::sqrt(var1 * var2);
+	}
+
+	//calulate percentage with same genotype if correlation is not calculatable
+	if (!BasicStatistics::isValidFloat(sample_correlation_))
+	{
+		sample_correlation_ = (double)(counts.wt_wt + counts.het_het + counts.hom_hom) / counts.overlap;
+		messages_.append("Could not calulate genotype correlation, calculated the fraction of matching genotypes instead.");
+	}
+}
+
+void SampleSimilarity::countPair(const GenotypeMatrix& matrix, int sample1, int sample2, int word_start, int word_end, PairCounts& counts)
+{
+	const quint64* bits1 = matrix.bits.constData() + 3 * sample1 * matrix.words;
+	const quint64* bits2 = matrix.bits.constData() + 3 * sample2 * matrix.words;
+	for (int w=word_start; w<word_end; ++w)
+	{
+		const quint64* x = bits1 + 3*w;
+		const quint64* y = bits2 + 3*w;
+
+		quint64 overlap = x[0] & y[0];
+		if (overlap==0) continue;
+
+		quint64 het1 = x[1] & overlap;
+		quint64 hom1 = x[2] & overlap;
+		quint64 het2 = y[1] & overlap;
+		quint64 hom2 = y[2] & overlap;
+		quint64 wt1 = overlap & ~(het1 | hom1);
+		quint64 wt2 = overlap & ~(het2 | hom2);
+
+		counts.overlap += qPopulationCount(overlap);
+		counts.het1 += qPopulationCount(het1);
+		counts.hom1 += qPopulationCount(hom1);
+		counts.het2 += qPopulationCount(het2);
+		counts.hom2 += qPopulationCount(hom2);
+		counts.het_het += qPopulationCount(het1 & het2);
+		counts.het_hom += qPopulationCount(het1 & hom2);
+		counts.hom_het += qPopulationCount(hom1 & het2);
+		counts.hom_hom += qPopulationCount(hom1 & hom2);
+		counts.wt_wt += qPopulationCount(wt1 & wt2);
+		counts.ibs0 += qPopulationCount((hom1 & wt2) | (wt1 & hom2));
+	}
+}
+
+int SampleSimilarity::variantCount(const GenotypeMatrix& matrix, int sample)
+{
+	int output = 0;
+	const quint64* bits = matrix.bits.constData() + 3 * sample * matrix.words;
+	for (int w=0; w<matrix.words; ++w)
+	{
+		output += qPopulationCount(bits[3*w]);
+	}
+	return output;
+}
+
 void SampleSimilarity::clear()
 {
 	no_variants1_ = 0;
@@ -5,6 +5,7 @@
 #include "BedFile.h"
 #include <QStringList>
 #include <QHash>
+#include <QVector>
 
 // Sample similarity calculator
 class CPPNGSSHARED_EXPORT SampleSimilarity
@@ -23,6 +24,50 @@ public:
 	//Calculation of similarity
 	void calculateSimilarity(const VariantGenotypes& in1, const VariantGenotypes& in2);
 
+	//Compact genotype matrix of a cohort.
+	//Each variant of the sorted variant dictionary (union of all samples) is a bit index. Each sample is stored as presence bitmap and 2-bit genotype (het/hom bitmaps).
+	struct GenotypeMatrix
+	{
+		int samples = 0;
+		int variants = 0;
+		int words = 0; //64-bit words per bitmap
+		QVector<quint64> bits; //presence, het and hom word of each sample and word (interleaved)
+	};
+
+	//Genotype counts of the overlapping variants of two samples of a genotype matrix (0=wildtype, 1=het, 2=hom).
+	struct PairCounts
+	{
+		int overlap = 0;
+		int het1 = 0;
+		int hom1 = 0;
+		int het2 = 0;
+		int hom2 = 0;
+		int het_het = 0;
+		int het_hom = 0;
+		int hom_het = 0;
+		int hom_hom = 0;
+		int wt_wt = 0;
+		int ibs0 = 0;
+	};
+
+	//Creates the genotype matrix of a cohort. Only discrete genotypes are supported (0.0, 0.5, 1.0), i.e. genotypes extracted from VCF/GSvar files.
+	static GenotypeMatrix genotypeMatrix(const QList<VariantGenotypes>& samples);
+
+	//Calculation of similarity of two samples of a genotype matrix
+	void calculateSimilarity(const GenotypeMatrix& matrix, int sample1, int sample2);
+
+	//Calculation of similarity of all sample pairs of a genotype matrix (pairs i<j in row-major order) using several threads.
+	static QList<SampleSimilarity> calculateSimilarityAll(const GenotypeMatrix& matrix, int threads);
+
+	//Calculation of similarity of one sample to the samples [start, end) of a genotype matrix using several threads.
+	static QList<SampleSimilarity> calculateSimilarity(const GenotypeMatrix& matrix, int sample, int start, int end, int threads);
+
+	//Adds the genotype counts of two samples of a genotype matrix in the given word range to @p counts.
+	static void countPair(const GenotypeMatrix& matrix, int sample1, int sample2, int word_start, int word_end, PairCounts& counts);
+
+	//Returns the number of variants of a sample of a genotype matrix.
+	static int variantCount(const GenotypeMatrix& matrix, int sample);
+
 	// Number of variants in first sample
 	int noVariants1()
 	{
@@ -75,6 +120,8 @@ public:
 	void clear();
 
 private:
+	//Sets the metrics from genotype counts of the overlapping variants.
+	void setMetrics(const PairCounts& counts, int no_variants1, int no_variants2);
 	static double genoToDouble(const QString& geno);
 	//Returns a string pointer, which can be stored/compared instead of the string. Reduces memory and run-time.
 	//Beanchmark with 38 GSvar files with 66k variants: memory-consumption 430>118MB, comparison time 20>5s
@@ -10,15 +10,16 @@
 #include "Pileup.h"
 #include "NGSHelper.h"
 #include "FastqFileStream.h"
-#include "LinePlot.h"
-#include "ScatterPlot.h"
-#include "BarPlot.h"
+#include "QCPlot.h"
+#include "QCPlotRenderer.h"
 #include "Helper.h"
 #include "SampleSimilarity.h"
 #include <QFileInfo>
 #include <QPair>
 #include "Histogram.h"
 #include "FilterCascade.h"
+#include <QThreadPool>
+#include <QRunnable>
 
 QCCollection Statistics::variantList(VariantList variants, bool filter)
 {
@@ -140,6 +141,7 @@ QCCollection Statistics::mapping(const BedFile& bed_file, const QString& bam_fil
         THROW(ArgumentException, "Merged and sorted BED file required for coverage details statistics!");
     }
     ChromosomalIndex<BedFile> roi_index(bed_file);
+	ChromosomalIndex<BedFile>::Sweep roi_sweep(roi_index); //alignments are sorted by position
 
     //open BAM file
 	BamReader reader(bam_file);
@@ -221,28 +223,26 @@ QCCollection Statistics::mapping(const BedFile& bed_file, const QString& bam_fil
 
             //calculate usable bases and base-resolution coverage
 			const Chromosome& chr = reader.chromosome(al.chromosomeID());
-            QVector<int> indices = roi_index.matchingIndices(chr, start_pos, end_pos);
-            if (indices.count()!=0)
-            {
-                ++al_ontarget;
-
-				if (!al.isDuplicate() && al.mappingQuality()>=min_mapq)
-                {
-                    foreach(int index, indices)
-                    {
-                        const int ol_start = std::max(bed_file[index].start(), start_pos);
-                        const int ol_end = std::min(bed_file[index].end(), end_pos);
-						bases_usable += ol_end - ol_start + 1;
-						auto it = roi_cov[chr.num()].lowerBound(ol_start);
-						auto end = roi_cov[chr.num()].upperBound(ol_end);
-						while (it!=end)
-						{
-							(*it)++;
-							++it;
-                        }
-                    }
-                }
-            }
+			const bool count_bases = !al.isDuplicate() && al.mappingQuality()>=min_mapq;
+			bool on_target = false;
+			roi_sweep.forEachMatch(chr, start_pos, end_pos, [&](int index)
+			{
+				on_target = true;
+				if (!count_bases) return false;
+
+				const int ol_start = std::max(bed_file[index].start(), start_pos);
+				const int ol_end = std::min(bed_file[index].end(), end_pos);
+				bases_usable += ol_end - ol_start + 1;
+				auto it = roi_cov[chr.num()].lowerBound(ol_start);
+				auto end = roi_cov[chr.num()].upperBound(ol_end);
+				while (it!=end)
+				{
+					(*it)++;
+					++it;
+				}
+				return true;
+			});
+			if (on_target) ++al_ontarget;
         }
 
         //trimmed bases (this is not entirely correct if the first alignments are all trimmed, but saves the second pass through the data)
@@ -323,29 +323,22 @@ QCCollection Statistics::mapping(const BedFile& bed_file, const QString& bam_fil
     }
 
 	//add depth distribtion plot
-	LinePlot plot;
+	QCPlot plot;
 	plot.setXLabel("depth of coverage");
 	plot.setYLabel("target region [%]");
 	plot.setXValues(depth_dist.xCoords());
 	plot.addLine(depth_dist.yCoords(true));
-	QString plotname = Helper::tempFileName(".png");
-	plot.store(plotname);
-	output.insert(QCValue::Image("depth distribution plot", plotname, "Depth of coverage distribution plot calculated one the target region.", "QC:2000037"));
-	QFile::remove(plotname);
+	output.insert(QCValue::ImageFromData("depth distribution plot", plot.toPNG(), "Depth of coverage distribution plot calculated one the target region.", "QC:2000037"));
 
 	//add insert size distribution plot
 	if (paired_end)
 	{
-		LinePlot plot2;
+		QCPlot plot2;
 		plot2.setXLabel("insert size");
 		plot2.setYLabel("reads [%]");
 		plot2.setXValues(insert_dist.xCoords());
 		plot2.addLine(insert_dist.yCoords(true));
-
-		plotname = Helper::tempFileName(".png");
-		plot2.store(plotname);
-		output.insert(QCValue::Image("insert size distribution plot", plotname, "Insert size distribution plot.", "QC:2000038"));
-		QFile::remove(plotname);
+		output.insert(QCValue::ImageFromData("insert size distribution plot", plot2.toPNG(), "Insert size distribution plot.", "QC:2000038"));
 	}
 
     return output;
@@ -530,16 +523,12 @@ QCCollection Statistics::mapping_rna(const QString &bam_file, int min_mapq)
     //add insert size distribution plot
     if (paired_end)
     {
-        LinePlot plot2;
+        QCPlot plot2;
         plot2.setXLabel("insert size");
         plot2.setYLabel("reads [%]");
         plot2.setXValues(insert_dist.xCoords());
         plot2.addLine(insert_dist.yCoords(true));
-
-        QString plotname = Helper::tempFileName(".png");
-        plot2.store(plotname);
-        output.insert(QCValue::Image("insert size distribution plot", plotname, "Insert size distribution plot.", "QC:2000038"));
-        QFile::remove(plotname);
+        output.insert(QCValue::ImageFromData("insert size distribution plot", plot2.toPNG(), "Insert size distribution plot.", "QC:2000038"));
     }
 
     return output;
@@ -660,16 +649,12 @@ QCCollection Statistics::mapping(const QString &bam_file, int min_mapq)
 	{
 		if (insert_dist.binSum()>0)
 		{
-			LinePlot plot2;
+			QCPlot plot2;
 			plot2.setXLabel("insert size");
 			plot2.setYLabel("reads [%]");
 			plot2.setXValues(insert_dist.xCoords());
 			plot2.addLine(insert_dist.yCoords(true));
-
-			QString plotname = Helper::tempFileName(".png");
-			plot2.store(plotname);
-			output.insert(QCValue::Image("insert size distribution plot", plotname, "Insert size distribution plot.", "QC:2000038"));
-			QFile::remove(plotname);
+			output.insert(QCValue::ImageFromData("insert size distribution plot", plot2.toPNG(), "Insert size distribution plot.", "QC:2000038"));
 		}
 		else
 		{
@@ -818,7 +803,75 @@ QCValue Statistics::mutationBurden(QString somatic_vcf, QString exons, QString t
 	return QCValue(qcml_name, QString::number(mutation_burden, 'f', 2), qcml_desc, qcml_id);
 }
 
-QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& normal_bam, QString& somatic_vcf, QString ref_fasta, const BedFile& target_file,bool skip_plots)
+//Determines the tumor allele frequencies of somatic SNVs of one chromosome used for the tumor content estimate. Tumor and normal BAM are read in one sweep each.
+class SomaticFrequencyWorker
+	: public QRunnable
+{
+public:
+	SomaticFrequencyWorker(const VariantList& variants, const QVector<int>& indices, const QString& tumor_bam, const QString& normal_bam, int min_depth, double max_somatic, QVector<double>& freqs, QString& error)
+		: QRunnable()
+		, variants_(variants)
+		, indices_(indices)
+		, tumor_bam_(tumor_bam)
+		, normal_bam_(normal_bam)
+		, min_depth_(min_depth)
+		, max_somatic_(max_somatic)
+		, freqs_(freqs)
+		, error_(error)
+	{
+	}
+
+	void run() override
+	{
+		try
+		{
+			const Chromosome& chr = variants_[indices_[0]].chr();
+			QVector<int> positions;
+			foreach(int index, indices_)
+			{
+				positions << variants_[index].start();
+			}
+
+			BamReader reader_tumor(tumor_bam_);
+			QVector<Pileup> pileups_tu = reader_tumor.getPileups(chr, positions);
+			BamReader reader_normal(normal_bam_);
+			QVector<Pileup> pileups_no = reader_normal.getPileups(chr, positions);
+
+			for (int i=0; i<indices_.count(); ++i)
+			{
+				const Variant& v = variants_[indices_[i]];
+				const Pileup& pileup_tu = pileups_tu[i];
+				if (pileup_tu.depth(true) < min_depth_) continue;
+				const Pileup& pileup_no = pileups_no[i];
+				if (pileup_no.depth(true) < min_depth_) continue;
+
+				double no_freq = pileup_no.frequency(v.ref()[0], v.obs()[0]);
+				if (!BasicStatistics::isValidFloat(no_freq) || no_freq >= max_somatic_) continue;
+
+				double tu_freq = pileup_tu.frequency(v.ref()[0], v.obs()[0]);
+				if (!BasicStatistics::isValidFloat(tu_freq) || tu_freq > 0.6) continue;
+
+				freqs_.append(tu_freq);
+			}
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
+		}
+	}
+
+protected:
+	const VariantList& variants_;
+	QVector<int> indices_;
+	QString tumor_bam_;
+	QString normal_bam_;
+	int min_depth_;
+	double max_somatic_;
+	QVector<double>& freqs_;
+	QString& error_;
+};
+
+QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& normal_bam, QString& somatic_vcf, QString ref_fasta, const BedFile& target_file,bool skip_plots, int threads)
 {
 	QCCollection output;
 
@@ -930,10 +983,8 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 	int min_depth = 30;
 	double max_somatic = 0.01;
 	int n = 10;
-	//process variants
-	QVector<double> freqs;
-	BamReader reader_tumor(tumor_bam);
-	BamReader reader_normal(normal_bam);
+	//process variants (somatic autosomal SNVs, in parallel per chromosome)
+	QList<QVector<int>> chr_indices;
 	for (int i=0; i<variants.count(); ++i)
 	{
 		const Variant& v = variants[i];
@@ -942,18 +993,26 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 		if (!v.chr().isAutosome()) continue;
 		if(!variants[i].filters().empty())	continue;	//skip non-somatic variants
 
-		Pileup pileup_tu = reader_tumor.getPileup(v.chr(), v.start());
-		if (pileup_tu.depth(true) < min_depth) continue;
-		Pileup pileup_no = reader_normal.getPileup(v.chr(), v.start());
-		if (pileup_no.depth(true) < min_depth) continue;
-
-		double no_freq = pileup_no.frequency(v.ref()[0], v.obs()[0]);
-		if (!BasicStatistics::isValidFloat(no_freq) || no_freq >= max_somatic) continue;
-
-		double tu_freq = pileup_tu.frequency(v.ref()[0], v.obs()[0]);
-		if (!BasicStatistics::isValidFloat(tu_freq) || tu_freq > 0.6) continue;
-
-		freqs.append(tu_freq);
+		if (chr_indices.isEmpty() || variants[chr_indices.last()[0]].chr()!=v.chr()) chr_indices << QVector<int>();
+		chr_indices.last() << i;
+	}
+	QVector<QVector<double>> chr_freqs(chr_indices.count());
+	QVector<QString> errors(chr_indices.count());
+	QThreadPool pool;
+	pool.setMaxThreadCount(std::max(1, threads));
+	for (int c=0; c<chr_indices.count(); ++c)
+	{
+		pool.start(new SomaticFrequencyWorker(variants, chr_indices[c], tumor_bam, normal_bam, min_depth, max_somatic, chr_freqs[c], errors[c]));
+	}
+	pool.waitForDone();
+	foreach(const QString& error, errors)
+	{
+		if (!error.isEmpty()) THROW(Exception, error);
+	}
+	QVector<double> freqs;
+	foreach(const QVector<double>& tmp, chr_freqs)
+	{
+		freqs += tmp;
 	}
 
 	//sort data
@@ -982,6 +1041,9 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 	if(!variants.sampleExists(tumor_id))	Log::error("Tumor sample " + tumor_id + " was not found in variant file " + somatic_vcf);
 	if(!variants.sampleExists(normal_id))	Log::error("Normal sample " + normal_id + " was not found in variant file " + somatic_vcf);
 
+	//plots are rendered on a worker thread while the data of the following plots is calculated
+	QCPlotRenderer plots(output);
+
 	//plot0: histogram allele frequencies somatic mutations
 	Histogram hist_filtered(0,1,0.0125);
 	Histogram hist_all(0,1,0.0125);
@@ -1034,15 +1096,16 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 		// else: strelka indel
 	}
 
-	QString plot0name = Helper::tempFileName(".png");
-	hist_all.setLabel("all variants");
-	hist_filtered.setLabel("variants with filter PASS");
-	Histogram::storeCombinedHistogram(plot0name, QList<Histogram>({hist_all,hist_filtered}),"tumor allele frequency","count");
-	output.insert(QCValue::Image("somatic SNVs allele frequency histogram", plot0name, "Allele frequency histogram of somatic SNVs.", "QC:2000055"));
-	QFile::remove(plot0name);
+	QCPlot plot0;
+	plot0.setXLabel("tumor allele frequency");
+	plot0.setYLabel("count");
+	plot0.setXValues(hist_all.xCoords());
+	plot0.addLine(hist_all.yCoords(false), "all variants");
+	plot0.addLine(hist_filtered.yCoords(false), "variants with filter PASS");
+	plots.add(plot0, "somatic SNVs allele frequency histogram", "Allele frequency histogram of somatic SNVs.", "QC:2000055");
 
 	//plot0b: absolute count mutation distribution
-	BarPlot plot0b;
+	QCPlot plot0b;
 	plot0b.setXLabel("base change");
 	plot0b.setYLabel("count");
 	QMap<QString,QString> color_map = QMap<QString,QString>{{"C>A","b"},{"C>G","k"},{"C>T","r"},{"T>A","g"},{"T>G","c"},{"T>C","y"}};
@@ -1085,14 +1148,16 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 
 	plot0b.setYRange(-ymax*0.02,ymax*1.2);
 	plot0b.setXRange(-1.5,nuc_changes.count()+0.5);
-	plot0b.setValues(counts, nuc_changes, colors);
-	QString plot0bname = Helper::tempFileName(".png");
-	plot0b.store(plot0bname);
-	output.insert(QCValue::Image("somatic SNV mutation types", plot0bname, "", "QC:?"));
-	QFile::remove(plot0bname);
+	QList<double> count_values;
+	foreach(int c, counts)
+	{
+		count_values << c;
+	}
+	plot0b.setBars(count_values, nuc_changes, colors);
+	plots.add(plot0b, "somatic SNV mutation types", "", "QC:?");
 
 	//plot1: allele frequencies
-	ScatterPlot plot1;
+	QCPlot plot1;
 	plot1.setXLabel("tumor allele frequency");
 	plot1.setYLabel("normal allele frequency");
 	plot1.setXRange(-0.015,1.015);
@@ -1208,17 +1273,14 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 		colors.append(b);
 	}
 
-	plot1.setValues(points, colors);
+	plot1.setPoints(points, colors);
 	plot1.addColorLegend(g,"all variants");
 	plot1.addColorLegend(b,"variants with filter PASS");
 
-	QString plot1name = Helper::tempFileName(".png");
-	plot1.store(plot1name);
-	output.insert(QCValue::Image("somatic variants allele frequencies plot", plot1name, ".", "QC:2000048"));
-	QFile::remove(plot1name);
+	plots.add(plot1, "somatic variants allele frequencies plot", ".", "QC:2000048");
 
 	//plot2: somatic variant signature
-	BarPlot plot2;
+	QCPlot plot2;
 	plot2.setXLabel("triplett");
 	plot2.setYLabel("count");
 	QString c,co,cod;
@@ -1361,16 +1423,13 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 
 	plot2.setXRange(-1.5,frequencies.count()+0.5);
 	plot2.setYRange(-y_max*0.02,y_max*1.2);
-	plot2.setValues(frequencies, labels, colors);
-	QString plot2name = Helper::tempFileName(".png");
-	plot2.store(plot2name);
-	output.insert(QCValue::Image("somatic SNV signature plot", plot2name, "Percentage of different variant types. If a target file was given, the variant type percentage is normalized to the reference genome.", "QC:2000047"));
-	QFile::remove(plot2name);
+	plot2.setBars(frequencies, labels, colors);
+	plots.add(plot2, "somatic SNV signature plot", "Percentage of different variant types. If a target file was given, the variant type percentage is normalized to the reference genome.", "QC:2000047");
 
 	//plot3: somatic variant distances, only for whole genome sequencing
 	if(target_file.count() == 0)
 	{
-		ScatterPlot plot3;
+		QCPlot plot3;
 		plot3.setXLabel("chromosomes");
 		plot3.setYLabel("somatic variant distance [bp]");
 		plot3.setYLogScale(true);
@@ -1437,12 +1496,10 @@ QCCollection Statistics::somatic(QString build, QString& tumor_bam, QString& nor
 		plot3.setYRange(0.975,max*100);
 		plot3.setXRange(0,1);
 		plot3.noXTicks();
-		plot3.setValues(points3);
-		QString plot3name = Helper::tempFileName(".png");
-		plot3.store(plot3name);
-		output.insert(QCValue::Image("somatic variant distance plot", plot3name, ".", "QC:2000046"));
-		QFile::remove(plot3name);
+		plot3.setPoints(points3);
+		plots.add(plot3, "somatic variant distance plot", ".", "QC:2000046");
 	}
+	plots.finish();
 
 	return output;
 }
@@ -1710,73 +1767,164 @@ BedFile Statistics::lowCoverage(const QString& bam_file, int cutoff, int min_map
     return output;
 }
 
-void Statistics::avgCoverage(BedFile& bed_file, const QString& bam_file, int min_mapq, bool include_duplicates, bool panel_mode, int decimals)
+//Calculates the coverage sum of BED regions for one BAM file. The regions are restricted to one chromosome, unless the whole BAM file is scanned (default mode without chromosome).
+class AvgCoverageWorker
+	: public QRunnable
 {
-    //check target region is merged/sorted and create index
-    if (!bed_file.isMergedAndSorted())
-    {
-        THROW(ArgumentException, "Merged and sorted BED file required for coverage calculation!");
-    }
-
-    //open BAM file
-	BamReader reader(bam_file);
+public:
+	AvgCoverageWorker(const BedFile& bed_file, const ChromosomalIndex<BedFile>& bed_idx, const QString& bam_file, const Chromosome& chr, int first, int last, int min_mapq, bool include_duplicates, bool panel_mode, long* cov, QString& error)
+		: QRunnable()
+		, bed_file_(bed_file)
+		, bed_idx_(bed_idx)
+		, bam_file_(bam_file)
+		, chr_(chr)
+		, first_(first)
+		, last_(last)
+		, min_mapq_(min_mapq)
+		, include_duplicates_(include_duplicates)
+		, panel_mode_(panel_mode)
+		, cov_(cov)
+		, error_(error)
+	{
+	}
 
-	if (panel_mode) //panel mode
+	void run() override
 	{
-		for (int i=0; i<bed_file.count(); ++i)
+		try
 		{
-			long cov = 0;
-			BedLine& bed_line = bed_file[i];
+			BamReader reader(bam_file_);
+			if (panel_mode_)
+			{
+				for (int i=first_; i<=last_; ++i)
+				{
+					const BedLine& bed_line = bed_file_[i];
 
-			//jump to region
-			reader.setRegion(bed_line.chr(), bed_line.start(), bed_line.end());
+					//jump to region
+					reader.setRegion(bed_line.chr(), bed_line.start(), bed_line.end());
 
-			//iterate through all alignments
-			BamAlignment al;
-			while (reader.getNextAlignment(al))
+					//iterate through all alignments
+					BamAlignment al;
+					while (reader.getNextAlignment(al))
+					{
+						if (!include_duplicates_ && al.isDuplicate()) continue;
+						if (al.isSecondaryAlignment()) continue;
+						if (al.isUnmapped() || al.mappingQuality()<min_mapq_) continue;
+
+						const int ol_start = std::max(bed_line.start(), al.start());
+						const int ol_end = std::min(bed_line.end(), al.end());
+						if (ol_start<=ol_end)
+						{
+							cov_[i] += ol_end - ol_start + 1;
+						}
+					}
+				}
+			}
+			else
 			{
-				if (!include_duplicates && al.isDuplicate()) continue;
-				if (al.isSecondaryAlignment()) continue;
-				if (al.isUnmapped() || al.mappingQuality()<min_mapq) continue;
+				//jump to chromosome
+				if (chr_.isValid())
+				{
+					if (!reader.chromosomes().contains(chr_)) return;
+					reader.setRegion(chr_, 1, reader.chromosomeSize(chr_));
+				}
 
-				const int ol_start = std::max(bed_line.start(), al.start());
-				const int ol_end = std::min(bed_line.end(), al.end());
-				if (ol_start<=ol_end)
+				//iterate through all alignments
+				BamAlignment al;
+				while (reader.getNextAlignment(al))
 				{
-					cov += ol_end - ol_start + 1;
+					if (!include_duplicates_ && al.isDuplicate()) continue;
+					if (al.isSecondaryAlignment()) continue;
+					if (al.isUnmapped() || al.mappingQuality()<min_mapq_) continue;
+
+					const Chromosome& chr = reader.chromosome(al.chromosomeID());
+					int end_position = al.end();
+					QVector<int> indices = bed_idx_.matchingIndices(chr, al.start(), end_position);
+					foreach(int index, indices)
+					{
+						cov_[index] += std::min(bed_file_[index].end(), end_position) - std::max(bed_file_[index].start(), al.start());
+					}
 				}
 			}
-			bed_line.annotations().append(QByteArray::number((double)cov / bed_line.length(), 'f', decimals));
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
 		}
 	}
-	else //default mode
+
+protected:
+	const BedFile& bed_file_;
+	const ChromosomalIndex<BedFile>& bed_idx_;
+	QString bam_file_;
+	Chromosome chr_;
+	int first_;
+	int last_;
+	int min_mapq_;
+	bool include_duplicates_;
+	bool panel_mode_;
+	long* cov_;
+	QString& error_;
+};
+
+void Statistics::avgCoverage(BedFile& bed_file, const QString& bam_file, int min_mapq, bool include_duplicates, bool panel_mode, int decimals)
+{
+	avgCoverage(bed_file, QStringList() << bam_file, min_mapq, include_duplicates, panel_mode, decimals, 1);
+}
+
+void Statistics::avgCoverage(BedFile& bed_file, const QStringList& bam_files, int min_mapq, bool include_duplicates, bool panel_mode, int decimals, int threads)
+{
+    //check target region is merged/sorted and create index
+    if (!bed_file.isMergedAndSorted())
+    {
+        THROW(ArgumentException, "Merged and sorted BED file required for coverage calculation!");
+    }
+	ChromosomalIndex<BedFile> bed_idx(bed_file);
+
+	//determine chromosome shards (index range of the regions of each chromosome)
+	QList<QPair<int, int>> shards;
+	for (int i=0; i<bed_file.count(); ++i)
 	{
-		//init coverage statistics data structure
-		QVector<long> cov;
-		cov.fill(0, bed_file.count());
+		if (i==0 || bed_file[i].chr()!=bed_file[i-1].chr())
+		{
+			shards << qMakePair(i, i);
+		}
+		shards.last().second = i;
+	}
 
-		//iterate through all alignments
-		ChromosomalIndex<BedFile> bed_idx(bed_file);
-		BamAlignment al;
-		while (reader.getNextAlignment(al))
+	//calculate coverage sums - the work is split by BAM file and chromosome.
+	//With one thread, the default mode streams through the whole BAM file (no index needed).
+	QVector<QVector<long>> cov(bam_files.count());
+	int c_jobs = (!panel_mode && threads<=1) ? bam_files.count() : bam_files.count() * shards.count();
+	QVector<QString> errors(c_jobs);
+	QThreadPool pool;
+	pool.setMaxThreadCount(std::max(1, threads));
+	int job = 0;
+	for (int b=0; b<bam_files.count(); ++b)
+	{
+		cov[b].fill(0, bed_file.count());
+		if (!panel_mode && threads<=1)
 		{
-			if (!include_duplicates && al.isDuplicate()) continue;
-			if (al.isSecondaryAlignment()) continue;
-			if (al.isUnmapped() || al.mappingQuality()<min_mapq) continue;
+			pool.start(new AvgCoverageWorker(bed_file, bed_idx, bam_files[b], Chromosome(), 0, bed_file.count()-1, min_mapq, include_duplicates, panel_mode, cov[b].data(), errors[job++]));
+			continue;
+		}
 
-			const Chromosome& chr = reader.chromosome(al.chromosomeID());
-			int end_position = al.end();
-			QVector<int> indices = bed_idx.matchingIndices(chr, al.start(), end_position);
-			foreach(int index, indices)
-			{
-				cov[index] += std::min(bed_file[index].end(), end_position) - std::max(bed_file[index].start(), al.start());
-			}
+		foreach(const auto& shard, shards)
+		{
+			pool.start(new AvgCoverageWorker(bed_file, bed_idx, bam_files[b], bed_file[shard.first].chr(), shard.first, shard.second, min_mapq, include_duplicates, panel_mode, cov[b].data(), errors[job++]));
 		}
+	}
+	pool.waitForDone();
+	foreach(const QString& error, errors)
+	{
+		if (!error.isEmpty()) THROW(Exception, error);
+	}
 
-		//calculate output
+	//calculate output
+	for (int b=0; b<bam_files.count(); ++b)
+	{
 		for (int i=0; i<bed_file.count(); ++i)
 		{
-			bed_file[i].annotations().append(QByteArray ::number((double)(cov[i]) / bed_file[i].length(), 'f', decimals));
+			bed_file[i].annotations().append(QByteArray::number((double)(cov[b][i]) / bed_file[i].length(), 'f', decimals));
 		}
 	}
 }
@@ -43,8 +43,8 @@ public:
 	static QCCollection mapping(const QString& bam_file, int min_mapq=1);
 	///Calculates target region statistics (term-value pairs). @p merge determines if overlapping regions are merged before calculating the statistics.
 	static QCCollection region(const BedFile& bed_file, bool merge);
-	///Calculates somatic QC metrics from BAM and VCF file
-	static QCCollection somatic(QString build, QString& tumor_bam, QString& normal_bam, QString& somatic_vcf, QString ref_fasta, const BedFile& target_file, bool skip_plots = false);
+	///Calculates somatic QC metrics from BAM and VCF file. The tumor/normal pileups of somatic variants are determined using @p threads threads (one job per chromosome).
+	static QCCollection somatic(QString build, QString& tumor_bam, QString& normal_bam, QString& somatic_vcf, QString ref_fasta, const BedFile& target_file, bool skip_plots = false, int threads = 1);
 	///Calculates mutation burden metric from somatic VCF
 	static QCValue mutationBurden(QString somatic_vcf, QString exons, QString target, QString tsg, QString blacklist);
 	///Calculates the percentage of common SNPs that lie outside the expected allele frequency range for diploid organisms.
@@ -58,6 +58,8 @@ public:
     static BedFile lowCoverage(const QString& bam_file, int cutoff, int min_mapq=1);
 	///Calculates and annotates the average coverage of the regions in the bed file. The input BED file must be merged and sorted! Panel mode should be used if only a small part of the BAM data is needed.
 	static void avgCoverage(BedFile& bed_file, const QString& bam_file, int min_mapq=1, bool include_duplicates=false, bool panel_mode=false, int decimals=2);
+	///Calculates and annotates the average coverage of the regions in the bed file for several BAM files (one column per BAM file). The work is split by BAM file and chromosome and processed with @p threads threads.
+	static void avgCoverage(BedFile& bed_file, const QStringList& bam_files, int min_mapq, bool include_duplicates, bool panel_mode, int decimals, int threads);
 	///Calculates the part of the genome that has a higher coverage than the given cutoff.
 	static BedFile highCoverage(const QString& bam_file, int cutoff, int min_mapq=1);
 
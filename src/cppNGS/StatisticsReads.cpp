@@ -1,20 +1,54 @@
 #include "StatisticsReads.h"
-#include "LinePlot.h"
+#include "QCPlot.h"
 #include "Helper.h"
+#include "Exceptions.h"
+#include <algorithm>
 
 StatisticsReads::StatisticsReads()
 	: c_forward_(0)
 	, c_reverse_(0)
 	, read_lengths_()
     , bases_sequenced_(0)
-	, c_read_q20_(0.0)
-	, c_base_q30_(0.0)
-	, pileups_()
+	, c_read_q20_(0)
+	, c_base_q30_(0)
+	, cycles_(0)
+	, base_counts_()
 	, qualities1_()
 	, qualities2_()
 {
 }
 
+const int* StatisticsReads::baseCodes()
+{
+	static const QVector<int> codes = []()
+	{
+		QVector<int> output(256, -1);
+		output['A'] = 0; output['a'] = 0;
+		output['C'] = 1; output['c'] = 1;
+		output['G'] = 2; output['g'] = 2;
+		output['T'] = 3; output['t'] = 3;
+		output['N'] = 4; output['n'] = 4;
+		output['-'] = 5; output['~'] = 5;
+		return output;
+	}();
+
+	return codes.constData();
+}
+
+void StatisticsReads::resize(int cycles)
+{
+	QVector<long long> base_counts(BASE_CODES * cycles, 0);
+	for (int b=0; b<BASE_CODES; ++b)
+	{
+		std::copy(base_counts_.constBegin() + b * cycles_, base_counts_.constBegin() + (b+1) * cycles_, base_counts.begin() + b * cycles);
+	}
+	base_counts_ = base_counts;
+
+	qualities1_.resize(cycles);
+	qualities2_.resize(cycles);
+	cycles_ = cycles;
+}
+
 void StatisticsReads::update(const FastqEntry& entry, ReadDirection direction)
 {
 	//update read counts
@@ -30,34 +64,63 @@ void StatisticsReads::update(const FastqEntry& entry, ReadDirection direction)
 	//check number of cycles
 	int cycles = entry.bases.count();
     bases_sequenced_ += cycles;
-	read_lengths_.insert(cycles);
-	if (cycles>pileups_.size())
+	if (cycles>=read_lengths_.count()) read_lengths_.resize(cycles+1);
+	++read_lengths_[cycles];
+	if (cycles>cycles_) resize(cycles);
+
+	//count bases per cycle
+	const int* codes = baseCodes();
+	const char* bases = entry.bases.constData();
+	long long* counts = base_counts_.data();
+	for (int i=0; i<cycles; ++i)
 	{
-		pileups_.resize(cycles);
-		qualities1_.resize(cycles);
-		qualities2_.resize(cycles);
+		int code = codes[(unsigned char)bases[i]];
+		if (code==-1) THROW(ArgumentException, "Unknown base '" + QString(QChar(bases[i])) + "' in pileup!");
+		++counts[code * cycles_ + i];
 	}
 
-	//create pileups
-	for (int i=0; i<cycles; ++i) pileups_[i].inc(entry.bases[i]);
-
 	//handle qualities
-	double q_sum = 0.0;
+	const char* qualities = entry.qualities.constData();
+	long long* q_cycle = (direction==FORWARD ? qualities1_ : qualities2_).data();
+	long long q_sum = 0;
+	int c_q30 = 0;
 	for (int i=0; i<cycles; ++i)
 	{
-		int q = entry.quality(i);
+		int q = qualities[i] - 33;
 		q_sum += q;
-		if (q>=30.0) ++c_base_q30_;
-		if (direction==FORWARD)
-		{
-			qualities1_[i] += q;
-		}
-		else
+		c_q30 += (q>=30);
+		q_cycle[i] += q;
+	}
+	c_base_q30_ += c_q30;
+	if (cycles>0 && q_sum>=20*cycles) ++c_read_q20_;
+}
+
+void StatisticsReads::merge(const StatisticsReads& other)
+{
+	c_forward_ += other.c_forward_;
+	c_reverse_ += other.c_reverse_;
+	if (other.read_lengths_.count()>read_lengths_.count()) read_lengths_.resize(other.read_lengths_.count());
+	for (int i=0; i<other.read_lengths_.count(); ++i)
+	{
+		read_lengths_[i] += other.read_lengths_[i];
+	}
+	bases_sequenced_ += other.bases_sequenced_;
+	c_read_q20_ += other.c_read_q20_;
+	c_base_q30_ += other.c_base_q30_;
+
+	if (other.cycles_>cycles_) resize(other.cycles_);
+	for (int b=0; b<BASE_CODES; ++b)
+	{
+		for (int i=0; i<other.cycles_; ++i)
 		{
-			qualities2_[i] += q;
+			base_counts_[b * cycles_ + i] += other.base_counts_[b * other.cycles_ + i];
 		}
 	}
-	if (q_sum/cycles>=20.0) ++c_read_q20_;
+	for (int i=0; i<other.cycles_; ++i)
+	{
+		qualities1_[i] += other.qualities1_[i];
+		qualities2_[i] += other.qualities2_[i];
+	}
 }
 
 QCCollection StatisticsReads::getResult()
@@ -65,11 +128,22 @@ QCCollection StatisticsReads::getResult()
 	//create output values
 	QCCollection output;
 
+	//create pileups from base counts
+	QVector<Pileup> pileups(cycles_);
+	const char bases[] = "ACGTN";
+	for (int i=0; i<cycles_; ++i)
+	{
+		for (int b=0; b<5; ++b)
+		{
+			pileups[i].inc(bases[b], base_counts_[b * cycles_ + i]);
+		}
+	}
+
 	long long total_reads = c_forward_ + c_reverse_;
 	long long c_base_n = 0;
 	long long c_base_gc = 0;
 	long long bases_total = 0;
-	foreach(const Pileup& pileup, pileups_)
+	foreach(const Pileup& pileup, pileups)
 	{
 		c_base_n += pileup.n();
 		c_base_gc += pileup.g() + pileup.c();
@@ -78,8 +152,11 @@ QCCollection StatisticsReads::getResult()
 
 	output.insert(QCValue("read count", total_reads, "Total number of reads (forward and reverse reads of paired-end sequencing count as two reads).", "QC:2000005"));
 	QString lengths = "";
-	QList<int> tmp = read_lengths_.toList(); //why? QSet is hash-based!
-	std::sort(tmp.begin(), tmp.end());
+	QList<int> tmp;
+	for (int i=0; i<read_lengths_.count(); ++i)
+	{
+		if (read_lengths_[i]>0) tmp << i;
+	}
 	if (tmp.size()<4)
 	{
 		lengths = QString::number(tmp[0]);
@@ -100,10 +177,10 @@ QCCollection StatisticsReads::getResult()
 	output.insert(QCValue("gc content percentage", 100.0*c_base_gc/(bases_total-c_base_n), "The percentage of bases that are called to be G or C.", "QC:2000010"));
 
 	//create output base distribution plot
-	int cycles = pileups_.count();
+	int cycles = pileups.count();
 	QVector<double> line_a(cycles), line_c(cycles), line_g(cycles), line_t(cycles), line_n(cycles), line_gc(cycles), line_x(cycles);
 	int i=0;
-	foreach(const Pileup& pileup, pileups_)
+	foreach(const Pileup& pileup, pileups)
 	{
 		double depth_no_n = pileup.depth(false);
 		line_a[i] = 100.0 * pileup.a() / depth_no_n;
@@ -115,7 +192,7 @@ QCCollection StatisticsReads::getResult()
 		line_x[i] = i+1;
 		++i;
 	}
-	LinePlot plot;
+	QCPlot plot;
 	plot.setXLabel("cycle");
 	plot.setYLabel("base [%]");
 	plot.setYRange(0.0, 100.0);
@@ -126,32 +203,27 @@ QCCollection StatisticsReads::getResult()
 	plot.addLine(line_t, "T");
 	plot.addLine(line_n, "N");
 	plot.addLine(line_gc, "GC");
-	QString plotname = Helper::tempFileName(".png");
-	plot.store(plotname);
-	output.insert(QCValue::Image("base distribution plot", plotname, "Base distribution plot per cycle.", "QC:2000011"));
-	QFile::remove(plotname);
+	output.insert(QCValue::ImageFromData("base distribution plot", plot.toPNG(), "Base distribution plot per cycle.", "QC:2000011"));
 
 	//create output quality distribution plot
-	for(int j=0; j<qualities1_.count(); ++j)
+	QVector<double> qualities1(cycles), qualities2(cycles);
+	for(int j=0; j<cycles; ++j)
 	{
-		int depth = pileups_[j].depth(false, true) / 2;
-		qualities1_[j] /= depth;
-		qualities2_[j] /= depth;
+		int depth = pileups[j].depth(false, true) / 2;
+		qualities1[j] = (double)qualities1_[j] / depth;
+		qualities2[j] = (double)qualities2_[j] / depth;
 	}
-	LinePlot plot2;
+	QCPlot plot2;
 	plot2.setXLabel("cycle");
 	plot2.setYLabel("mean Q score");
 	plot2.setYRange(0.0, 41.5);
 	plot2.setXValues(line_x);
-	plot2.addLine(qualities1_, "forward reads");
+	plot2.addLine(qualities1, "forward reads");
 	if (c_reverse_>0)
 	{
-		plot2.addLine(qualities2_, "reverse reads");
+		plot2.addLine(qualities2, "reverse reads");
 	}
-	QString plotname2 = Helper::tempFileName(".png");
-	plot2.store(plotname2);
-	output.insert(QCValue::Image("Q score plot", plotname2, "Mean Q score per cycle for forward/reverse reads.", "QC:2000012"));
-	QFile::remove(plotname2);
+	output.insert(QCValue::ImageFromData("Q score plot", plot2.toPNG(), "Mean Q score per cycle for forward/reverse reads.", "QC:2000012"));
 
 	return output;
 }
@@ -2,16 +2,15 @@
 #define STATISTICSREADS_H
 
 #include "cppNGS_global.h"
-#include <QSet>
 #include "FastqFileStream.h"
 #include "QCCollection.h"
 #include "Pileup.h"
-#include <QMutex>
+#include <QVector>
 
 /*
 	@brief Read statistics for quality control.
 
-	@note This class is thread-safe, i.e. several threads can update statistics without corrupting the result.
+	@note This class is not thread-safe. When processing reads in several threads, use one instance per thread and merge them afterwards.
 */
 class CPPNGSSHARED_EXPORT StatisticsReads
 {
@@ -28,19 +27,29 @@ public:
 	StatisticsReads();
 	///Updates the statistics based on the given read.
 	void update(const FastqEntry& entry, ReadDirection direction);
+	///Adds the statistics of another instance, e.g. of another thread.
+	void merge(const StatisticsReads& other);
 	///Returns the statistics result.
 	QCCollection getResult();
 
 private:
 	long long c_forward_;
 	long long c_reverse_;
-	QSet<int> read_lengths_;
+	QVector<long long> read_lengths_; //read count per read length
     long long bases_sequenced_;
 	long long c_read_q20_;
 	long long c_base_q30_;
-	QVector<Pileup> pileups_;
-	QVector<double> qualities1_;
-	QVector<double> qualities2_;
+	int cycles_;
+	QVector<long long> base_counts_; //base counts per cycle (index: base code * cycles_ + cycle)
+	QVector<long long> qualities1_;
+	QVector<long long> qualities2_;
+
+	///Number of base codes: A, C, G, T, N and ignored bases (deletions, skipped bases).
+	static const int BASE_CODES = 6;
+	///Returns the base code lookup table (-1 for invalid bases).
+	static const int* baseCodes();
+	///Increases the number of cycles.
+	void resize(int cycles);
 };
 
 #endif // STATISTICSREADS_H
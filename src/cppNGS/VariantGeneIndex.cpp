@@ -0,0 +1,118 @@
+#include "VariantGeneIndex.h"
+#include "VariantList.h"
+#include "CnvList.h"
+#include <algorithm>
+
+VariantGeneIndex::VariantGeneIndex()
+	: gene_column_(-1)
+	, gene_texts_()
+	, variant_offsets_(1, 0)
+	, variant_genes_()
+	, gene_offsets_(1, 0)
+	, gene_variants_()
+{
+}
+
+VariantGeneIndex::VariantGeneIndex(const VariantList& variants, int gene_column)
+	: gene_column_(gene_column)
+	, gene_texts_()
+	, variant_offsets_(1, 0)
+	, variant_genes_()
+	, gene_offsets_(1, 0)
+	, gene_variants_()
+{
+	gene_texts_.reserve(variants.count());
+	variant_offsets_.reserve(variants.count()+1);
+
+	//variant => genes (the gene column is parsed like in GeneSet::createFromText)
+	QVector<int> gene_ids;
+	for (int i=0; i<variants.count(); ++i)
+	{
+		const QByteArray& text = variants[i].annotations()[gene_column];
+		gene_texts_ << text;
+
+		gene_ids.clear();
+		foreach(const QByteArray& gene, text.split(','))
+		{
+			if (gene.startsWith("#")) continue;
+			QByteArray tmp = gene.trimmed().toUpper();
+			if (tmp.isEmpty()) continue;
+			gene_ids << GeneSymbolTable::id(tmp);
+		}
+		addVariant(gene_ids);
+	}
+
+	createGeneToVariantIndex();
+}
+
+VariantGeneIndex::VariantGeneIndex(const CnvList& cnvs)
+	: gene_column_(-1)
+	, gene_texts_()
+	, variant_offsets_(1, 0)
+	, variant_genes_()
+	, gene_offsets_(1, 0)
+	, gene_variants_()
+{
+	variant_offsets_.reserve(cnvs.count()+1);
+
+	//variant => genes
+	QVector<int> gene_ids;
+	for (int i=0; i<cnvs.count(); ++i)
+	{
+		gene_ids = cnvs[i].genes().ids();
+		addVariant(gene_ids);
+	}
+
+	createGeneToVariantIndex();
+}
+
+bool VariantGeneIndex::createdFrom(const VariantList& variants, int gene_column) const
+{
+	if (gene_column!=gene_column_ || variants.count()!=gene_texts_.count()) return false;
+
+	//the index references the gene column it was created from, so changing an annotation always changes the data pointer
+	for (int i=0; i<variants.count(); ++i)
+	{
+		const QByteArray& text = variants[i].annotations()[gene_column];
+		if (text.constData()!=gene_texts_[i].constData() || text.size()!=gene_texts_[i].size()) return false;
+	}
+
+	return true;
+}
+
+void VariantGeneIndex::addVariant(QVector<int>& gene_ids)
+{
+	std::sort(gene_ids.begin(), gene_ids.end());
+	auto end = std::unique(gene_ids.begin(), gene_ids.end());
+	for (auto it=gene_ids.begin(); it!=end; ++it)
+	{
+		variant_genes_ << *it;
+	}
+	variant_offsets_ << variant_genes_.count();
+}
+
+void VariantGeneIndex::createGeneToVariantIndex()
+{
+	//count variants per gene
+	int gene_id_count = variant_genes_.isEmpty() ? 0 : *std::max_element(variant_genes_.cbegin(), variant_genes_.cend()) + 1;
+	gene_offsets_.fill(0, gene_id_count+1);
+	foreach(int gene_id, variant_genes_)
+	{
+		++gene_offsets_[gene_id+1];
+	}
+	for (int g=0; g<gene_id_count; ++g)
+	{
+		gene_offsets_[g+1] += gene_offsets_[g];
+	}
+
+	//fill variants of genes (variants are processed in order, so the variants of each gene are sorted)
+	gene_variants_.resize(variant_genes_.count());
+	QVector<int> next = gene_offsets_;
+	for (int v=0; v<variantCount(); ++v)
+	{
+		for (int gene_id : genes(v))
+		{
+			gene_variants_[next[gene_id]++] = v;
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#ifndef VARIANTGENEINDEX_H
+#define VARIANTGENEINDEX_H
+
+#include "cppNGS_global.h"
+#include "GeneSet.h"
+#include <QVector>
+#include <QByteArrayList>
+
+class VariantList;
+class CnvList;
+
+///Inverted index of the genes of variants: variant index => gene identifiers and gene identifier => variant indices.
+///Gene identifiers are the identifiers of the normalized gene symbols in GeneSymbolTable, i.e. they can be compared with the identifiers of a GeneSet.
+class CPPNGSSHARED_EXPORT VariantGeneIndex
+{
+public:
+	///Range of identifiers/indices (sorted, without duplicates).
+	class Range
+	{
+	public:
+		Range(const int* begin, const int* end)
+			: begin_(begin)
+			, end_(end)
+		{
+		}
+		const int* begin() const
+		{
+			return begin_;
+		}
+		const int* end() const
+		{
+			return end_;
+		}
+		int count() const
+		{
+			return end_ - begin_;
+		}
+
+	protected:
+		const int* begin_;
+		const int* end_;
+	};
+
+	///Default constructor (empty).
+	VariantGeneIndex();
+	///Constructor for the comma-separated gene column of small variants.
+	VariantGeneIndex(const VariantList& variants, int gene_column);
+	///Constructor for CNVs.
+	VariantGeneIndex(const CnvList& cnvs);
+
+	///Returns the upper bound of the gene identifiers of the index, i.e. all gene identifiers of the index are smaller. Use it to size per-gene arrays.
+	int geneIdCount() const
+	{
+		return gene_offsets_.count() - 1;
+	}
+	///Returns the number of variants.
+	int variantCount() const
+	{
+		return variant_offsets_.count() - 1;
+	}
+	///Returns the identifiers of the genes of a variant.
+	Range genes(int variant) const
+	{
+		return Range(variant_genes_.constData() + variant_offsets_[variant], variant_genes_.constData() + variant_offsets_[variant+1]);
+	}
+	///Returns the indices of the variants of a gene.
+	Range variants(int gene_id) const
+	{
+		if (gene_id<0 || gene_id>=geneIdCount()) return Range(nullptr, nullptr);
+		return Range(gene_variants_.constData() + gene_offsets_[gene_id], gene_variants_.constData() + gene_offsets_[gene_id+1]);
+	}
+
+	///Returns if the index was created from the gene column of the given variant list, i.e. if it can be used for the variant list.
+	bool createdFrom(const VariantList& variants, int gene_column) const;
+
+protected:
+	int gene_column_;
+	QByteArrayList gene_texts_; //gene column the index was created from (shallow copies)
+	QVector<int> variant_offsets_; //offset of the first gene of each variant in 'variant_genes_' (and the end of the last variant)
+	QVector<int> variant_genes_;
+	QVector<int> gene_offsets_; //offset of the first variant of each gene in 'gene_variants_' (and the end of the last gene)
+	QVector<int> gene_variants_;
+
+	///Adds the genes of the next variant.
+	void addVariant(QVector<int>& gene_ids);
+	///Creates the gene to variant index from the variant to gene index.
+	void createGeneToVariantIndex();
+};
+
+#endif // VARIANTGENEINDEX_H
@@ -6,11 +6,18 @@
 #include "ChromosomalIndex.h"
 #include "NGSHelper.h"
 #include "VcfFile.h"
+#include "VariantGeneIndex.h"
 
 #include <QFile>
 #include <QTextStream>
 #include <QRegExp>
 #include <QBitArray>
+#include <QDataStream>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <queue>
+#include <algorithm>
 
 #include <zlib.h>
 
@@ -49,23 +56,14 @@ Variant::Variant(const Chromosome& chr, int start, int end, const Sequence& ref,
 	}
 }
 
-QByteArrayList Variant::vepAnnotations(int csq_index, int field_index) const
+VariantAnnotationIndex Variant::annotationIndex(int column_index, char separator, bool trim) const
 {
-	QByteArrayList output;
-
-	QByteArray csq = annotations()[csq_index].trimmed();
-	if (csq.count()>0)
-	{
-		QByteArrayList transcripts = csq.split(',');
-
-		foreach(const QByteArray& transcript, transcripts)
-		{
-			QByteArrayList csq_fields = transcript.split('|');
-			output << csq_fields[field_index];
-		}
-	}
+	return VariantAnnotationIndex(annotations_[column_index], separator, trim);
+}
 
-	return output;
+QByteArrayList Variant::vepAnnotations(int csq_index, int field_index) const
+{
+	return annotationIndex(csq_index, '|', false).fields(field_index);
 }
 
 void Variant::addFilter(QByteArray tag, int filter_column_index)
@@ -438,6 +436,8 @@ VariantList::VariantList()
 	, annotation_headers_()
 	, filters_()
 	, variants_()
+	, gene_index_cache_()
+	, annotation_cache_()
 {
 }
 
@@ -753,37 +753,8 @@ void VariantList::loadFromTSV(QString filename, ChromosomalIndex<BedFile>* roi_i
 		//skip empty lines
 		if(line.length()==0) continue;
 
-		if (line.startsWith("##"))//comment/description line
-		{
-			QList <QByteArray> parts = line.split('=');
-			if (line.startsWith("##DESCRIPTION=") && parts.count()>2)
-			{
-				annotationDescriptions().append(VariantAnnotationDescription(parts[1], parts.mid(2).join('='), VariantAnnotationDescription::STRING, false, "."));
-			}
-			else if (line.startsWith("##FILTER=") && parts.count()>2)
-			{
-				filters_[parts[1]] = parts.mid(2).join('=');
-			}
-			else
-			{
-				comments_.append(line); //comment line
-			}
-			continue;
-		}
-		if (line.startsWith("#"))//header
-		{
-			QList <QByteArray> fields = line.split('\t');
-            for (int i=special_cols; i<fields.count(); ++i)
-			{
-                if (fields[i]=="filter")
-                {
-                    filter_index = i - special_cols;
-                }
-
-				annotations().append(VariantAnnotationHeader(fields[i]));
-			}
-			continue;
-		}
+		//comment/description/header lines
+		if (processTsvHeaderLine(line, filter_index)) continue;
 
 		//error when special columns are not present
         QList<QByteArray> fields = line.split('\t');
@@ -816,6 +787,65 @@ void VariantList::loadFromTSV(QString filename, ChromosomalIndex<BedFile>* roi_i
 	}
 }
 
+void VariantList::loadHeaderOnly(QString filename)
+{
+	//remove old data
+	clear();
+
+	//parse until the first variant line
+	QSharedPointer<QFile> file = Helper::openFileForReading(filename, true);
+	int filter_index = -1;
+	while(!file->atEnd())
+	{
+		QByteArray line = file->readLine();
+		while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+
+		//skip empty lines
+		if(line.length()==0) continue;
+
+		if (!processTsvHeaderLine(line, filter_index)) break;
+	}
+}
+
+bool VariantList::processTsvHeaderLine(const QByteArray& line, int& filter_index)
+{
+	constexpr int special_cols = 5;
+
+	if (line.startsWith("##"))//comment/description line
+	{
+		QList <QByteArray> parts = line.split('=');
+		if (line.startsWith("##DESCRIPTION=") && parts.count()>2)
+		{
+			annotationDescriptions().append(VariantAnnotationDescription(parts[1], parts.mid(2).join('='), VariantAnnotationDescription::STRING, false, "."));
+		}
+		else if (line.startsWith("##FILTER=") && parts.count()>2)
+		{
+			filters_[parts[1]] = parts.mid(2).join('=');
+		}
+		else
+		{
+			comments_.append(line); //comment line
+		}
+		return true;
+	}
+	if (line.startsWith("#"))//header
+	{
+		QList <QByteArray> fields = line.split('\t');
+		for (int i=special_cols; i<fields.count(); ++i)
+		{
+			if (fields[i]=="filter")
+			{
+				filter_index = i - special_cols;
+			}
+
+			annotations().append(VariantAnnotationHeader(fields[i]));
+		}
+		return true;
+	}
+
+	return false;
+}
+
 void VariantList::storeToTSV(QString filename) const
 {
 	//open stream
@@ -1429,6 +1459,381 @@ void VariantList::sortByFile(QString filename)
 	sortCustom(LessComparatorByFile(filename));
 }
 
+//Entry of VariantList::sortFile: sort key and unchanged file line.
+struct VariantSortEntry
+{
+	Variant key; //the only annotation is the quality
+	QByteArray line;
+};
+
+//Sort key of a VCF/TSV line (see loadFromVCF and loadFromTSV).
+static Variant variantSortKey(const QByteArray& line, bool vcf, int quality_index)
+{
+	QList<QByteArray> parts = line.split('\t');
+	if (vcf)
+	{
+		if (parts.count()<VcfFile::MIN_COLS) THROW(FileParseException, "VCF data line needs at least 7 tab-separated columns! Found " + QString::number(parts.count()) + " column(s): " + line.trimmed());
+		Sequence ref = parts[3].toUpper();
+		int start = atoi(parts[1]);
+		return Variant(parts[0], start, start + ref.length() - 1, ref, parts[4].toUpper(), QList<QByteArray>() << parts[5]);
+	}
+
+	if (parts.count()<5) THROW(FileParseException, "Variant TSV file line with less than five fields found: '" + line.trimmed() + "'");
+	QList<QByteArray> annos;
+	if (quality_index!=-1) annos << parts.value(5 + quality_index).trimmed();
+	return Variant(parts[0], atoi(parts[1]), atoi(parts[2]), parts[3], parts[4], annos);
+}
+
+//Sequential writer for temporary run files of VariantList::sortFile (compressed blocks of serialized entries).
+class VariantSortRunWriter
+{
+public:
+	VariantSortRunWriter(QString filename)
+		: file_(Helper::openFileForWriting(filename))
+		, stream_(file_.data())
+		, block_()
+	{
+	}
+
+	~VariantSortRunWriter()
+	{
+		if (!block_.isEmpty()) stream_ << qCompress(block_, 1);
+	}
+
+	void write(const VariantSortEntry& entry)
+	{
+		const Variant& v = entry.key;
+		block_ += v.chr().str() + '\t' + QByteArray::number(v.start()) + '\t' + QByteArray::number(v.end()) + '\t' + v.ref() + '\t' + v.obs() + '\t' + v.annotations().value(0) + '\t' + entry.line;
+		if (block_.size()>=1048576)
+		{
+			stream_ << qCompress(block_, 1);
+			block_.clear();
+		}
+	}
+
+protected:
+	QSharedPointer<QFile> file_;
+	QDataStream stream_;
+	QByteArray block_;
+};
+
+//Sequential reader for temporary run files of VariantList::sortFile.
+class VariantSortRunReader
+{
+public:
+	VariantSortRunReader(QString filename)
+		: file_(Helper::openFileForReading(filename))
+		, stream_(file_.data())
+		, block_()
+		, pos_(0)
+	{
+	}
+
+	//Reads the next entry. Returns false if the end of the file is reached.
+	bool read(VariantSortEntry& entry)
+	{
+		if (pos_>=block_.size())
+		{
+			if (stream_.atEnd()) return false;
+			QByteArray compressed;
+			stream_ >> compressed;
+			block_ = qUncompress(compressed);
+			pos_ = 0;
+		}
+
+		//key
+		QByteArray fields[6];
+		for (int i=0; i<6; ++i)
+		{
+			int tab = block_.indexOf('\t', pos_);
+			fields[i] = block_.mid(pos_, tab-pos_);
+			pos_ = tab + 1;
+		}
+		entry.key = Variant(fields[0], fields[1].toInt(), fields[2].toInt(), fields[3], fields[4], QList<QByteArray>() << fields[5]);
+
+		//line
+		int end = block_.indexOf('\n', pos_);
+		entry.line = block_.mid(pos_, end-pos_+1);
+		pos_ = end + 1;
+
+		return true;
+	}
+
+protected:
+	QSharedPointer<QFile> file_;
+	QDataStream stream_;
+	QByteArray block_;
+	int pos_;
+};
+
+//Parses and sorts a run of lines and writes it to a temporary file.
+template <typename Less>
+class VariantSortRunWorker
+	: public QRunnable
+{
+public:
+	VariantSortRunWorker(QList<QByteArray> lines, bool vcf, int quality_index, const Less& less, QString filename, QString& error)
+		: QRunnable()
+		, lines_(lines)
+		, vcf_(vcf)
+		, quality_index_(quality_index)
+		, less_(less)
+		, filename_(filename)
+		, error_(error)
+	{
+	}
+
+	void run() override
+	{
+		try
+		{
+			QVector<VariantSortEntry> entries;
+			entries.reserve(lines_.count());
+			foreach(const QByteArray& line, lines_)
+			{
+				entries.append(VariantSortEntry{variantSortKey(line, vcf_, quality_index_), line});
+			}
+			lines_.clear();
+
+			std::stable_sort(entries.begin(), entries.end(), [this](const VariantSortEntry& a, const VariantSortEntry& b){ return less_(a.key, b.key); });
+			VariantSortRunWriter writer(filename_);
+			foreach(const VariantSortEntry& entry, entries)
+			{
+				writer.write(entry);
+			}
+		}
+		catch(Exception& e)
+		{
+			error_ = e.message();
+		}
+	}
+
+protected:
+	QList<QByteArray> lines_;
+	bool vcf_;
+	int quality_index_;
+	const Less& less_;
+	QString filename_;
+	QString& error_;
+};
+
+//k-way merge of run files (ties are resolved by run index, i.e. the input order is kept).
+template <typename Less>
+class VariantSortRunMerger
+{
+public:
+	VariantSortRunMerger(const QStringList& filenames, const Less& less)
+		: readers_()
+		, heads_(filenames.count())
+		, queue_(Greater{heads_, less})
+	{
+		for (int r=0; r<filenames.count(); ++r)
+		{
+			readers_ << QSharedPointer<VariantSortRunReader>(new VariantSortRunReader(filenames[r]));
+			if (readers_[r]->read(heads_[r])) queue_.push(r);
+		}
+	}
+
+	//Returns the next entry in sort order. Returns false if all runs are merged.
+	bool next(VariantSortEntry& entry)
+	{
+		if (queue_.empty()) return false;
+
+		int r = queue_.top();
+		queue_.pop();
+		entry = heads_[r];
+		if (readers_[r]->read(heads_[r])) queue_.push(r);
+
+		return true;
+	}
+
+protected:
+	struct Greater
+	{
+		const QVector<VariantSortEntry>& heads;
+		const Less& less;
+
+		bool operator()(int a, int b) const
+		{
+			if (less(heads[b].key, heads[a].key)) return true;
+			if (less(heads[a].key, heads[b].key)) return false;
+			return a>b;
+		}
+	};
+
+	QList<QSharedPointer<VariantSortRunReader>> readers_;
+	QVector<VariantSortEntry> heads_;
+	std::priority_queue<int, std::vector<int>, Greater> queue_;
+};
+
+//Removes the temporary run files when the sorting is done or fails.
+struct VariantSortRunFileGuard
+{
+	VariantSortRunFileGuard(QStringList& filenames)
+		: filenames_(filenames)
+	{
+	}
+	~VariantSortRunFileGuard()
+	{
+		foreach(const QString& filename, filenames_)
+		{
+			QFile::remove(filename);
+		}
+	}
+
+	QStringList& filenames_;
+};
+
+//Sorts the input file in runs and merges the runs (see VariantList::sortFile).
+template <typename Less>
+static void sortVariantFile(QSharedPointer<QFile> in_file, QSharedPointer<QFile> out_file, QByteArray line, bool vcf, int quality_index, const Less& less, int run_size, int threads)
+{
+	//sort runs (in parallel, at most 'threads' runs are kept in memory at the same time)
+	QStringList run_files;
+	VariantSortRunFileGuard run_file_guard(run_files); //declared before the pool and the readers, so it is destroyed after them
+	QByteArray last_chr;
+	QVector<QString> errors(threads);
+	QThreadPool pool;
+	pool.setMaxThreadCount(threads);
+	QList<QByteArray> lines;
+	int jobs = 0;
+	while (!line.isEmpty())
+	{
+		if (!line.endsWith('\n')) line += '\n';
+		if (!line.trimmed().isEmpty())
+		{
+			lines << line;
+
+			//register chromosomes in the order of the input file, so that the numbers of non-standard chromosomes do not depend on the worker threads
+			QByteArray chr = line.left(line.indexOf('\t'));
+			if (chr!=last_chr)
+			{
+				Chromosome tmp(chr);
+				last_chr = chr;
+			}
+		}
+		line = in_file->atEnd() ? QByteArray() : in_file->readLine();
+
+		bool last = line.isEmpty();
+		if (lines.count()>=run_size || (last && !lines.isEmpty()))
+		{
+			run_files << Helper::tempFileName(".run");
+			pool.start(new VariantSortRunWorker<Less>(lines, vcf, quality_index, less, run_files.last(), errors[jobs]));
+			lines.clear();
+			++jobs;
+		}
+
+		if (jobs==threads || last)
+		{
+			pool.waitForDone();
+			for (int j=0; j<jobs; ++j)
+			{
+				if (!errors[j].isEmpty()) THROW(FileParseException, errors[j]);
+			}
+			jobs = 0;
+		}
+	}
+
+	//merge consecutive runs until at most 'max_merge_files' are left, so that not too many files are open at once (consecutive runs keep the merge stable)
+	const int max_merge_files = 64;
+	QStringList runs = run_files;
+	while (runs.count()>max_merge_files)
+	{
+		QStringList merged_runs;
+		for (int i=0; i<runs.count(); i+=max_merge_files)
+		{
+			QStringList inputs = runs.mid(i, max_merge_files);
+			if (inputs.count()==1)
+			{
+				merged_runs << inputs;
+				continue;
+			}
+
+			run_files << Helper::tempFileName(".run");
+			merged_runs << run_files.last();
+			{
+				VariantSortRunWriter writer(run_files.last());
+				VariantSortRunMerger<Less> merger(inputs, less);
+				VariantSortEntry entry;
+				while (merger.next(entry))
+				{
+					writer.write(entry);
+				}
+			}
+
+			foreach(const QString& input, inputs)
+			{
+				QFile::remove(input);
+				run_files.removeOne(input);
+			}
+		}
+		runs = merged_runs;
+	}
+
+	//final merge
+	VariantSortRunMerger<Less> merger(runs, less);
+	VariantSortEntry entry;
+	while (merger.next(entry))
+	{
+		out_file->write(entry.line);
+	}
+}
+
+void VariantList::sortFile(QString in, QString out, int run_size, bool use_quality, QString fai_file, int threads)
+{
+	//determine format
+	QString fn_lower = in.toLower();
+	bool vcf = fn_lower.endsWith(".vcf");
+	if (!vcf && !fn_lower.endsWith(".tsv") && !fn_lower.contains(".gsvar"))
+	{
+		THROW(ArgumentException, "Could not determine format of file '" + in + "' from file extension. Valid extensions are 'vcf', 'tsv' and 'GSvar'.");
+	}
+	if (run_size<1) THROW(ArgumentException, "Invalid run size " + QString::number(run_size) + "!");
+
+	//copy headers
+	QSharedPointer<QFile> in_file = Helper::openFileForReading(in);
+	QSharedPointer<QFile> out_file = Helper::openFileForWriting(out);
+	int quality_index = -1;
+	QByteArray line;
+	while (!in_file->atEnd())
+	{
+		line = in_file->readLine();
+		if (line.trimmed().isEmpty())
+		{
+			line.clear();
+			continue;
+		}
+		if (!line.startsWith('#')) break;
+
+		if (!line.endsWith('\n')) line += '\n';
+		out_file->write(line);
+		if (!vcf && use_quality && line.startsWith("#") && !line.startsWith("##"))
+		{
+			QList<QByteArray> fields = line.trimmed().split('\t');
+			quality_index = fields.indexOf("QUAL") - 5;
+		}
+		line.clear();
+	}
+	if (use_quality)
+	{
+		if (vcf) quality_index = 0;
+		if (quality_index<0) THROW(ArgumentException, "Cannot sort '" + in + "' by quality: the header line does not contain a 'QUAL' column. Sorting TSV/GSvar files by quality requires a 'QUAL' column!");
+	}
+
+	//sort
+	threads = std::max(1, threads);
+	if (fai_file.isEmpty())
+	{
+		LessComparator less(use_quality ? 0 : -1);
+		sortVariantFile(in_file, out_file, line, vcf, quality_index, less, run_size, threads);
+	}
+	else
+	{
+		LessComparatorByFile less(fai_file);
+		sortVariantFile(in_file, out_file, line, vcf, quality_index, less, run_size, threads);
+	}
+}
+
 void VariantList::removeDuplicates(bool sort_by_quality)
 {
 	sort(sort_by_quality);
@@ -1474,6 +1879,9 @@ void VariantList::clearAnnotations()
 void VariantList::clearVariants()
 {
 	variants_.clear();
+
+	QMutexLocker locker(&annotation_cache_.mutex);
+	annotation_cache_.indices.clear();
 }
 
 void VariantList::leftAlign(QString ref_file, bool sort_by_quality)
@@ -1606,6 +2014,45 @@ AnalysisType VariantList::type(bool allow_fallback_germline_single_sample) const
 	}
 }
 
+QSharedPointer<const VariantGeneIndex> VariantList::geneIndex(int gene_column) const
+{
+	QMutexLocker locker(&gene_index_cache_.mutex);
+	if (gene_index_cache_.index.isNull() || !gene_index_cache_.index->createdFrom(*this, gene_column))
+	{
+		gene_index_cache_.index = QSharedPointer<const VariantGeneIndex>(new VariantGeneIndex(*this, gene_column));
+	}
+
+	return gene_index_cache_.index;
+}
+
+VariantAnnotationIndex VariantList::annotationIndex(int variant_index, int column_index, char separator, bool trim) const
+{
+	const QByteArray& text = variants_[variant_index].annotations()[column_index];
+
+	QMutexLocker locker(&annotation_cache_.mutex);
+	QVector<VariantAnnotationIndex>& indices = annotation_cache_.indices[column_index];
+	if (indices.count()!=variants_.count()) indices.resize(variants_.count());
+
+	//the cached index references the text it was created from, so changing the annotation always changes the data pointer
+	VariantAnnotationIndex& index = indices[variant_index];
+	if (!index.createdFrom(text, separator, trim))
+	{
+		index = VariantAnnotationIndex(text, separator, trim);
+	}
+
+	return index;
+}
+
+QByteArrayList VariantList::vepAnnotations(int variant_index, int csq_index, int field_index) const
+{
+	return annotationIndex(variant_index, csq_index, '|', false).fields(field_index);
+}
+
+QList<VariantTranscript> VariantList::transcriptAnnotations(int variant_index, int column_index) const
+{
+	return Variant::transcriptsFromIndex(annotationIndex(variant_index, column_index, ':', true), false);
+}
+
 void Variant::normalize(int& start, Sequence& ref, Sequence& obs)
 {
 	//remove common first base
@@ -1710,31 +2157,38 @@ QPair<int, int> Variant::indelRegion(const Chromosome& chr, int start, int end,
 	return qMakePair(start_orig, end_orig);
 }
 
+QList<VariantTranscript> Variant::transcriptAnnotations(int column_index) const
+{
+	return transcriptsFromIndex(annotationIndex(column_index, ':', true), false);
+}
+
 QList<VariantTranscript> Variant::parseTranscriptString(QByteArray text, bool allow_old_format_with_7_columns)
+{
+	return transcriptsFromIndex(VariantAnnotationIndex(text, ':', true), allow_old_format_with_7_columns);
+}
+
+QList<VariantTranscript> Variant::transcriptsFromIndex(const VariantAnnotationIndex& index, bool allow_old_format_with_7_columns)
 {
 	QList<VariantTranscript> output;
 
-	foreach(QByteArray transcript, text.split(','))
+	for (int i=0; i<index.count(); ++i)
 	{
-		transcript = transcript.trimmed();
-		if (transcript.isEmpty()) continue;
-
-		QList<QByteArray> parts = transcript.split(':');
-		if (allow_old_format_with_7_columns) parts << "";
-		if (parts.count()<8)
+		int parts = index.fieldCount(i);
+		if (allow_old_format_with_7_columns) ++parts;
+		if (parts<8)
 		{
-			THROW(ProgrammingException, "Could not split transcript information from 'coding_and_splicing' column to 8 parts. " + QString::number(parts.count()) + " parts found in: " + transcript);
+			THROW(ProgrammingException, "Could not split transcript information from 'coding_and_splicing' column to 8 parts. " + QString::number(parts) + " parts found in: " + index.entry(i));
 		}
 
 		VariantTranscript trans;
-		trans.gene = parts[0].trimmed();
-		trans.id = parts[1].trimmed();
-		trans.type = parts[2].trimmed();
-		trans.impact = parts[3].trimmed();
-		trans.exon = parts[4].trimmed();
-		trans.hgvs_c = parts[5].trimmed();
-		trans.hgvs_p = parts[6].trimmed();
-		trans.domain = parts[7].trimmed();
+		trans.gene = index.field(i, 0);
+		trans.id = index.field(i, 1);
+		trans.type = index.field(i, 2);
+		trans.impact = index.field(i, 3);
+		trans.exon = index.field(i, 4);
+		trans.hgvs_c = index.field(i, 5);
+		trans.hgvs_p = index.field(i, 6);
+		trans.domain = index.field(i, 7);
 
 		output << trans;
 	}
@@ -1742,6 +2196,99 @@ QList<VariantTranscript> Variant::parseTranscriptString(QByteArray text, bool al
 	return output;
 }
 
+VariantAnnotationIndex::VariantAnnotationIndex()
+	: text_()
+	, separator_(0)
+	, trim_(false)
+	, entries_(1, 0)
+	, fields_()
+{
+}
+
+//Returns if a character is whitespace (see QByteArray::trimmed).
+static inline bool isWhitespace(char c)
+{
+	return c==' ' || c=='\t' || c=='\n' || c=='\r' || c=='\v' || c=='\f';
+}
+
+VariantAnnotationIndex::VariantAnnotationIndex(const QByteArray& text, char separator, bool trim)
+	: text_(text)
+	, separator_(separator)
+	, trim_(trim)
+	, entries_(1, 0)
+	, fields_()
+{
+	const char* data = text_.constData();
+	int start = 0;
+	int end = text_.size();
+	while (start<end && isWhitespace(data[start])) ++start;
+	while (end>start && isWhitespace(data[end-1])) --end;
+	if (start==end) return;
+
+	int entry_start = start;
+	for (int pos=start; pos<=end; ++pos)
+	{
+		if (pos<end && data[pos]!=',') continue;
+
+		addEntry(entry_start, pos);
+		entry_start = pos + 1;
+	}
+}
+
+void VariantAnnotationIndex::addEntry(int start, int end)
+{
+	const char* data = text_.constData();
+	if (trim_)
+	{
+		while (start<end && isWhitespace(data[start])) ++start;
+		while (end>start && isWhitespace(data[end-1])) --end;
+		if (start==end) return;
+	}
+
+	int field_start = start;
+	for (int pos=start; pos<=end; ++pos)
+	{
+		if (pos<end && data[pos]!=separator_) continue;
+
+		int field_end = pos;
+		if (trim_)
+		{
+			while (field_start<field_end && isWhitespace(data[field_start])) ++field_start;
+			while (field_end>field_start && isWhitespace(data[field_end-1])) --field_end;
+		}
+		fields_ << field_start << field_end;
+		field_start = pos + 1;
+	}
+
+	entries_ << fields_.count()/2;
+}
+
+QByteArray VariantAnnotationIndex::entry(int entry) const
+{
+	int start = fields_[2*entries_[entry]];
+	int end = fields_[2*entries_[entry+1]-1];
+	return text_.mid(start, end-start);
+}
+
+QByteArray VariantAnnotationIndex::field(int entry, int field) const
+{
+	if (field<0 || field>=fieldCount(entry)) return QByteArray();
+
+	int i = 2 * (entries_[entry] + field);
+	return text_.mid(fields_[i], fields_[i+1]-fields_[i]);
+}
+
+QByteArrayList VariantAnnotationIndex::fields(int field) const
+{
+	QByteArrayList output;
+	output.reserve(count());
+	for (int i=0; i<count(); ++i)
+	{
+		output << this->field(i, field);
+	}
+	return output;
+}
+
 QDebug operator<<(QDebug d, const Variant& v)
 {
 	d.nospace() << v.chr().str() << ":" << v.start() << "-" << v.end() << " " << v.ref() << "=>" << v.obs();
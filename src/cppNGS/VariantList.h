@@ -12,6 +12,9 @@
 #include <QStringList>
 #include <QtAlgorithms>
 #include <QVectorIterator>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
 
 
 ///Transcript annotations e.g. from SnpEff/VEP.
@@ -32,6 +35,87 @@ struct CPPNGSSHARED_EXPORT VariantTranscript
 	bool typeMatchesTerms(const OntologyTermCollection& terms) const;
 };
 
+///Parsed representation of a multi-valued annotation, e.g. VEP CSQ or 'coding_and_splicing'.
+///Entries are separated by ',' and the fields of an entry by a custom separator. The text is split once and the fields are stored as offsets into the text.
+class CPPNGSSHARED_EXPORT VariantAnnotationIndex
+{
+public:
+	///Default constructor (no entries).
+	VariantAnnotationIndex();
+	///Constructor. If @p trim is set, entries and fields are trimmed and empty entries are skipped.
+	VariantAnnotationIndex(const QByteArray& text, char separator, bool trim);
+
+	///Returns the number of entries.
+	int count() const
+	{
+		return entries_.count() - 1;
+	}
+	///Returns the number of fields of an entry.
+	int fieldCount(int entry) const
+	{
+		return entries_[entry+1] - entries_[entry];
+	}
+	///Returns the text of an entry.
+	QByteArray entry(int entry) const;
+	///Returns a field of an entry, or an empty string if the entry has less fields.
+	QByteArray field(int entry, int field) const;
+	///Returns a field of all entries.
+	QByteArrayList fields(int field) const;
+
+	///Returns if the index was created from the given text (the same data, not only the same content) with the given parameters.
+	bool createdFrom(const QByteArray& text, char separator, bool trim) const
+	{
+		return text_.constData()==text.constData() && text_.size()==text.size() && separator_==separator && trim_==trim;
+	}
+
+protected:
+	QByteArray text_;
+	char separator_;
+	bool trim_;
+	QVector<int> entries_; //index of the first field of each entry (and the end of the last entry)
+	QVector<int> fields_; //start/end offset of each field in the text
+
+	void addEntry(int start, int end);
+};
+
+///Cache of the parsed annotations of a variant list. The cache is not copied, i.e. copies start with an empty cache.
+struct CPPNGSSHARED_EXPORT VariantAnnotationCache
+{
+	VariantAnnotationCache()
+	{
+	}
+	VariantAnnotationCache(const VariantAnnotationCache&)
+	{
+	}
+	VariantAnnotationCache& operator=(const VariantAnnotationCache&)
+	{
+		return *this;
+	}
+
+	QMutex mutex;
+	QHash<int, QVector<VariantAnnotationIndex>> indices; //column index => parsed annotation of each variant
+};
+
+class VariantGeneIndex;
+
+///Cache of the gene index of a variant list. The cache is not copied, i.e. copies start with an empty cache.
+struct CPPNGSSHARED_EXPORT VariantGeneIndexCache
+{
+	VariantGeneIndexCache()
+	{
+	}
+	VariantGeneIndexCache(const VariantGeneIndexCache&)
+	{
+	}
+	VariantGeneIndexCache& operator=(const VariantGeneIndexCache&)
+	{
+		return *this;
+	}
+
+	QMutex mutex;
+	QSharedPointer<const VariantGeneIndex> index;
+};
+
 ///Sample header struct for samples in variant lists.
 struct CPPNGSSHARED_EXPORT SampleInfo
 {
@@ -146,6 +230,10 @@ public:
 		annotations_ = annotations;
 	}
 
+	///Parses the annotation of a column (see VariantAnnotationIndex).
+	///The result is not cached. Use the methods of VariantList with variant index to parse each annotation only once.
+	VariantAnnotationIndex annotationIndex(int column_index, char separator, bool trim) const;
+
 	///Returns the VEP annotations for an certain annotation field (one for each transcript)
 	QByteArrayList vepAnnotations(int csq_index, int field_index) const;
 
@@ -207,12 +295,11 @@ public:
 	static QPair<int, int> indelRegion(const Chromosome& chr, int start, int end, Sequence ref, Sequence obs, const FastaFileIndex& reference);
 
 	///Returns transcript information from the given column index.
-	QList<VariantTranscript> transcriptAnnotations(int column_index) const
-	{
-		return parseTranscriptString(annotations()[column_index]);
-	}
+	QList<VariantTranscript> transcriptAnnotations(int column_index) const;
 
 	static QList<VariantTranscript> parseTranscriptString(QByteArray text, bool allow_old_format_with_7_columns=false);
+	///Returns transcript information from a parsed 'coding_and_splicing' annotation.
+	static QList<VariantTranscript> transcriptsFromIndex(const VariantAnnotationIndex& index, bool allow_old_format_with_7_columns);
 
 	///Returns a normalized variant extracted from user input text. Throws an exception, if it is not valid.
 	static Variant fromString(const QString& text);
@@ -225,7 +312,6 @@ protected:
 	Sequence obs_;
     QList<QByteArray> filters_;
 	QList<QByteArray> annotations_;
-
 };
 
 ///Debug output operator for Variant.
@@ -369,6 +455,8 @@ public:
 	///If @p roi is given, only variants that fall into the target regions are loaded.
 	///If @p invert is given, only variants that fall outside the target regions are loaded.
 	VariantListFormat load(QString filename, VariantListFormat format=AUTO, const BedFile* roi=nullptr, bool invert=false);
+	///Loads only the header of a GSvar/TSV file (comments, descriptions, filters and annotation columns). No variants are loaded.
+	void loadHeaderOnly(QString filename);
     ///Stores the variant list to a file.
 	void store(QString filename, VariantListFormat format=AUTO) const;
 
@@ -378,6 +466,9 @@ public:
 	void sortByAnnotation(int annotation_index);
 	///Sorts the lines accoring to FASTA index file. The order is chromosome (as given in the file), position, ref, obs.
     void sortByFile(QString file_name);
+	///Sorts a variant list file (VCF or TSV) that is too large to be loaded into memory (external merge sort). Runs of @p run_size variants are sorted using @p threads threads and stored in compressed temporary files, which are merged afterwards.
+	///The order is the same as for sort() or sortByFile() (if @p fai_file is given). Header and variant lines are written unchanged.
+	static void sortFile(QString in, QString out, int run_size, bool use_quality = false, QString fai_file = "", int threads = 1);
 	///Costum sorting of variants.
 	template <typename T>
 	void sortCustom(const T& comarator)
@@ -409,12 +500,26 @@ public:
 	///Returns analysis type.
 	AnalysisType type(bool allow_fallback_germline_single_sample = true) const;
 
+	///Returns the gene index of a gene column (see VariantGeneIndex).
+	///The index is created once and cached. When the variants or their genes change, it is created again.
+	QSharedPointer<const VariantGeneIndex> geneIndex(int gene_column) const;
+
+	///Returns the parsed annotation of a column of a variant (see VariantAnnotationIndex).
+	///The annotation is parsed once and cached. When the annotation changes, it is parsed again.
+	VariantAnnotationIndex annotationIndex(int variant_index, int column_index, char separator, bool trim) const;
+	///Returns the VEP annotations of a variant for a certain annotation field (see Variant::vepAnnotations). Uses the cache of annotationIndex().
+	QByteArrayList vepAnnotations(int variant_index, int csq_index, int field_index) const;
+	///Returns transcript information of a variant from the given column index (see Variant::transcriptAnnotations). Uses the cache of annotationIndex().
+	QList<VariantTranscript> transcriptAnnotations(int variant_index, int column_index) const;
+
 protected:
     QStringList comments_;
 	QList<VariantAnnotationDescription> annotation_descriptions_;
 	QList<VariantAnnotationHeader> annotation_headers_;
 	QMap<QString, QString> filters_;
     QVector<Variant> variants_;
+	mutable VariantGeneIndexCache gene_index_cache_;
+	mutable VariantAnnotationCache annotation_cache_;
 
 	///Comparator helper class used by sortByAnnotation
 	class LessComparatorByAnnotation
@@ -455,6 +560,8 @@ protected:
 
     ///Loads the variant list from a TSV file.
 	void loadFromTSV(QString filename, ChromosomalIndex<BedFile>* roi_idx=nullptr, bool invert=false);
+	///Processes a TSV header line (both for loadFromTSV and loadHeaderOnly). Returns false if the line is not a header line. Sets @p filter_index if the line contains the 'filter' column header.
+	bool processTsvHeaderLine(const QByteArray& line, int& filter_index);
     ///Stores the variant list as a TSV file.
 	void storeToTSV(QString filename) const;
 	///Loads the variant list from a VCF file.
@@ -2,7 +2,7 @@
 CONFIG += c++11 
 
 #base settings
-QT       -= gui
+QT       += gui
 QT       += xml xmlpatterns
 TEMPLATE = lib
 TARGET = cppNGS
@@ -37,6 +37,7 @@ LIBS += -lz
 QMAKE_LFLAGS += "-Wl,-rpath,\'\$$ORIGIN\'"
 
 SOURCES += BedFile.cpp \
+    BedFileStream.cpp \
     Chromosome.cpp \
     VariantList.cpp \
     Statistics.cpp \
@@ -50,6 +51,7 @@ SOURCES += BedFile.cpp \
     BamReader.cpp \
     BamWriter.cpp \
     SampleSimilarity.cpp \
+    SampleFingerprint.cpp \
     CnvList.cpp \
     Phenotype.cpp \
     Transcript.cpp \
@@ -60,10 +62,15 @@ SOURCES += BedFile.cpp \
     VcfFile.cpp \
     TabixIndexedFile.cpp \
     BedpeFile.cpp \
-    MidCheck.cpp
+    MidCheck.cpp \
+    BitSet.cpp \
+    VariantGeneIndex.cpp \
+    QCPlot.cpp \
+    QCPlotRenderer.cpp
 
 
 HEADERS += BedFile.h \
+    BedFileStream.h \
     Chromosome.h \
     VariantList.h \
     ChromosomalIndex.h \
@@ -79,6 +86,7 @@ HEADERS += BedFile.h \
     BamReader.h \
     BamWriter.h \
     SampleSimilarity.h \
+    SampleFingerprint.h \
     CnvList.h \
     Phenotype.h \
     Transcript.h \
@@ -91,7 +99,11 @@ HEADERS += BedFile.h \
     BedpeFile.h \
     KeyValuePair.h \
     VariantType.h \
-    MidCheck.h
+    MidCheck.h \
+    BitSet.h \
+    VariantGeneIndex.h \
+    QCPlot.h \
+    QCPlotRenderer.h
 
 
 RESOURCES += \
@@ -440,6 +440,10 @@ private slots:
 		I_EQUAL(gene_app_id, 1);
 		gene_app_id = db.geneToApprovedID("BLABLA");
 		I_EQUAL(gene_app_id, -1);
+		gene_app_id = db.geneToApprovedID("brca1"); //lower-case
+		I_EQUAL(gene_app_id, 1);
+		gene_app_id = db.geneToApprovedID(" Brca2 "); //mixed-case
+		I_EQUAL(gene_app_id, 2);
 
 		//genesOverlapping
 		GeneSet genes = db.genesOverlapping("chr13", 90, 95, 0); //nearby left
@@ -1299,6 +1303,24 @@ private slots:
 		S_EQUAL(omim_info.phenotypes[0].name(), "Ataxia-telangiectasia, 208900 (3)");
 		S_EQUAL(omim_info.phenotypes[1].accession(), "");
 		S_EQUAL(omim_info.phenotypes[1].name(), "Lymphoma, B-cell non-Hodgkin, somatic (3)");
+
+		//clearCache (cached gene data is updated after clearing the cache)
+		db.getQuery().exec("INSERT INTO gene (id, hgnc_id, symbol, name, type) VALUES (5, 1005, 'NEWGENE', 'new gene', 'protein-coding gene')");
+		db.getQuery().exec("INSERT INTO gene_alias (gene_id, symbol, type) VALUES (5, 'NEWALIAS', 'synonym')");
+		NGSD::clearCache();
+		I_EQUAL(db.approvedGeneNames().count(), 9);
+		S_EQUAL(db.geneToApproved("NEWALIAS"), "NEWGENE");
+		I_EQUAL(db.geneToApprovedID("newalias"), 5);
+
+		//cache check (modifications of the cached tables are detected without clearing the cache)
+		NGSD::setCacheCheckInterval(0);
+		db.getQuery().exec("INSERT INTO gene (id, hgnc_id, symbol, name, type) VALUES (6, 1006, 'C9orf72', 'mixed-case gene', 'protein-coding gene')");
+		I_EQUAL(db.approvedGeneNames().count(), 10);
+		I_EQUAL(db.geneToApprovedID("C9orf72"), 6);
+		I_EQUAL(db.geneToApprovedID("C9ORF72"), 6);
+		I_EQUAL(db.geneToApprovedID("c9orf72"), 6);
+		S_EQUAL(db.geneSymbol(6), "C9orf72");
+		NGSD::setCacheCheckInterval(10000);
 	}
 
 	//Test for debugging (without initialization because of speed)
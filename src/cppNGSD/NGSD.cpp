@@ -16,6 +16,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QCryptographicHash>
+#include <QElapsedTimer>
 #include "cmath"
 
 QMap<QString, TableInfo> NGSD::infos_;
@@ -727,19 +728,10 @@ QString NGSD::addVariant(const Variant& variant, const VariantList& variant_list
 	return query.lastInsertId().toString();
 }
 
-QList<int> NGSD::addVariants(const VariantList& variant_list, double max_af, int& c_add, int& c_update)
+QList<int> NGSD::addVariants(const VariantList& variant_list, double max_af, int& c_add, int& c_update, int chunk_size)
 {
 	QList<int> output;
-
-	//prepare queried
-	SqlQuery q_id = getQuery();
-	q_id.prepare("SELECT id, 1000g, gnomad, gene, variant_type, coding FROM variant WHERE chr=:0 AND start=:1 AND end=:2 AND ref=:3 AND obs=:4");
-
-	SqlQuery q_update = getQuery(); //use binding (user input)
-	q_update.prepare("UPDATE variant SET 1000g=:1, gnomad=:2, gene=:3, variant_type=:4, coding=:5 WHERE id=:6");
-
-	SqlQuery q_insert = getQuery(); //use binding (user input)
-	q_insert.prepare("INSERT INTO variant (chr, start, end, ref, obs, 1000g, gnomad, gene, variant_type, coding) VALUES (:0,:1,:2,:3,:4,:5,:6,:7,:8,:9)");
+	output.reserve(variant_list.count());
 
 	//get annotated column indices
 	int i_tg = variant_list.annotationIndexByName("1000g");
@@ -750,71 +742,165 @@ QList<int> NGSD::addVariants(const VariantList& variant_list, double max_af, int
 
 	c_add = 0;
 	c_update = 0;
-	for (int i=0; i<variant_list.count(); ++i)
+	for (int chunk_start=0; chunk_start<variant_list.count(); chunk_start+=chunk_size)
 	{
-		const Variant& variant = variant_list[i];
+		int chunk_end = std::min(chunk_start + chunk_size, variant_list.count());
 
-		//skip variants with too high AF
-		QByteArray tg = variant.annotations()[i_tg].trimmed();
-		if (tg=="n/a") tg.clear();
-		if (!tg.isEmpty() && tg.toDouble()>max_af)
+		//determine variants to import (skip variants with too high AF)
+		QList<int> indices;
+		QVector<QByteArray> tgs(chunk_end - chunk_start);
+		QVector<QByteArray> gnomads(chunk_end - chunk_start);
+		for (int i=chunk_start; i<chunk_end; ++i)
 		{
-			output << -1;
-			continue;
+			const Variant& variant = variant_list[i];
+
+			QByteArray tg = variant.annotations()[i_tg].trimmed();
+			if (tg=="n/a") tg.clear();
+			QByteArray gnomad = variant.annotations()[i_gnomad].trimmed();
+			if (gnomad=="n/a") gnomad.clear();
+			if ((!tg.isEmpty() && tg.toDouble()>max_af) || (!gnomad.isEmpty() && gnomad.toDouble()>max_af)) continue;
+
+			indices << i;
+			tgs[i-chunk_start] = tg;
+			gnomads[i-chunk_start] = gnomad;
 		}
-		QByteArray gnomad = variant.annotations()[i_gnomad].trimmed();
-		if (gnomad=="n/a") gnomad.clear();
-		if (!gnomad.isEmpty() && gnomad.toDouble()>max_af)
+
+		transaction();
+
+		//get variants already in NGSD (one query per chromosome)
+		QHash<QByteArray, QVariantList> existing = variantRows(variant_list, indices);
+
+		//determine variants to update/insert
+		QList<int> update;
+		QList<int> insert;
+		QSet<QByteArray> keys_done; //variants can be contained several times in the list
+		foreach(int i, indices)
 		{
-			output << -1;
-			continue;
+			const Variant& variant = variant_list[i];
+			QByteArray key = variantKey(variant);
+			if (keys_done.contains(key)) continue;
+			keys_done << key;
+
+			if (existing.contains(key))
+			{
+				//check if variant meta data needs to be updated
+				const QVariantList& row = existing[key];
+				if (row[1].toByteArray().toDouble()!=tgs[i-chunk_start].toDouble() //numeric comparison (NULL > "" > 0.0)
+					|| row[2].toByteArray().toDouble()!=gnomads[i-chunk_start].toDouble() //numeric comparison (NULL > "" > 0.0)
+					|| row[3].toByteArray()!=variant.annotations()[i_gene]
+					|| row[4].toByteArray()!=variant.annotations()[i_type]
+					|| row[5].toByteArray()!=variant.annotations()[i_co_sp])
+				{
+					update << i;
+					++c_update;
+				}
+			}
+			else
+			{
+				insert << i;
+				++c_add;
+			}
+		}
+
+		//update and insert variants with multi-row statements
+		if (!update.isEmpty() || !insert.isEmpty())
+		{
+			QList<int> rows = update + insert;
+			QStringList placeholders;
+			for (int r=0; r<rows.count(); ++r)
+			{
+				placeholders << "(?,?,?,?,?,?,?,?,?,?,?)";
+			}
+			SqlQuery query = getQuery(); //use binding (user input)
+			query.prepare("INSERT INTO variant (id, chr, start, end, ref, obs, 1000g, gnomad, gene, variant_type, coding) VALUES " + placeholders.join(",")
+						  + " ON DUPLICATE KEY UPDATE 1000g=VALUES(1000g), gnomad=VALUES(gnomad), gene=VALUES(gene), variant_type=VALUES(variant_type), coding=VALUES(coding)");
+			foreach(int i, rows)
+			{
+				const Variant& variant = variant_list[i];
+				QByteArray key = variantKey(variant);
+				query.addBindValue(existing.contains(key) ? existing[key][0] : QVariant());
+				query.addBindValue(variant.chr().strNormalized(true));
+				query.addBindValue(variant.start());
+				query.addBindValue(variant.end());
+				query.addBindValue(variant.ref());
+				query.addBindValue(variant.obs());
+				query.addBindValue(tgs[i-chunk_start].isEmpty() ? QVariant() : tgs[i-chunk_start]);
+				query.addBindValue(gnomads[i-chunk_start].isEmpty() ? QVariant() : gnomads[i-chunk_start]);
+				query.addBindValue(variant.annotations()[i_gene]);
+				query.addBindValue(variant.annotations()[i_type]);
+				query.addBindValue(variant.annotations()[i_co_sp]);
+			}
+			query.exec();
+		}
+
+		//get IDs of inserted variants
+		if (!insert.isEmpty())
+		{
+			QHash<QByteArray, QVariantList> inserted = variantRows(variant_list, insert);
+			for (auto it=inserted.cbegin(); it!=inserted.cend(); ++it)
+			{
+				existing.insert(it.key(), it.value());
+			}
 		}
 
-		//get variant ID
-		q_id.bindValue(0, variant.chr().strNormalized(true));
-		q_id.bindValue(1, variant.start());
-		q_id.bindValue(2, variant.end());
-		q_id.bindValue(3, variant.ref());
-		q_id.bindValue(4, variant.obs());
-		q_id.exec();
-		if (q_id.next()) //update (common case)
+		commit();
+
+		//output
+		int next = 0;
+		for (int i=chunk_start; i<chunk_end; ++i)
 		{
-			int id = q_id.value(0).toInt();
-
-			//check if variant meta data needs to be updated
-			if (q_id.value(1).toByteArray().toDouble()!=tg.toDouble() //numeric comparison (NULL > "" > 0.0)
-				|| q_id.value(2).toByteArray().toDouble()!=gnomad.toDouble() //numeric comparison (NULL > "" > 0.0)
-				|| q_id.value(3).toByteArray()!=variant.annotations()[i_gene]
-				|| q_id.value(4).toByteArray()!=variant.annotations()[i_type]
-				|| q_id.value(5).toByteArray()!=variant.annotations()[i_co_sp])
+			if (next<indices.count() && indices[next]==i)
+			{
+				QByteArray key = variantKey(variant_list[i]);
+				if (!existing.contains(key)) THROW(DatabaseException, "Variant " + variant_list[i].toString() + " not found in NGSD after import!");
+				output << existing[key][0].toInt();
+				++next;
+			}
+			else
 			{
-				q_update.bindValue(0, tg.isEmpty() ? QVariant() : tg);
-				q_update.bindValue(1, gnomad.isEmpty() ? QVariant() : gnomad);
-				q_update.bindValue(2, variant.annotations()[i_gene]);
-				q_update.bindValue(3, variant.annotations()[i_type]);
-				q_update.bindValue(4, variant.annotations()[i_co_sp]);
-				q_update.bindValue(5, id);
-				q_update.exec();
-				++c_update;
+				output << -1;
 			}
+		}
+	}
+
+	return output;
+}
+
+QByteArray NGSD::variantKey(const Variant& variant)
+{
+	//ref/obs are upper-case, because the NGSD compares them case-insensitive
+	return variant.chr().strNormalized(true) + ":" + QByteArray::number(variant.start()) + "-" + QByteArray::number(variant.end()) + " " + variant.ref().toUpper() + ">" + variant.obs().toUpper();
+}
+
+QHash<QByteArray, QVariantList> NGSD::variantRows(const VariantList& variant_list, const QList<int>& indices)
+{
+	QHash<QByteArray, QVariantList> output;
+
+	//group start positions by chromosome
+	QMap<QByteArray, QSet<int>> chr2starts;
+	foreach(int i, indices)
+	{
+		const Variant& variant = variant_list[i];
+		chr2starts[variant.chr().strNormalized(true)] << variant.start();
+	}
 
-			output << id;
+	//query variants (the start position is part of the unique index, so the IN-list is resolved by index lookups)
+	for (auto it=chr2starts.cbegin(); it!=chr2starts.cend(); ++it)
+	{
+		QStringList starts;
+		foreach(int start, it.value())
+		{
+			starts << QString::number(start);
 		}
-		else //insert (rare case)
+
+		SqlQuery query = getQuery();
+		query.prepare("SELECT id, 1000g, gnomad, gene, variant_type, coding, start, end, ref, obs FROM variant WHERE chr=:0 AND start IN (" + starts.join(",") + ")");
+		query.bindValue(0, it.key());
+		query.exec();
+		while (query.next())
 		{
-			q_insert.bindValue(0, variant.chr().strNormalized(true));
-			q_insert.bindValue(1, variant.start());
-			q_insert.bindValue(2, variant.end());
-			q_insert.bindValue(3, variant.ref());
-			q_insert.bindValue(4, variant.obs());
-			q_insert.bindValue(5, tg.isEmpty() ? QVariant() : tg);
-			q_insert.bindValue(6, gnomad.isEmpty() ? QVariant() : gnomad);
-			q_insert.bindValue(7, variant.annotations()[i_gene]);
-			q_insert.bindValue(8, variant.annotations()[i_type]);
-			q_insert.bindValue(9, variant.annotations()[i_co_sp]);
-			q_insert.exec();
-			++c_add;
-			output << q_insert.lastInsertId().toInt();
+			QByteArray key = it.key() + ":" + query.value(6).toByteArray() + "-" + query.value(7).toByteArray() + " " + query.value(8).toByteArray().toUpper() + ">" + query.value(9).toByteArray().toUpper(); //see variantKey()
+			output.insert(key, QVariantList() << query.value(0) << query.value(1) << query.value(2) << query.value(3) << query.value(4) << query.value(5));
 		}
 	}
 
@@ -1338,6 +1424,9 @@ QStringList NGSD::getValues(const QString& query, QString bind_value) const
 
 void NGSD::executeQueriesFromFile(QString filename)
 {
+	//the queries can modify cached tables
+	clearCache();
+
 	QStringList lines = Helper::loadTextFile(filename, true);
 	QString query = "";
 	for(const QString& line : lines)
@@ -2526,40 +2615,38 @@ void NGSD::clearTable(QString table)
 {
 	SqlQuery query = getQuery();
 	query.exec("DELETE FROM " + table);
+
+	//the table can be cached
+	clearCache();
 }
 
 int NGSD::geneToApprovedID(const QByteArray& gene)
 {
-	//approved
-	if (approvedGeneNames().contains(gene))
-	{
-		return getValue("SELECT id FROM gene WHERE symbol='" + gene + "'").toInt();
-	}
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheGenes(cache);
+
+	//approved (keys are upper-case because the database lookup was case-insensitive)
+	QByteArray gene_upper = gene.trimmed().toUpper();
+	int id = cache.gene_symbol2id.value(gene_upper, -1);
+	if (id!=-1) return id;
 
 	//previous
-	SqlQuery q_prev = getQuery();
-	q_prev.prepare("SELECT g.id FROM gene g, gene_alias ga WHERE g.id=ga.gene_id AND ga.symbol=:0 AND ga.type='previous'");
-	q_prev.bindValue(0, gene);
-	q_prev.exec();
-	if (q_prev.size()==1)
+	QList<int> ids = cache.gene_previous2ids.value(gene_upper);
+	if (ids.count()==1)
 	{
-		q_prev.next();
-		return q_prev.value(0).toInt();
+		return ids[0];
 	}
-	else if(q_prev.size()>1)
+	else if(ids.count()>1)
 	{
 		return -1;
 	}
 
 	//synonymous
-	SqlQuery q_syn = getQuery();
-	q_syn.prepare("SELECT g.id FROM gene g, gene_alias ga WHERE g.id=ga.gene_id AND ga.symbol=:0 AND ga.type='synonym'");
-	q_syn.bindValue(0, gene);
-	q_syn.exec();
-	if (q_syn.size()==1)
+	ids = cache.gene_synonym2ids.value(gene_upper);
+	if (ids.count()==1)
 	{
-		q_syn.next();
-		return q_syn.value(0).toInt();
+		return ids[0];
 	}
 
 	return -1;
@@ -2567,7 +2654,11 @@ int NGSD::geneToApprovedID(const QByteArray& gene)
 
 QByteArray NGSD::geneSymbol(int id)
 {
-	return getValue("SELECT symbol FROM gene WHERE id=:0", true, QString::number(id)).toByteArray();
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheGenes(cache);
+
+	return cache.gene_id2symbol.value(id);
 }
 
 QByteArray NGSD::geneToApproved(QByteArray gene, bool return_input_when_unconvertable)
@@ -2580,28 +2671,14 @@ QByteArray NGSD::geneToApproved(QByteArray gene, bool return_input_when_unconver
 		return gene;
 	}
 
-	//check if already cached
-	static QMap<QByteArray, QByteArray> mapping;
-	if (mapping.contains(gene))
-	{
-		if (return_input_when_unconvertable && mapping[gene].isEmpty())
-		{
-			return gene;
-		}
-
-		return mapping[gene];
-	}
-
-	//not cached => try to convert
+	//try to convert (in-memory)
 	int gene_id = geneToApprovedID(gene);
-	mapping[gene] = (gene_id!=-1) ? geneSymbol(gene_id) : "";
-
-	if (return_input_when_unconvertable && mapping[gene].isEmpty())
+	if (gene_id==-1)
 	{
-		return gene;
+		return return_input_when_unconvertable ? gene : "";
 	}
 
-	return mapping[gene];
+	return geneSymbol(gene_id);
 }
 
 GeneSet NGSD::genesToApproved(GeneSet genes, bool return_input_when_unconvertable)
@@ -2747,18 +2824,11 @@ GeneSet NGSD::synonymousSymbols(int id)
 
 QList<Phenotype> NGSD::phenotypes(const QByteArray& symbol)
 {
-	QList<Phenotype> output;
-
-	SqlQuery query = getQuery();
-	query.prepare("SELECT t.hpo_id, t.name FROM hpo_term t, hpo_genes g WHERE g.gene=:0 AND t.id=g.hpo_term_id ORDER BY t.name ASC");
-	query.bindValue(0, symbol);
-	query.exec();
-	while(query.next())
-	{
-		output << Phenotype(query.value(0).toByteArray(), query.value(1).toByteArray());
-	}
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cachePhenotypes(cache);
 
-	return output;
+	return cache.gene2phenotypes.value(symbol.toUpper());
 }
 
 QList<Phenotype> NGSD::phenotypes(QStringList search_terms)
@@ -2895,38 +2965,24 @@ QList<Phenotype> NGSD::phenotypeChildTerms(const Phenotype& phenotype, bool recu
 
 OmimInfo NGSD::omimInfo(const QByteArray& symbol)
 {
-	OmimInfo output;
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheOmim(cache);
 
 	//OMIM gene
-	QString omim_gene_id = getValue("SELECT id FROM omim_gene WHERE gene=:0", true, symbol).toString();
-	if (omim_gene_id=="")
+	QByteArray key = symbol.toUpper();
+	if (!cache.omim.contains(key))
 	{
-		QString symbol_approved = geneToApproved(symbol, true);
-		omim_gene_id = getValue("SELECT id FROM omim_gene WHERE gene=:0", true, symbol_approved).toString();
+		key = geneToApproved(symbol, true).toUpper();
 	}
 
-	if (omim_gene_id!="")
+	const QList<OmimInfo> infos = cache.omim.value(key);
+	if (infos.count()>1)
 	{
-		output.mim = getValue("SELECT mim FROM omim_gene WHERE id=" + omim_gene_id).toByteArray();
-		output.gene_symbol = getValue("SELECT gene FROM omim_gene WHERE id=" + omim_gene_id).toByteArray();
-
-		QRegExp mim_exp("[^0-9]([0-9]{6})[^0-9]");
-		QStringList phenos = getValues("SELECT phenotype FROM omim_phenotype WHERE omim_gene_id=" + omim_gene_id + " ORDER BY phenotype ASC");
-		foreach(QString pheno, phenos)
-		{
-			Phenotype tmp;
-
-			tmp.setName(pheno.toLatin1());
-			if (mim_exp.indexIn(pheno)!=-1)
-			{
-				tmp.setAccession(mim_exp.cap(1).toLatin1());
-			}
-
-			output.phenotypes << tmp;
-		}
+		THROW(DatabaseException, "Several OMIM genes found for gene symbol '" + symbol + "' in NGSD!");
 	}
 
-	return output;
+	return infos.isEmpty() ? OmimInfo() : infos[0];
 }
 
 
@@ -2951,81 +3007,320 @@ Phenotype NGSD::phenotypeByAccession(const QByteArray& accession, bool throw_on_
 	return Phenotype(accession, name);
 }
 
-const GeneSet& NGSD::approvedGeneNames()
+GeneSet NGSD::approvedGeneNames()
+{
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheGenes(cache);
+
+	return cache.approved_genes;
+}
+
+
+GeneSet NGSD::genesOverlapping(const Chromosome& chr, int start, int end, int extend)
 {
-	static GeneSet output;
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheGeneRegions(cache);
 
-	if (output.count()==0)
+	//create gene list
+	GeneSet genes;
+	QVector<int> matches = cache.gene_regions_index->matchingIndices(chr, start-extend, end+extend);
+	foreach(int i, matches)
 	{
-		SqlQuery query = getQuery();
-		query.exec("SELECT symbol from gene");
+		genes << cache.gene_regions[i].annotations()[0];
+	}
+	return genes;
+}
 
-		while(query.next())
-		{
-			output.insert(query.value(0).toByteArray());
-		}
+GeneSet NGSD::genesOverlappingByExon(const Chromosome& chr, int start, int end, int extend)
+{
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheGeneExons(cache);
+
+	//create gene list
+	GeneSet genes;
+	QVector<int> matches = cache.gene_exons_index->matchingIndices(chr, start-extend, end+extend);
+	foreach(int i, matches)
+	{
+		genes << cache.gene_exons[i].annotations()[0];
 	}
 
-	return output;
+	return genes;
 }
 
+void NGSD::clearCache()
+{
+	cache(false).clear();
+	cache(true).clear();
+}
 
-GeneSet NGSD::genesOverlapping(const Chromosome& chr, int start, int end, int extend)
+void NGSD::setCacheCheckInterval(int ms)
 {
-	//init static data (load gene regions file from NGSD to memory)
-	static BedFile bed;
-	static ChromosomalIndex<BedFile> index(bed);
-	if (bed.count()==0)
+	for (int i=0; i<2; ++i)
 	{
-		//add transcripts
-		SqlQuery query = getQuery();
-		query.exec("SELECT g.symbol, gt.chromosome, MIN(ge.start), MAX(ge.end) FROM gene g, gene_transcript gt, gene_exon ge WHERE ge.transcript_id=gt.id AND gt.gene_id=g.id GROUP BY gt.id");
-		while(query.next())
+		Cache& cache = NGSD::cache(i==1);
+		QMutexLocker locker(&cache.mutex);
+		cache.check_interval = ms;
+		cache.last_check.invalidate();
+	}
+}
+
+NGSD::Cache& NGSD::cache(bool test_db)
+{
+	static Cache caches[2];
+	return caches[test_db ? 1 : 0];
+}
+
+void NGSD::Cache::clear()
+{
+	QMutexLocker locker(&mutex);
+
+	genes_loaded = false;
+	approved_genes.clear();
+	gene_symbol2id.clear();
+	gene_id2symbol.clear();
+	gene_previous2ids.clear();
+	gene_synonym2ids.clear();
+
+	transcripts_loaded = false;
+	transcripts.clear();
+	gene2transcripts.clear();
+	exon_starts.clear();
+	exon_ends.clear();
+
+	gene_regions_loaded = false;
+	gene_regions_index.clear();
+	gene_regions.clear();
+	gene_exons_loaded = false;
+	gene_exons_index.clear();
+	gene_exons.clear();
+
+	phenotypes_loaded = false;
+	gene2phenotypes.clear();
+	omim_loaded = false;
+	omim.clear();
+}
+
+void NGSD::checkCache(Cache& cache)
+{
+	if (cache.last_check.isValid() && !cache.last_check.hasExpired(cache.check_interval)) return;
+	cache.last_check.start();
+
+	//MySQL 8 caches table statistics in 'information_schema' for one day by default (the statement fails on older servers, which do not cache - the error is ignored)
+	QSqlQuery(*db_).exec("SET SESSION information_schema_stats_expiry=0");
+
+	//the modification time has a resolution of seconds: if the tables were modified in the current second, they can be modified again without changing the version
+	SqlQuery query = getQuery();
+	query.exec("SELECT MAX(UPDATE_TIME), MAX(UPDATE_TIME)>=NOW() FROM information_schema.tables WHERE table_schema=DATABASE() AND table_name IN ('gene', 'gene_alias', 'gene_transcript', 'gene_exon', 'hpo_term', 'hpo_genes', 'omim_gene', 'omim_phenotype')");
+	query.next();
+	QByteArray version = query.value(1).toInt()==1 ? QByteArray() : "modified:" + query.value(0).toByteArray();
+
+	if (version.isEmpty() || version!=cache.version)
+	{
+		cache.clear();
+		cache.version = version;
+	}
+}
+
+void NGSD::cacheGenes(Cache& cache)
+{
+	checkCache(cache);
+	if (cache.genes_loaded) return;
+
+	SqlQuery query = getQuery();
+	query.exec("SELECT id, symbol FROM gene");
+	while(query.next())
+	{
+		int id = query.value(0).toInt();
+		QByteArray symbol = query.value(1).toByteArray();
+		cache.approved_genes.insert(symbol);
+		cache.gene_symbol2id.insert(symbol.trimmed().toUpper(), id);
+		cache.gene_id2symbol.insert(id, symbol);
+	}
+
+	query.exec("SELECT gene_id, symbol, type FROM gene_alias ORDER BY gene_id");
+	while(query.next())
+	{
+		int id = query.value(0).toInt();
+		QByteArray symbol = query.value(1).toByteArray().toUpper();
+		QByteArray type = query.value(2).toByteArray();
+		if (type=="previous")
 		{
-			bed.append(BedLine(query.value(1).toString(), query.value(2).toInt(), query.value(3).toInt(), QList<QByteArray>() << query.value(0).toByteArray()));
+			cache.gene_previous2ids[symbol] << id;
 		}
+		else if (type=="synonym")
+		{
+			cache.gene_synonym2ids[symbol] << id;
+		}
+	}
+
+	cache.genes_loaded = true;
+}
+
+void NGSD::cacheTranscripts(Cache& cache)
+{
+	checkCache(cache);
+	if (cache.transcripts_loaded) return;
+
+	SqlQuery query = getQuery();
+	query.exec("SELECT id, gene_id, source, name, chromosome, start_coding, end_coding, strand FROM gene_transcript ORDER BY name");
+	while(query.next())
+	{
+		int id = query.value(0).toInt();
 
-		//sort and index
-		bed.sort();
-		index.createIndex();
+		Cache::TranscriptData data;
+		data.source = Transcript::stringToSource(query.value(2).toString());
+		data.name = query.value(3).toByteArray();
+		data.chr = Chromosome(query.value(4).toByteArray());
+		data.start_coding = query.value(5).isNull() ? 0 : query.value(5).toInt();
+		data.end_coding = query.value(6).isNull() ? 0 : query.value(6).toInt();
+		data.strand = Transcript::stringToStrand(query.value(7).toByteArray());
+		data.exon_offset = 0;
+		data.exon_count = 0;
+		cache.transcripts.insert(id, data);
+		cache.gene2transcripts[query.value(1).toInt()] << id;
 	}
 
-	//create gene list
-	GeneSet genes;
-	QVector<int> matches = index.matchingIndices(chr, start-extend, end+extend);
-	foreach(int i, matches)
+	query.exec("SELECT transcript_id, start, end FROM gene_exon ORDER BY transcript_id, start");
+	cache.exon_starts.reserve(query.size());
+	cache.exon_ends.reserve(query.size());
+	while(query.next())
 	{
-		genes << bed[i].annotations()[0];
+		auto it = cache.transcripts.find(query.value(0).toInt());
+		if (it==cache.transcripts.end()) continue;
+
+		if (it->exon_count==0) it->exon_offset = cache.exon_starts.count();
+		++(it->exon_count);
+		cache.exon_starts << query.value(1).toInt();
+		cache.exon_ends << query.value(2).toInt();
 	}
-	return genes;
+
+	cache.transcripts_loaded = true;
 }
 
-GeneSet NGSD::genesOverlappingByExon(const Chromosome& chr, int start, int end, int extend)
+void NGSD::cacheGeneRegions(Cache& cache)
+{
+	checkCache(cache);
+	if (cache.gene_regions_loaded) return;
+
+	//add transcripts
+	SqlQuery query = getQuery();
+	query.exec("SELECT g.symbol, gt.chromosome, MIN(ge.start), MAX(ge.end) FROM gene g, gene_transcript gt, gene_exon ge WHERE ge.transcript_id=gt.id AND gt.gene_id=g.id GROUP BY gt.id");
+	while(query.next())
+	{
+		cache.gene_regions.append(BedLine(query.value(1).toString(), query.value(2).toInt(), query.value(3).toInt(), QList<QByteArray>() << query.value(0).toByteArray()));
+	}
+
+	//sort and index
+	cache.gene_regions.sort();
+	cache.gene_regions_index.reset(new ChromosomalIndex<BedFile>(cache.gene_regions));
+
+	cache.gene_regions_loaded = true;
+}
+
+void NGSD::cacheGeneExons(Cache& cache)
 {
-	//init static data (load gene regions file from NGSD to memory)
-	static BedFile bed;
-	static ChromosomalIndex<BedFile> index(bed);
-	if (bed.count()==0)
+	checkCache(cache);
+	if (cache.gene_exons_loaded) return;
+
+	SqlQuery query = getQuery();
+	query.exec("SELECT DISTINCT g.symbol, gt.chromosome, ge.start, ge.end FROM gene g, gene_exon ge, gene_transcript gt WHERE ge.transcript_id=gt.id AND gt.gene_id=g.id");
+	while(query.next())
 	{
-		SqlQuery query = getQuery();
-		query.exec("SELECT DISTINCT g.symbol, gt.chromosome, ge.start, ge.end FROM gene g, gene_exon ge, gene_transcript gt WHERE ge.transcript_id=gt.id AND gt.gene_id=g.id");
-		while(query.next())
+		cache.gene_exons.append(BedLine(query.value(1).toString(), query.value(2).toInt(), query.value(3).toInt(), QList<QByteArray>() << query.value(0).toByteArray()));
+	}
+
+	//sort and index
+	cache.gene_exons.sort();
+	cache.gene_exons_index.reset(new ChromosomalIndex<BedFile>(cache.gene_exons));
+
+	cache.gene_exons_loaded = true;
+}
+
+void NGSD::cachePhenotypes(Cache& cache)
+{
+	checkCache(cache);
+	if (cache.phenotypes_loaded) return;
+
+	SqlQuery query = getQuery();
+	query.exec("SELECT g.gene, t.hpo_id, t.name FROM hpo_term t, hpo_genes g WHERE t.id=g.hpo_term_id ORDER BY t.name ASC");
+	while(query.next())
+	{
+		cache.gene2phenotypes[query.value(0).toByteArray().toUpper()] << Phenotype(query.value(1).toByteArray(), query.value(2).toByteArray());
+	}
+
+	cache.phenotypes_loaded = true;
+}
+
+void NGSD::cacheOmim(Cache& cache)
+{
+	checkCache(cache);
+	if (cache.omim_loaded) return;
+
+	SqlQuery query = getQuery();
+	query.exec("SELECT id, gene, mim FROM omim_gene");
+	QHash<int, QPair<QByteArray, int>> id2key; //OMIM gene ID > key and index in list
+	while(query.next())
+	{
+		OmimInfo info;
+		info.gene_symbol = query.value(1).toByteArray();
+		info.mim = query.value(2).toByteArray();
+
+		//several OMIM genes can have the same symbol
+		QByteArray key = info.gene_symbol.toUpper();
+		QList<OmimInfo>& infos = cache.omim[key];
+		id2key.insert(query.value(0).toInt(), qMakePair(key, infos.count()));
+		infos << info;
+	}
+
+	QRegExp mim_exp("[^0-9]([0-9]{6})[^0-9]");
+	query.exec("SELECT omim_gene_id, phenotype FROM omim_phenotype ORDER BY phenotype ASC");
+	while(query.next())
+	{
+		QString pheno = query.value(1).toString();
+
+		Phenotype tmp;
+		tmp.setName(pheno.toLatin1());
+		if (mim_exp.indexIn(pheno)!=-1)
 		{
-			bed.append(BedLine(query.value(1).toString(), query.value(2).toInt(), query.value(3).toInt(), QList<QByteArray>() << query.value(0).toByteArray()));
+			tmp.setAccession(mim_exp.cap(1).toLatin1());
 		}
-		bed.sort();
-		index.createIndex();
+
+		auto it = id2key.find(query.value(0).toInt());
+		if (it==id2key.end()) continue;
+		cache.omim[it->first][it->second].phenotypes << tmp;
 	}
 
-	//create gene list
-	GeneSet genes;
-	QVector<int> matches = index.matchingIndices(chr, start-extend, end+extend);
-	foreach(int i, matches)
+	cache.omim_loaded = true;
+}
+
+Transcript NGSD::cachedTranscript(const Cache& cache, const Cache::TranscriptData& data)
+{
+	Transcript transcript;
+	transcript.setName(data.name);
+	transcript.setSource(data.source);
+	transcript.setStrand(data.strand);
+
+	//exons
+	BedFile regions;
+	for (int i=data.exon_offset; i<data.exon_offset+data.exon_count; ++i)
 	{
-		genes << bed[i].annotations()[0];
+		regions.append(BedLine(data.chr, cache.exon_starts[i], cache.exon_ends[i]));
 	}
 
-	return genes;
+	int start_coding = data.start_coding;
+	int end_coding = data.end_coding;
+	if (transcript.strand()==Transcript::MINUS)
+	{
+		int tmp = start_coding;
+		start_coding = end_coding;
+		end_coding = tmp;
+	}
+	transcript.setRegions(regions, start_coding, end_coding);
+
+	return transcript;
 }
 
 BedFile NGSD::geneToRegions(const QByteArray& gene, Transcript::SOURCE source, QString mode, bool fallback, bool annotate_transcript_names, QTextStream* messages)
@@ -3238,15 +3533,17 @@ QList<Transcript> NGSD::transcripts(int gene_id, Transcript::SOURCE source, bool
 {
 	QList<Transcript> output;
 
-	//get chromosome
-	QString gene_id_str = QString::number(gene_id);
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheTranscripts(cache);
 
-	//get transcripts
-	SqlQuery query = getQuery();
-	query.exec("SELECT id FROM gene_transcript WHERE gene_id=" + gene_id_str + " AND source='" + Transcript::sourceToString(source) + "' " + (coding_only ? "AND start_coding IS NOT NULL AND end_coding IS NOT NULL" : "") + " ORDER BY name");
-	while(query.next())
+	foreach(int id, cache.gene2transcripts.value(gene_id))
 	{
-		output.push_back(transcript(query.value(0).toInt()));
+		const Cache::TranscriptData& data = cache.transcripts[id];
+		if (data.source!=source) continue;
+		if (coding_only && (data.start_coding==0 || data.end_coding==0)) continue;
+
+		output << cachedTranscript(cache, data);
 	}
 
 	return output;
@@ -3254,42 +3551,13 @@ QList<Transcript> NGSD::transcripts(int gene_id, Transcript::SOURCE source, bool
 
 Transcript NGSD::transcript(int id)
 {
-	QString id_str = QString::number(id);
+	Cache& cache = NGSD::cache(test_db_);
+	QMutexLocker locker(&cache.mutex);
+	cacheTranscripts(cache);
 
-	SqlQuery query = getQuery();
-	query.exec("SELECT source, name, chromosome, start_coding, end_coding, strand FROM gene_transcript WHERE id=" + id_str);
-	if (query.size()==0) THROW(DatabaseException, "Could not find transcript with identifer  '" + id_str + "' in NGSD!");
-	query.next();
+	if (!cache.transcripts.contains(id)) THROW(DatabaseException, "Could not find transcript with identifer  '" + QString::number(id) + "' in NGSD!");
 
-	//get base information
-	Transcript transcript;
-	transcript.setName(query.value(1).toByteArray());
-	transcript.setSource(Transcript::stringToSource(query.value(0).toString()));
-	transcript.setStrand(Transcript::stringToStrand(query.value(5).toByteArray()));
-
-	//get exons
-	BedFile regions;
-	Chromosome chr = query.value(2).toByteArray();
-	SqlQuery query2 = getQuery();
-	query2.exec("SELECT start, end FROM gene_exon WHERE transcript_id=" + id_str + " ORDER BY start");
-	while(query2.next())
-	{
-		int start = query2.value(0).toInt();
-		int end = query2.value(1).toInt();
-		regions.append(BedLine(chr, start, end));
-	}
-
-	int start_coding = query.value(3).isNull() ? 0 : query.value(3).toInt();
-	int end_coding = query.value(4).isNull() ? 0 : query.value(4).toInt();
-	if (transcript.strand()==Transcript::MINUS)
-	{
-		int tmp = start_coding;
-		start_coding = end_coding;
-		end_coding = tmp;
-	}
-	transcript.setRegions(regions, start_coding, end_coding);
-
-	return transcript;
+	return cachedTranscript(cache, cache.transcripts[id]);
 }
 
 Transcript NGSD::longestCodingTranscript(int gene_id, Transcript::SOURCE source, bool fallback_alt_source, bool fallback_alt_source_nocoding)
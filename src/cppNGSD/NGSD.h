@@ -21,6 +21,9 @@
 #include "SomaticReportConfiguration.h"
 #include "CnvList.h"
 #include "BedpeFile.h"
+#include "ChromosomalIndex.h"
+#include <QMutex>
+#include <QElapsedTimer>
 
 ///OMIM information datastructure
 struct OmimInfo
@@ -439,6 +442,11 @@ public:
 	bool rollback() { return db_->rollback(); }
 
 	/*** gene/transcript handling ***/
+	///Removes all cached gene, transcript and phenotype data (of all instances), e.g. after the tables were modified.
+	///Modifications by other clients are detected automatically, see setCacheCheckInterval().
+	static void clearCache();
+	///Sets the minimum time in milliseconds between two checks if the cached tables were modified (default is 10 seconds). If the tables were modified, the cache is cleared.
+	static void setCacheCheckInterval(int ms);
 	///Returns the gene ID, or -1 if none approved gene name could be found. Checks approved symbols, previous symbols and synonyms.
 	int geneToApprovedID(const QByteArray& gene);
 	///Returns the gene symbol for a gene ID
@@ -472,7 +480,7 @@ public:
 	///Returns longest coding transcript of a gene.
 	Transcript longestCodingTranscript(int gene_id, Transcript::SOURCE source, bool fallback_alt_source=false, bool fallback_alt_source_nocoding=false);
 	///Returns the list of all approved gene names
-	const GeneSet& approvedGeneNames();
+	GeneSet approvedGeneNames();
 
 	/*** phenotype handling (HPO, OMIM) ***/
 	///Returns the phenotype for a given HPO accession.
@@ -504,7 +512,8 @@ public:
 	///Adds a variant to the NGSD. Returns the variant ID.
 	QString addVariant(const Variant& variant, const VariantList& variant_list);
 	///Adds all missing variants to the NGSD and returns the variant DB identifiers (or -1 if the variant was skipped due to 'max_af')
-	QList<int> addVariants(const VariantList& variant_list, double max_af, int& c_add, int& c_update);
+	///Variants are processed in chunks of @p chunk_size: one lookup query per chromosome, one multi-row INSERT/UPDATE statement and one transaction per chunk.
+	QList<int> addVariants(const VariantList& variant_list, double max_af, int& c_add, int& c_update, int chunk_size = 2000);
 	///Returns the NGSD ID for a variant. Returns '' or throws an exception if the ID cannot be determined.
 	QString variantId(const Variant& variant, bool throw_if_fails = true);
 	///Returns the variant corresponding to the given identifier or throws an exception if the ID does not exist.
@@ -673,9 +682,81 @@ protected:
 	void fixGeneNames(QTextStream* messages, bool fix_errors, QString table, QString column);
 	static QString escapeForSql(const QString& text);
 
+	///Returns the key used to match variants of a variant list with variants in the NGSD.
+	static QByteArray variantKey(const Variant& variant);
+	///Returns the NGSD variant rows (id, 1000g, gnomad, gene, variant_type, coding) of the given variants (key is the variant key).
+	QHash<QByteArray, QVariantList> variantRows(const VariantList& variant_list, const QList<int>& indices);
+
 	///Returns the maxiumn allele frequency of a variant.
 	static double maxAlleleFrequency(const Variant& v, QList<int> af_column_index);
 
+	///Compact in-memory copy of the gene, transcript and phenotype tables.
+	///The parts are loaded on first use with one query per table and shared by all instances connected to the same database.
+	struct Cache
+	{
+		QMutex mutex{QMutex::Recursive};
+
+		//version of the cached tables (last modification time), see NGSD::checkCache()
+		QByteArray version;
+		QElapsedTimer last_check;
+		int check_interval = 10000;
+
+		//genes (aliases are stored in upper-case because the database lookup was case-insensitive)
+		bool genes_loaded = false;
+		GeneSet approved_genes;
+		QHash<QByteArray, int> gene_symbol2id;
+		QHash<int, QByteArray> gene_id2symbol;
+		QHash<QByteArray, QList<int>> gene_previous2ids;
+		QHash<QByteArray, QList<int>> gene_synonym2ids;
+
+		//transcripts (exons of all transcripts are stored consecutively)
+		struct TranscriptData
+		{
+			QByteArray name;
+			Transcript::SOURCE source;
+			Transcript::STRAND strand;
+			Chromosome chr;
+			int start_coding;
+			int end_coding;
+			int exon_offset;
+			int exon_count;
+		};
+		bool transcripts_loaded = false;
+		QHash<int, TranscriptData> transcripts;
+		QHash<int, QList<int>> gene2transcripts; //sorted by transcript name
+		QVector<int> exon_starts;
+		QVector<int> exon_ends;
+
+		//gene regions
+		bool gene_regions_loaded = false;
+		BedFile gene_regions;
+		QSharedPointer<ChromosomalIndex<BedFile>> gene_regions_index;
+		bool gene_exons_loaded = false;
+		BedFile gene_exons;
+		QSharedPointer<ChromosomalIndex<BedFile>> gene_exons_index;
+
+		//phenotypes and OMIM (keys are upper-case gene symbols)
+		bool phenotypes_loaded = false;
+		QHash<QByteArray, QList<Phenotype>> gene2phenotypes;
+		bool omim_loaded = false;
+		QHash<QByteArray, QList<OmimInfo>> omim;
+
+		///Removes all cached data.
+		void clear();
+	};
+	///Returns the cache of the production or test database.
+	static Cache& cache(bool test_db);
+	//Methods that load parts of the cache (the cache mutex has to be locked)
+	void checkCache(Cache& cache);
+	void cacheGenes(Cache& cache);
+	void cacheTranscripts(Cache& cache);
+	void cacheGeneRegions(Cache& cache);
+	void cacheGeneExons(Cache& cache);
+	void cachePhenotypes(Cache& cache);
+	void cacheOmim(Cache& cache);
+	///Creates a transcript from cached data.
+	static Transcript cachedTranscript(const Cache& cache, const Cache::TranscriptData& data);
+
 	///The database adapter
 	QSharedPointer<QSqlDatabase> db_;
 	bool test_db_;
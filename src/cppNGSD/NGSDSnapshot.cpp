@@ -0,0 +1,245 @@
+#include "NGSDSnapshot.h"
+#include "Exceptions.h"
+#include "Helper.h"
+#include <QDateTime>
+#include <QTextStream>
+#include <algorithm>
+
+NGSDSnapshot::NGSDSnapshot()
+	: approved_genes_()
+	, gene_info_()
+	, gene_regions_()
+	, exon_regions_()
+	, transcript_regions_()
+	, transcript_regions_index_(new ChromosomalIndex<BedFile>(transcript_regions_))
+	, pathogenic_cnvs_()
+	, pathogenic_cnvs_index_(new ChromosomalIndex<BedFile>(pathogenic_cnvs_))
+{
+}
+
+void NGSDSnapshot::create(NGSD& db, QString filename)
+{
+	QSharedPointer<QFile> file = Helper::openFileForWriting(filename);
+	QTextStream stream(file.data());
+	stream << "##NGSD snapshot\n";
+	stream << "##version=" << VERSION << "\n";
+	stream << "##created=" << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+
+	//gene info
+	QHash<QByteArray, QStringList> gene_info;
+	SqlQuery query = db.getQuery();
+	query.exec("SELECT symbol, inheritance, gnomad_oe_syn, gnomad_oe_mis, gnomad_oe_lof FROM geneinfo_germline");
+	while(query.next())
+	{
+		QStringList info;
+		info << query.value(1).toString();
+		for (int i=2; i<=4; ++i)
+		{
+			info << (query.value(i).isNull() ? "n/a" : QString::number(query.value(i).toDouble(), 'f', 2));
+		}
+		gene_info.insert(query.value(0).toByteArray().trimmed().toUpper(), info);
+	}
+
+	//genes and their regions (gene symbols of gene sets are upper-case)
+	//Gene and exon regions are calculated like NGSD::genesToRegions with Ensembl transcripts and fallback, but the transcripts and exons of a gene are queried only once for both modes.
+	SqlQuery q_transcript = db.getQuery();
+	q_transcript.prepare("SELECT id, chromosome, start_coding, end_coding, source FROM gene_transcript WHERE gene_id=:0");
+	SqlQuery q_exon = db.getQuery();
+	q_exon.prepare("SELECT start, end FROM gene_exon WHERE transcript_id=:0");
+	GeneSet genes = db.approvedGeneNames();
+	foreach(const QByteArray& gene, genes)
+	{
+		stream << "GENE\t" << gene << "\t" << gene_info.value(gene, QStringList() << "n/a" << "n/a" << "n/a" << "n/a").join("\t") << "\n";
+
+		//regions of Ensembl transcripts (index 0) and of all transcripts (index 1, fallback)
+		BedFile gene_regions[2];
+		BedFile exon_regions[2];
+		q_transcript.bindValue(0, db.geneToApprovedID(gene));
+		q_transcript.exec();
+		while(q_transcript.next())
+		{
+			Chromosome chr("chr" + q_transcript.value(1).toByteArray());
+			bool is_coding = !q_transcript.value(2).isNull() && !q_transcript.value(3).isNull();
+			int start_coding = q_transcript.value(2).toInt();
+			int end_coding = q_transcript.value(3).toInt();
+			bool is_ensembl = q_transcript.value(4).toString()==Transcript::sourceToString(Transcript::ENSEMBL);
+
+			int min = -1;
+			int max = -1;
+			q_exon.bindValue(0, q_transcript.value(0).toInt());
+			q_exon.exec();
+			while(q_exon.next())
+			{
+				int start = q_exon.value(0).toInt();
+				int end = q_exon.value(1).toInt();
+				if (min==-1 || start<min) min = start;
+				if (max==-1 || end>max) max = end;
+
+				if (is_coding)
+				{
+					start = std::max(start_coding, start);
+					end = std::min(end_coding, end);
+
+					//skip non-coding exons of coding transcripts
+					if (end<start_coding || start>end_coding) continue;
+				}
+				for (int i=(is_ensembl ? 0 : 1); i<2; ++i)
+				{
+					exon_regions[i].append(BedLine(chr, start, end));
+				}
+			}
+			if (min==-1) continue;
+
+			for (int i=(is_ensembl ? 0 : 1); i<2; ++i)
+			{
+				gene_regions[i].append(BedLine(chr, min, max));
+			}
+		}
+
+		foreach(QString mode, QStringList() << "gene" << "exon")
+		{
+			BedFile* regions = (mode=="gene" ? gene_regions : exon_regions);
+			BedFile& selected = regions[0].isEmpty() ? regions[1] : regions[0];
+			selected.sort(true);
+			for (int i=0; i<selected.count(); ++i)
+			{
+				const BedLine& line = selected[i];
+				stream << (mode=="gene" ? "GENE_REGION\t" : "EXON_REGION\t") << gene << "\t" << line.chr().strNormalized(true) << "\t" << line.start() << "\t" << line.end() << "\n";
+			}
+		}
+	}
+
+	//transcript regions (see NGSD::genesOverlapping)
+	query.exec("SELECT g.symbol, gt.chromosome, MIN(ge.start), MAX(ge.end) FROM gene g, gene_transcript gt, gene_exon ge WHERE ge.transcript_id=gt.id AND gt.gene_id=g.id GROUP BY gt.id");
+	while(query.next())
+	{
+		stream << "TRANSCRIPT_REGION\t" << query.value(0).toString() << "\t" << Chromosome(query.value(1).toByteArray()).strNormalized(true) << "\t" << query.value(2).toInt() << "\t" << query.value(3).toInt() << "\n";
+	}
+
+	//pathogenic CNVs
+	query.exec("SELECT rcc.class, cnv.chr, cnv.start, cnv.end FROM cnv INNER JOIN report_configuration_cnv rcc ON cnv.id = rcc.cnv_id WHERE rcc.class IN ('4', '5')");
+	while(query.next())
+	{
+		stream << "PATHOGENIC_CNV\t" << query.value(0).toString() << "\t" << query.value(1).toString() << "\t" << query.value(2).toInt() << "\t" << query.value(3).toInt() << "\n";
+	}
+}
+
+void NGSDSnapshot::load(QString filename)
+{
+	approved_genes_.clear();
+	gene_info_.clear();
+	gene_regions_.clear();
+	exon_regions_.clear();
+	transcript_regions_.clear();
+	pathogenic_cnvs_.clear();
+
+	QSharedPointer<QFile> file = Helper::openFileForReading(filename);
+	int version = -1;
+	while(!file->atEnd())
+	{
+		QByteArray line = file->readLine();
+		while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+		if (line.isEmpty()) continue;
+
+		//header
+		if (line.startsWith("##"))
+		{
+			if (line.startsWith("##version="))
+			{
+				version = line.mid(10).toInt();
+				if (version!=VERSION) THROW(FileParseException, "NGSD snapshot '" + filename + "' has version " + QString::number(version) + ", but version " + QString::number(VERSION) + " is required. Please re-create the snapshot!");
+			}
+			continue;
+		}
+		if (version==-1) THROW(FileParseException, "NGSD snapshot '" + filename + "' does not contain a version header!");
+
+		//records
+		QByteArrayList parts = line.split('\t');
+		const QByteArray& type = parts[0];
+		if (type=="GENE" && parts.count()==6)
+		{
+			GeneInfo info;
+			info.symbol = parts[1];
+			info.inheritance = parts[2];
+			info.oe_syn = parts[3];
+			info.oe_mis = parts[4];
+			info.oe_lof = parts[5];
+			approved_genes_.insert(parts[1]);
+			gene_info_.insert(parts[1].trimmed().toUpper(), info);
+		}
+		else if (type=="GENE_REGION" && parts.count()==5)
+		{
+			gene_regions_[parts[1].trimmed().toUpper()].append(BedLine(parts[2], Helper::toInt(parts[3], "start"), Helper::toInt(parts[4], "end")));
+		}
+		else if (type=="EXON_REGION" && parts.count()==5)
+		{
+			exon_regions_[parts[1].trimmed().toUpper()].append(BedLine(parts[2], Helper::toInt(parts[3], "start"), Helper::toInt(parts[4], "end")));
+		}
+		else if (type=="TRANSCRIPT_REGION" && parts.count()==5)
+		{
+			transcript_regions_.append(BedLine(parts[2], Helper::toInt(parts[3], "start"), Helper::toInt(parts[4], "end"), QByteArrayList() << parts[1]));
+		}
+		else if (type=="PATHOGENIC_CNV" && parts.count()==5)
+		{
+			pathogenic_cnvs_.append(BedLine(parts[2], Helper::toInt(parts[3], "start"), Helper::toInt(parts[4], "end"), QByteArrayList() << parts[1]));
+		}
+		else
+		{
+			THROW(FileParseException, "Invalid line in NGSD snapshot '" + filename + "': " + line);
+		}
+	}
+
+	//index
+	transcript_regions_.sort();
+	transcript_regions_index_->createIndex();
+	pathogenic_cnvs_.sort();
+	pathogenic_cnvs_index_->createIndex();
+}
+
+GeneSet NGSDSnapshot::genesOverlapping(const Chromosome& chr, int start, int end, int extend) const
+{
+	GeneSet genes;
+
+	QVector<int> matches = transcript_regions_index_->matchingIndices(chr, start-extend, end+extend);
+	foreach(int i, matches)
+	{
+		genes << transcript_regions_[i].annotations()[0];
+	}
+
+	return genes;
+}
+
+BedFile NGSDSnapshot::geneRegions(const QByteArray& symbol, QString mode) const
+{
+	if (mode=="gene") return gene_regions_.value(symbol.trimmed().toUpper());
+	if (mode=="exon") return exon_regions_.value(symbol.trimmed().toUpper());
+
+	THROW(ArgumentException, "Invalid mode '" + mode + "'. Valid modes are: gene, exon.");
+}
+
+GeneInfo NGSDSnapshot::geneInfo(const QByteArray& symbol) const
+{
+	QByteArray key = symbol.trimmed().toUpper();
+	if (gene_info_.contains(key)) return gene_info_[key];
+
+	GeneInfo output;
+	output.symbol = symbol;
+	output.inheritance = "n/a";
+	output.oe_syn = "n/a";
+	output.oe_mis = "n/a";
+	output.oe_lof = "n/a";
+	return output;
+}
+
+BedFile NGSDSnapshot::pathogenicCnvs(const Chromosome& chr, int start, int end) const
+{
+	BedFile output;
+
+	QVector<int> matches = pathogenic_cnvs_index_->matchingIndices(chr, start, end);
+	foreach(int i, matches)
+	{
+		output.append(pathogenic_cnvs_[i]);
+	}
+
+	return output;
+}
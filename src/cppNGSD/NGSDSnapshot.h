@@ -0,0 +1,56 @@
+#ifndef NGSDSNAPSHOT_H
+#define NGSDSNAPSHOT_H
+
+#include "cppNGSD_global.h"
+#include "NGSD.h"
+#include "ChromosomalIndex.h"
+
+///Offline copy of the NGSD data needed by the gene/CNV annotation tools (transcript regions, gene regions, exon regions, gene info and pathogenic CNVs).
+///A snapshot is created from the NGSD once and can then be used without database connection, e.g. on compute nodes.
+///The file is a versioned text file - lines start with the record type, followed by tab-separated fields.
+///OMIM data is not contained: none of the tools that support snapshots annotates OMIM from the NGSD.
+class CPPNGSDSHARED_EXPORT NGSDSnapshot
+{
+public:
+	///Constructor.
+	NGSDSnapshot();
+
+	///Writes a snapshot of the NGSD to a file.
+	static void create(NGSD& db, QString filename);
+	///Loads a snapshot from file. Throws a FileParseException if the file format version is not supported.
+	void load(QString filename);
+
+	///Returns the list of all approved gene names (see NGSD::approvedGeneNames).
+	const GeneSet& approvedGeneNames() const
+	{
+		return approved_genes_;
+	}
+	///Returns the genes overlapping a regions (see NGSD::genesOverlapping).
+	GeneSet genesOverlapping(const Chromosome& chr, int start, int end, int extend=0) const;
+	///Returns the Ensembl regions of a gene in mode 'gene' or 'exon' (see NGSD::genesToRegions with fallback).
+	BedFile geneRegions(const QByteArray& symbol, QString mode) const;
+	///Returns the gene information of an approved gene symbol (only symbol, inheritance and gnomAD o/e scores are stored).
+	GeneInfo geneInfo(const QByteArray& symbol) const;
+	///Returns the pathogenic CNVs (class 4 and 5) overlapping a region. The class is stored as annotation.
+	BedFile pathogenicCnvs(const Chromosome& chr, int start, int end) const;
+
+	///Current file format version.
+	static const int VERSION = 1;
+
+protected:
+	//gene symbols used as keys are trimmed and upper-case, like in GeneSet
+	GeneSet approved_genes_;
+	QHash<QByteArray, GeneInfo> gene_info_;
+	QHash<QByteArray, BedFile> gene_regions_;
+	QHash<QByteArray, BedFile> exon_regions_;
+	BedFile transcript_regions_;
+	QSharedPointer<ChromosomalIndex<BedFile>> transcript_regions_index_;
+	BedFile pathogenic_cnvs_;
+	QSharedPointer<ChromosomalIndex<BedFile>> pathogenic_cnvs_index_;
+
+	//declared away methods
+	NGSDSnapshot(const NGSDSnapshot&) = delete;
+	NGSDSnapshot& operator=(const NGSDSnapshot&) = delete;
+};
+
+#endif // NGSDSNAPSHOT_H
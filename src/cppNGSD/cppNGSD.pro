@@ -40,7 +40,8 @@ SOURCES += \
     DBTable.cpp \
     ReportConfiguration.cpp \
     SomaticReportConfiguration.cpp \
-    LoginManager.cpp
+    LoginManager.cpp \
+    NGSDSnapshot.cpp
 
 HEADERS += \
     SqlQuery.h \
@@ -49,7 +50,8 @@ HEADERS += \
     DBTable.h \
     ReportConfiguration.h \
     SomaticReportConfiguration.h \
-    LoginManager.h
+    LoginManager.h \
+    NGSDSnapshot.h
 
 RESOURCES += \
     cppNGSD.qrc
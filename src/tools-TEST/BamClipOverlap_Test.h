@@ -75,5 +75,12 @@ private slots:
 		IS_TRUE(QFile::exists("out/BamClipOverlap_out4.bam"));
 		COMPARE_FILES("out/BamClipOverlap_Test_line74.log", TESTDATA("data_out/BamClipOverlap_out10.log"));
 	}
-};
 
+	void coord_sorted()
+	{
+		EXECUTE("BamClipOverlap", "-in " + TESTDATA("data_in/BamClipOverlap_in1.bam") + " -out out/BamClipOverlap_out11.bam -coord_sorted -v");
+		IS_TRUE(QFile::exists("out/BamClipOverlap_out11.bam"));
+		COMPARE_FILES("out/BamClipOverlap_Test_line81.log", TESTDATA("data_out/BamClipOverlap_out1.log"));
+		COMPARE_GZ_FILES("out/BamClipOverlap_out11.bam", TESTDATA("data_out/BamClipOverlap_out11.bam"));
+	}
+};
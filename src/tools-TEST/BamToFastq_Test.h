@@ -23,6 +23,25 @@ private slots:
 		COMPARE_GZ_FILES("out/BamToFastq_out3.fastq.gz", TESTDATA("data_out/BamToFastq_out3.fastq.gz"));
 		COMPARE_GZ_FILES("out/BamToFastq_out4.fastq.gz", TESTDATA("data_out/BamToFastq_out4.fastq.gz"));
 	}
+
+	void test_spill()
+	{
+		EXECUTE("BamToFastq", "-in " + TESTDATA("data_in/BamToFastq_in1.bam") + " -max_cached 50 -batch_size 100 -out1 out/BamToFastq_out5.fastq.gz -out2 out/BamToFastq_out6.fastq.gz");
+		IS_TRUE(QFile::exists("out/BamToFastq_out5.fastq.gz"));
+		IS_TRUE(QFile::exists("out/BamToFastq_out6.fastq.gz"));
+		COMPARE_GZ_FILES("out/BamToFastq_out5.fastq.gz", TESTDATA("data_out/BamToFastq_out5.fastq.gz"));
+		COMPARE_GZ_FILES("out/BamToFastq_out6.fastq.gz", TESTDATA("data_out/BamToFastq_out6.fastq.gz"));
+	}
+
+	void test_spill_many_files()
+	{
+		//more temporary files than are merged at once
+		EXECUTE("BamToFastq", "-in " + TESTDATA("data_in/BamToFastq_in1.bam") + " -max_cached 10 -out1 out/BamToFastq_out7.fastq.gz -out2 out/BamToFastq_out8.fastq.gz");
+		IS_TRUE(QFile::exists("out/BamToFastq_out7.fastq.gz"));
+		IS_TRUE(QFile::exists("out/BamToFastq_out8.fastq.gz"));
+		COMPARE_GZ_FILES("out/BamToFastq_out7.fastq.gz", TESTDATA("data_out/BamToFastq_out7.fastq.gz"));
+		COMPARE_GZ_FILES("out/BamToFastq_out8.fastq.gz", TESTDATA("data_out/BamToFastq_out8.fastq.gz"));
+	}
 };
 
 
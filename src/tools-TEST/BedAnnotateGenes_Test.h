@@ -52,4 +52,20 @@ private slots:
 		EXECUTE("BedAnnotateGenes", "-test -clear -in " + TESTDATA("data_in/BedAnnotateGenes_in2.bed") + " -out out/BedAnnotateGenes_out3.bed");
 		COMPARE_FILES("out/BedAnnotateGenes_out3.bed", TESTDATA("data_out/BedAnnotateGenes_out3.bed"));
 	}
+
+	void with_snapshot()
+	{
+		QString host = Settings::string("ngsd_test_host");
+		if (host=="") SKIP("Test needs access to the NGSD test database!");
+
+		//init
+		NGSD db(true);
+		db.init();
+		db.executeQueriesFromFile(TESTDATA("data_in/BedAnnotateGenes_init.sql"));
+
+		//test (annotation from snapshot has to be identical to annotation from NGSD)
+		EXECUTE("NGSDExportSnapshot", "-test -out out/BedAnnotateGenes_snapshot.tsv");
+		EXECUTE("BedAnnotateGenes", "-snapshot out/BedAnnotateGenes_snapshot.tsv -extend 25 -in " + TESTDATA("data_in/BedAnnotateGenes_in2.bed") + " -out out/BedAnnotateGenes_out4.bed");
+		COMPARE_FILES("out/BedAnnotateGenes_out4.bed", TESTDATA("data_out/BedAnnotateGenes_out2.bed"));
+	}
 };
@@ -28,4 +28,16 @@ private slots:
 		EXECUTE("BedCoverage", "-in " + TESTDATA("../cppNGS-TEST/data_in/panel.bed") + " -bam " + TESTDATA("../cppNGS-TEST/data_in/panel.bam") + " " + TESTDATA("../cppNGS-TEST/data_in/panel.bam") + " -out out/BedCoverage_test04_out.tsv");
 		COMPARE_FILES_DELTA("out/BedCoverage_test04_out.tsv", TESTDATA("data_out/BedCoverage_test04_out.tsv"), 1.0, true, '\t'); //delta because of macOS rounding problem
 	}
+
+	void two_input_files_threads()
+	{
+		EXECUTE("BedCoverage", "-in " + TESTDATA("../cppNGS-TEST/data_in/panel.bed") + " -bam " + TESTDATA("../cppNGS-TEST/data_in/panel.bam") + " " + TESTDATA("../cppNGS-TEST/data_in/panel.bam") + " -threads 4 -out out/BedCoverage_test05_out.tsv");
+		COMPARE_FILES_DELTA("out/BedCoverage_test05_out.tsv", TESTDATA("data_out/BedCoverage_test04_out.tsv"), 1.0, true, '\t'); //delta because of macOS rounding problem
+	}
+
+	void panelMode_threads()
+	{
+		EXECUTE("BedCoverage", "-in " + TESTDATA("../cppNGS-TEST/data_in/panel.bed") + " -bam " + TESTDATA("../cppNGS-TEST/data_in/panel.bam") + " -out out/BedCoverage_test06_out.tsv -min_mapq 0 -mode panel -decimals 1 -threads 4");
+		COMPARE_FILES_DELTA("out/BedCoverage_test06_out.tsv", TESTDATA("data_out/BedCoverage_test03_out.tsv"), 1.0, true, '\t'); //delta because of macOS rounding problem
+	}
 };
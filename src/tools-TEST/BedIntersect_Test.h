@@ -23,4 +23,26 @@ private slots:
 		COMPARE_FILES("out/BedIntersect_test03_out.bed", TESTDATA("data_out/BedIntersect_test03_out.bed"));
 	}
 
+	void mode_intersect_stream()
+	{
+		EXECUTE("BedIntersect", "-in " + TESTDATA("data_in/exome.bed") + " -in2 " + TESTDATA("data_in/BedIntersect_in2.bed") + " -out out/BedIntersect_test01_stream_out.bed -stream");
+		COMPARE_FILES("out/BedIntersect_test01_stream_out.bed", TESTDATA("data_out/BedIntersect_test01_out.bed"));
+	}
+
+	void mode_in_stream()
+	{
+		EXECUTE("BedIntersect", "-in " + TESTDATA("data_in/exome.bed") + " -in2 " + TESTDATA("data_in/BedIntersect_in2.bed") + " -out out/BedIntersect_test02_stream_out.bed -mode in -stream");
+		COMPARE_FILES("out/BedIntersect_test02_stream_out.bed", TESTDATA("data_out/BedIntersect_test02_out.bed"));
+	}
+
+	void mode_in2_stream()
+	{
+		EXECUTE("BedIntersect", "-in " + TESTDATA("data_in/exome.bed") + " -in2 " + TESTDATA("data_in/BedIntersect_in2.bed") + " -out out/BedIntersect_test04_out.bed -mode in2 -stream");
+		COMPARE_FILES("out/BedIntersect_test04_out.bed", TESTDATA("data_out/BedIntersect_test04_out.bed"));
+	}
+
+	void stream_unsorted()
+	{
+		EXECUTE_FAIL("BedIntersect", "-in " + TESTDATA("data_in/exome.bed") + " -in2 " + TESTDATA("../cppNGS-TEST/data_in/panel.bed") + " -out out/BedIntersect_test05_out.bed -stream");
+	}
 };
@@ -17,4 +17,9 @@ private slots:
 		COMPARE_FILES("out/BedMerge_test02_out.bed", TESTDATA("data_out/BedMerge_test02_out.bed"));
 	}
 
+	void test_03_stream()
+	{
+		EXECUTE("BedMerge", "-in " + TESTDATA("data_in/exome.bed") + " -out out/BedMerge_test03_out.bed -stream");
+		COMPARE_FILES("out/BedMerge_test03_out.bed", TESTDATA("data_out/BedMerge_test01_out.bed"));
+	}
 };
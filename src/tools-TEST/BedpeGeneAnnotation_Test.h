@@ -55,6 +55,23 @@ private slots:
 		COMPARE_FILES("out/BedpeGeneAnnotation_out3.bedpe", TESTDATA("data_out/BedpeGeneAnnotation_out2.bedpe"));
 	}
 
+	void snapshot()
+	{
+		QString host = Settings::string("ngsd_test_host");
+		if (host=="") SKIP("Test needs access to the NGSD test database!");
+
+		//init
+		NGSD db(true);
+		db.init();
+		db.executeQueriesFromFile(TESTDATA("data_in/BedpeGeneAnnotation_init.sql"));
+
+		//test (annotation from snapshot has to be identical to annotation from NGSD)
+		EXECUTE("NGSDExportSnapshot", "-test -out out/BedpeGeneAnnotation_snapshot.tsv");
+		EXECUTE("BedpeGeneAnnotation", "-add_simple_gene_names -snapshot out/BedpeGeneAnnotation_snapshot.tsv -in " + TESTDATA("data_in/BedpeGeneAnnotation_in1.bedpe") + " -out out/BedpeGeneAnnotation_out4.bedpe");
+
+		COMPARE_FILES("out/BedpeGeneAnnotation_out4.bedpe", TESTDATA("data_out/BedpeGeneAnnotation_out2.bedpe"));
+	}
+
 
 
 };
@@ -39,6 +39,23 @@ private slots:
 		COMPARE_FILES("out/CnvGeneAnnotation_out2.tsv", TESTDATA("data_out/CnvGeneAnnotation_out2.tsv"));
 	}
 
+	void test_snapshot()
+	{
+		QString host = Settings::string("ngsd_test_host");
+		if (host=="") SKIP("Test needs access to the NGSD test database!");
+
+		//init
+		NGSD db(true);
+		db.init();
+		db.executeQueriesFromFile(TESTDATA("data_in/CnvGeneAnnotation_init.sql"));
+
+		//test (annotation from snapshot has to be identical to annotation from NGSD)
+		EXECUTE("NGSDExportSnapshot", "-test -out out/CnvGeneAnnotation_snapshot.tsv");
+		EXECUTE("CnvGeneAnnotation", "-add_simple_gene_names -snapshot out/CnvGeneAnnotation_snapshot.tsv -in " + TESTDATA("data_in/CnvGeneAnnotation_in.tsv") + " -out out/CnvGeneAnnotation_out3.tsv");
+
+		COMPARE_FILES("out/CnvGeneAnnotation_out3.tsv", TESTDATA("data_out/CnvGeneAnnotation_out2.tsv"));
+	}
+
 
 };
 
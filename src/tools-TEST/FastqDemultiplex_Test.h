@@ -0,0 +1,28 @@
+#include "TestFramework.h"
+
+TEST_CLASS(FastqDemultiplex_Test)
+{
+Q_OBJECT
+private slots:
+
+	void index_files()
+	{
+		EXECUTE("FastqDemultiplex", "-in1 " + TESTDATA("data_in/FastqDemultiplex_in1_R1.fastq.gz") + " -in2 " + TESTDATA("data_in/FastqDemultiplex_in1_R2.fastq.gz") + " -index1 " + TESTDATA("data_in/FastqDemultiplex_in1_I1.fastq.gz") + " -index2 " + TESTDATA("data_in/FastqDemultiplex_in1_I2.fastq.gz") + " -sheet " + TESTDATA("data_in/FastqDemultiplex_sheet.tsv") + " -out out/FastqDemultiplex_out1/ -summary out/FastqDemultiplex_out1.tsv -batch_size 4 -threads 3");
+		COMPARE_FILES("out/FastqDemultiplex_out1.tsv", TESTDATA("data_out/FastqDemultiplex_out1.tsv"));
+		foreach(QString sample, QStringList() << "S1" << "S2" << "S3" << "Undetermined")
+		{
+			COMPARE_GZ_FILES("out/FastqDemultiplex_out1/" + sample + "_R1_001.fastq.gz", TESTDATA("data_out/FastqDemultiplex_out1_" + sample + "_R1_001.fastq.gz"));
+			COMPARE_GZ_FILES("out/FastqDemultiplex_out1/" + sample + "_R2_001.fastq.gz", TESTDATA("data_out/FastqDemultiplex_out1_" + sample + "_R2_001.fastq.gz"));
+		}
+	}
+
+	void index_from_header_single_end()
+	{
+		EXECUTE("FastqDemultiplex", "-in1 " + TESTDATA("data_in/FastqDemultiplex_in1_R1.fastq.gz") + " -sheet " + TESTDATA("data_in/FastqDemultiplex_sheet.tsv") + " -out out/FastqDemultiplex_out2/ -summary out/FastqDemultiplex_out2.tsv");
+		COMPARE_FILES("out/FastqDemultiplex_out2.tsv", TESTDATA("data_out/FastqDemultiplex_out1.tsv"));
+		foreach(QString sample, QStringList() << "S1" << "S2" << "S3" << "Undetermined")
+		{
+			COMPARE_GZ_FILES("out/FastqDemultiplex_out2/" + sample + "_R1_001.fastq.gz", TESTDATA("data_out/FastqDemultiplex_out1_" + sample + "_R1_001.fastq.gz"));
+		}
+	}
+};
@@ -23,6 +23,23 @@ private slots:
 		COMPARE_FILES("out/NGSDAnnotateCNV_out.tsv", TESTDATA("data_out/NGSDAnnotateCNV_out.tsv"));
 	}
 
+	void test_snapshot()
+	{
+		QString host = Settings::string("ngsd_test_host");
+		if (host=="") SKIP("Test needs access to the NGSD test database!");
+
+		//init
+		NGSD db(true);
+		db.init();
+		db.executeQueriesFromFile(TESTDATA("data_in/NGSDAnnotateCNV_init.sql"));
+
+		//test
+		EXECUTE("NGSDExportSnapshot", "-test -out out/NGSDAnnotateCNV_snapshot.tsv");
+		EXECUTE("NGSDAnnotateCNV", "-snapshot out/NGSDAnnotateCNV_snapshot.tsv -in "+ TESTDATA("data_in/NGSDAnnotateCNV_in.tsv") + " -out out/NGSDAnnotateCNV_out2.tsv");
+
+		COMPARE_FILES("out/NGSDAnnotateCNV_out2.tsv", TESTDATA("data_out/NGSDAnnotateCNV_out.tsv"));
+	}
+
 };
 
 
@@ -46,6 +46,24 @@ private slots:
 		COMPARE_FILES("out/NGSDExportAnnotationData_out2.vcf", TESTDATA("data_out/NGSDExportAnnotationData_out2.vcf"));
 	}
 
+	void test_germline_threads()
+	{
+		QString host = Settings::string("ngsd_test_host");
+		if (host=="") SKIP("Test needs access to the NGSD test database!");
+
+		//init
+		NGSD db(true);
+		db.init();
+		db.executeQueriesFromFile(TESTDATA("data_in/NGSDExportAnnotationData_init1.sql"));
+
+		//test (small windows to test window borders)
+		EXECUTE("NGSDExportAnnotationData", "-test -variants out/NGSDExportAnnotationData_out4.vcf -threads 3 -window 1000");
+		REMOVE_LINES("out/NGSDExportAnnotationData_out4.vcf", QRegExp("##fileDate="));
+		REMOVE_LINES("out/NGSDExportAnnotationData_out4.vcf", QRegExp("##source=NGSDExportAnnotationData"));
+		REMOVE_LINES("out/NGSDExportAnnotationData_out4.vcf", QRegExp("##reference="));
+		COMPARE_FILES("out/NGSDExportAnnotationData_out4.vcf", TESTDATA("data_out/NGSDExportAnnotationData_out.vcf"));
+	}
+
 	void test_somatic_01()
 	{
 		QString host = Settings::string("ngsd_test_host");
@@ -19,6 +19,12 @@ private slots:
 		COMPARE_FILES("out/ReadQC_out2.txt", TESTDATA("data_out/ReadQC_out2.txt"));
 	}
 
+	void with_txt_parameter_threads()
+	{
+		EXECUTE("ReadQC", "-in1 " + TESTDATA("data_in/ReadQC_in1.fastq.gz") + " -in2 " + TESTDATA("data_in/ReadQC_in2.fastq.gz") + " -out out/ReadQC_out6.txt -txt -threads 3");
+		COMPARE_FILES("out/ReadQC_out6.txt", TESTDATA("data_out/ReadQC_out2.txt"));
+	}
+
 	void single_end()
 	{
 		EXECUTE("ReadQC", "-in1 " + TESTDATA("data_in/ReadQC_in1.fastq.gz") + " -out out/ReadQC_out3.qcML");
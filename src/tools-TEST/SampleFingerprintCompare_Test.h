@@ -0,0 +1,14 @@
+#include "TestFramework.h"
+
+TEST_CLASS(SampleFingerprintCompare_Test)
+{
+Q_OBJECT
+private slots:
+
+	void test_default()
+	{
+		EXECUTE("SampleFingerprintCompare", "-in " + TESTDATA("data_in/SampleFingerprintCompare_in1.fp") + " -db " + TESTDATA("data_in/SampleFingerprintCompare_db.fp") + " -out out/SampleFingerprintCompare_out1.tsv");
+		COMPARE_FILES("out/SampleFingerprintCompare_out1.tsv", TESTDATA("data_out/SampleFingerprintCompare_out1.tsv"));
+	}
+
+};
@@ -0,0 +1,20 @@
+#include "TestFramework.h"
+
+TEST_CLASS(SampleFingerprint_Test)
+{
+Q_OBJECT
+private slots:
+
+	void test_vcf()
+	{
+		EXECUTE("SampleFingerprint", "-in " + TESTDATA("data_in/SampleSimilarity_in1.GSvar") + " -mode vcf -out out/SampleFingerprint_out1.fp");
+		COMPARE_FILES("out/SampleFingerprint_out1.fp", TESTDATA("data_out/SampleFingerprint_out1.fp"));
+	}
+
+	void test_bam()
+	{
+		EXECUTE("SampleFingerprint", "-in " + TESTDATA("data_in/SampleSimilarity_in4.bam") + " -out out/SampleFingerprint_out2.fp");
+		COMPARE_FILES("out/SampleFingerprint_out2.fp", TESTDATA("data_out/SampleFingerprint_out2.fp"));
+	}
+
+};
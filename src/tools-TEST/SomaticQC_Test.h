@@ -39,6 +39,17 @@ private slots:
 		COMPARE_FILES("out/SomaticQC_out3.qcML", TESTDATA("data_out/SomaticQC_out3.qcML"));
     }
 
+	void tumor_content_threads()
+	{
+		QString ref_file = Settings::string("reference_genome");
+		if (ref_file=="") SKIP("Test needs the reference genome!");
+
+		EXECUTE("SomaticQC", "-tumor_bam " + TESTDATA("data_in/SomaticQC_in1_tum.bam") + " -normal_bam " + TESTDATA("data_in/SomaticQC_in1_nor.bam") + " -somatic_vcf " + TESTDATA("data_in/SomaticQC_in1.GSvar") + " -links " + TESTDATA("data_in/SomaticQC_in4.qcML") + " -skip_plots -threads 4 -out out/SomaticQC_out3_threads.qcML");
+		REMOVE_LINES("out/SomaticQC_out3_threads.qcML", QRegExp("creation "));
+		REMOVE_LINES("out/SomaticQC_out3_threads.qcML", QRegExp("<binary>"));
+		COMPARE_FILES("out/SomaticQC_out3_threads.qcML", TESTDATA("data_out/SomaticQC_out3.qcML"));
+	}
+
     void target()
 	{
         QString ref_file = Settings::string("reference_genome");
@@ -26,6 +26,21 @@ private slots:
 		COMPARE_FILES("out/VcfSort_out3.vcf", TESTDATA("data_out/VcfSort_out3.vcf"));
 		VCF_IS_VALID("out/VcfSort_out3.vcf")
 	}
+
+	void test_external()
+	{
+		EXECUTE("VcfSort", "-in " + TESTDATA("data_in/VcfSort_in3.vcf") + " -out out/VcfSort_out4.vcf -fai " + TESTDATA("data_in/hg19.fa.fai") + " -external 10 -threads 2");
+		COMPARE_FILES("out/VcfSort_out4.vcf", TESTDATA("data_out/VcfSort_out4.vcf"));
+		VCF_IS_VALID("out/VcfSort_out4.vcf")
+	}
+
+	void test_external_multipass()
+	{
+		//more runs than files merged at once, non-standard chromosomes are sorted in the order of the input file
+		EXECUTE("VcfSort", "-in " + TESTDATA("data_in/VcfSort_in4.vcf") + " -out out/VcfSort_out5.vcf -external 1 -threads 4");
+		COMPARE_FILES("out/VcfSort_out5.vcf", TESTDATA("data_out/VcfSort_out5.vcf"));
+		//VCF_IS_VALID not applied because this is fake data with invalid chromosomes/coordinates
+	}
 };
 
 
@@ -21,5 +21,12 @@ private slots:
 		COMPARE_FILES("out/VcfStreamSort_out2.vcf", TESTDATA("data_out/VcfStreamSort_out2.vcf"));
 		VCF_IS_VALID("out/VcfStreamSort_out2.vcf")
 	}
+
+	void window_grows()
+	{
+		EXECUTE("VcfStreamSort", "-n 2 -in " + TESTDATA("data_in/VcfStreamSort_in3.vcf") + " -out out/VcfStreamSort_out3.vcf");
+		COMPARE_FILES("out/VcfStreamSort_out3.vcf", TESTDATA("data_out/VcfStreamSort_out3.vcf"));
+		VCF_IS_VALID("out/VcfStreamSort_out3.vcf")
+	}
 };
 
@@ -0,0 +1,6 @@
+##fingerprint=1
+##build=hg19
+##panel=29210
+#sample	genotypes
+SampleSimilarity_in2	...111.......1.1112..1.........22...........2.......12...2..1.....1..1111............1121...12.........2...2.22....1......12.1.2.....12..2.1211..11.11............22.2......1.....111212222112...11.2....1...121..............1...11111111111..1................21122......122.111....................2............1111..1..1.11122.2.2...22.........2....2222....2.22222.22...111....111.........2................1.1....1.1..111111.1.1112.222..221.22...1..1.1..1....11.1111111111.11.....222111..22.2.1.2..1.11.1.12.111.22111....1111.11.1..121111..1122111..11..222222.2221....2.22222222.2222111111.11..222...1..2.1..211111...1...1.222222111...22..1.112.....1.11.2222.11......111212221.1.1111..2........222.1111.11111..21....1221.........22..2.222.2..2...2.....1......11...112.22..1.12...21....2211.22......211.....11...111111111112111.1111.1.111.111111111122..111.....11.11.111111.1.111.2111.111111111.1.21111...2...........11112.112.21..22.2..22.11222.12111.1...22....111111.....112111..22122..1.1111....2.2.22111111.11.1.....22221121122.2.211.1..11.....111.....2....22....22212.2.1..2......1.111111.2........121212211111.12.1.21..2......2...1.121...1.12111.1.11111111.1.111111121122122111.........111.22111.2.2.1.22.111.11.......11222.22..222222.2.11.1....11.211...211....12222222111..122.12222...1..2..1111112.1.12.2.2.2112..222.1.1...........11.1...1..1.11111111..112.1212...1...2222...2.111...1111.2.1..............11111.........1..1....11111..............1..121.........222.211.1211.2..11122.222................2222.2222222.......................................................22211111.111..11....111111111111..1.2.22222222211.1111111.1111.22..1111121111111............121211.2........11122.2111122.2122112.2.1..111.222........2.111.111.11.111....1111...........1111111.11...1111.1111.211222211....11..1211...1..1.111111111111112.11..111.....11....1..1.111.2.11.2..1.11....1..112.......112.....1111...1.12.1211111111..211.1212.2.1112.11..12........12.....1......222.2.222221.11.2111122..2.....1..11.....222.211.22.222.111111.11.11..111222.2222....................22.12...11111111..1122.111.1.11111...22.................1111.111.....1...1....22211......111121111111111211........1...............11122.2....111..111111.112222.1......11..1.22.....11111.2222.1.1..1111..1111.....22111.2..11......1222221.1..2......1111.....1..1111..2....12.2111.11111.1.1111....2111..1.11.222.....1.121212..22.22.1..1..12......1111.111.12...222.....1111...22222.2221...1111111121222222221.2....22...2.....2..2222222..22222....2.2.2.2.222.2222....1...12.1....111.1112..1111.111.....21....1.1.11221111.....1....2..11.211...............2..2...12222212.222222222222222222222........1...111.....11.1.11....1.2......2...211..1..1....11.....1221122.121.122.22..2.1.1..11122......2.111111112..1111....1111.111..1....1....1111111111....112.....................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................
+SampleSimilarity_in3	....222........111.......1.....22....................2.1.2.......21.11111........112222211...122..2.2.......2..22.......2....1.11......22.111.2..2.....212211...2222.11.....11.....121.22.2.12...22.11.11.....2.11111111111........2222..22211.112............2.111.2.......21.21222..................1......1...21..1.1.1..2...................111112....2222....2.111121111..222.11111122.2222...2...............1..11.111111111111.2.11111222..221..11..1.1112..1....21.11.111111111......222.2...112.2222.222221.1..1122.22....11.12.1.121211212111....12111111...222221111121...2.22222222.1111111111.111.111...1..1....2221121....111.211111111...1111....1..11.111..2111..1..1111111.1111...2221......11....1111111111.221.1.111112121..11.....22..11121.11111...221.2.11111122..2..1.11..1.11....111...2.2.221..1.111........1.............22..........111.112222222122........11....122........222.2......22.....1112....1..2...........11111...2..111..11.111.11222.11222.1...1.2...11.11.1.......1.21111.1121.1..22....2.1.22211.11.222211..22222.222222.1.2.2.1..11..11....11...21.1.22..1.111..11111.1......21121.1..2...1...1.2.2.1112........11...2......1..1...2.12.11.21111.1..111..1..22222...........222.........2222..1.1.2.221111.222...11111....1.212...222222..1211.1...22.2..22...12111122222222...1122..222.......11..21..11.1.1211.2121.1..1.1.1111111.11.22.11.2...2..111..1..2...2.2122121..2111211111.1.222.112211.2.1..............2.111.........1.2.1111................1.12.............1.22.21111.11.21.22222.2222...............2222.2121222..........................................................1....111111......111111111111....1111111111111.111.1.1.12.2.11......2211..111...11111...11121..12111111.2....111111111.2..1...1.2...111.222..11111...1.21211.111..1.11111222.1122222212221111121111.222.111112.1....122..2....2.2..11....1...22222..11111.111.1221..1.22...1....1122212...2.111.112..1......1.....1.11..1..112..11111111111111..1.11..111....22111....121.11...2.11..1.112....2222..22..11.22.2.21122.211111111111..111112.1...21.122.111111.1112....22.221111.............11.....2...1.1..11...1...1111111222221111...211122111...222..1111111.111..2.1.1..1221.1112....1..2.1.....12111.1111111111..........1.111111121222.2..1112..111111..22222.1.1.....2.11.2111.1.22212.2211..1.....1...1111.....1111..112...1...122.......11...122..........1..12...11....12.1111122222.1.2111....21.1111.22.222...111..2.1111112.22.1..21...1...11.2.2.211..21111111.1.........22222.22.....22.2...11.22211222..2....22...1..1111..1111111..1.111....1.11...1.111.1111111111121......111.1111.12211.111....11.112..1.....1....2..........11....1122...........2.2111111122212.2.22222222122221222212..2222....221.1122.21..221..11211111.1..11....22...22......2.11..1.11211.212..22.22..11..111111.2......112..2....1..1111.....111.111..1....1....1111111111....11.........2.......22...................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................
@@ -0,0 +1,5 @@
+##fingerprint=1
+##build=hg19
+##panel=29210
+#sample	genotypes
+SampleSimilarity_in1	...111.......1.1111..1.........22...........2.......12...2..1.....1..1111............1121...12.........2...2.22....1......12.1.21....12..2.1211..11.11............22.2......1....11112122.2112...11.2....1...121..............1...11111111111..1................21122......122.111....................2............1111..1..1.11122.2.2...22.........2....2222....2.22222.22...1111....11.........2..1.............1.1....1.1..111111.1.1112.222..221.22...1..11...1....11.1111111111111.....222111..22.2.1.2..1.11...12.111.22111....1111.1..1..121111..1122111..11..222222.2221....2.22222222.2222111111.11..222...1..2.1..211111...1...1..22222111...22..1.112.....1.11.2222.11......111212221.1.1111..2.2......222.1111.11111..21....1221.........22..2.222.2..2...2.....1......11...112.22..1.12...21....2211.22......211.....11...111111111112111.1111.1.111.111111111122..111.....11.11.111111.1.111.2111.111111111.1.21111...2...........11111.112.21..22.2..22.11222.12111.1...22....111111....1112111..22122..1.11111...2.2.22111111.11.1.....22221121122.2.211.1..11.....111.....2....22....22212.2.1..2......1.111111.2........121212211111.12.1.21..2......2...1.121...1.12111.1.11111111.1.11111112112212.111.........111.22111.2.2.1.22.111.11.......11222.22..222222.2.11.11...11.211...211....12222222111..122.12222...1..2..1111112.1.12.2.2.2112..222.1.1...........11.1...1..1.111.1111..212.1212...1...2222...2.111...1111.2.1..............11111.........1..1....11111..............1..121..........22.211.1211.2..11122.222................2222.2222222.......................................................22211111.111..11....11111111111.....2.22222222211.1111111.1111.22..1111121111111............121211.2........11122.2111122.2122112.2.1..111.222........2.111.111.11.111....1111...........1111111.11...1111.1111.211222211.....1..1211...1..1.111111111111112.11..111.....11....1.11.111.2.11.2..1.11....1..112.......112.....1111...1.12.1211111111..211.1212.2.1112.11..12........12.....1.......22.2.222221.11.2111122..2.....1..11.....222.211.22.222.111111.11.11..111222.2222....................22.12...111.1111.11122.111.1.11111...22.................1111.111.....1...1....22211......111121111111111211........1...............11122.2....111..111111.112222.1......11..1.22.....11111.2222.1.1..1111..1111.....22111.2..11......1222221.1..2......1111.....1..1111..2....12.2111.11111.1.1111....2111..1.11.222.....1.121212..22.22.1..1..12......1111.111..2...222.....11111..22222.2221...1111111121222222221.2....22...2.....2..2222222..22222....2.2.2.2.222.2222....1...12.1....111.1112..1111.111.....21....1.1.11221111.....1....2..11..11...............2..2...12222212.222222222222222222222........1...121...1.11.1.11....1.2......2...211..1..1....11...1.1221122.121.122.22..2.1.1..11122......2.111111112..1111....1111.111..1....1....1111111111....1.....................2.................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................................
@@ -46,6 +46,8 @@ HEADERS += NGSDAddVariantsSomatic_Test.h \
     FastaInfo_Test.h \
     BedIntersect_Test.h \
     SampleSimilarity_Test.h \
+    SampleFingerprint_Test.h \
+    SampleFingerprintCompare_Test.h \
     SampleDiff_Test.h \
     GenesToApproved_Test.h \
     BedAnnotateFreq_Test.h \
@@ -60,6 +62,7 @@ HEADERS += NGSDAddVariantsSomatic_Test.h \
     BedToFasta_Test.h \
     VariantFilterRegions_Test.h \
     FastqMidParser_Test.h \
+    FastqDemultiplex_Test.h \
     FastqTrim_Test.h \
     FastqConvert_Test.h \
     CnvHunter_Test.h \
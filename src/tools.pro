@@ -93,6 +93,14 @@ SUBDIRS += SampleSimilarity
 tools-TEST.depends += SampleSimilarity
 SampleSimilarity.depends = cppNGS
 
+SUBDIRS += SampleFingerprint
+tools-TEST.depends += SampleFingerprint
+SampleFingerprint.depends = cppNGS
+
+SUBDIRS += SampleFingerprintCompare
+tools-TEST.depends += SampleFingerprintCompare
+SampleFingerprintCompare.depends = cppNGS
+
 SUBDIRS += SampleDiff
 tools-TEST.depends += SampleDiff
 SampleDiff.depends = cppNGS
@@ -157,6 +165,10 @@ SUBDIRS += FastqMidParser
 tools-TEST.depends += FastqMidParser
 FastqMidParser.depends = cppNGS
 
+SUBDIRS += FastqDemultiplex
+tools-TEST.depends += FastqDemultiplex
+FastqDemultiplex.depends = cppNGS
+
 SUBDIRS += FastqTrim
 tools-TEST.depends += FastqTrim
 FastqTrim.depends = cppNGS
@@ -373,5 +385,9 @@ SUBDIRS += NGSDAnnotateSV
 tools-TEST.depends += NGSDAnnotateSV
 NGSDAnnotateSV.depends = cppNGS
 
+SUBDIRS += NGSDExportSnapshot
+tools-TEST.depends += NGSDExportSnapshot
+NGSDExportSnapshot.depends = cppNGS
+
 #other stuff
 OTHER_FILES += ToDos.txt